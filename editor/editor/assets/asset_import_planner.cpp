@@ -0,0 +1,375 @@
+#include "asset_import_planner.h"
+#include <engine/assets/impl/asset_extensions.h>
+#include <engine/meta/assets/asset_database.hpp>
+#include <engine/threading/threader.h>
+
+#include <logging/logging.h>
+
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include <thread>
+
+#define POOLSTL_STD_SUPPLEMENT 1
+#include <poolstl/poolstl.hpp>
+
+namespace unravel
+{
+namespace
+{
+
+auto get_source_path(const fs::path& ref_path) -> fs::path
+{
+    fs::path source = fs::convert_to_protocol(ref_path);
+    source = fs::resolve_protocol(fs::replace(source, ex::get_meta_directory(), ex::get_data_directory()));
+    if(source.extension() == ".meta")
+    {
+        source.replace_extension();
+    }
+    return source;
+}
+
+/// Collects every quoted uuid in a serialized source. Asset handles are stored as their uid so
+/// this finds all referenced assets without having to load the source.
+auto scan_referenced_uids(const fs::path& source) -> std::vector<hpp::uuid>
+{
+    std::vector<hpp::uuid> uids;
+
+    std::ifstream file(source, std::ios::binary);
+    if(!file.is_open())
+    {
+        return uids;
+    }
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    const std::string text = buffer.str();
+
+    constexpr size_t uuid_length = 36;
+    size_t pos = text.find('"');
+    while(pos != std::string::npos && pos + uuid_length + 1 < text.size())
+    {
+        if(text[pos + uuid_length + 1] == '"')
+        {
+            auto uid = hpp::uuid::from_string(std::string_view(text).substr(pos + 1, uuid_length));
+            if(uid && !uid->is_nil())
+            {
+                uids.emplace_back(*uid);
+                pos = text.find('"', pos + uuid_length + 2);
+                continue;
+            }
+        }
+        pos = text.find('"', pos + 1);
+    }
+
+    return uids;
+}
+
+auto to_seconds(asset_import_planner::clock_t::duration d) -> double
+{
+    return std::chrono::duration<double>(d).count();
+}
+
+} // namespace
+
+void asset_import_planner::add(const fs::path& ref_path,
+                               const std::string& job_name,
+                               int rank,
+                               bool scan_references,
+                               compile_t compile)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto key = ref_path.generic_string();
+    auto it = lookup_.find(key);
+    if(it == lookup_.end())
+    {
+        it = lookup_.emplace(key, nodes_.size()).first;
+
+        auto& n = nodes_.emplace_back();
+        n.ref_path = ref_path;
+        n.job_name = job_name;
+        n.rank = rank;
+        n.scan_references = scan_references;
+    }
+
+    nodes_[it->second].jobs.emplace_back(std::move(compile));
+}
+
+void asset_import_planner::build_edges()
+{
+    // Every node is identified by the uid stored in its meta.
+    std::vector<hpp::uuid> node_uids(nodes_.size());
+    std::vector<std::vector<hpp::uuid>> references(nodes_.size());
+
+    std::vector<size_t> indices(nodes_.size());
+    std::iota(indices.begin(), indices.end(), size_t(0));
+
+    std::for_each(std::execution::par,
+                  indices.begin(),
+                  indices.end(),
+                  [&](size_t index)
+                  {
+                      const auto& n = nodes_[index];
+
+                      asset_meta meta;
+                      if(load_from_file(n.ref_path.string(), meta))
+                      {
+                          node_uids[index] = meta.uid;
+                      }
+
+                      if(n.scan_references)
+                      {
+                          references[index] = scan_referenced_uids(get_source_path(n.ref_path));
+                      }
+                  });
+
+    std::unordered_map<hpp::uuid, size_t> by_uid;
+    by_uid.reserve(nodes_.size());
+    for(size_t i = 0; i < nodes_.size(); ++i)
+    {
+        if(!node_uids[i].is_nil())
+        {
+            by_uid.emplace(node_uids[i], i);
+        }
+    }
+
+    size_t edges = 0;
+    for(size_t i = 0; i < nodes_.size(); ++i)
+    {
+        auto& refs = references[i];
+        std::sort(refs.begin(), refs.end());
+        refs.erase(std::unique(refs.begin(), refs.end()), refs.end());
+
+        for(const auto& uid : refs)
+        {
+            auto it = by_uid.find(uid);
+            if(it == by_uid.end() || it->second == i)
+            {
+                continue;
+            }
+
+            auto& dependency = nodes_[it->second];
+            dependency.dependents.emplace_back(i);
+            nodes_[i].pending++;
+            edges++;
+        }
+    }
+
+    APPLOG_TRACE("Import plan : {} assets, {} dependencies", nodes_.size(), edges);
+}
+
+void asset_import_planner::execute(rtti::context& ctx, size_t budget)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        collecting_ = false;
+        ctx_ = &ctx;
+        start_ = clock_t::now();
+
+        if(budget == 0)
+        {
+            budget = std::max(1u, std::thread::hardware_concurrency()) - 1;
+        }
+        budget_ = std::max<size_t>(budget, 1);
+    }
+
+    if(nodes_.empty())
+    {
+        finished_cv_.notify_all();
+        return;
+    }
+
+    build_edges();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        for(size_t i = 0; i < nodes_.size(); ++i)
+        {
+            if(nodes_[i].pending == 0)
+            {
+                push_ready(i);
+            }
+        }
+        release_cycle();
+
+        APPLOG_INFO("Importing {} assets with {} concurrent jobs.", nodes_.size(), budget_);
+    }
+
+    schedule_ready();
+}
+
+void asset_import_planner::push_ready(size_t index)
+{
+    ready_.emplace_back(index);
+    std::push_heap(ready_.begin(), ready_.end(), by_rank{nodes_});
+}
+
+void asset_import_planner::release_cycle()
+{
+    // Nothing is running and nothing is ready but the plan is not done, so the remaining
+    // nodes reference each other. Release the lowest ranked one to keep the plan going.
+    if(cancelled_ || in_flight_ > 0 || !ready_.empty() || done_ == nodes_.size())
+    {
+        return;
+    }
+
+    size_t selected = nodes_.size();
+    for(size_t i = 0; i < nodes_.size(); ++i)
+    {
+        if(nodes_[i].pending > 0 && (selected == nodes_.size() || nodes_[i].rank < nodes_[selected].rank))
+        {
+            selected = i;
+        }
+    }
+
+    if(selected != nodes_.size())
+    {
+        APPLOG_WARNING("Cyclic asset references detected while importing {}", nodes_[selected].ref_path.string());
+        nodes_[selected].pending = 0;
+        push_ready(selected);
+    }
+}
+
+void asset_import_planner::schedule_ready()
+{
+    auto& ts = ctx_->get_cached<threader>();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    while(!cancelled_ && in_flight_ < budget_ && !ready_.empty())
+    {
+        std::pop_heap(ready_.begin(), ready_.end(), by_rank{nodes_});
+        auto index = ready_.back();
+        ready_.pop_back();
+
+        in_flight_++;
+
+        auto& n = nodes_[index];
+        auto task = ts.pool->schedule(n.job_name,
+            [self = shared_from_this(), index]()
+            {
+                for(const auto& job : self->nodes_[index].jobs)
+                {
+                    job();
+                }
+
+                self->on_finished(index);
+            });
+    }
+}
+
+void asset_import_planner::on_finished(size_t index)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        in_flight_--;
+        done_++;
+
+        for(auto dependent : nodes_[index].dependents)
+        {
+            auto& n = nodes_[dependent];
+            if(n.pending > 0 && --n.pending == 0)
+            {
+                push_ready(dependent);
+            }
+        }
+        release_cycle();
+    }
+
+    report_progress();
+    schedule_ready();
+
+    finished_cv_.notify_all();
+}
+
+void asset_import_planner::report_progress()
+{
+    auto p = get_progress();
+    if(p.total == 0)
+    {
+        return;
+    }
+
+    constexpr size_t steps = 10;
+    size_t step = (p.done * steps) / p.total;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if(step <= reported_step_)
+        {
+            return;
+        }
+        reported_step_ = step;
+    }
+
+    if(p.running)
+    {
+        APPLOG_INFO("Importing assets {}/{} ({:.1f}s elapsed, ~{:.1f}s left)",
+                    p.done,
+                    p.total,
+                    to_seconds(p.elapsed),
+                    to_seconds(p.eta));
+    }
+    else
+    {
+        APPLOG_INFO("Imported {} assets in {:.2f}s", p.total, to_seconds(p.elapsed));
+    }
+}
+
+void asset_import_planner::cancel()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        collecting_ = false;
+        cancelled_ = true;
+        ready_.clear();
+    }
+    finished_cv_.notify_all();
+}
+
+void asset_import_planner::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    finished_cv_.wait(lock,
+                      [this]()
+                      {
+                          if(collecting_)
+                          {
+                              return false;
+                          }
+                          return in_flight_ == 0 && (cancelled_ || done_ == nodes_.size());
+                      });
+}
+
+auto asset_import_planner::is_collecting() const -> bool
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return collecting_;
+}
+
+auto asset_import_planner::get_progress() const -> progress
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    progress p;
+    p.total = nodes_.size();
+    p.done = done_;
+    p.running = !collecting_ && !cancelled_ && done_ < nodes_.size();
+    if(collecting_)
+    {
+        return p;
+    }
+
+    p.elapsed = clock_t::now() - start_;
+    if(p.done > 0 && p.running)
+    {
+        p.eta = (p.elapsed / p.done) * (p.total - p.done);
+    }
+
+    return p;
+}
+
+} // namespace unravel
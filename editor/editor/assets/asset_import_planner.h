@@ -0,0 +1,119 @@
+#pragma once
+#include <context/context.hpp>
+#include <filesystem/filesystem.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace unravel
+{
+
+/**
+ * @class asset_import_planner
+ * @brief Collects the compile jobs discovered during an initial import and runs them as a graph.
+ *
+ * Every source asset becomes a node. Edges come from the asset uids referenced by text sources
+ * (materials, prefabs, scenes), so an asset is only compiled after everything it references.
+ * Ready nodes are ordered by rank and at most 'budget' of them are in flight on the thread pool
+ * at any time, leaving the remaining workers free for the editor. Must be owned by a shared_ptr
+ * since scheduled jobs keep the planner alive.
+ */
+class asset_import_planner : public std::enable_shared_from_this<asset_import_planner>
+{
+public:
+    using clock_t = std::chrono::steady_clock;
+    using compile_t = std::function<void()>;
+
+    struct progress
+    {
+        /// Number of source assets in the plan.
+        size_t total{};
+        /// Number of source assets already compiled.
+        size_t done{};
+        /// Time since the plan was started.
+        clock_t::duration elapsed{};
+        /// Estimated time until the plan finishes.
+        clock_t::duration eta{};
+        /// Whether the plan is still running.
+        bool running{};
+    };
+
+    /**
+     * @brief Adds a compile job for a source asset.
+     * @param ref_path The meta file of the source asset.
+     * @param job_name The name the job is scheduled under.
+     * @param rank Ready nodes with a lower rank are scheduled first.
+     * @param scan_references Whether the source should be scanned for referenced assets.
+     * @param compile The job itself. Jobs added for the same ref_path run together.
+     */
+    void add(const fs::path& ref_path, const std::string& job_name, int rank, bool scan_references, compile_t compile);
+
+    /**
+     * @brief Builds the graph and starts compiling.
+     * @param budget Maximum number of jobs in flight. 0 picks one less than the number of cores.
+     */
+    void execute(rtti::context& ctx, size_t budget = 0);
+
+    /// Stops scheduling new jobs. Jobs already in flight still finish.
+    void cancel();
+
+    /// Blocks until every scheduled job has finished.
+    void wait();
+
+    auto is_collecting() const -> bool;
+    auto get_progress() const -> progress;
+
+private:
+    struct node
+    {
+        fs::path ref_path;
+        std::string job_name;
+        int rank{};
+        bool scan_references{};
+        std::vector<compile_t> jobs;
+
+        std::vector<size_t> dependents;
+        size_t pending{};
+    };
+
+    struct by_rank
+    {
+        const std::vector<node>& nodes;
+
+        auto operator()(size_t lhs, size_t rhs) const -> bool
+        {
+            return nodes[lhs].rank > nodes[rhs].rank;
+        }
+    };
+
+    void build_edges();
+    void push_ready(size_t index);
+    void release_cycle();
+    void schedule_ready();
+    void on_finished(size_t index);
+    void report_progress();
+
+    mutable std::mutex mutex_;
+    std::condition_variable finished_cv_;
+
+    rtti::context* ctx_{};
+    std::vector<node> nodes_;
+    std::unordered_map<std::string, size_t> lookup_;
+    std::vector<size_t> ready_;
+
+    size_t budget_{};
+    size_t in_flight_{};
+    size_t done_{};
+    size_t reported_step_{};
+    bool collecting_{true};
+    bool cancelled_{};
+    clock_t::time_point start_{};
+};
+
+} // namespace unravel
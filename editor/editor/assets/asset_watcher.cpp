@@ -40,6 +40,40 @@ auto get_job_name() -> std::string
     return fmt::format("Compiling {}", ex::get_type<T>());
 }
 
+/// Ready assets with a lower rank are imported first during the initial import.
+template<typename T>
+auto get_import_rank() -> int
+{
+    if constexpr(std::is_same_v<T, mesh>)
+    {
+        return 1;
+    }
+    else if constexpr(std::is_same_v<T, material> || std::is_same_v<T, animation_clip> ||
+                      std::is_same_v<T, physics_material>)
+    {
+        return 2;
+    }
+    else if constexpr(std::is_same_v<T, prefab>)
+    {
+        return 3;
+    }
+    else if constexpr(std::is_same_v<T, scene_prefab>)
+    {
+        return 4;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+/// Whether the source of T is serialized with references to other assets.
+template<typename T>
+auto has_asset_references() -> bool
+{
+    return std::is_same_v<T, material> || std::is_same_v<T, prefab> || std::is_same_v<T, scene_prefab>;
+}
+
 template<typename T>
 auto checking_dependencies_job_name() -> std::string
 {
@@ -322,6 +356,7 @@ auto watch_assets_depenencies(rtti::context& ctx, const fs::path& dir, const fs:
 template<typename T>
 static void add_to_syncer(rtti::context& ctx,
                           fs::syncer& syncer,
+                          const std::shared_ptr<asset_import_planner>& planner,
                           const fs::syncer::on_entry_removed_t& on_removed,
                           const fs::syncer::on_entry_renamed_t& on_renamed)
 {
@@ -329,7 +364,7 @@ static void add_to_syncer(rtti::context& ctx,
     auto& am = ctx.get_cached<asset_manager>();
 
     auto on_modified =
-        [&ts, &am](const std::string& ext, const auto& ref_path, const auto& synced_paths, bool is_initial_listing)
+        [&ts, &am, planner](const std::string& ext, const auto& ref_path, const auto& synced_paths, bool is_initial_listing)
     {
         auto paths = remove_meta_tag(synced_paths);
 
@@ -343,11 +378,19 @@ static void add_to_syncer(rtti::context& ctx,
             auto key = get_asset_key(output);
             if(check_files_integrity(key, output))
             {
-                auto task = ts.pool->schedule(get_job_name<T>(),
-                    [&am, ref_path, output]()
-                    {
-                        asset_compiler::compile<T>(am, ref_path, output);
-                    });
+                auto compile = [&am, ref_path, output]()
+                {
+                    asset_compiler::compile<T>(am, ref_path, output);
+                };
+
+                if(is_initial_listing && planner->is_collecting())
+                {
+                    planner->add(ref_path, get_job_name<T>(), get_import_rank<T>(), has_asset_references<T>(), compile);
+                }
+                else
+                {
+                    auto task = ts.pool->schedule(get_job_name<T>(), compile);
+                }
             }
         }
     };
@@ -371,6 +414,7 @@ static void watch_synced(rtti::context& ctx, std::vector<uint64_t>& watchers, co
 template<>
 void add_to_syncer<gfx::shader>(rtti::context& ctx,
                                 fs::syncer& syncer,
+                                const std::shared_ptr<asset_import_planner>& planner,
                                 const fs::syncer::on_entry_removed_t& on_removed,
                                 const fs::syncer::on_entry_renamed_t& on_renamed)
 {
@@ -378,7 +422,7 @@ void add_to_syncer<gfx::shader>(rtti::context& ctx,
     auto& am = ctx.get_cached<asset_manager>();
 
     auto on_modified =
-        [&ts, &am](const std::string& ext, const auto& ref_path, const auto& synced_paths, bool is_initial_listing)
+        [&ts, &am, planner](const std::string& ext, const auto& ref_path, const auto& synced_paths, bool is_initial_listing)
     {
         auto paths = remove_meta_tag(synced_paths);
         if(paths.empty())
@@ -387,6 +431,9 @@ void add_to_syncer<gfx::shader>(rtti::context& ctx,
         }
         const auto& platform_supported = gfx::get_renderer_platform_supported_filename_extensions();
 
+        // All renderer variants of a shader go out as one job so they can share the
+        // preprocessed source and compile in parallel.
+        std::vector<fs::path> outputs;
         for(const auto& output : paths)
         {
             auto it =
@@ -406,13 +453,32 @@ void add_to_syncer<gfx::shader>(rtti::context& ctx,
             auto key = get_asset_key(output);
             if(check_files_integrity(key, output))
             {
-                auto task = ts.pool->schedule(get_job_name<gfx::shader>(),
-                    [&am, ref_path, output]()
-                    {
-                        asset_compiler::compile<gfx::shader>(am, ref_path, output);
-                    });
+                outputs.emplace_back(output);
             }
         }
+
+        if(outputs.empty())
+        {
+            return;
+        }
+
+        auto compile = [&am, ref_path, outputs]()
+        {
+            asset_compiler::compile_shader_variants(am, ref_path, outputs);
+        };
+
+        if(is_initial_listing && planner->is_collecting())
+        {
+            planner->add(ref_path,
+                         get_job_name<gfx::shader>(),
+                         get_import_rank<gfx::shader>(),
+                         has_asset_references<gfx::shader>(),
+                         compile);
+        }
+        else
+        {
+            auto task = ts.pool->schedule(get_job_name<gfx::shader>(), compile);
+        }
     };
 
     for(const auto& type : ex::get_suported_formats<gfx::shader>())
@@ -548,6 +614,7 @@ void asset_watcher::setup_cache_syncer(rtti::context& ctx,
                                        fs::syncer& syncer,
                                        const fs::path& meta_dir,
                                        const fs::path& cache_dir,
+                                       const std::shared_ptr<asset_import_planner>& planner,
                                        bool wait)
 {
     setup_directory(ctx, syncer);
@@ -573,22 +640,27 @@ void asset_watcher::setup_cache_syncer(rtti::context& ctx,
         }
     };
 
-    add_to_syncer<gfx::texture>(ctx, syncer, on_removed, on_renamed);
-    add_to_syncer<gfx::shader>(ctx, syncer, on_removed, on_renamed);
-    add_to_syncer<mesh>(ctx, syncer, on_removed, on_renamed);
-    add_to_syncer<material>(ctx, syncer, on_removed, on_renamed);
-    add_to_syncer<animation_clip>(ctx, syncer, on_removed, on_renamed);
-    add_to_syncer<prefab>(ctx, syncer, on_removed, on_renamed);
-    add_to_syncer<scene_prefab>(ctx, syncer, on_removed, on_renamed);
-    add_to_syncer<physics_material>(ctx, syncer, on_removed, on_renamed);
-    add_to_syncer<audio_clip>(ctx, syncer, on_removed, on_renamed);
-    add_to_syncer<font>(ctx, syncer, on_removed, on_renamed);
-    add_to_syncer<script>(ctx, syncer, on_removed, on_renamed);
-
+    add_to_syncer<gfx::texture>(ctx, syncer, planner, on_removed, on_renamed);
+    add_to_syncer<gfx::shader>(ctx, syncer, planner, on_removed, on_renamed);
+    add_to_syncer<mesh>(ctx, syncer, planner, on_removed, on_renamed);
+    add_to_syncer<material>(ctx, syncer, planner, on_removed, on_renamed);
+    add_to_syncer<animation_clip>(ctx, syncer, planner, on_removed, on_renamed);
+    add_to_syncer<prefab>(ctx, syncer, planner, on_removed, on_renamed);
+    add_to_syncer<scene_prefab>(ctx, syncer, planner, on_removed, on_renamed);
+    add_to_syncer<physics_material>(ctx, syncer, planner, on_removed, on_renamed);
+    add_to_syncer<audio_clip>(ctx, syncer, planner, on_removed, on_renamed);
+    add_to_syncer<font>(ctx, syncer, planner, on_removed, on_renamed);
+    add_to_syncer<script>(ctx, syncer, planner, on_removed, on_renamed);
+
+    // The initial listing only collects what needs compiling. Run it as one plan so
+    // assets are compiled after everything they reference.
     syncer.sync(meta_dir, cache_dir);
+    planner->execute(ctx);
 
     if(wait)
     {
+        planner->wait();
+
         auto& ts = ctx.get_cached<threader>();
         ts.pool->wait_all();
     }
@@ -670,11 +742,14 @@ void asset_watcher::watch_assets(rtti::context& ctx, const std::string& protocol
                       fs::resolve_protocol(meta_protocol),
                       wait);
 
+    w.planner = std::make_shared<asset_import_planner>();
+
     setup_cache_syncer(ctx,
                        w.watchers,
                        w.cache_syncer,
                        fs::resolve_protocol(meta_protocol),
                        fs::resolve_protocol(cache_protocol),
+                       w.planner,
                        wait);
 }
 
@@ -686,10 +761,41 @@ void asset_watcher::unwatch_assets(rtti::context& ctx, const std::string& protoc
     w.meta_syncer.unsync();
     w.cache_syncer.unsync();
 
+    if(w.planner)
+    {
+        w.planner->cancel();
+        w.planner->wait();
+    }
+
     watched_protocols_.erase(protocol);
 
     auto& am = ctx.get_cached<asset_manager>();
     am.unload_group(protocol);
 }
 
+auto asset_watcher::get_import_progress() const -> asset_import_planner::progress
+{
+    asset_import_planner::progress result;
+    for(const auto& [protocol, w] : watched_protocols_)
+    {
+        if(!w.planner)
+        {
+            continue;
+        }
+
+        auto p = w.planner->get_progress();
+        if(!p.running)
+        {
+            continue;
+        }
+
+        result.total += p.total;
+        result.done += p.done;
+        result.elapsed = std::max(result.elapsed, p.elapsed);
+        result.eta = std::max(result.eta, p.eta);
+        result.running = true;
+    }
+    return result;
+}
+
 } // namespace unravel
@@ -1,4 +1,5 @@
 #pragma once
+#include "asset_import_planner.h"
 #include <context/context.hpp>
 #include <filesystem/syncer.h>
 #include <ospp/event.h>
@@ -20,6 +21,9 @@ public:
     void watch_assets(rtti::context& ctx, const std::string& protocol, bool wait = false);
     void unwatch_assets(rtti::context& ctx, const std::string& protocol);
 
+    /// Combined progress of the initial imports that are still running.
+    auto get_import_progress() const -> asset_import_planner::progress;
+
 private:
     void on_os_event(rtti::context& ctx, os::event& e);
 
@@ -35,6 +39,7 @@ private:
                             fs::syncer& syncer,
                             const fs::path& meta_dir,
                             const fs::path& cache_dir,
+                            const std::shared_ptr<asset_import_planner>& planner,
                             bool wait);
 
     struct watched
@@ -42,6 +47,7 @@ private:
         fs::syncer meta_syncer;
         fs::syncer cache_syncer;
         std::vector<std::uint64_t> watchers;
+        std::shared_ptr<asset_import_planner> planner;
     };
 
     std::map<std::string, watched> watched_protocols_{};
@@ -1133,6 +1133,9 @@ auto editor_actions::deploy_project(rtti::context& ctx,
                             APPLOG_TRACE("Copying {} -> {}", data.generic_string(), cached_data.generic_string());
                             fs::copy(data, cached_data, fs::copy_options::recursive, ec);
 
+                            // The shader cache only speeds up compiling in the editor.
+                            fs::remove_all(params.deploy_location / "data" / "app" / ex::get_shader_cache_directory_no_slash(), ec);
+
                             remove_unreferenced_files(cached_data);
                         }
 
@@ -1169,6 +1172,9 @@ auto editor_actions::deploy_project(rtti::context& ctx,
                                    APPLOG_TRACE("Copying {} -> {}", data.generic_string(), cached_data.generic_string());
                                    fs::copy(data, cached_data, fs::copy_options::recursive, ec);
 
+                                   // The shader cache only speeds up compiling in the editor.
+                                   fs::remove_all(params.deploy_location / "data" / "engine" / ex::get_shader_cache_directory_no_slash(), ec);
+
                                    remove_unreferenced_files(cached_data);
                                }
 
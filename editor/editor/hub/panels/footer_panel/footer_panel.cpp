@@ -1,6 +1,7 @@
 #include "footer_panel.h"
 #include "../panels_defs.h"
 
+#include <editor/assets/asset_watcher.h>
 #include <engine/threading/threader.h>
 
 #include <imgui/imgui.h>
@@ -27,11 +28,14 @@ void footer_panel::draw_footer_child(rtti::context& ctx, float footer_size, cons
     auto& thr = ctx.get_cached<threader>();
     auto pool_jobs = thr.pool->get_jobs_count_detailed();
 
+    auto& aw = ctx.get_cached<asset_watcher>();
+    auto import_progress = aw.get_import_progress();
+
 
     constexpr uint64_t notification_id = 99;
     if(!pool_jobs.empty())
     {
-        auto callback = [jobs = std::move(pool_jobs)](const ImGuiToast& toast, float opacity, const ImVec4& text_color) 
+        auto callback = [jobs = std::move(pool_jobs), import_progress](const ImGuiToast& toast, float opacity, const ImVec4& text_color) 
         {
             size_t total_job_count = 0;
             for(const auto& [name, count] : jobs)
@@ -53,6 +57,18 @@ void footer_panel::draw_footer_child(rtti::context& ctx, float footer_size, cons
 
             ImGui::TextColored(text_color, "%s", fmt::format("Jobs : {}", total_job_count).c_str());
 
+            if(import_progress.running)
+            {
+                auto eta = std::chrono::duration_cast<std::chrono::seconds>(import_progress.eta);
+                ImGui::TextColored(text_color,
+                                   "%s",
+                                   fmt::format("Importing : {}/{} (~{}s left)",
+                                               import_progress.done,
+                                               import_progress.total,
+                                               eta.count())
+                                       .c_str());
+            }
+
             for(const auto& [name, count] : jobs)
             {
                 ImGui::TextColored(text_color, "%s", fmt::format("{} : {}", name, count).c_str());
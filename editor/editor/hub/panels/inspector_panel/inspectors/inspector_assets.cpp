@@ -500,6 +500,7 @@ auto inspector_asset_handle_mesh::inspect(rtti::context& ctx,
         inspected_asset_ = data;
         inspected_version_ = data.version();
         importer_ = nullptr;
+        cache_stats_.clear();
     }
 
     auto& am = ctx.get_cached<asset_manager>();
@@ -523,10 +524,45 @@ auto inspector_asset_handle_mesh::inspect(rtti::context& ctx,
                     mesh_info.submeshes = static_cast<std::uint32_t>(mesh->get_submeshes_count());
                     mesh_info.data_groups = static_cast<std::uint32_t>(mesh->get_data_groups_count());
 
+                    // Simulating the cache walks the whole index buffer, only do it once per version.
+                    const auto* indices = mesh->get_system_ib();
+                    if(cache_stats_.empty() && indices)
+                    {
+                        cache_stats_.emplace_back(
+                            importer::analyze_vertex_cache(indices, size_t(mesh->get_face_count()) * 3));
+
+                        for(const auto* submesh : mesh->get_submeshes())
+                        {
+                            cache_stats_.emplace_back(
+                                importer::analyze_vertex_cache(indices + size_t(submesh->face_start) * 3,
+                                                               size_t(submesh->face_count) * 3));
+                        }
+                    }
+
+                    if(!cache_stats_.empty())
+                    {
+                        mesh_info.acmr = cache_stats_.front().acmr;
+                        mesh_info.atvr = cache_stats_.front().atvr;
+                    }
+
                     rttr::variant var = mesh_info;
                     var_info mesh_var_info;
                     mesh_var_info.read_only = true;
                     result |= ::unravel::inspect_var(ctx, var, mesh_var_info);
+
+                    if(cache_stats_.size() > 1 && ImGui::TreeNode("Submesh Vertex Cache"))
+                    {
+                        const auto& submeshes = mesh->get_submeshes();
+                        for(size_t i = 1; i < cache_stats_.size() && i <= submeshes.size(); ++i)
+                        {
+                            ImGui::Text("Submesh %d : %u triangles, ACMR %.3f, ATVR %.3f",
+                                        int(i - 1),
+                                        submeshes[i - 1]->face_count,
+                                        cache_stats_[i].acmr,
+                                        cache_stats_[i].atvr);
+                        }
+                        ImGui::TreePop();
+                    }
                 }
             }
             ImGui::EndChild();
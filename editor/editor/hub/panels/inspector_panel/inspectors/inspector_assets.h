@@ -3,6 +3,7 @@
 #include "inspector.h"
 #include <engine/assets/asset_handle.h>
 #include <engine/assets/asset_manager.h>
+#include <engine/assets/impl/importers/mesh_optimizer.h>
 #include <engine/ecs/scene.h>
 #include <audiopp/source.h>
 
@@ -74,6 +75,9 @@ struct inspector_asset_handle_mesh : public inspector_asset_handle
     asset_handle<mesh> inspected_asset_;
     std::shared_ptr<mesh_importer_meta> importer_;
     uintptr_t inspected_version_{};
+
+    /// Vertex cache statistics of the whole index buffer followed by every submesh.
+    std::vector<importer::vertex_cache_stats> cache_stats_;
 };
 REFLECT_INSPECTOR_INLINE(inspector_asset_handle_mesh, asset_handle<mesh>)
 
@@ -76,6 +76,10 @@ inspect_result inspector_physics_compound_shape::inspect(rtti::context& ctx,
         {
             data.shape = physics_cylinder_shape{};
         }
+        else if(*type == rttr::type::get<physics_mesh_shape>())
+        {
+            data.shape = physics_mesh_shape{};
+        }
     }
 
     if(hpp::holds_alternative<physics_box_shape>(data.shape))
@@ -98,6 +102,11 @@ inspect_result inspector_physics_compound_shape::inspect(rtti::context& ctx,
         auto& shape = hpp::get<physics_cylinder_shape>(data.shape);
         result |= ::unravel::inspect(ctx, shape);
     }
+    else if(hpp::holds_alternative<physics_mesh_shape>(data.shape))
+    {
+        auto& shape = hpp::get<physics_mesh_shape>(data.shape);
+        result |= ::unravel::inspect(ctx, shape);
+    }
     else
     {
         ImGui::LabelText("Unknown", "%s", "test");
@@ -895,6 +895,21 @@ void draw_time_settings(rtti::context& ctx)
     ImGui::PopItemWidth();
 }
 
+void draw_physics_settings(rtti::context& ctx)
+{
+    auto& pm = ctx.get_cached<project_manager>();
+    auto& settings = pm.get_settings();
+
+    ImGui::PushItemWidth(150.0f);
+
+    if(inspect(ctx, settings.physics).edit_finished)
+    {
+        pm.save_project_settings(ctx);
+    }
+
+    ImGui::PopItemWidth();
+}
+
 } // namespace
 
 project_settings_panel::project_settings_panel(imgui_panels* parent) : parent_(parent)
@@ -946,7 +961,8 @@ void project_settings_panel::draw_ui(rtti::context& ctx)
                                                  {"Standalone", &draw_standalone_settings},
                                                  {"Layers", &draw_layers_settings},
                                                  {"Input", &draw_input_settings},
-                                                 {"Time", &draw_time_settings}};
+                                                 {"Time", &draw_time_settings},
+                                                 {"Physics", &draw_physics_settings}};
     // Child A: the categories list
     // We fix the width of this child, so the right child uses the remaining space.
     ImGui::BeginChild("##LeftSidebar", avail * ImVec2(0.15f, 1.0f), ImGuiChildFlags_Borders | ImGuiChildFlags_ResizeX);
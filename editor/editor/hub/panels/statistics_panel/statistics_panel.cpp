@@ -2,7 +2,12 @@
 #include "statistics_utils.h"
 #include "../panels_defs.h"
 
+#include <engine/ecs/ecs.h>
+#include <engine/events.h>
+#include <engine/meta/physics/physics_replay.hpp>
+#include <engine/physics/ecs/systems/physics_system.h>
 #include <engine/profiler/profiler.h>
+#include <filesystem/filesystem.h>
 #include <graphics/graphics.h>
 #include <math/math.h>
 
@@ -22,6 +27,9 @@ namespace
     constexpr float PROFILER_MAX_WIDTH = 30.0f;
     constexpr float RESOURCE_BAR_WIDTH = 90.0f;
     constexpr float MEGABYTE_DIVISOR = 1024.0f * 1024.0f;
+    constexpr uint32_t BROADPHASE_BENCHMARK_BODIES = 50000;
+    constexpr uint32_t BROADPHASE_BENCHMARK_STEPS = 60;
+    constexpr const char* PHYSICS_RECORDING_PATH = "app:/physics_recording.bin";
     
     // Colors for profiler bars
     constexpr ImVec4 CPU_COLOR{0.5f, 1.0f, 0.5f, 1.0f};
@@ -33,6 +41,19 @@ namespace
     statistics_utils::sample_data gpu_memory_samples;
     statistics_utils::sample_data render_target_memory_samples;
     statistics_utils::sample_data texture_memory_samples;
+
+    auto get_broadphase_name(settings::physics_settings::broadphase_type type) -> const char*
+    {
+        switch(type)
+        {
+            case settings::physics_settings::broadphase_type::sweep_and_prune:
+                return "Sweep And Prune";
+            case settings::physics_settings::broadphase_type::uniform_grid:
+                return "Uniform Grid";
+            default:
+                return "Dynamic AABB Tree";
+        }
+    }
 }
 
 auto statistics_panel::init(rtti::context& ctx) -> void
@@ -60,7 +81,7 @@ auto statistics_panel::on_frame_ui_render(rtti::context& ctx, const char* name)
     if(ImGui::Begin(name, nullptr, ImGuiWindowFlags_MenuBar))
     {
         draw_menubar(ctx);
-        draw_statistics_content(enable_profiler_);
+        draw_statistics_content(ctx, enable_profiler_);
     }
     ImGui::End();
 }
@@ -74,7 +95,7 @@ auto statistics_panel::draw_menubar(rtti::context& ctx) -> void
     }
 }
 
-auto statistics_panel::draw_statistics_content(bool& enable_profiler) -> void
+auto statistics_panel::draw_statistics_content(rtti::context& ctx, bool& enable_profiler) -> void
 {
     const auto& io = ImGui::GetIO();
     const auto area = ImGui::GetContentRegionAvail();
@@ -88,6 +109,7 @@ auto statistics_panel::draw_statistics_content(bool& enable_profiler) -> void
     draw_profiler_section(enable_profiler);
     draw_memory_info_section(overlay_width);
     draw_resources_section();
+    draw_physics_section(ctx);
 }
 
 auto statistics_panel::draw_frame_statistics(float overlay_width) -> void
@@ -266,6 +288,146 @@ auto statistics_panel::draw_resources_section() -> void
     ImGui::PopFont();
 }
 
+auto statistics_panel::draw_physics_section(rtti::context& ctx) -> void
+{
+    if(!ImGui::CollapsingHeader(ICON_MDI_CUBE_OUTLINE "\tPhysics"))
+    {
+        return;
+    }
+
+    const auto stats = ctx.get_cached<physics_system>().get_island_stats();
+    const auto sleeping_bodies = stats.bodies - stats.active_bodies;
+
+    ImGui::PushFont(ImGui::Font::Mono);
+
+    ImGui::Text("Bodies:  %u (Awake: %u, Sleeping: %u)", stats.bodies, stats.active_bodies, sleeping_bodies);
+    ImGui::Text("Islands: %u (Awake: %u)", stats.islands, stats.active_islands);
+    ImGui::Text("Streamed Out: %u bodies", stats.streamed_out);
+    ImGui::Text("Largest Island: %u bodies", stats.largest_island);
+    ImGui::Text("Average Island: %.1f bodies",
+                stats.islands > 0 ? static_cast<float>(stats.bodies) / static_cast<float>(stats.islands) : 0.0f);
+
+    ImGui::PopFont();
+
+    ImGui::Separator();
+    draw_physics_replay(ctx);
+
+    ImGui::Separator();
+    if(ImGui::Button("Benchmark Broadphases"))
+    {
+        const auto physics_settings = ctx.has<settings>() ? ctx.get<settings>().physics : settings::physics_settings{};
+        broadphase_benchmark_ = physics_system::benchmark_broadphases(physics_settings,
+                                                                      BROADPHASE_BENCHMARK_BODIES,
+                                                                      BROADPHASE_BENCHMARK_STEPS);
+    }
+    ImGui::SetItemTooltipEx("Simulates %u bodies on a flat scene with every broadphase, blocks the editor until done.",
+                            BROADPHASE_BENCHMARK_BODIES);
+
+    if(broadphase_benchmark_.empty())
+    {
+        return;
+    }
+
+    ImGui::PushFont(ImGui::Font::Mono);
+
+    for(const auto& result : broadphase_benchmark_)
+    {
+        ImGui::Text("%-18s Pairs: %-7u Update: %7.3fms  Step: %7.3fms  Create: %8.1fms",
+                    get_broadphase_name(result.broadphase),
+                    result.pairs,
+                    result.pair_update,
+                    result.step,
+                    result.create);
+    }
+
+    ImGui::PopFont();
+}
+
+auto statistics_panel::draw_physics_replay(rtti::context& ctx) -> void
+{
+    const bool is_playing = ctx.get_cached<events>().is_playing;
+    const auto path = fs::resolve_protocol(PHYSICS_RECORDING_PATH).string();
+
+    // Play ending stops the recording as well, keep what was recorded.
+    if(is_recording_physics_ && (!is_playing || ImGui::Button("Stop Recording")))
+    {
+        physics_system::stop_recording();
+        save_to_file_bin(path, physics_recording_);
+        is_recording_physics_ = false;
+    }
+    else if(!is_recording_physics_)
+    {
+        ImGui::BeginDisabled(!is_playing);
+        if(ImGui::Button("Record"))
+        {
+            physics_system::start_recording(physics_recording_);
+            is_recording_physics_ = true;
+        }
+        ImGui::EndDisabled();
+        ImGui::SetItemTooltipEx("Records the simulation inputs of the playing scene to %s.", PHYSICS_RECORDING_PATH);
+
+        ImGui::SameLine();
+        ImGui::BeginDisabled(is_playing);
+        if(ImGui::Button("Replay"))
+        {
+            physics_recording recording;
+            load_from_file_bin(path, recording);
+
+            // The replay moves bodies, keep the edited scene untouched.
+            scene replay_scene("physics_replay");
+            scene::clone_scene(ctx.get_cached<ecs>().get_scene(), replay_scene);
+            physics_replay_report_ = physics_system::replay(replay_scene, recording);
+            has_physics_replay_report_ = true;
+        }
+        ImGui::EndDisabled();
+        ImGui::SetItemTooltipEx("Replays %s on a copy of the scene and compares the state after every step.",
+                                PHYSICS_RECORDING_PATH);
+    }
+
+    if(is_recording_physics_)
+    {
+        ImGui::SameLine();
+        ImGui::Text("Recording: %zu steps, %zu events", physics_recording_.hashes.size(), physics_recording_.events.size());
+    }
+
+    if(!has_physics_replay_report_)
+    {
+        return;
+    }
+
+    const auto& report = physics_replay_report_;
+    physics_step_timing average{};
+    for(const auto& step : report.steps)
+    {
+        average.broadphase += step.broadphase;
+        average.narrowphase += step.narrowphase;
+        average.solver += step.solver;
+        average.sync += step.sync;
+        average.total += step.total;
+    }
+    const float step_count = float(std::max<size_t>(report.steps.size(), 1));
+
+    ImGui::PushFont(ImGui::Font::Mono);
+    if(report.matches())
+    {
+        ImGui::Text("Replay: %zu steps, matches the recording", report.steps.size());
+    }
+    else
+    {
+        ImGui::Text("Replay: %zu steps, first mismatch at step %lld, %u unresolved events",
+                    report.steps.size(),
+                    static_cast<long long>(report.first_mismatch),
+                    report.unresolved_events);
+    }
+    ImGui::Text("Average: Broadphase %.3fms  Narrowphase %.3fms  Solver %.3fms  Sync %.3fms  Step %.3fms",
+                average.broadphase / step_count,
+                average.narrowphase / step_count,
+                average.solver / step_count,
+                average.sync / step_count,
+                average.total / step_count);
+    ImGui::PopFont();
+}
+
 // Private helper methods
 
 auto statistics_panel::update_sample_data() -> void
@@ -3,6 +3,9 @@
 
 #include <base/basetypes.hpp>
 #include <context/context.hpp>
+#include <engine/physics/physics_replay.h>
+
+#include <vector>
 
 // Forward declarations
 namespace bgfx { struct Stats; }
@@ -98,9 +101,10 @@ private:
     /// <summary>
     /// Draw the main statistics display.
     /// </summary>
+    /// <param name="ctx">The application context</param>
     /// <param name="enable_profiler">Reference to profiler enable flag</param>
     //-----------------------------------------------------------------------------
-    auto draw_statistics_content(bool& enable_profiler) -> void;
+    auto draw_statistics_content(rtti::context& ctx, bool& enable_profiler) -> void;
 
     //-----------------------------------------------------------------------------
     /// <summary>
@@ -133,6 +137,22 @@ private:
     //-----------------------------------------------------------------------------
     auto draw_resources_section() -> void;
 
+    //-----------------------------------------------------------------------------
+    /// <summary>
+    /// Draw the physics bodies, simulation islands and broadphase benchmark section.
+    /// </summary>
+    /// <param name="ctx">The application context</param>
+    //-----------------------------------------------------------------------------
+    auto draw_physics_section(rtti::context& ctx) -> void;
+
+    //-----------------------------------------------------------------------------
+    /// <summary>
+    /// Draw the controls recording the playing simulation and replaying the saved recording.
+    /// </summary>
+    /// <param name="ctx">The application context</param>
+    //-----------------------------------------------------------------------------
+    auto draw_physics_replay(rtti::context& ctx) -> void;
+
     // Helper methods for updating and drawing specific components
     auto update_sample_data() -> void;
     auto draw_primitive_counts(const bgfx::Stats* stats, const ImGuiIO& io) -> void;
@@ -147,6 +167,11 @@ private:
 
     bool is_visible_{false};
     bool enable_profiler_{false};
+    std::vector<physics_broadphase_benchmark> broadphase_benchmark_;
+    physics_recording physics_recording_;
+    physics_replay_report physics_replay_report_;
+    bool is_recording_physics_{false};
+    bool has_physics_replay_report_{false};
 };
 
 } // namespace unravel
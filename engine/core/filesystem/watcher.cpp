@@ -1,7 +1,18 @@
 #include "watcher.h"
+#include <algorithm>
+#include <limits>
+#include <set>
 #include <sstream>
 #include <utility>
 #include <base/platform/thread.hpp>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
 namespace fs
 {
 using namespace std::literals;
@@ -13,8 +24,322 @@ void log_path(const fs::path& /*unused*/)
 {
 }
 
+auto has_path_prefix(const std::string& str, const std::string& prefix) -> bool
+{
+    if(str.size() < prefix.size() || str.compare(0, prefix.size(), prefix) != 0)
+    {
+        return false;
+    }
+
+    return str.size() == prefix.size() || str[prefix.size()] == '/' || str[prefix.size()] == '\\';
+}
+
+/// Events are collected until nothing new arrives for this long.
+constexpr watcher::clock_t::duration coalesce_quiet_time = 10ms;
+/// Upper bound for collecting a burst of events before notifying.
+constexpr watcher::clock_t::duration coalesce_max_time = 100ms;
+
+struct native_event
+{
+    enum kind_t
+    {
+        created,
+        modified,
+        removed,
+        moved_from,
+        moved_to,
+        overflow,
+    };
+
+    kind_t kind = modified;
+    fs::path path;
+    std::uint32_t cookie = 0;
+    bool is_dir = false;
+};
+
 } // namespace
 
+#if defined(__linux__)
+
+class watcher::native_backend
+{
+public:
+    native_backend()
+    {
+        inotify_fd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    }
+
+    ~native_backend()
+    {
+        if(inotify_fd_ >= 0)
+        {
+            ::close(inotify_fd_);
+        }
+
+        if(wake_fd_ >= 0)
+        {
+            ::close(wake_fd_);
+        }
+    }
+
+    auto is_valid() const -> bool
+    {
+        return inotify_fd_ >= 0 && wake_fd_ >= 0;
+    }
+
+    //-----------------------------------------------------------------------------
+    //  Name : add_directory ()
+    /// <summary>
+    /// Starts watching a single directory. Directories are reference counted so
+    /// overlapping watchers share one inotify watch. Fails when the kernel watch
+    /// limit is reached.
+    /// </summary>
+    //-----------------------------------------------------------------------------
+    auto add_directory(const fs::path& dir) -> bool
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto key = dir.string();
+        auto it = dirs_.find(key);
+        if(it != dirs_.end())
+        {
+            it->second.refs++;
+            return true;
+        }
+
+        constexpr std::uint32_t mask = IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB |
+                                       IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR | IN_EXCL_UNLINK;
+
+        int wd = ::inotify_add_watch(inotify_fd_, key.c_str(), mask);
+        if(wd < 0)
+        {
+            return false;
+        }
+
+        dirs_[key] = {wd, 1};
+        paths_[wd] = key;
+        return true;
+    }
+
+    void remove_directory(const fs::path& dir)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = dirs_.find(dir.string());
+        if(it == dirs_.end())
+        {
+            return;
+        }
+
+        if(--it->second.refs == 0)
+        {
+            ::inotify_rm_watch(inotify_fd_, it->second.wd);
+            paths_.erase(it->second.wd);
+            dirs_.erase(it);
+        }
+    }
+
+    void wake()
+    {
+        std::uint64_t one = 1;
+        [[maybe_unused]] auto res = ::write(wake_fd_, &one, sizeof(one));
+    }
+
+    //-----------------------------------------------------------------------------
+    //  Name : wait ()
+    /// <summary>
+    /// Blocks until events arrive, the backend is woken up or the timeout expires.
+    /// Returns true if new events were appended.
+    /// </summary>
+    //-----------------------------------------------------------------------------
+    auto wait(clock_t::duration timeout, std::vector<native_event>& events) -> bool
+    {
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(timeout).count();
+        ms = std::clamp<decltype(ms)>(ms, 0, std::numeric_limits<int>::max());
+
+        pollfd fds[2] = {{inotify_fd_, POLLIN, 0}, {wake_fd_, POLLIN, 0}};
+        int res = ::poll(fds, 2, static_cast<int>(ms));
+        if(res <= 0)
+        {
+            return false;
+        }
+
+        if(fds[1].revents & POLLIN)
+        {
+            std::uint64_t value = 0;
+            [[maybe_unused]] auto read_res = ::read(wake_fd_, &value, sizeof(value));
+        }
+
+        if(!(fds[0].revents & POLLIN))
+        {
+            return false;
+        }
+
+        return read_events(events);
+    }
+
+private:
+    auto read_events(std::vector<native_event>& events) -> bool
+    {
+        alignas(inotify_event) char buffer[64 * 1024];
+        bool any = false;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::map<std::uint32_t, std::string> moved_dirs;
+
+        while(true)
+        {
+            auto len = ::read(inotify_fd_, buffer, sizeof(buffer));
+            if(len <= 0)
+            {
+                break;
+            }
+
+            for(char* ptr = buffer; ptr < buffer + len;)
+            {
+                const auto* ev = reinterpret_cast<const inotify_event*>(ptr);
+                ptr += sizeof(inotify_event) + ev->len;
+                any = true;
+
+                if(ev->mask & IN_Q_OVERFLOW)
+                {
+                    native_event e;
+                    e.kind = native_event::overflow;
+                    events.emplace_back(std::move(e));
+                    continue;
+                }
+
+                if(ev->mask & IN_IGNORED)
+                {
+                    auto it = paths_.find(ev->wd);
+                    if(it != paths_.end())
+                    {
+                        dirs_.erase(it->second);
+                        paths_.erase(it);
+                    }
+                    continue;
+                }
+
+                auto it = paths_.find(ev->wd);
+                if(it == paths_.end() || ev->len == 0)
+                {
+                    continue;
+                }
+
+                native_event e;
+                e.path = fs::path(it->second) / ev->name;
+                e.cookie = ev->cookie;
+                e.is_dir = (ev->mask & IN_ISDIR) != 0;
+
+                if(ev->mask & IN_MOVED_FROM)
+                {
+                    e.kind = native_event::moved_from;
+                    if(e.is_dir)
+                    {
+                        moved_dirs[e.cookie] = e.path.string();
+                    }
+                }
+                else if(ev->mask & IN_MOVED_TO)
+                {
+                    e.kind = native_event::moved_to;
+
+                    // Watches follow the inode, keep our paths in sync right away so later
+                    // events from inside the moved directory resolve to the new location.
+                    auto moved = moved_dirs.find(e.cookie);
+                    if(e.is_dir && moved != moved_dirs.end())
+                    {
+                        rename_prefix(moved->second, e.path.string());
+                    }
+                }
+                else if(ev->mask & IN_CREATE)
+                {
+                    e.kind = native_event::created;
+                }
+                else if(ev->mask & IN_DELETE)
+                {
+                    e.kind = native_event::removed;
+                }
+                else
+                {
+                    e.kind = native_event::modified;
+                }
+
+                events.emplace_back(std::move(e));
+            }
+        }
+
+        return any;
+    }
+
+    void rename_prefix(const std::string& old_prefix, const std::string& new_prefix)
+    {
+        std::vector<std::pair<std::string, watched_dir>> moved;
+        for(auto it = dirs_.begin(); it != dirs_.end();)
+        {
+            if(has_path_prefix(it->first, old_prefix))
+            {
+                moved.emplace_back(new_prefix + it->first.substr(old_prefix.size()), it->second);
+                it = dirs_.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        for(auto& kvp : moved)
+        {
+            paths_[kvp.second.wd] = kvp.first;
+            dirs_[kvp.first] = kvp.second;
+        }
+    }
+
+    struct watched_dir
+    {
+        int wd = -1;
+        std::uint32_t refs = 0;
+    };
+
+    int inotify_fd_ = -1;
+    int wake_fd_ = -1;
+
+    std::mutex mutex_;
+    std::map<std::string, watched_dir> dirs_;
+    std::map<int, std::string> paths_;
+};
+
+#else
+
+class watcher::native_backend
+{
+public:
+    auto is_valid() const -> bool
+    {
+        return false;
+    }
+
+    auto add_directory(const fs::path& /*dir*/) -> bool
+    {
+        return false;
+    }
+
+    void remove_directory(const fs::path& /*dir*/)
+    {
+    }
+
+    void wake()
+    {
+    }
+
+    auto wait(clock_t::duration /*timeout*/, std::vector<native_event>& /*events*/) -> bool
+    {
+        return false;
+    }
+};
+
+#endif
+
 class watcher::impl
 {
 public:
@@ -83,32 +408,30 @@ public:
          bool recursive,
          bool initial_list,
          clock_t::duration poll_interval,
-         notify_callback list_callback)
+         notify_callback list_callback,
+         native_backend* native)
         : filter_(filter)
         , callback_(std::move(list_callback))
         , poll_interval_(poll_interval)
         , recursive_(recursive)
     {
         root_ = path;
-        observed_changes changes;
-        if(recursive_)
+
+        if(native && native->is_valid())
         {
-            fs::error_code err;
-            for(auto& entry : fs::recursive_directory_iterator(root_, err))
-            {
-                if(filter_.should_include(entry.path()))
-                    poll_entry(entry.path(), changes);
-            }
+            native_ = native;
+            add_native_watch(root_);
         }
-        else
+
+        observed_changes changes;
+        scan(root_, changes);
+
+        // Not enough watches available, poll this one instead.
+        if(native_failed_)
         {
-            fs::error_code err;
-            for(auto& entry : fs::directory_iterator(root_, err))
-            {
-                if(filter_.should_include(entry.path()))
-                    poll_entry(entry.path(), changes);
-            }
+            release_native_watches();
         }
+
         if(initial_list)
         {
             if(!changes.entries.empty() && callback_)
@@ -118,6 +441,11 @@ public:
         }
     }
 
+    ~impl()
+    {
+        release_native_watches();
+    }
+
     void pause()
     {
         paused_ = true;
@@ -128,12 +456,16 @@ public:
         paused_ = false;
     }
 
+    auto is_event_driven() const -> bool
+    {
+        return native_ != nullptr;
+    }
+
     //-----------------------------------------------------------------------------
     //  Name : watch ()
     /// <summary>
-    ///
-    ///
-    ///
+    /// Polls the whole watched tree. Used by polling watchers and by event driven
+    /// ones when the event queue overflowed.
     /// </summary>
     //-----------------------------------------------------------------------------
     void watch()
@@ -147,39 +479,125 @@ public:
                 std::swap(changes, buffered_changes_);
             }
         }
-        if(recursive_)
+
+        scan(root_, changes);
+
+        if(paused)
         {
-            fs::error_code err;
-            for(auto& entry : fs::recursive_directory_iterator(root_, err))
+            if(!changes.entries.empty())
             {
-                if(filter_.should_include(entry.path()))
-                    poll_entry(entry.path(), changes);
+                buffered_changes_.append(std::move(changes));
             }
         }
         else
         {
-            fs::error_code err;
-            for(auto& entry : fs::directory_iterator(root_, err))
+            process_modifications(entries_, changes);
+            if(!changes.entries.empty() && callback_)
             {
-                if(filter_.should_include(entry.path()))
-                    poll_entry(entry.path(), changes);
+                callback_(changes.entries, false);
             }
         }
-        if(paused)
+    }
+
+    //-----------------------------------------------------------------------------
+    //  Name : on_events ()
+    /// <summary>
+    /// Applies a coalesced batch of native events. Only the paths named by the
+    /// events are inspected, renames are paired by the kernel so no heuristics
+    /// are needed.
+    /// </summary>
+    //-----------------------------------------------------------------------------
+    void on_events(const std::vector<native_event>& events)
+    {
+        for(const auto& e : events)
         {
-            if(!changes.entries.empty())
+            if(e.kind == native_event::overflow)
             {
-                buffered_changes_.append(std::move(changes));
+                watch();
+                return;
             }
         }
-        else
+
+        observed_changes changes;
+        std::map<std::uint32_t, fs::path> moved_from;
+
+        for(const auto& e : events)
         {
-            process_modifications(entries_, changes);
-            if(!changes.entries.empty() && callback_)
+            if(!is_watched_path(e.path))
             {
-                callback_(changes.entries, false);
+                continue;
+            }
+
+            switch(e.kind)
+            {
+                case native_event::moved_from:
+                {
+                    moved_from[e.cookie] = e.path;
+                    break;
+                }
+                case native_event::moved_to:
+                {
+                    auto it = moved_from.find(e.cookie);
+                    if(it != moved_from.end())
+                    {
+                        on_renamed(it->second, e.path, e.is_dir, changes);
+                        moved_from.erase(it);
+                    }
+                    else
+                    {
+                        on_created(e.path, e.is_dir, changes);
+                    }
+                    break;
+                }
+                case native_event::created:
+                {
+                    on_created(e.path, e.is_dir, changes);
+                    break;
+                }
+                case native_event::removed:
+                {
+                    on_removed(e.path, changes);
+                    break;
+                }
+                default:
+                {
+                    if(filter_.should_include(e.path))
+                    {
+                        poll_entry(e.path, changes);
+                    }
+                    break;
+                }
             }
         }
+
+        // Moved somewhere we don't watch.
+        for(const auto& kvp : moved_from)
+        {
+            on_removed(kvp.second, changes);
+        }
+
+        deliver(std::move(changes));
+    }
+
+    //-----------------------------------------------------------------------------
+    //  Name : flush ()
+    /// <summary>
+    /// Delivers changes buffered while paused.
+    /// </summary>
+    //-----------------------------------------------------------------------------
+    void flush()
+    {
+        if(paused_ || buffered_changes_.entries.empty())
+        {
+            return;
+        }
+
+        observed_changes changes;
+        std::swap(changes, buffered_changes_);
+        if(callback_)
+        {
+            callback_(changes.entries, false);
+        }
     }
 
     static auto get_original_path(const fs::path& old_path, const fs::path& renamed_path, const fs::path& new_path) -> fs::path
@@ -382,6 +800,198 @@ public:
         }
     }
 
+private:
+    void scan(const fs::path& dir, observed_changes& changes)
+    {
+        fs::error_code err;
+        if(recursive_)
+        {
+            for(auto& entry : fs::recursive_directory_iterator(dir, err))
+            {
+                if(native_ && entry.is_directory(err))
+                {
+                    add_native_watch(entry.path());
+                }
+
+                if(filter_.should_include(entry.path()))
+                    poll_entry(entry.path(), changes);
+            }
+        }
+        else
+        {
+            for(auto& entry : fs::directory_iterator(dir, err))
+            {
+                if(filter_.should_include(entry.path()))
+                    poll_entry(entry.path(), changes);
+            }
+        }
+    }
+
+    void add_native_watch(const fs::path& dir)
+    {
+        if(!native_ || native_failed_ || native_dirs_.contains(dir))
+        {
+            return;
+        }
+
+        if(native_->add_directory(dir))
+        {
+            native_dirs_.emplace(dir);
+        }
+        else
+        {
+            native_failed_ = true;
+        }
+    }
+
+    void release_native_watches(const fs::path& prefix = {})
+    {
+        if(!native_)
+        {
+            return;
+        }
+
+        const auto prefix_str = prefix.string();
+        for(auto it = native_dirs_.begin(); it != native_dirs_.end();)
+        {
+            if(prefix.empty() || has_path_prefix(it->string(), prefix_str))
+            {
+                native_->remove_directory(*it);
+                it = native_dirs_.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        if(prefix.empty())
+        {
+            native_ = nullptr;
+        }
+    }
+
+    auto is_watched_path(const fs::path& path) const -> bool
+    {
+        if(recursive_)
+        {
+            return path != root_ && has_path_prefix(path.string(), root_.string());
+        }
+
+        return path.parent_path() == root_;
+    }
+
+    void on_created(const fs::path& path, bool is_dir, observed_changes& changes)
+    {
+        if(is_dir && recursive_)
+        {
+            add_native_watch(path);
+        }
+
+        if(filter_.should_include(path))
+        {
+            poll_entry(path, changes);
+        }
+
+        // Pick up anything created before the watch was in place.
+        if(is_dir && recursive_)
+        {
+            scan(path, changes);
+        }
+    }
+
+    void on_removed(const fs::path& path, observed_changes& changes)
+    {
+        const auto key = path.string();
+        for(auto it = entries_.lower_bound(key); it != entries_.end() && has_path_prefix(it->first, key);)
+        {
+            it->second.status = watcher::entry_status::removed;
+            changes.entries.push_back(it->second);
+            it = entries_.erase(it);
+        }
+
+        release_native_watches(path);
+    }
+
+    void on_renamed(const fs::path& old_path, const fs::path& new_path, bool is_dir, observed_changes& changes)
+    {
+        const auto old_key = old_path.string();
+        const auto new_key = new_path.string();
+
+        std::vector<watcher::entry> moved;
+        for(auto it = entries_.lower_bound(old_key); it != entries_.end() && has_path_prefix(it->first, old_key);)
+        {
+            moved.emplace_back(std::move(it->second));
+            it = entries_.erase(it);
+        }
+
+        for(auto& e : moved)
+        {
+            auto path = fs::path(new_key + e.path.string().substr(old_key.size()));
+
+            if(!filter_.should_include(path))
+            {
+                e.status = watcher::entry_status::removed;
+                changes.entries.push_back(e);
+                continue;
+            }
+
+            e.last_path = e.path;
+            e.path = path;
+            e.status = watcher::entry_status::renamed;
+            changes.entries.push_back(e);
+
+            entries_[path.string()] = e;
+        }
+
+        if(is_dir)
+        {
+            std::vector<fs::path> renamed_dirs;
+            for(auto it = native_dirs_.begin(); it != native_dirs_.end();)
+            {
+                if(has_path_prefix(it->string(), old_key))
+                {
+                    renamed_dirs.emplace_back(new_key + it->string().substr(old_key.size()));
+                    it = native_dirs_.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+            native_dirs_.insert(renamed_dirs.begin(), renamed_dirs.end());
+        }
+
+        // Renamed into something the filter accepts, e.g. a temp file replacing the original.
+        if(moved.empty() && filter_.should_include(new_path))
+        {
+            poll_entry(new_path, changes);
+        }
+    }
+
+    void deliver(observed_changes&& changes)
+    {
+        if(changes.entries.empty())
+        {
+            return;
+        }
+
+        if(paused_)
+        {
+            buffered_changes_.append(std::move(changes));
+            return;
+        }
+
+        observed_changes all;
+        std::swap(all, buffered_changes_);
+        all.append(std::move(changes));
+
+        if(callback_)
+        {
+            callback_(all.entries, false);
+        }
+    }
+
 protected:
     friend class watcher;
 
@@ -404,6 +1014,12 @@ protected:
     std::atomic<bool> paused_ = {false};
 
     observed_changes buffered_changes_;
+    /// Event backend, null when polling
+    native_backend* native_ = nullptr;
+    /// Directories registered with the event backend
+    std::set<fs::path> native_dirs_;
+    /// Set when the backend ran out of watches
+    bool native_failed_ = false;
 };
 
 static auto get_watcher() -> watcher&
@@ -467,11 +1083,23 @@ void watcher::touch(const fs::path& path, bool recursive, fs::file_time_type tim
     log_path(path);
 }
 
+watcher::watcher() = default;
+
 watcher::~watcher()
 {
     close();
 }
 
+void watcher::notify()
+{
+    cv_.notify_all();
+
+    if(native_)
+    {
+        native_->wake();
+    }
+}
+
 void watcher::pause()
 {
     auto& wd = get_watcher();
@@ -500,6 +1128,9 @@ void watcher::resume()
             w->resume();
         }
     }
+
+    // Event driven watchers flush what they buffered on the watcher thread.
+    wd.notify();
 }
 
 
@@ -518,6 +1149,11 @@ void watcher::close()
 
 void watcher::start()
 {
+    if(!native_)
+    {
+        native_ = std::make_unique<native_backend>();
+    }
+
     watching_ = true;
     thread_ = std::thread(
         [this]()
@@ -540,6 +1176,12 @@ void watcher::start()
                 {
                     auto watcher = pair.second;
 
+                    if(watcher->is_event_driven())
+                    {
+                        watcher->flush();
+                        continue;
+                    }
+
                     auto now = clock_t::now();
 
                     auto diff = (watcher->last_poll_ + watcher->poll_interval_) - now;
@@ -555,9 +1197,41 @@ void watcher::start()
                         sleep_time = std::min(sleep_time, diff);
                     }
                 }
+                watchers.clear();
 
-                std::unique_lock<std::mutex> lock(mutex_);
-                cv_.wait_for(lock, sleep_time);
+                if(native_->is_valid())
+                {
+                    std::vector<native_event> events;
+                    if(!native_->wait(sleep_time, events))
+                    {
+                        continue;
+                    }
+
+                    // Coalesce bursts (an editor save, a compiler writing several outputs)
+                    // into a single notification per watcher.
+                    auto deadline = clock_t::now() + coalesce_max_time;
+                    while(clock_t::now() < deadline && native_->wait(coalesce_quiet_time, events))
+                    {
+                    }
+
+                    {
+                        std::unique_lock<std::mutex> lock(mutex_);
+                        watchers = watchers_;
+                    }
+
+                    for(auto& pair : watchers)
+                    {
+                        if(pair.second->is_event_driven())
+                        {
+                            pair.second->on_events(events);
+                        }
+                    }
+                }
+                else
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    cv_.wait_for(lock, sleep_time);
+                }
             }
         });
 }
@@ -582,11 +1256,17 @@ auto watcher::watch_impl(const fs::path& path,
         static std::atomic<std::uint64_t> free_id = {1};
         auto key = free_id++;
         {
-            auto imp = std::make_shared<impl>(path, filter, recursive, initial_list, poll_interval, std::move(list_callback));
+            auto imp = std::make_shared<impl>(path,
+                                              filter,
+                                              recursive,
+                                              initial_list,
+                                              poll_interval,
+                                              std::move(list_callback),
+                                              wd.native_.get());
             std::lock_guard<std::mutex> lock(wd.mutex_);
             wd.watchers_.emplace(key, std::move(imp));
         }
-        wd.cv_.notify_all();
+        wd.notify();
         return key;
     }
 
@@ -601,7 +1281,7 @@ void watcher::unwatch_impl(std::uint64_t key)
         std::lock_guard<std::mutex> lock(wd.mutex_);
         wd.watchers_.erase(key);
     }
-    wd.cv_.notify_all();
+    wd.notify();
 }
 
 void watcher::unwatch_all_impl()
@@ -611,7 +1291,7 @@ void watcher::unwatch_all_impl()
         std::lock_guard<std::mutex> lock(wd.mutex_);
         wd.watchers_.clear();
     }
-    wd.cv_.notify_all();
+    wd.notify();
 }
 
 auto to_string(const watcher::entry& e) -> std::string
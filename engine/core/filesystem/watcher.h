@@ -99,7 +99,7 @@ public:
     /// </summary>
     //-----------------------------------------------------------------------------
     ~watcher();
-    watcher() = default;
+    watcher();
 
     static void pause();
     static void resume();
@@ -144,6 +144,14 @@ protected:
 
     static void unwatch_all_impl();
 
+    //-----------------------------------------------------------------------------
+    //  Name : notify ()
+    /// <summary>
+    /// Wakes up the watcher thread.
+    /// </summary>
+    //-----------------------------------------------------------------------------
+    void notify();
+
     /// Mutex for the file watchers
     std::mutex mutex_;
     /// Atomic bool sync
@@ -152,6 +160,9 @@ protected:
     std::condition_variable cv_;
     /// Thread that polls for changes
     std::thread thread_;
+    /// Event driven backend (inotify on linux). Watchers fall back to polling without it.
+    class native_backend;
+    std::unique_ptr<native_backend> native_;
     /// Registered file watchers
     class impl;
     std::map<std::uint64_t, std::shared_ptr<impl>> watchers_;
@@ -34,6 +34,15 @@ void mesh_vertex::init(vertex_layout& decl)
         .end();
 }
 
+void mesh_vertex_compressed::init(vertex_layout& decl)
+{
+    decl.begin()
+        .add(attribute::Position, 4, attribute_type::Int16, true)
+        .add(attribute::Normal, 4, attribute_type::Uint8, true)
+        .add(attribute::TexCoord0, 2, attribute_type::Half)
+        .end();
+}
+
 void pos_texcoord0_color0_vertex::init(vertex_layout& decl)
 {
     decl.begin()
@@ -58,6 +58,13 @@ struct mesh_vertex : vertex<mesh_vertex>
     static void init(vertex_layout& decl);
 };
 
+/// Compact mesh vertex. Positions are normalized to the submesh bounds with the bitangent sign in w,
+/// the normal and tangent are octahedral encoded into the normal attribute and uvs are half floats.
+struct mesh_vertex_compressed : vertex<mesh_vertex_compressed>
+{
+    static void init(vertex_layout& decl);
+};
+
 struct pos_texcoord0_color0_vertex : vertex<pos_texcoord0_color0_vertex>
 {
     static void init(vertex_layout& decl);
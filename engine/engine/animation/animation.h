@@ -4,6 +4,7 @@
 #include <math/math.h>
 
 #include <chrono>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -41,17 +42,17 @@ struct animation_channel
 
     auto get_position_keys_count() const -> size_t
     {
-        return position_keys.size();
+        return position_keys.empty() ? compressed_position_keys_count : position_keys.size();
     }
 
     auto get_rotation_keys_count() const -> size_t
     {
-        return rotation_keys.size();
+        return rotation_keys.empty() ? compressed_rotation_keys_count : rotation_keys.size();
     }
 
     auto get_scaling_keys_count() const -> size_t
     {
-        return scaling_keys.size();
+        return scaling_keys.empty() ? compressed_scaling_keys_count : scaling_keys.size();
     }
 
     /// The name of the node affected by this animation. The node must exist and it must be unique.
@@ -67,6 +68,12 @@ struct animation_channel
 
     /// The scaling keys of this animation channel. Scalings are specified as 3D vector.
     std::vector<key<math::vec3>> scaling_keys;
+
+    /// Number of keys kept for each track when the clip is compressed and the raw keys are released.
+    /// Not serialized, read back from the compressed tracks (see update_compressed_key_counts).
+    size_t compressed_position_keys_count{};
+    size_t compressed_rotation_keys_count{};
+    size_t compressed_scaling_keys_count{};
 };
 
 
@@ -99,6 +106,12 @@ struct animation_clip
 {
     using seconds_t = animation_channel::seconds_t;
 
+    /// Whether the keys of the channels are stored in compressed_tracks.
+    auto is_compressed() const -> bool
+    {
+        return !compressed_tracks.empty();
+    }
+
     /// The name of the animation_clip. Usually empty if the modeling package supports only a single animation_clip channel.
     std::string name;
 
@@ -109,6 +122,9 @@ struct animation_clip
     std::vector<animation_channel> channels;
 
     root_motion_params root_motion;
+
+    /// Keys of all channels packed by compress_animation. Empty if the channels hold their raw keys.
+    std::vector<uint8_t> compressed_tracks;
 };
 
 } // namespace unravel
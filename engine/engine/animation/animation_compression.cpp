@@ -0,0 +1,634 @@
+#include "animation_compression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace unravel
+{
+
+namespace
+{
+
+/// Describes one track in the header table at the start of the compressed blob.
+/// The table holds three tracks per channel: position, rotation and scaling.
+struct track_header
+{
+    /// Number of keys in the track.
+    uint32_t key_count : 31 {};
+    /// Set when the key times are float seconds instead of 16 bit fractions of the clip duration,
+    /// for keys too close together for 16 bits to resolve. Shares its word with key_count so
+    /// clips compressed before it existed keep their layout.
+    uint32_t float_times : 1 {};
+    /// Byte offset of the key times from the start of the blob. The values follow the times.
+    uint32_t offset{};
+    /// Smallest value of the track, unused for rotations.
+    float range_min[3]{};
+    /// Size of one quantization step of the track, unused for rotations.
+    float range_step[3]{};
+};
+
+constexpr uint32_t tracks_per_channel = 3;
+constexpr float max_quantized = 65535.0f;
+constexpr float max_quantized_rotation = 32767.0f;
+/// 16 bit key times are only used when the shortest interval between keys spans at least
+/// this many steps, so rounding moves a key by a small part of its interval at most.
+constexpr float min_time_steps_per_key = 16.0f;
+
+auto get_time_size(const track_header& header) -> size_t
+{
+    return header.float_times ? sizeof(float) : sizeof(uint16_t);
+}
+
+auto quantize_unorm16(float value) -> uint16_t
+{
+    return static_cast<uint16_t>(std::lround(math::clamp(value, 0.0f, max_quantized)));
+}
+
+auto quantize_time(animation_clip::seconds_t time, animation_clip::seconds_t duration) -> uint16_t
+{
+    if(duration.count() <= 0.0f)
+    {
+        return 0;
+    }
+
+    return quantize_unorm16(time.count() / duration.count() * max_quantized);
+}
+
+void encode_vec3(const math::vec3& value, const track_header& header, uint16_t* output)
+{
+    for(int i = 0; i < 3; ++i)
+    {
+        output[i] = header.range_step[i] > 0.0f
+                        ? quantize_unorm16((value[i] - header.range_min[i]) / header.range_step[i])
+                        : uint16_t(0);
+    }
+}
+
+auto decode_vec3(const uint16_t* input, const track_header& header) -> math::vec3
+{
+    return {header.range_min[0] + float(input[0]) * header.range_step[0],
+            header.range_min[1] + float(input[1]) * header.range_step[1],
+            header.range_min[2] + float(input[2]) * header.range_step[2]};
+}
+
+/// Smallest three encoding. The largest component is dropped and rebuilt from the unit length,
+/// the other three are stored in 15 bits each and the index of the dropped one in the two
+/// remaining high bits.
+void encode_quat(const math::quat& value, uint16_t* output)
+{
+    auto q = math::normalize(value);
+    float components[4] = {q.x, q.y, q.z, q.w};
+
+    int largest = 0;
+    for(int i = 1; i < 4; ++i)
+    {
+        if(math::abs(components[i]) > math::abs(components[largest]))
+        {
+            largest = i;
+        }
+    }
+
+    // q and -q are the same rotation, keep the dropped component positive.
+    const float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+    const float scale = math::sqrt(2.0f) * 0.5f;
+
+    int out = 0;
+    for(int i = 0; i < 4; ++i)
+    {
+        if(i == largest)
+        {
+            continue;
+        }
+
+        float normalized = components[i] * sign * scale + 0.5f;
+        output[out++] =
+            static_cast<uint16_t>(std::lround(math::clamp(normalized, 0.0f, 1.0f) * max_quantized_rotation));
+    }
+
+    output[0] |= uint16_t((largest & 1) << 15);
+    output[1] |= uint16_t((largest >> 1) << 15);
+}
+
+auto decode_quat(const uint16_t* input) -> math::quat
+{
+    const int largest = (input[0] >> 15) | ((input[1] >> 15) << 1);
+    const float scale = math::sqrt(2.0f);
+
+    float components[4];
+    float sum = 0.0f;
+    int in = 0;
+    for(int i = 0; i < 4; ++i)
+    {
+        if(i == largest)
+        {
+            continue;
+        }
+
+        float value = (float(input[in++] & 0x7fff) / max_quantized_rotation - 0.5f) * scale;
+        components[i] = value;
+        sum += value * value;
+    }
+    components[largest] = math::sqrt(math::max(0.0f, 1.0f - sum));
+
+    math::quat result;
+    result.x = components[0];
+    result.y = components[1];
+    result.z = components[2];
+    result.w = components[3];
+    return result;
+}
+
+/// Angle between two rotations in degrees. Works on the vector part of the difference so it
+/// stays precise for the very small angles the tolerances are about.
+auto get_rotation_error(const math::quat& lhs, const math::quat& rhs) -> float
+{
+    auto delta = math::conjugate(math::normalize(lhs)) * math::normalize(rhs);
+    float vector_length = math::sqrt(delta.x * delta.x + delta.y * delta.y + delta.z * delta.z);
+    return math::degrees(2.0f * std::atan2(vector_length, math::abs(delta.w)));
+}
+
+/// Finds the keys around a time given in the units of the track (see get_track_time).
+/// Returns false if the time is outside the keys, with 'first' set to the closest key.
+template<typename Time>
+auto find_keys(const Time* times, uint32_t count, float time, uint32_t& first, float& factor) -> bool
+{
+    const auto* upper = std::upper_bound(times,
+                                         times + count,
+                                         time,
+                                         [](float lhs, Time rhs)
+                                         {
+                                             return lhs < float(rhs);
+                                         });
+
+    if(upper == times)
+    {
+        first = 0;
+        return false;
+    }
+
+    if(upper == times + count)
+    {
+        first = count - 1;
+        return false;
+    }
+
+    first = uint32_t(upper - times) - 1;
+    factor = (time - float(times[first])) / (float(times[first + 1]) - float(times[first]));
+    return true;
+}
+
+/// Calls 'f' with the key times and the values of a track.
+template<typename F>
+auto visit_track(const uint8_t* blob, const track_header& header, F&& f)
+{
+    if(header.float_times)
+    {
+        const auto* times = reinterpret_cast<const float*>(blob + header.offset);
+        return f(times, reinterpret_cast<const uint16_t*>(times + header.key_count));
+    }
+
+    const auto* times = reinterpret_cast<const uint16_t*>(blob + header.offset);
+    return f(times, times + header.key_count);
+}
+
+template<typename T>
+auto decode_value(const uint16_t* values, uint32_t index, const track_header& header) -> T
+{
+    if constexpr(std::is_same_v<T, math::quat>)
+    {
+        return decode_quat(values + size_t(index) * 3);
+    }
+    else
+    {
+        return decode_vec3(values + size_t(index) * 3, header);
+    }
+}
+
+template<typename T>
+auto interpolate_value(const T& lhs, const T& rhs, float factor) -> T
+{
+    if constexpr(std::is_same_v<T, math::quat>)
+    {
+        return math::slerp(lhs, rhs, factor);
+    }
+    else
+    {
+        return math::lerp(lhs, rhs, factor);
+    }
+}
+
+template<typename T>
+auto sample_track(const uint8_t* blob, const track_header& header, float time) -> T
+{
+    if(header.key_count == 0)
+    {
+        return {};
+    }
+
+    return visit_track(blob,
+                       header,
+                       [&](const auto* times, const uint16_t* values) -> T
+                       {
+                           uint32_t first = 0;
+                           float factor = 0.0f;
+                           if(!find_keys(times, header.key_count, time, first, factor))
+                           {
+                               return decode_value<T>(values, first, header);
+                           }
+
+                           return interpolate_value(decode_value<T>(values, first, header),
+                                                    decode_value<T>(values, first + 1, header),
+                                                    factor);
+                       });
+}
+
+template<typename T>
+auto get_error(const T& lhs, const T& rhs) -> float
+{
+    if constexpr(std::is_same_v<T, math::quat>)
+    {
+        return get_rotation_error(lhs, rhs);
+    }
+    else
+    {
+        return math::length(lhs - rhs);
+    }
+}
+
+/// Output of compressing one track, before it is placed in the blob.
+struct encoded_track
+{
+    track_header header;
+    /// Key times in the units of the track, 16 bit fractions are written as integers.
+    std::vector<float> times;
+    std::vector<uint16_t> values;
+};
+
+template<typename T>
+auto encode_track(const std::vector<animation_channel::key<T>>& keys,
+                  animation_clip::seconds_t duration,
+                  float tolerance,
+                  float& max_error) -> encoded_track
+{
+    encoded_track result;
+    if(keys.empty())
+    {
+        return result;
+    }
+
+    const size_t count = keys.size();
+
+    if constexpr(!std::is_same_v<T, math::quat>)
+    {
+        math::vec3 range_min = keys.front().value;
+        math::vec3 range_max = keys.front().value;
+        for(const auto& key : keys)
+        {
+            range_min = math::min(range_min, key.value);
+            range_max = math::max(range_max, key.value);
+        }
+
+        auto step = (range_max - range_min) / max_quantized;
+        for(int i = 0; i < 3; ++i)
+        {
+            result.header.range_min[i] = range_min[i];
+            result.header.range_step[i] = step[i];
+        }
+
+        // A track with a large range cannot be stored more precisely than its step.
+        tolerance = math::max(tolerance, math::length(step) * 0.5f);
+    }
+
+    // Long clips with a high sample rate would merge neighbouring keys in 16 bit fractions of
+    // the duration, keep float seconds for those tracks.
+    float min_interval = std::numeric_limits<float>::max();
+    for(size_t i = 1; i < count; ++i)
+    {
+        const float interval = keys[i].time.count() - keys[i - 1].time.count();
+        if(interval > 0.0f)
+        {
+            min_interval = math::min(min_interval, interval);
+        }
+    }
+
+    const float time_step = duration.count() / max_quantized;
+    result.header.float_times = time_step * min_time_steps_per_key > min_interval;
+
+    // Quantize every key first so the reduction accounts for the quantization error.
+    std::vector<float> times(count);
+    std::vector<uint16_t> values(count * 3);
+    std::vector<T> decoded(count);
+    for(size_t i = 0; i < count; ++i)
+    {
+        times[i] = result.header.float_times ? keys[i].time.count() : float(quantize_time(keys[i].time, duration));
+        if constexpr(std::is_same_v<T, math::quat>)
+        {
+            encode_quat(keys[i].value, &values[i * 3]);
+        }
+        else
+        {
+            encode_vec3(keys[i].value, result.header, &values[i * 3]);
+        }
+        decoded[i] = decode_value<T>(values.data(), uint32_t(i), result.header);
+    }
+
+    // Keys that quantize to the same time cannot be interpolated between, keep the first one.
+    std::vector<size_t> candidates;
+    candidates.reserve(count);
+    for(size_t i = 0; i < count; ++i)
+    {
+        if(candidates.empty() || times[candidates.back()] != times[i])
+        {
+            candidates.emplace_back(i);
+        }
+    }
+
+    auto segment_fits = [&](size_t from, size_t to)
+    {
+        const float span = times[to] - times[from];
+        for(size_t i = from + 1; i < to; ++i)
+        {
+            float factor = math::clamp((times[i] - times[from]) / span, 0.0f, 1.0f);
+            if(get_error(interpolate_value(decoded[from], decoded[to], factor), keys[i].value) > tolerance)
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    auto constant_fits = [&]()
+    {
+        return std::all_of(keys.begin(),
+                           keys.end(),
+                           [&](const animation_channel::key<T>& key)
+                           {
+                               return get_error(decoded.front(), key.value) <= tolerance;
+                           });
+    };
+
+    // Greedy reduction, each kept key is followed by the furthest one that still
+    // interpolates every key in between within the tolerance.
+    std::vector<size_t> kept{candidates.front()};
+    if(candidates.size() > 1 && !constant_fits())
+    {
+        size_t anchor = 0;
+        while(anchor + 1 < candidates.size())
+        {
+            size_t end = anchor + 1;
+            while(end + 1 < candidates.size() && segment_fits(candidates[anchor], candidates[end + 1]))
+            {
+                ++end;
+            }
+
+            kept.emplace_back(candidates[end]);
+            anchor = end;
+        }
+    }
+
+    result.header.key_count = uint32_t(kept.size());
+    result.times.reserve(kept.size());
+    result.values.reserve(kept.size() * 3);
+    for(auto index : kept)
+    {
+        result.times.emplace_back(times[index]);
+        result.values.insert(result.values.end(), &values[index * 3], &values[index * 3 + 3]);
+    }
+
+    // Measure the error of the final track at every raw key.
+    for(size_t i = 0; i < count; ++i)
+    {
+        uint32_t first = 0;
+        float factor = 0.0f;
+        T value = find_keys(result.times.data(), result.header.key_count, times[i], first, factor)
+                      ? interpolate_value(decode_value<T>(result.values.data(), first, result.header),
+                                          decode_value<T>(result.values.data(), first + 1, result.header),
+                                          factor)
+                      : decode_value<T>(result.values.data(), first, result.header);
+
+        max_error = math::max(max_error, get_error(value, keys[i].value));
+    }
+
+    return result;
+}
+
+template<typename T>
+void get_track_keys(const uint8_t* blob,
+                    const track_header& header,
+                    float time,
+                    uint32_t& cursor,
+                    T* values,
+                    float& factor)
+{
+    if(header.key_count == 0)
+    {
+        factor = 0.0f;
+        return;
+    }
+
+    visit_track(blob,
+                header,
+                [&](const auto* times, const uint16_t* keys)
+                {
+                    auto first = find_key(
+                        [&](uint32_t i)
+                        {
+                            return float(times[i]);
+                        },
+                        header.key_count,
+                        time,
+                        cursor,
+                        factor);
+
+                    values[0] = decode_value<T>(keys, first, header);
+                    const uint32_t count = header.key_count;
+                    values[1] = first + 1 < count ? decode_value<T>(keys, first + 1, header) : values[0];
+                });
+}
+
+/// Converts a clip time to the units of the key times of a track.
+auto get_track_time(const animation_clip& clip, const track_header& header, animation_clip::seconds_t time) -> float
+{
+    if(header.float_times)
+    {
+        return time.count();
+    }
+
+    if(clip.duration.count() <= 0.0f)
+    {
+        return 0.0f;
+    }
+
+    return time.count() / clip.duration.count() * max_quantized;
+}
+
+auto get_header(const animation_clip& clip, size_t track_index) -> const track_header*
+{
+    if((track_index + 1) * sizeof(track_header) > clip.compressed_tracks.size())
+    {
+        return nullptr;
+    }
+
+    return reinterpret_cast<const track_header*>(clip.compressed_tracks.data()) + track_index;
+}
+
+} // namespace
+
+auto compress_animation(animation_clip& clip, const animation_compression_settings& settings)
+    -> animation_compression_stats
+{
+    animation_compression_stats stats;
+
+    if(clip.is_compressed())
+    {
+        return stats;
+    }
+
+    std::vector<encoded_track> tracks;
+    tracks.reserve(clip.channels.size() * tracks_per_channel);
+
+    for(const auto& channel : clip.channels)
+    {
+        tracks.emplace_back(
+            encode_track(channel.position_keys, clip.duration, settings.position_tolerance, stats.max_position_error));
+        tracks.emplace_back(
+            encode_track(channel.rotation_keys, clip.duration, settings.rotation_tolerance, stats.max_rotation_error));
+        tracks.emplace_back(
+            encode_track(channel.scaling_keys, clip.duration, settings.scaling_tolerance, stats.max_scaling_error));
+
+        stats.raw_size += channel.position_keys.size() * sizeof(animation_channel::key<math::vec3>);
+        stats.raw_size += channel.rotation_keys.size() * sizeof(animation_channel::key<math::quat>);
+        stats.raw_size += channel.scaling_keys.size() * sizeof(animation_channel::key<math::vec3>);
+        stats.raw_keys += channel.position_keys.size() + channel.rotation_keys.size() + channel.scaling_keys.size();
+    }
+
+    size_t size = tracks.size() * sizeof(track_header);
+    for(auto& track : tracks)
+    {
+        // Float key times need a 4 byte aligned offset.
+        size = (size + sizeof(float) - 1) & ~(sizeof(float) - 1);
+        track.header.offset = uint32_t(size);
+        size += track.times.size() * get_time_size(track.header);
+        size += track.values.size() * sizeof(uint16_t);
+        stats.compressed_keys += track.header.key_count;
+    }
+
+    std::vector<uint8_t> blob(size);
+    for(size_t i = 0; i < tracks.size(); ++i)
+    {
+        const auto& track = tracks[i];
+        std::memcpy(blob.data() + i * sizeof(track_header), &track.header, sizeof(track_header));
+
+        auto* output = blob.data() + track.header.offset;
+        if(track.header.float_times)
+        {
+            std::memcpy(output, track.times.data(), track.times.size() * sizeof(float));
+            output += track.times.size() * sizeof(float);
+        }
+        else
+        {
+            for(auto time : track.times)
+            {
+                const auto quantized = uint16_t(time);
+                std::memcpy(output, &quantized, sizeof(uint16_t));
+                output += sizeof(uint16_t);
+            }
+        }
+        std::memcpy(output, track.values.data(), track.values.size() * sizeof(uint16_t));
+    }
+
+    stats.compressed_size = blob.size();
+
+    for(auto& channel : clip.channels)
+    {
+        channel.position_keys = {};
+        channel.rotation_keys = {};
+        channel.scaling_keys = {};
+    }
+    clip.compressed_tracks = std::move(blob);
+    update_compressed_key_counts(clip);
+
+    return stats;
+}
+
+void update_compressed_key_counts(animation_clip& clip)
+{
+    for(size_t i = 0; i < clip.channels.size(); ++i)
+    {
+        auto& channel = clip.channels[i];
+        const auto* headers = get_header(clip, i * tracks_per_channel + 2);
+        if(!headers)
+        {
+            channel.compressed_position_keys_count = 0;
+            channel.compressed_rotation_keys_count = 0;
+            channel.compressed_scaling_keys_count = 0;
+            continue;
+        }
+        headers -= 2;
+
+        channel.compressed_position_keys_count = headers[0].key_count;
+        channel.compressed_rotation_keys_count = headers[1].key_count;
+        channel.compressed_scaling_keys_count = headers[2].key_count;
+    }
+}
+
+void sample_compressed_channel(const animation_clip& clip,
+                               size_t channel_index,
+                               animation_clip::seconds_t time,
+                               math::vec3& position,
+                               math::quat& rotation,
+                               math::vec3& scaling)
+{
+    const auto* headers = get_header(clip, channel_index * tracks_per_channel + 2);
+    if(!headers)
+    {
+        position = {};
+        rotation = {};
+        scaling = {};
+        return;
+    }
+    headers -= 2;
+
+    const auto* blob = clip.compressed_tracks.data();
+    position = sample_track<math::vec3>(blob, headers[0], get_track_time(clip, headers[0], time));
+    rotation = sample_track<math::quat>(blob, headers[1], get_track_time(clip, headers[1], time));
+    scaling = sample_track<math::vec3>(blob, headers[2], get_track_time(clip, headers[2], time));
+}
+
+void get_compressed_channel_keys(const animation_clip& clip,
+                                 size_t channel_index,
+                                 animation_clip::seconds_t time,
+                                 uint32_t* cursors,
+                                 channel_keys& keys)
+{
+    const auto* headers = get_header(clip, channel_index * tracks_per_channel + 2);
+    if(!headers)
+    {
+        return;
+    }
+    headers -= 2;
+
+    const auto* blob = clip.compressed_tracks.data();
+    get_track_keys(blob,
+                   headers[0],
+                   get_track_time(clip, headers[0], time),
+                   cursors[0],
+                   keys.position,
+                   keys.position_factor);
+    get_track_keys(blob,
+                   headers[1],
+                   get_track_time(clip, headers[1], time),
+                   cursors[1],
+                   keys.rotation,
+                   keys.rotation_factor);
+    get_track_keys(blob,
+                   headers[2],
+                   get_track_time(clip, headers[2], time),
+                   cursors[2],
+                   keys.scaling,
+                   keys.scaling_factor);
+}
+
+} // namespace unravel
@@ -0,0 +1,100 @@
+#pragma once
+#include <engine/engine_export.h>
+
+#include "animation.h"
+#include "animation_sampler.h"
+
+namespace unravel
+{
+
+/**
+ * @brief Error bounds used when compressing an animation clip.
+ */
+struct animation_compression_settings
+{
+    /// Maximum position error in model units.
+    float position_tolerance{0.0001f};
+    /// Maximum rotation error in degrees.
+    float rotation_tolerance{0.01f};
+    /// Maximum scaling error.
+    float scaling_tolerance{0.0001f};
+};
+
+/**
+ * @brief Results of compressing an animation clip.
+ */
+struct animation_compression_stats
+{
+    /// Size of the raw keys in bytes.
+    size_t raw_size{};
+    /// Size of the compressed tracks in bytes.
+    size_t compressed_size{};
+    /// Number of raw keys over all tracks.
+    size_t raw_keys{};
+    /// Number of keys kept over all tracks.
+    size_t compressed_keys{};
+    /// Largest position error measured at the raw keys.
+    float max_position_error{};
+    /// Largest rotation error measured at the raw keys, in degrees.
+    float max_rotation_error{};
+    /// Largest scaling error measured at the raw keys.
+    float max_scaling_error{};
+};
+
+/**
+ * @brief Compresses the keys of every channel of a clip into clip.compressed_tracks.
+ *
+ * Each track keeps only the keys needed to stay within the tolerances when linearly
+ * interpolated. Key times are stored as 16 bit fractions of the clip duration, or as float
+ * seconds for tracks whose keys are too close together for 16 bits to resolve. Positions
+ * and scalings are stored as 16 bit values normalized to the range of their track, and
+ * rotations with the smallest three encoding in 48 bits. The raw keys of the channels are
+ * released.
+ *
+ * @param clip The clip to compress.
+ * @param settings The error bounds.
+ * @return Size and error statistics.
+ */
+auto compress_animation(animation_clip& clip, const animation_compression_settings& settings)
+    -> animation_compression_stats;
+
+/**
+ * @brief Sets the compressed key counts of every channel from the track headers of a compressed clip.
+ *
+ * @param clip The clip. Channels of a clip that is not compressed get counts of 0.
+ */
+void update_compressed_key_counts(animation_clip& clip);
+
+/**
+ * @brief Samples a channel of a compressed clip.
+ *
+ * @param clip The compressed clip.
+ * @param channel_index Index of the channel in clip.channels.
+ * @param time The time to sample at.
+ * @param position Receives the position.
+ * @param rotation Receives the rotation.
+ * @param scaling Receives the scaling.
+ */
+void sample_compressed_channel(const animation_clip& clip,
+                               size_t channel_index,
+                               animation_clip::seconds_t time,
+                               math::vec3& position,
+                               math::quat& rotation,
+                               math::vec3& scaling);
+
+/**
+ * @brief Finds the keys of a channel of a compressed clip around a time.
+ *
+ * @param clip The compressed clip.
+ * @param channel_index Index of the channel in clip.channels.
+ * @param time The time to sample at.
+ * @param cursors Key cursors of the position, rotation and scaling tracks of the channel (see find_key).
+ * @param keys Receives the decoded keys. Left untouched for tracks without keys.
+ */
+void get_compressed_channel_keys(const animation_clip& clip,
+                                 size_t channel_index,
+                                 animation_clip::seconds_t time,
+                                 uint32_t* cursors,
+                                 channel_keys& keys);
+
+} // namespace unravel
@@ -1,4 +1,6 @@
 #include "animation_player.h"
+#include "animation_compression.h"
+#include "animation_sampler.h"
 #include <hpp/utility/overload.hpp>
 namespace unravel
 {
@@ -6,64 +8,46 @@ namespace unravel
 namespace
 {
 /**
- * @brief Interpolates between keyframes to find the appropriate value at the current time.
- *  * @tparam T The type of value being interpolated (e.g., vec3 or quat).
- * @param keys The list of keyframes.
- * @param time The current animation time.
- * @return The interpolated value.
+ * @brief Gets the first and last values of a channel track.
+ *
+ * Compressed clips sample them at the start and the end of the clip.
  */
 template<typename T>
-auto interpolate(const std::vector<animation_channel::key<T>>& keys, animation_player::seconds_t time) -> T
+void get_channel_bounds(const animation_clip& clip,
+                        size_t channel_index,
+                        const std::vector<animation_channel::key<T>>& keys,
+                        T& first,
+                        T& last)
 {
-    if(keys.empty())
+    if(!clip.is_compressed())
     {
-        return {}; // Return default value if there are no keys
-    }
-
-    // Do binary search for keyframe
-    int high = (int)keys.size(), low = -1;
-    while(high - low > 1)
-    {
-        int probe = (high + low) / 2;
-        if(keys[probe].time < time)
-        {
-            low = probe;
-        }
-        else
-        {
-            high = probe;
-        }
+        first = keys.front().value;
+        last = keys.back().value;
+        return;
     }
 
-    if(low == -1)
+    math::vec3 position;
+    math::quat rotation;
+    math::vec3 scaling;
+    sample_compressed_channel(clip, channel_index, animation_clip::seconds_t(0), position, rotation, scaling);
+    if constexpr(std::is_same_v<T, math::quat>)
     {
-        // Before first key, return first key
-        return keys.front().value;
+        first = rotation;
     }
-
-    if(high == (int)keys.size())
+    else
     {
-        // Beyond last key, return last key
-        return keys.back().value;
+        first = position;
     }
 
-    const auto& key1 = keys[low];
-    const auto& key2 = keys[low + 1];
-
-    // Compute the interpolation factor (0.0 to 1.0)
-    float factor = (time.count() - key1.time.count()) / (key2.time.count() - key1.time.count());
-
-    // Perform the interpolation
-    if constexpr(std::is_same_v<T, math::vec3>)
+    sample_compressed_channel(clip, channel_index, clip.duration, position, rotation, scaling);
+    if constexpr(std::is_same_v<T, math::quat>)
     {
-        return math::lerp(key1.value, key2.value, factor);
+        last = rotation;
     }
-    else if constexpr(std::is_same_v<T, math::quat>)
+    else
     {
-        return math::slerp(key1.value, key2.value, factor);
+        last = position;
     }
-
-    return {};
 }
 
 } // namespace
@@ -233,7 +217,10 @@ auto animation_player::update_time(seconds_t delta_time, bool force) -> bool
     return false;
 }
 
-void animation_player::update_poses(const animation_pose& ref_pose, const update_callback_t& set_transform_callback)
+void animation_player::update_poses(const animation_pose& ref_pose,
+                                    const update_callback_t& set_transform_callback,
+                                    const std::vector<uint8_t>* skipped_nodes,
+                                    const animation_pose_sharing& sharing)
 {
     if(layers_.empty())
     {
@@ -243,10 +230,10 @@ void animation_player::update_poses(const animation_pose& ref_pose, const update
     for(auto& layer : layers_)
     {
         // Update current layer
-        update_pose(layer.current_state);
+        update_pose(layer.current_state, skipped_nodes, sharing);
 
         // Update target layer
-        if(update_pose(layer.target_state))
+        if(update_pose(layer.target_state, skipped_nodes, sharing))
         {
             // Compute blend factor
             float blend_progress = get_blend_progress(layer);
@@ -297,7 +284,9 @@ void animation_player::update_poses(const animation_pose& ref_pose, const update
     }
 }
 
-auto animation_player::update_pose(animation_layer_state& layer) -> bool
+auto animation_player::update_pose(animation_layer_state& layer,
+                                   const std::vector<uint8_t>* skipped_nodes,
+                                   const animation_pose_sharing& sharing) -> bool
 {
     auto& state = layer.state;
     auto& pose = layer.pose;
@@ -313,7 +302,11 @@ auto animation_player::update_pose(animation_layer_state& layer) -> bool
         for(size_t i = 0; i < state.blend_clips.size(); ++i)
         {
             const auto& clip_weight_pair = state.blend_clips[i];
-            sample_animation(clip_weight_pair.first.get().get(), state.elapsed, state.blend_poses[i]);
+            sample_animation(clip_weight_pair.first.get().get(),
+                             state.elapsed,
+                             state.blend_poses[i],
+                             skipped_nodes,
+                             sharing);
         }
 
         // Blend all poses based on their weights
@@ -332,13 +325,16 @@ auto animation_player::update_pose(animation_layer_state& layer) -> bool
                             pose);
                 total_weight += state.blend_clips[i].second;
             }
+
+            // The blend is ordered by node, it can't be resampled in place as a clip.
+            pose.sampled_clip = nullptr;
         }
         return true;
     }
 
     if(state.clip)
     {
-        sample_animation(state.clip.get().get(), state.elapsed, pose);
+        sample_animation(state.clip.get().get(), state.elapsed, pose, skipped_nodes, sharing);
         return true;
     }
 
@@ -402,27 +398,47 @@ auto animation_player::compute_blend_factor(const animation_layer& layer, float
 
 void animation_player::sample_animation(const animation_clip* anim_clip,
                                         seconds_t time,
-                                        animation_pose& pose) const noexcept
+                                        animation_pose& pose,
+                                        const std::vector<uint8_t>* skipped_nodes,
+                                        const animation_pose_sharing& sharing) const noexcept
 {
     if(!anim_clip)
     {
         return;
     }
-    pose.nodes.clear();
-    pose.nodes.reserve(anim_clip->channels.size());
 
-    for(const auto& channel : anim_clip->channels)
+    // Nodes are only kept from a previous sample of the same clip. Blend spaces can hand a pose another
+    // clip from one frame to the next, its nodes would then keep the other clip's indices and values.
+    if(pose.sampled_clip != anim_clip)
+    {
+        skipped_nodes = nullptr;
+        pose.key_cursors.clear();
+    }
+
+    if(sharing.cache && !skipped_nodes)
+    {
+        time = animation_pose_cache::quantize(time, sharing.step);
+        pose.nodes = sharing.cache->get_nodes(*anim_clip, time);
+    }
+    else
     {
-        math::vec3 position = interpolate(channel.position_keys, time);
-        math::quat rotation = interpolate(channel.rotation_keys, time);
-        math::vec3 scaling = interpolate(channel.scaling_keys, time);
+        sample_clip(*anim_clip, time, pose.key_cursors, pose.nodes, skipped_nodes);
+    }
+    pose.sampled_clip = anim_clip;
+
+    for(size_t channel_index = 0; channel_index < anim_clip->channels.size(); ++channel_index)
+    {
+        const auto& channel = anim_clip->channels[channel_index];
+        const auto& node = pose.nodes[channel_index];
+
+        if(int(node.desc.index) != anim_clip->root_motion.position_node_index &&
+           int(node.desc.index) != anim_clip->root_motion.rotation_node_index)
+        {
+            continue;
+        }
 
-        auto& node = pose.nodes.emplace_back();
-        node.desc.index = channel.node_index;
-        // node.desc.name = channel.node_name;
-        node.transform.set_position(position);
-        node.transform.set_rotation(rotation);
-        node.transform.set_scale(scaling);
+        math::vec3 position = node.transform.get_position();
+        math::quat rotation = node.transform.get_rotation();
 
         bool processed = false;
 
@@ -430,8 +446,9 @@ void animation_player::sample_animation(const animation_clip* anim_clip,
         {
             pose.motion_result.root_position_node_index = anim_clip->root_motion.position_node_index;
 
-            const auto& clip_start_pos = channel.position_keys.front().value;
-            const auto& clip_end_pos = channel.position_keys.back().value;
+            math::vec3 clip_start_pos;
+            math::vec3 clip_end_pos;
+            get_channel_bounds(*anim_clip, channel_index, channel.position_keys, clip_start_pos, clip_end_pos);
 
             pose.motion_result.root_position_weights = {1.0f, 1.0f, 1.0f};
             pose.motion_result.bone_position_weights = {0.0f, 0.0f, 0.0f};
@@ -488,8 +505,9 @@ void animation_player::sample_animation(const animation_clip* anim_clip,
         {
             pose.motion_result.root_rotation_node_index = anim_clip->root_motion.rotation_node_index;
 
-            const auto& clip_start_rotation = channel.rotation_keys.front().value;
-            const auto& clip_end_rotation = channel.rotation_keys.back().value;
+            math::quat clip_start_rotation;
+            math::quat clip_end_rotation;
+            get_channel_bounds(*anim_clip, channel_index, channel.rotation_keys, clip_start_rotation, clip_end_rotation);
 
             pose.motion_result.root_rotation_weight = {1.0f};
             pose.motion_result.bone_rotation_weight = {0.0f};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "animation_blend_space.h"
+#include "animation_pose_cache.h"
 #include <engine/assets/asset_handle.h>
 #include <engine/rendering/model.h>
 
@@ -135,8 +136,20 @@ public:
      * @param set_transform_callback The callback function to set the transform of a node.
      */
     auto update_time(seconds_t delta_time, bool force = false) -> bool;
+
+    /**
+     * @brief Samples the layers at their current time and passes the final pose to the callback.
+     *
+     * @param ref_pose The reference pose used for additive blending.
+     * @param set_transform_callback The callback function to set the transform of a node.
+     * @param skipped_nodes Optional flags indexed by node index. Flagged nodes are not sampled and
+     * keep their previous value.
+     * @param sharing Optional pose cache shared with other players. Not used with skipped nodes.
+     */
     void update_poses(const animation_pose& ref_pose,
-                      const update_callback_t& set_transform_callback);
+                      const update_callback_t& set_transform_callback,
+                      const std::vector<uint8_t>* skipped_nodes = nullptr,
+                      const animation_pose_sharing& sharing = {});
 
     /**
      * @brief Returns whether the animation is currently playing.
@@ -191,12 +204,15 @@ private:
 
     void sample_animation(const animation_clip* anim_clip,
                           seconds_t time,
-                          animation_pose& pose) const noexcept;
+                          animation_pose& pose,
+                          const std::vector<uint8_t>* skipped_nodes,
+                          const animation_pose_sharing& sharing) const noexcept;
     auto compute_blend_factor(const animation_layer& layer, float normalized_blend_time) noexcept -> float;
     void update_state(seconds_t delta_time, animation_state& state);
     auto get_blend_progress(const animation_layer& layer) const -> float;
-    auto update_pose(animation_layer_state& layer)
-        -> bool;
+    auto update_pose(animation_layer_state& layer,
+                     const std::vector<uint8_t>* skipped_nodes,
+                     const animation_pose_sharing& sharing) -> bool;
 
     std::vector<animation_layer> layers_;
 
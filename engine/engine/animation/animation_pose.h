@@ -47,6 +47,14 @@ struct animation_pose
     root_motion_result motion_result;
     root_motion_state motion_state;
 
+    /// Key cursors of the last sampled clip, three per channel. Only a starting point for the
+    /// next key search, see find_key.
+    std::vector<uint32_t> key_cursors;
+
+    /// Clip the nodes were last sampled from, one node per channel. Null when they hold anything else,
+    /// like a blend of several clips. Only nodes sampled from the same clip can be kept between samples.
+    const animation_clip* sampled_clip{};
+
 };
 
 
@@ -0,0 +1,74 @@
+#include "animation_pose_cache.h"
+#include "animation_sampler.h"
+
+#include <base/hash.hpp>
+
+#include <cmath>
+
+namespace unravel
+{
+
+auto animation_pose_cache::key_hash::operator()(const key& k) const -> size_t
+{
+    size_t seed = 0;
+    utils::hash_combine(seed, k.clip);
+    utils::hash_combine(seed, k.time);
+    return seed;
+}
+
+auto animation_pose_cache::get_nodes(const animation_clip& clip, seconds_t time)
+    -> const std::vector<animation_pose::node>&
+{
+    entry* cached = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        requests_++;
+
+        auto& slot = entries_[key{&clip, time.count()}];
+        if(!slot)
+        {
+            slot = std::make_unique<entry>();
+        }
+        cached = slot.get();
+    }
+
+    // Sample outside of the lock, players asking for the same pose meanwhile wait for it here.
+    std::call_once(cached->sampled,
+                   [&]()
+                   {
+                       sample_clip(clip, time, cached->cursors, cached->nodes);
+                   });
+
+    return cached->nodes;
+}
+
+void animation_pose_cache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    requests_ = 0;
+}
+
+auto animation_pose_cache::get_request_count() const -> size_t
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return requests_;
+}
+
+auto animation_pose_cache::get_sample_count() const -> size_t
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+auto animation_pose_cache::quantize(seconds_t time, seconds_t step) -> seconds_t
+{
+    if(step.count() <= 0.0f)
+    {
+        return time;
+    }
+
+    return seconds_t(std::floor(time.count() / step.count()) * step.count());
+}
+
+} // namespace unravel
@@ -0,0 +1,96 @@
+#pragma once
+#include <engine/engine_export.h>
+
+#include "animation_pose.h"
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace unravel
+{
+
+/**
+ * @brief Poses of clips sampled during a frame, shared between animation players.
+ *
+ * Crowds often play the same clip at the same phase. Players which opt into sharing snap
+ * their sampling time to a step, and every player asking for the same clip at the same
+ * snapped time gets the nodes sampled by the first one. The cache is safe to use from
+ * several threads and is meant to be cleared once per frame.
+ */
+class animation_pose_cache
+{
+public:
+    using seconds_t = animation_clip::seconds_t;
+
+    /**
+     * @brief Gets the nodes of a clip sampled at a time, sampling them on the first request.
+     *
+     * @param clip The clip to sample.
+     * @param time The time to sample at, already snapped by the caller.
+     * @return The sampled nodes, valid until the cache is cleared.
+     */
+    auto get_nodes(const animation_clip& clip, seconds_t time) -> const std::vector<animation_pose::node>&;
+
+    /**
+     * @brief Releases the poses sampled so far.
+     */
+    void clear();
+
+    /**
+     * @brief Gets the number of requests served since the last clear.
+     */
+    auto get_request_count() const -> size_t;
+
+    /**
+     * @brief Gets the number of poses sampled since the last clear.
+     */
+    auto get_sample_count() const -> size_t;
+
+    /**
+     * @brief Snaps a time down to a multiple of a step.
+     *
+     * @param time The time to snap.
+     * @param step The step, times are left unchanged when it is not positive.
+     * @return The snapped time.
+     */
+    static auto quantize(seconds_t time, seconds_t step) -> seconds_t;
+
+private:
+    struct key
+    {
+        const animation_clip* clip{};
+        float time{};
+
+        auto operator==(const key& rhs) const -> bool = default;
+    };
+
+    struct key_hash
+    {
+        auto operator()(const key& k) const -> size_t;
+    };
+
+    struct entry
+    {
+        std::once_flag sampled;
+        std::vector<uint32_t> cursors;
+        std::vector<animation_pose::node> nodes;
+    };
+
+    mutable std::mutex mutex_;
+    std::unordered_map<key, std::unique_ptr<entry>, key_hash> entries_;
+    size_t requests_{};
+};
+
+/**
+ * @brief How an animation player samples through a shared pose cache.
+ */
+struct animation_pose_sharing
+{
+    /// The cache to sample through, nullptr to sample independently.
+    animation_pose_cache* cache{};
+    /// Sampling times are snapped down to multiples of this step.
+    animation_clip::seconds_t step{};
+};
+
+} // namespace unravel
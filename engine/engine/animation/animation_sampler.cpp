@@ -0,0 +1,226 @@
+#include "animation_sampler.h"
+#include "animation_compression.h"
+
+#include <algorithm>
+
+namespace unravel
+{
+
+namespace
+{
+
+constexpr size_t lane_count = 4;
+
+/// Quaternions closer than this are nlerped, the error against slerp stays below 0.005 degrees.
+constexpr float nlerp_min_dot = 0.99f;
+
+template<typename T>
+void get_track_keys(const std::vector<animation_channel::key<T>>& keys,
+                    float time,
+                    uint32_t& cursor,
+                    T* values,
+                    float& factor)
+{
+    if(keys.empty())
+    {
+        factor = 0.0f;
+        return;
+    }
+
+    auto first = find_key(
+        [&](uint32_t i)
+        {
+            return keys[i].time.count();
+        },
+        uint32_t(keys.size()),
+        time,
+        cursor,
+        factor);
+
+    values[0] = keys[first].value;
+    values[1] = keys[first + 1 < keys.size() ? first + 1 : first].value;
+}
+
+void get_channel_keys(const animation_channel& channel, float time, uint32_t* cursors, channel_keys& keys)
+{
+    get_track_keys(channel.position_keys, time, cursors[0], keys.position, keys.position_factor);
+    get_track_keys(channel.rotation_keys, time, cursors[1], keys.rotation, keys.rotation_factor);
+    get_track_keys(channel.scaling_keys, time, cursors[2], keys.scaling, keys.scaling_factor);
+}
+
+/// Three component values of four channels in structure of arrays form.
+struct vec3_lanes
+{
+    math::vec4 x;
+    math::vec4 y;
+    math::vec4 z;
+};
+
+/// Rotations of four channels in structure of arrays form.
+struct quat_lanes
+{
+    math::vec4 x;
+    math::vec4 y;
+    math::vec4 z;
+    math::vec4 w;
+};
+
+auto lerp(const vec3_lanes& from, const vec3_lanes& to, const math::vec4& factor) -> vec3_lanes
+{
+    return {from.x + (to.x - from.x) * factor, from.y + (to.y - from.y) * factor, from.z + (to.z - from.z) * factor};
+}
+
+/// Normalized lerp along the shortest path. Returns the cosine between the inputs in 'dot'.
+auto nlerp(const quat_lanes& from, const quat_lanes& to, const math::vec4& factor, math::vec4& dot) -> quat_lanes
+{
+    dot = from.x * to.x + from.y * to.y + from.z * to.z + from.w * to.w;
+
+    const auto sign = math::mix(math::vec4(1.0f), math::vec4(-1.0f), math::lessThan(dot, math::vec4(0.0f)));
+    const auto from_weight = math::vec4(1.0f) - factor;
+    const auto to_weight = factor * sign;
+
+    quat_lanes result{from.x * from_weight + to.x * to_weight,
+                      from.y * from_weight + to.y * to_weight,
+                      from.z * from_weight + to.z * to_weight,
+                      from.w * from_weight + to.w * to_weight};
+
+    const auto inverse_length =
+        math::inversesqrt(result.x * result.x + result.y * result.y + result.z * result.z + result.w * result.w);
+    result.x *= inverse_length;
+    result.y *= inverse_length;
+    result.z *= inverse_length;
+    result.w *= inverse_length;
+
+    dot *= sign;
+    return result;
+}
+
+/// Interpolates up to four channels at once and writes them to their nodes.
+void interpolate_lanes(const channel_keys* keys, size_t count, animation_pose::node** nodes)
+{
+    vec3_lanes position_from{}, position_to{}, scaling_from{}, scaling_to{};
+    quat_lanes rotation_from{}, rotation_to{};
+    math::vec4 position_factor{}, rotation_factor{}, scaling_factor{};
+
+    // Unused lanes repeat the last channel so every lane holds valid values.
+    for(size_t lane = 0; lane < lane_count; ++lane)
+    {
+        const auto& key = keys[lane < count ? lane : count - 1];
+
+        position_from.x[lane] = key.position[0].x;
+        position_from.y[lane] = key.position[0].y;
+        position_from.z[lane] = key.position[0].z;
+        position_to.x[lane] = key.position[1].x;
+        position_to.y[lane] = key.position[1].y;
+        position_to.z[lane] = key.position[1].z;
+        position_factor[lane] = key.position_factor;
+
+        rotation_from.x[lane] = key.rotation[0].x;
+        rotation_from.y[lane] = key.rotation[0].y;
+        rotation_from.z[lane] = key.rotation[0].z;
+        rotation_from.w[lane] = key.rotation[0].w;
+        rotation_to.x[lane] = key.rotation[1].x;
+        rotation_to.y[lane] = key.rotation[1].y;
+        rotation_to.z[lane] = key.rotation[1].z;
+        rotation_to.w[lane] = key.rotation[1].w;
+        rotation_factor[lane] = key.rotation_factor;
+
+        scaling_from.x[lane] = key.scaling[0].x;
+        scaling_from.y[lane] = key.scaling[0].y;
+        scaling_from.z[lane] = key.scaling[0].z;
+        scaling_to.x[lane] = key.scaling[1].x;
+        scaling_to.y[lane] = key.scaling[1].y;
+        scaling_to.z[lane] = key.scaling[1].z;
+        scaling_factor[lane] = key.scaling_factor;
+    }
+
+    const auto position = lerp(position_from, position_to, position_factor);
+    const auto scaling = lerp(scaling_from, scaling_to, scaling_factor);
+
+    math::vec4 dot;
+    const auto rotation = nlerp(rotation_from, rotation_to, rotation_factor, dot);
+
+    for(size_t lane = 0; lane < count; ++lane)
+    {
+        auto& transform = nodes[lane]->transform;
+        transform.set_position({position.x[lane], position.y[lane], position.z[lane]});
+        transform.set_scale({scaling.x[lane], scaling.y[lane], scaling.z[lane]});
+
+        if(dot[lane] < nlerp_min_dot && keys[lane].rotation_factor > 0.0f)
+        {
+            transform.set_rotation(math::slerp(keys[lane].rotation[0], keys[lane].rotation[1], keys[lane].rotation_factor));
+        }
+        else
+        {
+            math::quat value;
+            value.x = rotation.x[lane];
+            value.y = rotation.y[lane];
+            value.z = rotation.z[lane];
+            value.w = rotation.w[lane];
+            transform.set_rotation(value);
+        }
+    }
+}
+
+} // namespace
+
+void sample_clip(const animation_clip& clip,
+                 animation_clip::seconds_t time,
+                 std::vector<uint32_t>& cursors,
+                 std::vector<animation_pose::node>& nodes,
+                 const std::vector<uint8_t>* skipped_nodes)
+{
+    const size_t channel_count = clip.channels.size();
+    const size_t sampled_count = nodes.size();
+    cursors.resize(channel_count * 3);
+    nodes.resize(channel_count);
+
+    const bool compressed = clip.is_compressed();
+    const float time_value = time.count();
+
+    channel_keys keys[lane_count];
+    animation_pose::node* lane_nodes[lane_count];
+    size_t count = 0;
+
+    for(size_t channel_index = 0; channel_index < channel_count; ++channel_index)
+    {
+        const auto node_index = clip.channels[channel_index].node_index;
+
+        // Skipped nodes keep their last sampled value, nodes never sampled before are always sampled.
+        if(skipped_nodes && channel_index < sampled_count && node_index < skipped_nodes->size() &&
+           (*skipped_nodes)[node_index])
+        {
+            continue;
+        }
+
+        auto& key = keys[count];
+        key = {};
+        key.rotation[0] = key.rotation[1] = math::quat(1.0f, 0.0f, 0.0f, 0.0f);
+
+        if(compressed)
+        {
+            get_compressed_channel_keys(clip, channel_index, time, &cursors[channel_index * 3], key);
+        }
+        else
+        {
+            get_channel_keys(clip.channels[channel_index], time_value, &cursors[channel_index * 3], key);
+        }
+
+        auto& node = nodes[channel_index];
+        node.desc.index = node_index;
+        lane_nodes[count] = &node;
+
+        if(++count == lane_count)
+        {
+            interpolate_lanes(keys, count, lane_nodes);
+            count = 0;
+        }
+    }
+
+    if(count > 0)
+    {
+        interpolate_lanes(keys, count, lane_nodes);
+    }
+}
+
+} // namespace unravel
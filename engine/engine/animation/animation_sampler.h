@@ -0,0 +1,109 @@
+#pragma once
+#include <engine/engine_export.h>
+
+#include "animation_pose.h"
+
+namespace unravel
+{
+
+/**
+ * @brief Keys around a sampled time for the three tracks of a channel.
+ *
+ * Interpolating from the first to the second key of a track by its factor gives the sampled value.
+ */
+struct channel_keys
+{
+    math::vec3 position[2]{};
+    math::quat rotation[2]{};
+    math::vec3 scaling[2]{};
+    float position_factor{};
+    float rotation_factor{};
+    float scaling_factor{};
+};
+
+/**
+ * @brief Finds the key before a time, starting from the key found by the previous call.
+ *
+ * Playback moves forward by a key or two per frame, so the cursor is advanced linearly and
+ * only falls back to a binary search when the time jumps backwards or far ahead.
+ *
+ * @param get_time Returns the time of a key as a float.
+ * @param count Number of keys, must not be zero.
+ * @param time The time to search for, in the same unit as get_time.
+ * @param cursor The key found by the previous call, updated with the result.
+ * @param factor Receives the interpolation factor towards the next key, 0 outside the keys.
+ * @return Index of the key to interpolate from.
+ */
+template<typename GetTime>
+auto find_key(const GetTime& get_time, uint32_t count, float time, uint32_t& cursor, float& factor) -> uint32_t
+{
+    constexpr uint32_t max_linear_steps = 4;
+
+    uint32_t first = cursor < count ? cursor : 0;
+    if(get_time(first) > time)
+    {
+        first = 0;
+    }
+
+    uint32_t steps = 0;
+    while(first + 1 < count && get_time(first + 1) <= time)
+    {
+        if(++steps > max_linear_steps)
+        {
+            // Binary search for the last key at or before the time.
+            uint32_t low = first + 1;
+            uint32_t high = count;
+            while(high - low > 1)
+            {
+                uint32_t probe = low + (high - low) / 2;
+                if(get_time(probe) <= time)
+                {
+                    low = probe;
+                }
+                else
+                {
+                    high = probe;
+                }
+            }
+            first = low;
+            break;
+        }
+        ++first;
+    }
+
+    cursor = first;
+    factor = 0.0f;
+
+    if(first + 1 < count && get_time(first) <= time)
+    {
+        float from = get_time(first);
+        float to = get_time(first + 1);
+        factor = (time - from) / (to - from);
+    }
+
+    return first;
+}
+
+/**
+ * @brief Samples every channel of a clip into the nodes of a pose.
+ *
+ * The keys of each track are found from a per track cursor kept in 'cursors', which makes
+ * sampling during playback close to constant time. Channels are then interpolated four at
+ * a time in structure of arrays form: positions and scalings are lerped and rotations
+ * nlerped, falling back to slerp for keys far apart. The nodes are reused and only their
+ * position, rotation and scale are written, their matrices are built when first needed.
+ *
+ * @param clip The clip to sample.
+ * @param time The time to sample at.
+ * @param cursors Key cursors of the clip, three per channel. Resized if needed.
+ * @param nodes Receives one node per channel of the clip.
+ * @param skipped_nodes Optional flags indexed by node index. Channels of flagged nodes are not
+ * sampled and keep the value of the previous call.
+ */
+void sample_clip(const animation_clip& clip,
+                 animation_clip::seconds_t time,
+                 std::vector<uint32_t>& cursors,
+                 std::vector<animation_pose::node>& nodes,
+                 const std::vector<uint8_t>* skipped_nodes = nullptr);
+
+} // namespace unravel
@@ -52,6 +52,68 @@ auto animation_component::get_speed() const -> float
     return speed_;
 }
 
+void animation_component::set_update_rate_lod(bool on)
+{
+    update_rate_lod_ = on;
+}
+
+auto animation_component::get_update_rate_lod() const -> bool
+{
+    return update_rate_lod_;
+}
+
+void animation_component::set_half_rate_coverage(float coverage)
+{
+    half_rate_coverage_ = math::clamp(coverage, 0.0f, 100.0f);
+}
+
+auto animation_component::get_half_rate_coverage() const -> float
+{
+    return half_rate_coverage_;
+}
+
+void animation_component::set_quarter_rate_coverage(float coverage)
+{
+    quarter_rate_coverage_ = math::clamp(coverage, 0.0f, 100.0f);
+}
+
+auto animation_component::get_quarter_rate_coverage() const -> float
+{
+    return quarter_rate_coverage_;
+}
+
+void animation_component::set_reduced_bones_coverage(float coverage)
+{
+    reduced_bones_coverage_ = math::clamp(coverage, 0.0f, 100.0f);
+}
+
+auto animation_component::get_reduced_bones_coverage() const -> float
+{
+    return reduced_bones_coverage_;
+}
+
+void animation_component::set_reduced_bones(const std::vector<std::string>& bones)
+{
+    reduced_bones_ = bones;
+    lod_state_.skipped_nodes.clear();
+    lod_state_.skipped_nodes_mesh = nullptr;
+}
+
+auto animation_component::get_reduced_bones() const -> const std::vector<std::string>&
+{
+    return reduced_bones_;
+}
+
+void animation_component::set_pose_sharing_step(float step)
+{
+    pose_sharing_step_ = std::max(0.0f, step);
+}
+
+auto animation_component::get_pose_sharing_step() const -> float
+{
+    return pose_sharing_step_;
+}
+
 auto animation_component::get_player() const -> const animation_player&
 {
     return player_;
@@ -61,4 +123,9 @@ auto animation_component::get_player() -> animation_player&
     return player_;
 }
 
+auto animation_component::get_lod_state() -> animation_lod_state&
+{
+    return lod_state_;
+}
+
 } // namespace unravel
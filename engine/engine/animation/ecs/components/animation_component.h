@@ -7,6 +7,25 @@
 namespace unravel
 {
 
+/**
+ * @brief Runtime state of the update-rate LOD of an animation component.
+ */
+struct animation_lod_state
+{
+    /// Frames between two pose evaluations.
+    uint32_t interval{1};
+    /// Frames since the last pose evaluation.
+    uint32_t step{};
+    /// Local transforms of the nodes when the pose was last evaluated.
+    std::vector<animation_pose::node> from;
+    /// Local transforms of the last evaluated pose.
+    std::vector<animation_pose::node> to;
+    /// Nodes skipped at the reduced bones level, indexed by node index.
+    std::vector<uint8_t> skipped_nodes;
+    /// Mesh the skipped nodes were built for.
+    const mesh* skipped_nodes_mesh{};
+};
+
 class animation_component : public component_crtp<animation_component>
 {
 public:
@@ -49,9 +68,57 @@ public:
      */
     auto get_speed() const -> float;
 
+    /**
+     * @brief Sets whether the update rate is reduced for characters small on screen.
+     *
+     * Below the coverage thresholds the pose is evaluated every 2nd or 4th frame, staggered
+     * across entities, and interpolated in between. Below the reduced bones threshold the
+     * descendants of the reduced bones are no longer evaluated.
+     * @param on True to enable the update-rate LOD, false otherwise.
+     */
+    void set_update_rate_lod(bool on);
+    auto get_update_rate_lod() const -> bool;
+
+    /**
+     * @brief Sets the viewport height coverage in percent below which the pose is evaluated every 2nd frame.
+     */
+    void set_half_rate_coverage(float coverage);
+    auto get_half_rate_coverage() const -> float;
+
+    /**
+     * @brief Sets the viewport height coverage in percent below which the pose is evaluated every 4th frame.
+     */
+    void set_quarter_rate_coverage(float coverage);
+    auto get_quarter_rate_coverage() const -> float;
+
+    /**
+     * @brief Sets the viewport height coverage in percent below which the reduced bones are skipped.
+     */
+    void set_reduced_bones_coverage(float coverage);
+    auto get_reduced_bones_coverage() const -> float;
+
+    /**
+     * @brief Sets the bones whose descendants are skipped at the lowest LOD, e.g. the hands and the head.
+     * @param bones The names of the armature nodes.
+     */
+    void set_reduced_bones(const std::vector<std::string>& bones);
+    auto get_reduced_bones() const -> const std::vector<std::string>&;
+
+    /**
+     * @brief Sets the step the sampling time is snapped to so instances share their poses.
+     *
+     * Components playing the same clip at the same snapped time are sampled once per frame
+     * and the pose is copied to each of them.
+     * @param step The step in seconds, 0 to sample independently.
+     */
+    void set_pose_sharing_step(float step);
+    auto get_pose_sharing_step() const -> float;
+
     auto get_player() const -> const animation_player&;
     auto get_player() -> animation_player&;
 
+    auto get_lod_state() -> animation_lod_state&;
+
 private:
     asset_handle<animation_clip> animation_;
 
@@ -61,6 +128,15 @@ private:
     bool auto_play_ = true;
     bool apply_root_motion_ = false;
     float speed_ = 1.0f;
+
+    bool update_rate_lod_ = false;
+    float half_rate_coverage_ = 20.0f;
+    float quarter_rate_coverage_ = 8.0f;
+    float reduced_bones_coverage_ = 4.0f;
+    std::vector<std::string> reduced_bones_;
+    float pose_sharing_step_ = 0.0f;
+
+    animation_lod_state lod_state_;
 };
 
 } // namespace unravel
@@ -31,8 +31,265 @@ void on_play_begin_impl(animation_component& comp)
         player.play();
     }
 }
+
+/// Exposes a node of a compact skeleton with the part of the transform_component interface used by the
+/// animation update, so root motion is applied the same way as for armature entities.
+class skeleton_node_transform
+{
+public:
+    skeleton_node_transform(model_component& model_comp, size_t index, const transform_component& owner_transform)
+        : model_comp_(model_comp)
+        , index_(index)
+        , owner_transform_(owner_transform)
+    {
+    }
+
+    auto get_position_local() const -> math::vec3
+    {
+        return model_comp_.get_skeleton_node_transform(index_).get_position();
+    }
+
+    void set_position_local(const math::vec3& position)
+    {
+        auto local = model_comp_.get_skeleton_node_transform(index_);
+        local.set_position(position);
+        model_comp_.set_skeleton_node_transform(index_, local);
+    }
+
+    auto get_rotation_local() const -> math::quat
+    {
+        return model_comp_.get_skeleton_node_transform(index_).get_rotation();
+    }
+
+    void set_rotation_local(const math::quat& rotation)
+    {
+        auto local = model_comp_.get_skeleton_node_transform(index_);
+        local.set_rotation(rotation);
+        model_comp_.set_skeleton_node_transform(index_, local);
+    }
+
+    void set_scale_local(const math::vec3& scale)
+    {
+        auto local = model_comp_.get_skeleton_node_transform(index_);
+        local.set_scale(scale);
+        model_comp_.set_skeleton_node_transform(index_, local);
+    }
+
+    auto get_scale_global() const -> math::vec3
+    {
+        return owner_transform_.get_scale_global() * model_comp_.get_skeleton_node_scale(index_);
+    }
+
+    void set_transform_local(const math::transform& transform)
+    {
+        model_comp_.set_skeleton_node_transform(index_, transform);
+    }
+
+private:
+    model_component& model_comp_;
+    size_t index_{};
+    const transform_component& owner_transform_;
+};
+
+template<typename NodeTransform>
+void apply_node_transform(NodeTransform& armature_transform_comp,
+                          transform_component& transform_comp,
+                          bool apply_root_motion,
+                          const animation_pose::node_desc& desc,
+                          const math::transform& transform,
+                          const animation_pose::root_motion_result& motion_result)
+{
+    bool processed_by_root_motion = false;
+
+    if(apply_root_motion && desc.index == motion_result.root_position_node_index)
+    {
+        armature_transform_comp.set_scale_local(transform.get_scale());
+
+        auto position_local = armature_transform_comp.get_position_local();
+        auto result_positon_local = math::lerp(position_local,
+                                               transform.get_position(),
+                                               motion_result.bone_position_weights);
+        armature_transform_comp.set_position_local(result_positon_local);
+
+        math::vec3 delta_translation_logical = motion_result.root_transform_delta.get_translation();
+
+        // // Apply scaling if needed (for example, if BoneRoot’s scale differs significantly)
+        auto scale_global = armature_transform_comp.get_scale_global();
+        delta_translation_logical *= scale_global;
+
+        // Blend translation as needed:
+        auto result_move_local = math::lerp(math::zero<math::vec3>(),
+                                            delta_translation_logical,
+                                            motion_result.root_position_weights);
+        // APPLOG_INFO("position_weights {}", motion_result.position_weights);
+        // if(physics_comp_ptr)
+        // {
+        //     if(math::length2(result_move_local) > 0.0f)
+        //     {
+        //         auto global_delta =
+        //             armature_transform_comp.get_transform_global().transform_normal(result_move_local);
+        //         auto rm_velocity = global_delta / dt.count();
+        //         physics_comp_ptr->set_velocity(rm_velocity);
+        //     }
+        // }
+        // else
+        {
+            transform_comp.move_by_local(result_move_local);
+        }
+        processed_by_root_motion = true;
+    }
+
+    if(apply_root_motion && desc.index == motion_result.root_position_node_index)
+    {
+        armature_transform_comp.set_scale_local(transform.get_scale());
+
+        auto rotation_local = armature_transform_comp.get_rotation_local();
+        auto result_rotation_local = math::slerp(rotation_local,
+                                                 transform.get_rotation(),
+                                                 motion_result.bone_rotation_weight);
+        armature_transform_comp.set_rotation_local(result_rotation_local);
+
+        // --- Rotation ---
+        math::quat delta_rotation_logical = motion_result.root_transform_delta.get_rotation();
+
+        // Optionally blend this delta toward identity:
+        auto result_rotate_local = math::slerp(math::identity<math::quat>(),
+                                               delta_rotation_logical,
+                                               motion_result.root_rotation_weight);
+        transform_comp.rotate_by_local(result_rotate_local);
+
+        processed_by_root_motion = true;
+    }
+
+    if(false == processed_by_root_motion)
+    {
+        armature_transform_comp.set_transform_local(transform);
+    }
+}
+auto get_node_local_transform(const model_component& model_comp, size_t index) -> math::transform
+{
+    if(model_comp.is_compact_skeleton())
+    {
+        return model_comp.get_skeleton_node_transform(index);
+    }
+
+    if(auto armature = model_comp.get_armature_by_index(index))
+    {
+        return armature.get<transform_component>().get_transform_local();
+    }
+
+    return {};
+}
+
+void set_node_local_transform(model_component& model_comp, size_t index, const math::transform& transform)
+{
+    if(model_comp.is_compact_skeleton())
+    {
+        model_comp.set_skeleton_node_transform(index, transform);
+    }
+    else if(auto armature = model_comp.get_armature_by_index(index))
+    {
+        armature.get<transform_component>().set_transform_local(transform);
+    }
 }
 
+/// Frames between pose evaluations for the screen coverage of the model.
+auto get_update_interval(const animation_component& animation_comp, const model_component& model_comp) -> uint32_t
+{
+    if(!animation_comp.get_update_rate_lod())
+    {
+        return 1;
+    }
+
+    auto coverage = model_comp.get_screen_coverage();
+    if(coverage < animation_comp.get_quarter_rate_coverage())
+    {
+        return 4;
+    }
+
+    if(coverage < animation_comp.get_half_rate_coverage())
+    {
+        return 2;
+    }
+
+    return 1;
+}
+
+void mark_skipped_nodes(const mesh::armature_node& node,
+                        const std::vector<std::string>& reduced_bones,
+                        bool skipped,
+                        std::vector<uint8_t>& skipped_nodes)
+{
+    if(node.index >= 0)
+    {
+        if(size_t(node.index) >= skipped_nodes.size())
+        {
+            skipped_nodes.resize(node.index + 1);
+        }
+        skipped_nodes[node.index] = skipped;
+    }
+
+    bool reduced = skipped || std::find(reduced_bones.begin(), reduced_bones.end(), node.name) != reduced_bones.end();
+    for(const auto& child : node.children)
+    {
+        mark_skipped_nodes(*child, reduced_bones, reduced, skipped_nodes);
+    }
+}
+
+/// Nodes to leave out of the evaluation, or nullptr to evaluate all of them.
+auto get_skipped_nodes(animation_component& animation_comp, const model_component& model_comp)
+    -> const std::vector<uint8_t>*
+{
+    if(!animation_comp.get_update_rate_lod() || animation_comp.get_reduced_bones().empty())
+    {
+        return nullptr;
+    }
+
+    if(model_comp.get_screen_coverage() >= animation_comp.get_reduced_bones_coverage())
+    {
+        return nullptr;
+    }
+
+    auto lod = model_comp.get_model().get_lod(0);
+    if(!lod)
+    {
+        return nullptr;
+    }
+
+    auto mesh = lod.get();
+    auto& state = animation_comp.get_lod_state();
+    if(state.skipped_nodes_mesh != mesh.get())
+    {
+        state.skipped_nodes.clear();
+        if(const auto& root = mesh->get_armature())
+        {
+            mark_skipped_nodes(*root, animation_comp.get_reduced_bones(), false, state.skipped_nodes);
+        }
+        state.skipped_nodes_mesh = mesh.get();
+    }
+
+    return &state.skipped_nodes;
+}
+
+/// Moves the nodes between the last two evaluated poses.
+void interpolate_lod_pose(model_component& model_comp, const animation_lod_state& state)
+{
+    float factor = float(state.step) / float(state.interval);
+    for(size_t i = 0; i < state.to.size(); ++i)
+    {
+        const auto& from = state.from[i].transform;
+        const auto& to = state.to[i].transform;
+
+        math::transform transform;
+        transform.set_position(math::lerp(from.get_position(), to.get_position(), factor));
+        transform.set_rotation(math::slerp(from.get_rotation(), to.get_rotation(), factor));
+        transform.set_scale(math::lerp(from.get_scale(), to.get_scale(), factor));
+
+        set_node_local_transform(model_comp, state.to[i].desc.index, transform);
+    }
+}
+} // namespace
+
 auto animation_system::init(rtti::context& ctx) -> bool
 {
     APPLOG_TRACE("{}::{}", hpp::type_name_str(*this), __func__);
@@ -131,6 +388,8 @@ void animation_system::on_update(scene& scn, delta_t dt, bool force)
     // Create a view for entities with transform_component and submesh_component
     auto view = scn.registry->view<model_component, animation_component, transform_component>();
 
+    pose_cache_.clear();
+
     // this code should be thread safe as each task works with a whole hierarchy and
     // there is no interleaving between tasks.
     std::for_each(std::execution::par,
@@ -165,101 +424,112 @@ void animation_system::on_update(scene& scn, delta_t dt, bool force)
 
                           bool apply_root_motion = animation_comp.get_apply_root_motion();
 
-                          player.update_poses(
-                              model_comp.get_bind_pose(),
-                              [&](const animation_pose::node_desc& desc,
-                                  const math::transform& transform,
-                                  const animation_pose::root_motion_result& motion_result)
+                          auto apply_transform = [&](const animation_pose::node_desc& desc,
+                                                     const math::transform& transform,
+                                                     const animation_pose::root_motion_result& motion_result)
+                          {
+                              if(model_comp.is_compact_skeleton())
                               {
-                                  auto armature = model_comp.get_armature_by_index(desc.index);
-                                  if(armature)
+                                  if(desc.index < model_comp.get_skeleton_node_count())
                                   {
-                                      auto& armature_transform_comp = armature.template get<transform_component>();
-
-                                      bool processed_by_root_motion = false;
+                                      skeleton_node_transform node(model_comp, desc.index, transform_comp);
+                                      apply_node_transform(node,
+                                                           transform_comp,
+                                                           apply_root_motion,
+                                                           desc,
+                                                           transform,
+                                                           motion_result);
+                                  }
+                                  else
+                                  {
+                                      APPLOG_WARNING("Cannot find skeleton node with index {}", desc.index);
+                                  }
+                                  return;
+                              }
 
-                                      if(apply_root_motion && desc.index == motion_result.root_position_node_index)
-                                      {
-                                          armature_transform_comp.set_scale_local(transform.get_scale());
-
-                                          auto position_local = armature_transform_comp.get_position_local();
-                                          auto result_positon_local = math::lerp(position_local,
-                                                                                 transform.get_position(),
-                                                                                 motion_result.bone_position_weights);
-                                          armature_transform_comp.set_position_local(result_positon_local);
-
-                                          math::vec3 delta_translation_logical =
-                                              motion_result.root_transform_delta.get_translation();
-
-                                          // // Apply scaling if needed (for example, if BoneRoot’s scale differs
-                                          // significantly)
-                                          auto scale_global = armature_transform_comp.get_scale_global();
-                                          delta_translation_logical *= scale_global;
-
-                                          // Blend translation as needed:
-                                          auto result_move_local = math::lerp(math::zero<math::vec3>(),
-                                                                              delta_translation_logical,
-                                                                              motion_result.root_position_weights);
-                                          // APPLOG_INFO("position_weights {}", motion_result.position_weights);
-                                          // if(physics_comp_ptr)
-                                          // {
-                                          //     if(math::length2(result_move_local) > 0.0f)
-                                          //     {
-                                          //         auto global_delta =
-                                          //             armature_transform_comp.get_transform_global().transform_normal(
-                                          //                 result_move_local);
-                                          //         auto rm_velocity = global_delta / dt.count();
-                                          //         physics_comp_ptr->set_velocity(rm_velocity);
-                                          //     }
-                                          // }
-                                          // else
-                                          {
-                                              transform_comp.move_by_local(result_move_local);
-                                          }
-                                          processed_by_root_motion = true;
-                                      }
+                              auto armature = model_comp.get_armature_by_index(desc.index);
+                              if(armature)
+                              {
+                                  auto& armature_transform_comp = armature.template get<transform_component>();
+                                  apply_node_transform(armature_transform_comp,
+                                                       transform_comp,
+                                                       apply_root_motion,
+                                                       desc,
+                                                       transform,
+                                                       motion_result);
+
+                                  // if(desc.index == root_motion_entity_index)
+                                  // {
+                                  //     model_comp.update_world_bounds(
+                                  //         armature_transform_comp.get_transform_global());
+                                  // }
+                              }
+                              else
+                              {
+                                  APPLOG_WARNING("Cannot find armature with index {}", desc.index);
+                              }
+                          };
 
-                                      if(apply_root_motion && desc.index == motion_result.root_position_node_index)
-                                      {
-                                          armature_transform_comp.set_scale_local(transform.get_scale());
+                          auto& lod_state = animation_comp.get_lod_state();
+                          auto interval = force ? 1u : get_update_interval(animation_comp, model_comp);
+                          const auto* skipped_nodes = get_skipped_nodes(animation_comp, model_comp);
 
-                                          auto rotation_local = armature_transform_comp.get_rotation_local();
-                                          auto result_rotation_local = math::slerp(rotation_local,
-                                                                                   transform.get_rotation(),
-                                                                                   motion_result.bone_rotation_weight);
-                                          armature_transform_comp.set_rotation_local(result_rotation_local);
+                          animation_pose_sharing sharing;
+                          if(animation_comp.get_pose_sharing_step() > 0.0f)
+                          {
+                              sharing.cache = &pose_cache_;
+                              sharing.step = animation_clip::seconds_t(animation_comp.get_pose_sharing_step());
+                          }
 
-                                          // --- Rotation ---
-                                          math::quat delta_rotation_logical =
-                                              motion_result.root_transform_delta.get_rotation();
+                          if(interval == 1)
+                          {
+                              lod_state.interval = 1;
+                              lod_state.from.clear();
+                              lod_state.to.clear();
 
-                                          // Optionally blend this delta toward identity:
-                                          auto result_rotate_local = math::slerp(math::identity<math::quat>(),
-                                                                                 delta_rotation_logical,
-                                                                                 motion_result.root_rotation_weight);
-                                          transform_comp.rotate_by_local(result_rotate_local);
+                              player.update_poses(model_comp.get_bind_pose(), apply_transform, skipped_nodes, sharing);
+                              return;
+                          }
 
-                                          processed_by_root_motion = true;
-                                      }
+                          // Stagger the evaluations so only a part of the entities is evaluated each frame.
+                          auto stagger = uint64_t(entt::to_integral(entity));
+                          bool evaluate = (frame_index_ + stagger) % interval == 0 ||
+                                          lod_state.interval != interval || lod_state.to.empty();
+                          lod_state.interval = interval;
 
-                                      if(false == processed_by_root_motion)
+                          if(evaluate)
+                          {
+                              // Interpolate from where the nodes are now towards the new pose over the interval.
+                              // Root motion moves the owner and is applied right away.
+                              lod_state.from.clear();
+                              lod_state.to.clear();
+                              lod_state.step = 0;
+
+                              player.update_poses(
+                                  model_comp.get_bind_pose(),
+                                  [&](const animation_pose::node_desc& desc,
+                                      const math::transform& transform,
+                                      const animation_pose::root_motion_result& motion_result)
+                                  {
+                                      if(apply_root_motion && int(desc.index) == motion_result.root_position_node_index)
                                       {
-                                          armature_transform_comp.set_transform_local(transform);
+                                          apply_transform(desc, transform, motion_result);
+                                          return;
                                       }
 
-                                      // if(desc.index == root_motion_entity_index)
-                                      // {
-                                      //     model_comp.update_world_bounds(
-                                      //         armature_transform_comp.get_transform_global());
-                                      // }
-                                  }
-                                  else
-                                  {
-                                      APPLOG_WARNING("Cannot find armature with index {}", desc.index);
-                                  }
-                              });
+                                      lod_state.from.push_back({desc, get_node_local_transform(model_comp, desc.index)});
+                                      lod_state.to.push_back({desc, transform});
+                                  },
+                                  skipped_nodes,
+                                  sharing);
+                          }
+
+                          lod_state.step = std::min(lod_state.step + 1, lod_state.interval);
+                          interpolate_lod_pose(model_comp, lod_state);
                       }
                   });
+
+    ++frame_index_;
 }
 
 void animation_system::on_frame_update(scene& scn, delta_t dt)
@@ -2,6 +2,7 @@
 
 #include <base/basetypes.hpp>
 #include <context/context.hpp>
+#include <engine/animation/animation_pose_cache.h>
 #include <engine/ecs/scene.h>
 #include <hpp/span.hpp>
 
@@ -71,6 +72,11 @@ private:
 
     void on_update(scene& scn, delta_t dt, bool force);
 
+    /// Counts updates to stagger the reduced rate evaluations across entities.
+    uint64_t frame_index_{};
+
+    /// Poses shared by the components playing the same clip at the same time, cleared every update.
+    animation_pose_cache pose_cache_;
 
     std::shared_ptr<int> sentinel_ = std::make_shared<int>(0);
 };
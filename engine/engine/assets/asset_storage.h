@@ -10,6 +10,7 @@
 #include <map>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include <reflection/registration.h>
 
@@ -31,6 +32,7 @@ struct texture_importer_meta : asset_importer_meta
         automatic,
         normal_map,
         equirect,
+        mask,
     };
 
     enum class compression_quality
@@ -83,8 +85,27 @@ struct mesh_importer_meta : asset_importer_meta
         bool split_large_meshes{true};
         bool find_degenerates{true};
         bool find_invalid_data{true};
+        bool optimize_vertex_cache{true};
+        bool optimize_overdraw{true};
+        bool optimize_vertex_fetch{true};
+        bool compress_vertices{false};
+        bool generate_clusters{false};
     } model;
 
+    struct lods_meta
+    {
+        bool generate_lods{false};
+        /// Fraction of the LOD0 triangles kept by each generated level, starting at LOD1.
+        std::vector<float> ratios{0.5f, 0.25f, 0.125f};
+    } lods;
+
+    struct collision_meta
+    {
+        bool generate_collision{false};
+        /// Maximum number of points kept on the baked convex hull.
+        uint32_t hull_vertex_limit{32};
+    } collision;
+
     struct rig_meta
     {
 
@@ -118,6 +139,15 @@ struct animation_importer_meta : asset_importer_meta
         bool keep_in_place{};
 
     } root_motion;
+
+    struct compression_meta
+    {
+        bool compress{true};
+        float position_tolerance{0.0001f};
+        float rotation_tolerance{0.01f};
+        float scaling_tolerance{0.0001f};
+
+    } compression;
 };
 
 /**
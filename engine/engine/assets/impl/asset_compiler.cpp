@@ -1,6 +1,13 @@
 #include "asset_compiler.h"
 #include "asset_writer.h"
+#include "shader_compiler.h"
+#include "importers/mesh_clusterizer.h"
+#include "importers/mesh_collision.h"
 #include "importers/mesh_importer.h"
+#include "importers/mesh_optimizer.h"
+#include "importers/mesh_quantizer.h"
+#include "importers/mesh_simplifier.h"
+#include "importers/texture_importer.h"
 
 #include <bx/error.h>
 #include <bx/process.h>
@@ -15,6 +22,7 @@
 #include <serialization/binary_archive.h>
 
 #include <engine/assets/impl/asset_extensions.h>
+#include <engine/animation/animation_compression.h>
 #include <engine/engine.h>
 #include <engine/settings/settings.h>
 #include <engine/meta/animation/animation.hpp>
@@ -64,32 +72,6 @@ auto escape_str(const std::string& str) -> std::string
     return "\"" + str + "\"";
 }
 
-auto run_process(const std::string& process,
-                 const std::vector<std::string>& args_array,
-                 bool chekc_retcode,
-                 std::string& err) -> bool
-{
-    auto result = subprocess::call(process, args_array);
-    err = result.out_output;
-
-    if(!result.err_output.empty())
-    {
-        if(!err.empty())
-        {
-            err += "\n";
-        }
-
-        err += result.err_output;
-    }
-
-    if(err.find("error") != std::string::npos)
-    {
-        return false;
-    }
-
-    return result.retcode == 0;
-}
-
 void copy_compiled_file(const fs::path& from, const fs::path& to, const std::string& str_input)
 {
     fs::error_code err;
@@ -105,99 +87,11 @@ void copy_compiled_file(const fs::path& from, const fs::path& to, const std::str
     }
 }
 
-auto select_compressed_format(gfx::texture_format input_format,
-                              const fs::path& extension,
-                              texture_importer_meta::compression_quality quality) -> gfx::texture_format
-{
-    if(quality == texture_importer_meta::compression_quality::none)
-    {
-        return gfx::texture_format::Unknown;
-    }
-
-    auto info = gfx::get_format_info(input_format);
-
-    if(extension == ".hdr" || extension == ".exr")
-    {
-        info.is_hdr = true;
-    }
-
-    // 1) HDR? Use BC6H for color data, ignoring alpha (HDR with alpha is non-trivial).
-    if(info.is_hdr)
-    {
-        // BC6H: color (RGB) 16F
-        // No standard BC format for HDR alpha in the block-compression range.
-        return gfx::texture_format::BC6H;
-    }
-
-    // 2) Single channel => BC4
-    //    e.g., for grayscale height map or single-channel mask
-    if(info.num_hannels == 1)
-    {
-        return gfx::texture_format::BC4;
-    }
-
-    // 3) Two channel => BC5
-    //    e.g., typical for 2D vector data, normal map XY
-    if(info.num_hannels == 2)
-    {
-        return gfx::texture_format::BC5;
-    }
-
-    // 4) If we reach here, we have 3 or 4 channels in LDR.
-
-    // 4a) No alpha needed => choose BC1 or BC7, etc.
-    if(!info.has_alpha_channel)
-    {
-        switch(quality)
-        {
-            case texture_importer_meta::compression_quality::low_quality:
-                // BC1 is cheap and has no alpha
-                return gfx::texture_format::BC1;
-            case texture_importer_meta::compression_quality::normal_quality:
-                // BC1 is standard for color w/out alpha
-                return gfx::texture_format::BC1;
-            case texture_importer_meta::compression_quality::high_quality:
-                // BC7 is higher quality for color, also supports alpha but not needed here.
-                // It is also really slow for encoding so don't use it for now.
-                return gfx::texture_format::BC1;
-            default:
-                break;
-        }
-        // fallback
-        return gfx::texture_format::BC1;
-    }
-    else
-    {
-        // 4b) We do have alpha => choose BC2, BC3, or BC7.
-        // BC2 (DXT3) is old and rarely used except for sharp alpha transitions.
-        // BC3 (DXT5) is the typical solution for alpha textures if BC7 is not an option.
-        // BC7 is better (but bigger decode cost).
-        switch(quality)
-        {
-            case texture_importer_meta::compression_quality::low_quality:
-                return gfx::texture_format::BC3;
-            case texture_importer_meta::compression_quality::normal_quality:
-                return gfx::texture_format::BC3; // DXT5
-            case texture_importer_meta::compression_quality::high_quality:
-                //  BC7 is best BC for RGBA
-                // It is also really slow for encoding so don't use it for now.
-                return gfx::texture_format::BC3;
-            default:
-                break;
-        }
-        // fallback
-        return gfx::texture_format::BC3;
-    }
-}
-
 auto compile_texture_to_file(const fs::path& input_path, 
                             const fs::path& output_path,
                             const texture_importer_meta& importer,
                             const std::string& protocol) -> bool
 {
-    std::string str_input = input_path.string();
-    std::string str_output = output_path.string();
-    
     bool try_compress = protocol == "app";
     
     auto quality = importer.quality;
@@ -233,317 +127,69 @@ auto compile_texture_to_file(const fs::path& input_path,
         quality.max_size = texture_importer_meta::texture_size::size_2048;
     }
 
-    auto format =
-        select_compressed_format(gfx::texture_format::RGBA8, input_path.extension(), quality.compression);
-    
-    std::vector<std::string> args_array = {
-        "-f",
-        str_input,
-        "-o",
-        str_output,
-        "--as",
-        "dds",
-    };
-    
-    if(try_compress && format != gfx::texture_format::Unknown)
-    {
-        args_array.emplace_back("-t");
-        args_array.emplace_back(gfx::to_string(format));
-
-        if(format == gfx::texture_format::BC7 || format == gfx::texture_format::BC6H)
-        {
-            APPLOG_INFO("Compressing to {0}. May take a while.", gfx::to_string(format));
-
-            args_array.emplace_back("-q");
-            args_array.emplace_back("fastest");
-        }
-        else if(quality.compression == texture_importer_meta::compression_quality::high_quality)
-        {
-            args_array.emplace_back("-q");
-            args_array.emplace_back("highest");
-        }
-    }
-
-    if(importer.generate_mipmaps)
-    {
-        args_array.emplace_back("-m");
-    }
+    auto resolved = importer;
+    resolved.quality = quality;
 
-    switch(quality.max_size)
-    {
-        case texture_importer_meta::texture_size::project_default:
-        {
-            break;
-        }
-        case texture_importer_meta::texture_size::size_32:
-        {
-            args_array.emplace_back("--max");
-            args_array.emplace_back("32");
-            break;
-        }
-        case texture_importer_meta::texture_size::size_64:
-        {
-            args_array.emplace_back("--max");
-            args_array.emplace_back("64");
-            break;
-        }
-        case texture_importer_meta::texture_size::size_128:
-        {
-            args_array.emplace_back("--max");
-            args_array.emplace_back("128");
-            break;
-        }
-        case texture_importer_meta::texture_size::size_256:
-        {
-            args_array.emplace_back("--max");
-            args_array.emplace_back("256");
-            break;
-        }
-        case texture_importer_meta::texture_size::size_512:
-        {
-            args_array.emplace_back("--max");
-            args_array.emplace_back("512");
-            break;
-        }
-        case texture_importer_meta::texture_size::size_1024:
-        {
-            args_array.emplace_back("--max");
-            args_array.emplace_back("1024");
-            break;
-        }
-        case texture_importer_meta::texture_size::size_2048:
-        {
-            args_array.emplace_back("--max");
-            args_array.emplace_back("2048");
-            break;
-        }
-        case texture_importer_meta::texture_size::size_4096:
-        {
-            args_array.emplace_back("--max");
-            args_array.emplace_back("4096");
-            break;
-        }
-        case texture_importer_meta::texture_size::size_8192:
-        {
-            args_array.emplace_back("--max");
-            args_array.emplace_back("8192");
-            break;
-        }
-        case texture_importer_meta::texture_size::size_16384:
-        {
-            args_array.emplace_back("--max");
-            args_array.emplace_back("16384");
-            break;
-        }
-    }
-
-    switch(importer.type)
-    {
-        case texture_importer_meta::texture_type::equirect:
-        {
-            args_array.emplace_back("--equirect");
-            break;
-        }
-
-        case texture_importer_meta::texture_type::normal_map:
-        {
-            args_array.emplace_back("--normalmap");
-            break;
-        }
-
-        default:
-            break;
-    }
-
-    std::string error;
-    
-    // Create an empty file at the output location so the process can write to it
-    {
-        std::ofstream output_file(str_output);
-        (void)output_file;
-    }
-    
-    auto texturec = fs::resolve_protocol("binary:/texturec");
-    
-    // Run the texture compiler directly to the temporary output location
-    if(!run_process(texturec.string(), args_array, false, error))
-    {
-        APPLOG_ERROR("Failed compilation of {0} with error: {1}", str_input, error);
-        return false;
-    }
-    
-    return true;
+    return unravel::importer::compile_texture_to_file(input_path, output_path, resolved, try_compress);
 }
 
-auto compile_shader_to_file(const fs::path& input_path, 
-                           const fs::path& output_path,
-                           gfx::renderer_type renderer) -> bool
+auto get_shader_cache_directory(const fs::path& key) -> fs::path
 {
-    std::string str_input = input_path.string();
-    std::string str_output = output_path.string();
-    
-    std::string file = input_path.stem().string();
-    fs::path dir = input_path.parent_path();
-
-    fs::path include = fs::resolve_protocol("engine:/data/shaders");
-    std::string str_include = include.string();
-    
-    fs::path varying = dir / (file + ".io");
-
-    fs::error_code err;
-    if(!fs::exists(varying, err))
-    {
-        varying = dir / "varying.def.io";
-    }
-    if(!fs::exists(varying, err))
-    {
-        varying = dir / "varying.def.sc";
-    }
-    
-    std::string str_varying = varying.string();
-    
-    std::string str_platform;
-    std::string str_profile;
-    std::string str_type;
-    std::string str_opt = "3";
+    auto protocol = fs::extract_protocol(fs::convert_to_protocol(key)).generic_string();
+    return fs::resolve_protocol(ex::get_shader_cache_directory(protocol));
+}
 
-    bool vs = hpp::string_view(file).starts_with("vs_");
-    bool fs = hpp::string_view(file).starts_with("fs_");
-    bool cs = hpp::string_view(file).starts_with("cs_");
+} // namespace
 
-    if(renderer == gfx::renderer_type::Vulkan)
-    {
-        str_platform = "windows";
-        str_profile = "spirv";
-    }
+auto run_process(const std::string& process,
+                 const std::vector<std::string>& args_array,
+                 bool check_retcode,
+                 std::string& err) -> bool
+{
+    auto result = subprocess::call(process, args_array);
+    err = result.out_output;
 
-    if(renderer == gfx::renderer_type::Direct3D11 || renderer == gfx::renderer_type::Direct3D12)
+    if(!result.err_output.empty())
     {
-        str_platform = "windows";
-
-        if(vs || fs)
-        {
-            str_profile = "s_5_0";
-            str_opt = "3";
-        }
-        else if(cs)
+        if(!err.empty())
         {
-            str_profile = "s_5_0";
-            str_opt = "1";
+            err += "\n";
         }
-    }
-    else if(renderer == gfx::renderer_type::OpenGLES)
-    {
-        str_platform = "android";
-        str_profile = "100_es";
-    }
-    else if(renderer == gfx::renderer_type::OpenGL)
-    {
-        str_platform = "linux";
 
-        if(vs || fs)
-            str_profile = "140";
-        else if(cs)
-            str_profile = "430";
-    }
-    else if(renderer == gfx::renderer_type::Metal)
-    {
-        str_platform = "osx";
-        str_profile = "metal";
-    }
-
-    if(vs)
-        str_type = "vertex";
-    else if(fs)
-        str_type = "fragment";
-    else if(cs)
-        str_type = "compute";
-    else
-        str_type = "unknown";
-
-    std::vector<std::string> args_array = {
-        "-f",
-        str_input,
-        "-o",
-        str_output,
-        "-i",
-        str_include,
-        "--varyingdef",
-        str_varying,
-        "--type",
-        str_type,
-        "--define",
-        "BGFX_CONFIG_MAX_BONES=" + std::to_string(gfx::get_max_blend_transforms())
-        //        "--Werror"
-    };
-
-    if(!str_platform.empty())
-    {
-        args_array.emplace_back("--platform");
-        args_array.emplace_back(str_platform);
-    }
-
-    if(!str_profile.empty())
-    {
-        args_array.emplace_back("-p");
-        args_array.emplace_back(str_profile);
-    }
-
-    if(!str_opt.empty())
-    {
-        args_array.emplace_back("-O");
-        args_array.emplace_back(str_opt);
-    }
-
-    std::string error;
-
-    // Create an empty file at the output location
-    {
-        std::ofstream output_file(str_output);
-        (void)output_file;
+        err += result.err_output;
     }
 
-    auto shaderc = fs::resolve_protocol("binary:/shaderc");
-
-    if(!run_process(shaderc.string(), args_array, true, error))
+    if(err.find("error") != std::string::npos)
     {
-        APPLOG_ERROR("Failed compilation of {0} -> {1} with error: {2}", str_input, output_path.filename().string(), error);
         return false;
     }
-    
-    return true;
-}
 
-} // namespace
+    return !check_retcode || result.retcode == 0;
+}
 
 template<>
 auto compile<gfx::shader>(asset_manager& am, const fs::path& key, const fs::path& output, uint32_t flags) -> bool
+{
+    return compile_shader_variants(am, key, {output}, flags);
+}
+
+auto compile_shader_variants(asset_manager& am,
+                             const fs::path& key,
+                             const std::vector<fs::path>& outputs,
+                             uint32_t flags) -> bool
 {
     auto absolute_path = resolve_input_file(key);
-    std::string str_input = absolute_path.string();
-    
-    auto extension = output.extension();
-    auto renderer = gfx::get_renderer_based_on_filename_extension(extension.string());
-    
-    fs::error_code err;
-    // Use atomic_write_file to handle the temporary file creation and atomic rename
-    asset_writer::atomic_write_file(output, [&](const fs::path& temp_output) 
-    {
-        return compile_shader_to_file(
-            absolute_path,
-            temp_output,
-            renderer
-        );
-    }, err);
-    
-    if(err)
+
+    std::vector<shader_compiler::variant> variants;
+    variants.reserve(outputs.size());
+    for(const auto& output : outputs)
     {
-        APPLOG_ERROR("Failed compilation of {0} -> {1} with error: {2}", 
-            str_input, output.filename().string(), err.message());
-        return false;
+        auto extension = output.extension();
+        auto renderer = gfx::get_renderer_based_on_filename_extension(extension.string());
+        variants.emplace_back(shader_compiler::variant{output, renderer});
     }
-    
-    return true;
+
+    return shader_compiler::compile(absolute_path, variants, get_shader_cache_directory(key));
 }
 
 template<>
@@ -661,6 +307,13 @@ auto read_importer<mesh>(asset_manager& am, const fs::path& key) -> std::shared_
 template<>
 auto compile<mesh>(asset_manager& am, const fs::path& key, const fs::path& output, uint32_t flags) -> bool
 {
+    // Native meshes (e.g. generated LODs) are already stored in the compiled format.
+    if(resolve_input_file(key).extension() == ex::get_format<mesh>())
+    {
+        fs::error_code err;
+        return asset_writer::atomic_copy_file(resolve_input_file(key), output, err);
+    }
+
     // Try to import first.
     auto base_importer = read_importer<mesh>(am, key);
 
@@ -690,14 +343,103 @@ auto compile<mesh>(asset_manager& am, const fs::path& key, const fs::path& outpu
         APPLOG_ERROR("Failed compilation of {0}", str_input);
         return false;
     }
+
+    unravel::importer::mesh_optimize_options optimize_options;
+    optimize_options.vertex_cache = importer->model.optimize_vertex_cache;
+    optimize_options.overdraw = importer->model.optimize_overdraw;
+    optimize_options.vertex_fetch = importer->model.optimize_vertex_fetch;
+
+    // Clusters keep the triangle order they are built in, so only the vertices get reordered after.
+    unravel::importer::mesh_optimize_options fetch_options;
+    fetch_options.vertex_cache = false;
+    fetch_options.overdraw = false;
+    fetch_options.vertex_fetch = importer->model.optimize_vertex_fetch;
+
+    auto build_clusters = [&](mesh::load_data& mesh_data)
+    {
+        if(importer->model.generate_clusters)
+        {
+            unravel::importer::build_clusters(mesh_data);
+            unravel::importer::optimize_mesh(mesh_data, fetch_options);
+        }
+    };
+
+    std::vector<mesh::load_data> lods;
     if(!data.vertex_data.empty())
     {
+        auto before = unravel::importer::analyze_vertex_cache(data);
+        unravel::importer::optimize_mesh(data, optimize_options);
+        auto after = unravel::importer::analyze_vertex_cache(data);
+
+        for(size_t i = 0; i < after.size(); ++i)
+        {
+            APPLOG_INFO("Mesh Importer: {} submesh {} ({} triangles) ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}",
+                        str_input,
+                        i,
+                        data.submeshes[i].face_count,
+                        before[i].acmr,
+                        after[i].acmr,
+                        before[i].atvr,
+                        after[i].atvr);
+        }
+
+        // Levels are simplified from the full precision vertices.
+        if(importer->lods.generate_lods)
+        {
+            lods = unravel::importer::generate_mesh_lods(data, importer->lods.ratios);
+        }
+
+        // Colliders use the full mesh, so only the main mesh carries the baked collision.
+        if(importer->collision.generate_collision)
+        {
+            unravel::importer::bake_collision(data, importer->collision.hull_vertex_limit);
+        }
+
+        build_clusters(data);
+
+        if(importer->model.compress_vertices)
+        {
+            unravel::importer::quantize_vertices(data);
+        }
+
         asset_writer::atomic_write_file(output, [&](const fs::path& temp) 
         {
             save_to_file_bin(temp.string(), data);
         }, err);
     }
 
+    {
+        // Generated LODs are written next to the source as native meshes so they get
+        // imported as regular mesh assets.
+        for(size_t i = 0; i < lods.size(); ++i)
+        {
+            unravel::importer::optimize_mesh(lods[i], optimize_options);
+            build_clusters(lods[i]);
+            if(importer->model.compress_vertices)
+            {
+                unravel::importer::quantize_vertices(lods[i]);
+            }
+
+            fs::path lod_output = ex::get_mesh_lod_key(absolute_path.string(), i + 1);
+
+            asset_writer::atomic_write_file(lod_output, [&](const fs::path& temp)
+            {
+                save_to_file_bin(temp.string(), lods[i]);
+            }, err);
+        }
+
+        // Remove levels left over from a previous import with more of them.
+        for(size_t lod = lods.size() + 1;; ++lod)
+        {
+            fs::path stale = ex::get_mesh_lod_key(absolute_path.string(), lod);
+            if(!fs::exists(stale, err))
+            {
+                break;
+            }
+            fs::remove(stale, err);
+        }
+    }
+
     {
         for(const auto& animation : animations)
         {
@@ -799,6 +541,29 @@ auto compile<animation_clip>(asset_manager& am, const fs::path& key, const fs::p
         anim.root_motion.keep_rotation = importer->root_motion.keep_rotation;
         anim.root_motion.keep_in_place = importer->root_motion.keep_in_place;
 
+        if(importer->compression.compress)
+        {
+            animation_compression_settings settings;
+            settings.position_tolerance = importer->compression.position_tolerance;
+            settings.rotation_tolerance = importer->compression.rotation_tolerance;
+            settings.scaling_tolerance = importer->compression.scaling_tolerance;
+
+            auto stats = compress_animation(anim, settings);
+            if(stats.compressed_size > 0)
+            {
+                APPLOG_INFO("Animation Importer: {} {} -> {} bytes ({:.1f}x), {} -> {} keys, max error {:.6f} / {:.4f} deg / {:.6f}",
+                            str_input,
+                            stats.raw_size,
+                            stats.compressed_size,
+                            float(stats.raw_size) / float(stats.compressed_size),
+                            stats.raw_keys,
+                            stats.compressed_keys,
+                            stats.max_position_error,
+                            stats.max_rotation_error,
+                            stats.max_scaling_error);
+            }
+        }
+
         fs::error_code err;
         asset_writer::atomic_write_file(output, [&](const fs::path& temp) 
         {
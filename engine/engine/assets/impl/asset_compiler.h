@@ -13,6 +13,30 @@ auto compile(asset_manager& am, const fs::path& key, const fs::path& output_key,
 template<typename T>
 auto read_importer(asset_manager& am, const fs::path& key) -> std::shared_ptr<asset_importer_meta>;
 
+/**
+ * @brief Compiles a shader for several renderers at once.
+ *
+ * Outputs that resolve to the same preprocessed source and target are compiled once and
+ * previously compiled bytecode is reused from the shader cache.
+ */
+auto compile_shader_variants(asset_manager& am,
+                             const fs::path& key,
+                             const std::vector<fs::path>& outputs,
+                             uint32_t flags = 0) -> bool;
+
+/**
+ * @brief Runs an external tool and waits for it to finish.
+ * @param process The tool to run.
+ * @param args_array The arguments passed to the tool.
+ * @param check_retcode Whether a non zero exit code counts as a failure.
+ * @param err Receives everything the tool printed.
+ * @return True if the tool succeeded and printed no errors.
+ */
+auto run_process(const std::string& process,
+                 const std::vector<std::string>& args_array,
+                 bool check_retcode,
+                 std::string& err) -> bool;
+
 
 } // namespace asset_compiler
 
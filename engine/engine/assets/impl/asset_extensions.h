@@ -182,6 +182,21 @@ inline auto get_meta_format() -> const std::string&
 }
 
 
+/// Key of a level of detail generated for a mesh, e.g. "app:/data/house.fbx" -> "app:/data/house_LOD1.emesh".
+inline auto get_mesh_lod_key(const std::string& key, size_t lod) -> std::string
+{
+    auto name_start = key.find_last_of("/\\");
+    name_start = name_start == std::string::npos ? 0 : name_start + 1;
+
+    auto extension_start = key.find_last_of('.');
+    if(extension_start == std::string::npos || extension_start < name_start)
+    {
+        extension_start = key.size();
+    }
+
+    return key.substr(0, extension_start) + "_LOD" + std::to_string(lod) + get_format<unravel::mesh>();
+}
+
 inline auto get_meta_directory_no_slash(const std::string& prefix = {}) -> std::string
 {
     return prefix + "data";
@@ -212,6 +227,16 @@ inline auto get_compiled_directory(const std::string& prefix = {}) -> std::strin
     return get_compiled_directory_no_slash(prefix + ":/");
 }
 
+inline auto get_shader_cache_directory_no_slash(const std::string& prefix = {}) -> std::string
+{
+    return get_compiled_directory_no_slash(prefix) + "/.shader_cache";
+}
+
+inline auto get_shader_cache_directory(const std::string& prefix = {}) -> std::string
+{
+    return get_shader_cache_directory_no_slash(prefix + ":/");
+}
+
 
 inline auto get_type(const std::string& ex, bool is_directory = false) -> const std::string&
 {
@@ -0,0 +1,478 @@
+#include "mesh_clusterizer.h"
+
+#include <logging/logging.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+#define POOLSTL_STD_SUPPLEMENT 1
+#include <poolstl/poolstl.hpp>
+
+namespace unravel
+{
+namespace importer
+{
+namespace
+{
+
+constexpr uint32_t invalid_index = std::numeric_limits<uint32_t>::max();
+
+/// Vertex positions with seams welded, so clusters can grow across uv and normal splits.
+struct welded_positions
+{
+    std::vector<math::vec3> positions;
+    std::vector<math::vec3> normals;
+    /// Welded position id of every vertex.
+    std::vector<uint32_t> ids;
+    uint32_t count{};
+};
+
+auto weld_positions(const mesh::load_data& data) -> welded_positions
+{
+    welded_positions result;
+    result.positions.resize(data.vertex_count);
+    result.ids.resize(data.vertex_count);
+
+    const bool has_normal = data.vertex_format.has(gfx::attribute::Normal);
+    if(has_normal)
+    {
+        result.normals.resize(data.vertex_count);
+    }
+
+    struct key_hash
+    {
+        auto operator()(const std::array<uint32_t, 3>& key) const -> size_t
+        {
+            uint64_t h = key[0];
+            h = h * 0x9E3779B97F4A7C15ull ^ key[1];
+            h = h * 0x9E3779B97F4A7C15ull ^ key[2];
+            return size_t(h ^ (h >> 29));
+        }
+    };
+
+    std::unordered_map<std::array<uint32_t, 3>, uint32_t, key_hash> lookup;
+    lookup.reserve(data.vertex_count);
+
+    for(uint32_t v = 0; v < data.vertex_count; ++v)
+    {
+        float value[4];
+        gfx::vertex_unpack(value, gfx::attribute::Position, data.vertex_format, data.vertex_data.data(), v);
+        result.positions[v] = math::vec3(value[0], value[1], value[2]);
+
+        if(has_normal)
+        {
+            gfx::vertex_unpack(value, gfx::attribute::Normal, data.vertex_format, data.vertex_data.data(), v);
+            result.normals[v] = math::vec3(value[0], value[1], value[2]);
+        }
+
+        std::array<uint32_t, 3> key;
+        std::memcpy(key.data(), &result.positions[v], sizeof(key));
+        auto it = lookup.emplace(key, result.count).first;
+        if(it->second == result.count)
+        {
+            result.count++;
+        }
+        result.ids[v] = it->second;
+    }
+
+    return result;
+}
+
+/// Unit face normal facing the same way as the vertex normals, so the cone does not depend on the winding order.
+auto get_face_normal(const welded_positions& welded, const mesh::triangle& tri) -> math::vec3
+{
+    const auto& p0 = welded.positions[tri.indices[0]];
+    const auto& p1 = welded.positions[tri.indices[1]];
+    const auto& p2 = welded.positions[tri.indices[2]];
+
+    auto normal = math::cross(p1 - p0, p2 - p0);
+    float length = math::length(normal);
+    if(length <= std::numeric_limits<float>::epsilon())
+    {
+        return math::vec3(0.0f);
+    }
+    normal /= length;
+
+    if(!welded.normals.empty())
+    {
+        auto vertex_normal = welded.normals[tri.indices[0]] + welded.normals[tri.indices[1]] +
+                             welded.normals[tri.indices[2]];
+        if(math::dot(normal, vertex_normal) < 0.0f)
+        {
+            normal = -normal;
+        }
+    }
+
+    return normal;
+}
+
+struct submesh_clusters
+{
+    std::vector<mesh::triangle> triangles;
+    std::vector<mesh::cluster> clusters;
+};
+
+class cluster_builder
+{
+public:
+    cluster_builder(const mesh::load_data& data,
+                    const welded_positions& welded,
+                    const mesh::submesh& submesh,
+                    uint32_t max_triangles)
+        : data_(data)
+        , welded_(welded)
+        , submesh_(submesh)
+        , max_triangles_(max_triangles)
+    {
+    }
+
+    auto build() -> submesh_clusters
+    {
+        const uint32_t face_count = submesh_.face_count;
+        build_adjacency();
+
+        centroids_.resize(face_count);
+        normals_.resize(face_count);
+        for(uint32_t f = 0; f < face_count; ++f)
+        {
+            const auto& tri = get_triangle(f);
+            centroids_[f] = (welded_.positions[tri.indices[0]] + welded_.positions[tri.indices[1]] +
+                             welded_.positions[tri.indices[2]]) /
+                            3.0f;
+            normals_[f] = get_face_normal(welded_, tri);
+        }
+
+        assigned_.assign(face_count, invalid_index);
+        frontier_stamp_.assign(face_count, invalid_index);
+        vertex_stamp_.assign(vertex_triangles_.size() - 1, invalid_index);
+
+        std::vector<std::vector<uint32_t>> clusters;
+        uint32_t cursor = 0;
+        while(true)
+        {
+            while(cursor < face_count && assigned_[cursor] != invalid_index)
+            {
+                ++cursor;
+            }
+
+            if(cursor == face_count)
+            {
+                break;
+            }
+
+            clusters.emplace_back(grow_cluster(cursor, uint32_t(clusters.size()), cursor));
+        }
+
+        submesh_clusters result;
+        result.triangles.reserve(face_count);
+        result.clusters.reserve(clusters.size());
+        for(auto& members : clusters)
+        {
+            // Keep the order the triangles had, it is already optimized for the vertex cache.
+            std::sort(members.begin(), members.end());
+
+            auto& cluster = result.clusters.emplace_back();
+            cluster.face_start = uint32_t(result.triangles.size());
+            cluster.face_count = uint32_t(members.size());
+            for(auto f : members)
+            {
+                result.triangles.emplace_back(get_triangle(f));
+            }
+
+            compute_bounds(members, cluster);
+        }
+
+        return result;
+    }
+
+private:
+    auto get_triangle(uint32_t f) const -> const mesh::triangle&
+    {
+        return data_.triangle_data[size_t(submesh_.face_start) + f];
+    }
+
+    auto get_local_id(uint32_t vertex) const -> uint32_t
+    {
+        return local_ids_.at(welded_.ids[vertex]);
+    }
+
+    /// Maps the welded positions used by the submesh to local ids and lists the triangles around each.
+    void build_adjacency()
+    {
+        const uint32_t face_count = submesh_.face_count;
+        local_ids_.reserve(size_t(face_count) * 2);
+        for(uint32_t f = 0; f < face_count; ++f)
+        {
+            for(auto vertex : get_triangle(f).indices)
+            {
+                local_ids_.emplace(welded_.ids[vertex], uint32_t(local_ids_.size()));
+            }
+        }
+
+        vertex_triangles_.assign(local_ids_.size() + 1, 0);
+        triangle_vertices_.resize(size_t(face_count) * 3);
+        for(uint32_t f = 0; f < face_count; ++f)
+        {
+            const auto& tri = get_triangle(f);
+            for(uint32_t k = 0; k < 3; ++k)
+            {
+                auto id = get_local_id(tri.indices[k]);
+                triangle_vertices_[f * 3 + k] = id;
+                vertex_triangles_[id + 1]++;
+            }
+        }
+
+        std::partial_sum(vertex_triangles_.begin(), vertex_triangles_.end(), vertex_triangles_.begin());
+
+        triangle_lists_.resize(size_t(face_count) * 3);
+        std::vector<uint32_t> fill(vertex_triangles_.begin(), vertex_triangles_.end() - 1);
+        for(uint32_t f = 0; f < face_count; ++f)
+        {
+            for(uint32_t k = 0; k < 3; ++k)
+            {
+                triangle_lists_[fill[triangle_vertices_[f * 3 + k]]++] = f;
+            }
+        }
+    }
+
+    auto grow_cluster(uint32_t seed, uint32_t cluster_id, uint32_t cursor) -> std::vector<uint32_t>
+    {
+        std::vector<uint32_t> members;
+        members.reserve(max_triangles_);
+        frontier_.clear();
+
+        math::vec3 centroid_sum(0.0f);
+        math::vec3 normal_sum(0.0f);
+        math::bbox bounds;
+
+        auto add = [&](uint32_t f)
+        {
+            assigned_[f] = cluster_id;
+            members.emplace_back(f);
+            centroid_sum += centroids_[f];
+            normal_sum += normals_[f];
+            bounds.add_point(centroids_[f]);
+
+            for(uint32_t k = 0; k < 3; ++k)
+            {
+                auto id = triangle_vertices_[f * 3 + k];
+                vertex_stamp_[id] = cluster_id;
+
+                for(uint32_t i = vertex_triangles_[id]; i < vertex_triangles_[id + 1]; ++i)
+                {
+                    auto neighbour = triangle_lists_[i];
+                    if(assigned_[neighbour] == invalid_index && frontier_stamp_[neighbour] != cluster_id)
+                    {
+                        frontier_stamp_[neighbour] = cluster_id;
+                        frontier_.emplace_back(neighbour);
+                    }
+                }
+            }
+        };
+
+        add(seed);
+
+        while(members.size() < max_triangles_)
+        {
+            const auto center = centroid_sum / float(members.size());
+            const float normal_length = math::length(normal_sum);
+            const auto axis = normal_length > 0.0f ? normal_sum / normal_length : math::vec3(0.0f);
+            const float extent = math::max(math::length(bounds.get_extents()), std::numeric_limits<float>::epsilon());
+
+            uint32_t best = invalid_index;
+            float best_score = std::numeric_limits<float>::max();
+            for(size_t i = 0; i < frontier_.size();)
+            {
+                auto f = frontier_[i];
+                if(assigned_[f] != invalid_index)
+                {
+                    frontier_[i] = frontier_.back();
+                    frontier_.pop_back();
+                    continue;
+                }
+
+                uint32_t new_vertices = 0;
+                for(uint32_t k = 0; k < 3; ++k)
+                {
+                    new_vertices += vertex_stamp_[triangle_vertices_[f * 3 + k]] != cluster_id ? 1 : 0;
+                }
+
+                // Reusing vertices matters most, then staying compact, then keeping the normal cone narrow.
+                float distance = math::length(centroids_[f] - center) / extent;
+                float spread = 1.0f - math::dot(normals_[f], axis);
+                float score = float(new_vertices) + distance * 0.5f + spread;
+                if(score < best_score)
+                {
+                    best_score = score;
+                    best = f;
+                }
+                ++i;
+            }
+
+            if(best == invalid_index)
+            {
+                // Disconnected piece, continue with the next triangle in order if it is nearby.
+                while(cursor < submesh_.face_count && assigned_[cursor] != invalid_index)
+                {
+                    ++cursor;
+                }
+
+                if(cursor == submesh_.face_count || math::length(centroids_[cursor] - center) > extent * 2.0f)
+                {
+                    break;
+                }
+                best = cursor;
+            }
+
+            add(best);
+        }
+
+        return members;
+    }
+
+    void compute_bounds(const std::vector<uint32_t>& members, mesh::cluster& cluster) const
+    {
+        math::bbox bounds;
+        math::vec3 normal_sum(0.0f);
+        for(auto f : members)
+        {
+            for(auto vertex : get_triangle(f).indices)
+            {
+                bounds.add_point(welded_.positions[vertex]);
+            }
+            normal_sum += normals_[f];
+        }
+
+        cluster.center = bounds.get_center();
+        cluster.radius = 0.0f;
+        for(auto f : members)
+        {
+            for(auto vertex : get_triangle(f).indices)
+            {
+                cluster.radius = math::max(cluster.radius, math::length(welded_.positions[vertex] - cluster.center));
+            }
+        }
+
+        cluster.cone_axis = math::vec3(0.0f, 0.0f, 1.0f);
+        cluster.cone_cutoff = 1.0f;
+
+        float normal_length = math::length(normal_sum);
+        if(normal_length <= std::numeric_limits<float>::epsilon())
+        {
+            return;
+        }
+
+        auto axis = normal_sum / normal_length;
+        float min_dot = 1.0f;
+        for(auto f : members)
+        {
+            if(math::dot(normals_[f], normals_[f]) > 0.0f)
+            {
+                min_dot = math::min(min_dot, math::dot(normals_[f], axis));
+            }
+        }
+
+        // Cones wider than a hemisphere (with some margin) can always be seen from somewhere.
+        if(min_dot <= 0.1f)
+        {
+            return;
+        }
+
+        cluster.cone_axis = axis;
+        cluster.cone_cutoff = math::sqrt(1.0f - min_dot * min_dot);
+    }
+
+    const mesh::load_data& data_;
+    const welded_positions& welded_;
+    const mesh::submesh& submesh_;
+    uint32_t max_triangles_{};
+
+    std::unordered_map<uint32_t, uint32_t> local_ids_;
+    std::vector<uint32_t> triangle_vertices_;
+    std::vector<uint32_t> vertex_triangles_;
+    std::vector<uint32_t> triangle_lists_;
+
+    std::vector<math::vec3> centroids_;
+    std::vector<math::vec3> normals_;
+    std::vector<uint32_t> assigned_;
+    std::vector<uint32_t> frontier_stamp_;
+    std::vector<uint32_t> vertex_stamp_;
+    std::vector<uint32_t> frontier_;
+};
+
+auto should_split(const mesh::load_data& data, const mesh::submesh& submesh, uint32_t max_triangles) -> bool
+{
+    return !submesh.skinned && submesh.face_start >= 0 && submesh.face_count >= max_triangles * 2 &&
+           size_t(submesh.face_start) + submesh.face_count <= data.triangle_data.size();
+}
+
+} // namespace
+
+void build_clusters(mesh::load_data& data, uint32_t max_triangles)
+{
+    APPLOG_TRACE_PERF_NAMED(std::chrono::milliseconds, "Mesh Importer: Build Clusters");
+
+    data.clusters.clear();
+
+    if(max_triangles == 0 || data.vertex_count == 0 || !data.vertex_format.has(gfx::attribute::Position))
+    {
+        return;
+    }
+
+    std::vector<uint32_t> split;
+    for(uint32_t i = 0; i < uint32_t(data.submeshes.size()); ++i)
+    {
+        if(should_split(data, data.submeshes[i], max_triangles))
+        {
+            split.emplace_back(i);
+        }
+    }
+
+    if(split.empty())
+    {
+        return;
+    }
+
+    auto welded = weld_positions(data);
+
+    std::vector<submesh_clusters> results(split.size());
+    std::vector<size_t> jobs(split.size());
+    std::iota(jobs.begin(), jobs.end(), size_t(0));
+    std::for_each(std::execution::par,
+                  jobs.begin(),
+                  jobs.end(),
+                  [&](size_t job)
+                  {
+                      const auto& submesh = data.submeshes[split[job]];
+                      cluster_builder builder(data, welded, submesh, max_triangles);
+                      results[job] = builder.build();
+                  });
+
+    // Submeshes own disjoint ranges of triangles.
+    for(size_t job = 0; job < split.size(); ++job)
+    {
+        const auto submesh_index = split[job];
+        const auto& submesh = data.submeshes[submesh_index];
+        auto& result = results[job];
+
+        std::copy(result.triangles.begin(),
+                  result.triangles.end(),
+                  data.triangle_data.begin() + submesh.face_start);
+
+        for(auto& cluster : result.clusters)
+        {
+            cluster.submesh_index = submesh_index;
+            cluster.face_start += uint32_t(submesh.face_start);
+            data.clusters.emplace_back(cluster);
+        }
+
+        APPLOG_TRACE("Mesh Importer: submesh {} split into {} clusters", submesh_index, result.clusters.size());
+    }
+}
+
+} // namespace importer
+} // namespace unravel
@@ -0,0 +1,25 @@
+#pragma once
+#include <engine/rendering/mesh.h>
+
+namespace unravel
+{
+namespace importer
+{
+
+/**
+ * @brief Splits the large submeshes of a mesh into clusters that can be culled on their own.
+ *
+ * Clusters are grown greedily from a seed triangle over shared positions, preferring triangles
+ * that add few new vertices and stay close to the cluster center and normal, so they end up
+ * compact and mostly facing one way. Triangles of every submesh are reordered so each cluster is
+ * a contiguous range of the index buffer, keeping their previous relative order. Each cluster gets
+ * a bounding sphere and a normal cone (see mesh::cluster). Skinned submeshes and submeshes with
+ * fewer than twice 'max_triangles' faces are left whole. Submeshes are processed in parallel.
+ *
+ * @param data The mesh to split. The clusters are written to data.clusters.
+ * @param max_triangles Maximum number of triangles per cluster.
+ */
+void build_clusters(mesh::load_data& data, uint32_t max_triangles = 128);
+
+} // namespace importer
+} // namespace unravel
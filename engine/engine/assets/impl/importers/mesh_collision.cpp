@@ -0,0 +1,195 @@
+#include "mesh_collision.h"
+
+#include <BulletCollision/CollisionShapes/btOptimizedBvh.h>
+#include <BulletCollision/CollisionShapes/btTriangleIndexVertexArray.h>
+#include <LinearMath/btAlignedAllocator.h>
+#include <LinearMath/btConvexHullComputer.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+namespace unravel
+{
+namespace importer
+{
+namespace
+{
+
+auto weld_collision_positions(const mesh::load_data& data, mesh::collision_data& collision) -> std::vector<uint32_t>
+{
+    struct key_hash
+    {
+        auto operator()(const std::array<uint32_t, 3>& key) const -> size_t
+        {
+            uint64_t h = key[0];
+            h = h * 0x9E3779B97F4A7C15ull ^ key[1];
+            h = h * 0x9E3779B97F4A7C15ull ^ key[2];
+            return size_t(h ^ (h >> 29));
+        }
+    };
+
+    std::vector<uint32_t> ids(data.vertex_count);
+    std::unordered_map<std::array<uint32_t, 3>, uint32_t, key_hash> lookup;
+    lookup.reserve(data.vertex_count);
+
+    for(uint32_t v = 0; v < data.vertex_count; ++v)
+    {
+        float value[4];
+        gfx::vertex_unpack(value, gfx::attribute::Position, data.vertex_format, data.vertex_data.data(), v);
+        math::vec3 position(value[0], value[1], value[2]);
+
+        std::array<uint32_t, 3> key;
+        std::memcpy(key.data(), &position, sizeof(key));
+        auto it = lookup.emplace(key, uint32_t(collision.vertices.size())).first;
+        if(it->second == collision.vertices.size())
+        {
+            collision.vertices.emplace_back(position);
+        }
+        ids[v] = it->second;
+    }
+
+    return ids;
+}
+
+auto compute_hull(const std::vector<math::vec3>& points) -> std::vector<math::vec3>
+{
+    btConvexHullComputer computer;
+    if(computer.compute(&points[0].x, int(sizeof(math::vec3)), int(points.size()), 0.0f, 0.0f) < 0.0f)
+    {
+        return {};
+    }
+
+    std::vector<math::vec3> hull;
+    hull.reserve(computer.vertices.size());
+    for(int i = 0; i < computer.vertices.size(); ++i)
+    {
+        const auto& v = computer.vertices[i];
+        hull.emplace_back(v.x(), v.y(), v.z());
+    }
+    return hull;
+}
+
+/// Keeps the hull points furthest along 'limit' directions spread evenly over the sphere.
+auto reduce_hull(const std::vector<math::vec3>& hull, uint32_t limit) -> std::vector<math::vec3>
+{
+    const float golden_angle = math::pi<float>() * (3.0f - math::sqrt(5.0f));
+
+    std::vector<uint32_t> picked;
+    picked.reserve(limit);
+    for(uint32_t d = 0; d < limit; ++d)
+    {
+        float y = 1.0f - 2.0f * (float(d) + 0.5f) / float(limit);
+        float radius = math::sqrt(1.0f - y * y);
+        float angle = golden_angle * float(d);
+        math::vec3 direction(math::cos(angle) * radius, y, math::sin(angle) * radius);
+
+        uint32_t best = 0;
+        float best_distance = std::numeric_limits<float>::lowest();
+        for(uint32_t i = 0; i < hull.size(); ++i)
+        {
+            float distance = math::dot(hull[i], direction);
+            if(distance > best_distance)
+            {
+                best_distance = distance;
+                best = i;
+            }
+        }
+        picked.emplace_back(best);
+    }
+
+    std::sort(picked.begin(), picked.end());
+    picked.erase(std::unique(picked.begin(), picked.end()), picked.end());
+
+    std::vector<math::vec3> result;
+    result.reserve(picked.size());
+    for(auto i : picked)
+    {
+        result.emplace_back(hull[i]);
+    }
+    return result;
+}
+
+/// Builds the bvh the same way btBvhTriangleMeshShape does, so the runtime can use it as is.
+auto build_bvh(mesh::collision_data& collision) -> std::vector<uint8_t>
+{
+    btTriangleIndexVertexArray triangles(int(collision.indices.size() / 3),
+                                         reinterpret_cast<int*>(collision.indices.data()),
+                                         int(3 * sizeof(uint32_t)),
+                                         int(collision.vertices.size()),
+                                         &collision.vertices[0].x,
+                                         int(sizeof(math::vec3)));
+
+    btVector3 aabb_min;
+    btVector3 aabb_max;
+    triangles.calculateAabbBruteForce(aabb_min, aabb_max);
+
+    btOptimizedBvh bvh;
+    bvh.build(&triangles, true, aabb_min, aabb_max);
+
+    // Serializing in place needs a 16 byte aligned buffer.
+    unsigned size = bvh.calculateSerializeBufferSize();
+    void* buffer = btAlignedAlloc(size, 16);
+    std::vector<uint8_t> result;
+    if(bvh.serializeInPlace(buffer, size, false))
+    {
+        result.assign(static_cast<const uint8_t*>(buffer), static_cast<const uint8_t*>(buffer) + size);
+    }
+    btAlignedFree(buffer);
+
+    return result;
+}
+
+} // namespace
+
+void bake_collision(mesh::load_data& data, uint32_t hull_vertex_limit)
+{
+    mesh::collision_data collision;
+    if(data.vertex_count == 0)
+    {
+        data.collision = {};
+        return;
+    }
+
+    auto ids = weld_collision_positions(data, collision);
+
+    collision.indices.reserve(data.triangle_data.size() * 3);
+    for(const auto& tri : data.triangle_data)
+    {
+        uint32_t i0 = ids[tri.indices[0]];
+        uint32_t i1 = ids[tri.indices[1]];
+        uint32_t i2 = ids[tri.indices[2]];
+        if(i0 == i1 || i1 == i2 || i0 == i2)
+        {
+            continue;
+        }
+
+        const auto& p0 = collision.vertices[i0];
+        auto normal = math::cross(collision.vertices[i1] - p0, collision.vertices[i2] - p0);
+        if(math::length2(normal) <= std::numeric_limits<float>::epsilon())
+        {
+            continue;
+        }
+
+        collision.indices.insert(collision.indices.end(), {i0, i1, i2});
+    }
+
+    if(!collision.indices.empty())
+    {
+        collision.bvh = build_bvh(collision);
+    }
+
+    collision.hull = compute_hull(collision.vertices);
+    hull_vertex_limit = std::max(hull_vertex_limit, 4u);
+    if(collision.hull.size() > hull_vertex_limit)
+    {
+        collision.hull = reduce_hull(collision.hull, hull_vertex_limit);
+    }
+
+    data.collision = std::move(collision);
+}
+
+} // namespace importer
+} // namespace unravel
@@ -0,0 +1,25 @@
+#pragma once
+#include <engine/rendering/mesh.h>
+
+namespace unravel
+{
+namespace importer
+{
+
+/**
+ * @brief Bakes the collision geometry of a mesh used by mesh colliders.
+ *
+ * Positions are welded across uv and normal seams and degenerate triangles are dropped, giving
+ * the triangle mesh the physics backend builds its static bvh from. The convex hull of the welded
+ * positions is computed and, when it has more points than 'hull_vertex_limit', reduced to its
+ * extreme points along evenly spread directions so dynamic bodies get a cheap convex shape.
+ * The quantized bvh of the triangle mesh is built and serialized here as well, so loading a mesh
+ * collider doesn't have to build it. Must run before the vertices are quantized.
+ *
+ * @param data The mesh to bake. The result is written to data.collision.
+ * @param hull_vertex_limit Maximum number of points kept on the convex hull.
+ */
+void bake_collision(mesh::load_data& data, uint32_t hull_vertex_limit = 32);
+
+} // namespace importer
+} // namespace unravel
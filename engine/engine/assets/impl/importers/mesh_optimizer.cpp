@@ -0,0 +1,562 @@
+#include "mesh_optimizer.h"
+
+#include <logging/logging.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <numeric>
+
+#define POOLSTL_STD_SUPPLEMENT 1
+#include <poolstl/poolstl.hpp>
+
+namespace unravel
+{
+namespace importer
+{
+namespace
+{
+
+constexpr uint32_t invalid_index = std::numeric_limits<uint32_t>::max();
+constexpr uint32_t optimizer_cache_size = 16;
+
+/// FIFO cache simulation. A vertex is in the cache while fewer than 'size' misses happened since its own.
+struct fifo_cache
+{
+    std::vector<uint32_t> timestamps;
+    uint32_t time{};
+    uint32_t size{};
+
+    fifo_cache(uint32_t vertex_count, uint32_t cache_entries)
+        : timestamps(vertex_count, 0)
+        , time(cache_entries + 1)
+        , size(cache_entries)
+    {
+    }
+
+    /// Forgets every cached vertex.
+    void flush()
+    {
+        time += size + 1;
+    }
+
+    /// Returns the number of misses caused by the triangle.
+    auto add(const uint32_t* tri) -> uint32_t
+    {
+        uint32_t misses = 0;
+        for(uint32_t i = 0; i < 3; ++i)
+        {
+            auto& stamp = timestamps[tri[i]];
+            if(time - stamp > size)
+            {
+                stamp = time++;
+                misses++;
+            }
+        }
+        return misses;
+    }
+};
+
+/**
+ * @brief Orders triangles for the post transform cache (Sander et al, "Fast Triangle Reordering
+ * for Vertex Locality and Reduced Overdraw").
+ *
+ * Triangles are emitted by fanning around a vertex, the next fanning vertex is the one among the
+ * vertices just emitted that will still be in the cache after its remaining triangles are emitted.
+ *
+ * @return The new order of the triangles.
+ */
+auto order_for_vertex_cache(const std::vector<uint32_t>& indices, uint32_t vertex_count) -> std::vector<uint32_t>
+{
+    const auto face_count = uint32_t(indices.size() / 3);
+
+    // Triangles using each vertex.
+    std::vector<uint32_t> offsets(vertex_count + 1, 0);
+    for(auto index : indices)
+    {
+        offsets[index + 1]++;
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    std::vector<uint32_t> adjacency(indices.size());
+    {
+        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for(size_t i = 0; i < indices.size(); ++i)
+        {
+            adjacency[fill[indices[i]]++] = uint32_t(i / 3);
+        }
+    }
+
+    std::vector<uint32_t> live(vertex_count);
+    for(uint32_t v = 0; v < vertex_count; ++v)
+    {
+        live[v] = offsets[v + 1] - offsets[v];
+    }
+
+    std::vector<uint32_t> timestamps(vertex_count, 0);
+    std::vector<uint8_t> emitted(face_count, 0);
+    std::vector<uint32_t> dead_end;
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> order;
+    dead_end.reserve(indices.size());
+    order.reserve(face_count);
+
+    uint32_t time = optimizer_cache_size + 1;
+    uint32_t cursor = 0;
+    uint32_t fanning = 0;
+
+    while(fanning != invalid_index)
+    {
+        candidates.clear();
+
+        for(uint32_t k = offsets[fanning]; k < offsets[fanning + 1]; ++k)
+        {
+            auto face = adjacency[k];
+            if(emitted[face])
+            {
+                continue;
+            }
+            emitted[face] = 1;
+            order.emplace_back(face);
+
+            for(uint32_t j = 0; j < 3; ++j)
+            {
+                auto v = indices[face * 3 + j];
+                dead_end.emplace_back(v);
+                candidates.emplace_back(v);
+                live[v]--;
+
+                if(time - timestamps[v] > optimizer_cache_size)
+                {
+                    timestamps[v] = time++;
+                }
+            }
+        }
+
+        // Prefer the oldest candidate that stays in the cache while its fan is emitted.
+        fanning = invalid_index;
+        int64_t best_priority = -1;
+        for(auto v : candidates)
+        {
+            if(live[v] == 0)
+            {
+                continue;
+            }
+
+            int64_t priority = 0;
+            if(time - timestamps[v] + 2 * live[v] <= optimizer_cache_size)
+            {
+                priority = time - timestamps[v];
+            }
+
+            if(priority > best_priority)
+            {
+                best_priority = priority;
+                fanning = v;
+            }
+        }
+
+        // Dead end, go back to a recently used vertex or to the next unfinished one.
+        while(fanning == invalid_index && !dead_end.empty())
+        {
+            auto v = dead_end.back();
+            dead_end.pop_back();
+            if(live[v] > 0)
+            {
+                fanning = v;
+            }
+        }
+
+        while(fanning == invalid_index && cursor < vertex_count)
+        {
+            if(live[cursor] > 0)
+            {
+                fanning = cursor;
+            }
+            cursor++;
+        }
+    }
+
+    return order;
+}
+
+/**
+ * @brief Sorts clusters of cache ordered triangles to reduce overdraw from any view direction.
+ *
+ * Clusters start where the cache order jumps to a disjoint patch, and are split further while
+ * their ACMR stays within 'threshold' of the whole patch. Clusters whose normal points away from
+ * the mesh centroid are likely to occlude the others so they are drawn first.
+ *
+ * @return The new order of the triangles.
+ */
+auto order_for_overdraw(const std::vector<uint32_t>& indices,
+                        const std::vector<math::vec3>& positions,
+                        float threshold) -> std::vector<uint32_t>
+{
+    const auto face_count = uint32_t(indices.size() / 3);
+    fifo_cache cache(uint32_t(positions.size()), optimizer_cache_size);
+
+    // Hard boundaries, all three vertices of the triangle miss the cache.
+    std::vector<uint32_t> patches;
+    for(uint32_t i = 0; i < face_count; ++i)
+    {
+        if(cache.add(&indices[i * 3]) == 3 || i == 0)
+        {
+            patches.emplace_back(i);
+        }
+    }
+
+    // Soft boundaries, split a patch as soon as the running ACMR is good enough.
+    std::vector<uint32_t> clusters;
+    for(size_t p = 0; p < patches.size(); ++p)
+    {
+        auto start = patches[p];
+        auto end = p + 1 < patches.size() ? patches[p + 1] : face_count;
+
+        cache.flush();
+        uint32_t patch_misses = 0;
+        for(auto i = start; i < end; ++i)
+        {
+            patch_misses += cache.add(&indices[i * 3]);
+        }
+        const float target = threshold * float(patch_misses) / float(end - start);
+
+        const auto first = clusters.size();
+        clusters.emplace_back(start);
+
+        cache.flush();
+        uint32_t misses = 0;
+        uint32_t faces = 0;
+        for(auto i = start; i < end; ++i)
+        {
+            misses += cache.add(&indices[i * 3]);
+            faces++;
+
+            if(float(misses) / float(faces) <= target)
+            {
+                clusters.emplace_back(i + 1);
+                cache.flush();
+                misses = 0;
+                faces = 0;
+            }
+        }
+
+        // The last boundary may be the end of the patch, or leave a tail with a poor ACMR.
+        // Either way it belongs to the previous cluster.
+        if(clusters.size() > first + 1 && (clusters.back() == end || faces > 0))
+        {
+            clusters.pop_back();
+        }
+    }
+
+    math::vec3 mesh_centroid{};
+    for(auto index : indices)
+    {
+        mesh_centroid += positions[index];
+    }
+    mesh_centroid /= float(indices.size());
+
+    std::vector<float> keys(clusters.size());
+    for(size_t c = 0; c < clusters.size(); ++c)
+    {
+        auto start = clusters[c];
+        auto end = c + 1 < clusters.size() ? clusters[c + 1] : face_count;
+
+        math::vec3 centroid{};
+        math::vec3 normal{};
+        for(auto i = start; i < end; ++i)
+        {
+            const auto& p0 = positions[indices[i * 3 + 0]];
+            const auto& p1 = positions[indices[i * 3 + 1]];
+            const auto& p2 = positions[indices[i * 3 + 2]];
+
+            // Area weighted.
+            normal += math::cross(p1 - p0, p2 - p0);
+            centroid += p0 + p1 + p2;
+        }
+        centroid /= float((end - start) * 3);
+
+        auto length = math::length(normal);
+        keys[c] = length > 0.0f ? math::dot(centroid - mesh_centroid, normal) / length : 0.0f;
+    }
+
+    std::vector<uint32_t> sorted(clusters.size());
+    std::iota(sorted.begin(), sorted.end(), uint32_t(0));
+    std::stable_sort(sorted.begin(),
+                     sorted.end(),
+                     [&](uint32_t lhs, uint32_t rhs)
+                     {
+                         return keys[lhs] > keys[rhs];
+                     });
+
+    std::vector<uint32_t> order;
+    order.reserve(face_count);
+    for(auto c : sorted)
+    {
+        auto start = clusters[c];
+        auto end = c + 1 < clusters.size() ? clusters[c + 1] : face_count;
+        for(auto i = start; i < end; ++i)
+        {
+            order.emplace_back(i);
+        }
+    }
+
+    return order;
+}
+
+auto is_valid(const mesh::load_data& data, const mesh::submesh& submesh) -> bool
+{
+    return submesh.face_start >= 0 && submesh.face_count > 0 &&
+           size_t(submesh.face_start) + submesh.face_count <= data.triangle_data.size();
+}
+
+void optimize_submesh(mesh::load_data& data,
+                      const std::vector<math::vec3>& positions,
+                      const mesh::submesh& submesh,
+                      const mesh_optimize_options& options)
+{
+    auto first = data.triangle_data.begin() + submesh.face_start;
+    auto last = first + submesh.face_count;
+
+    // Work on indices local to the range of vertices used by the submesh.
+    uint32_t min_vertex = invalid_index;
+    uint32_t max_vertex = 0;
+    for(auto it = first; it != last; ++it)
+    {
+        for(auto index : it->indices)
+        {
+            min_vertex = std::min(min_vertex, index);
+            max_vertex = std::max(max_vertex, index);
+        }
+    }
+    if(max_vertex >= data.vertex_count)
+    {
+        return;
+    }
+
+    std::vector<uint32_t> indices;
+    indices.reserve(size_t(submesh.face_count) * 3);
+    for(auto it = first; it != last; ++it)
+    {
+        for(auto index : it->indices)
+        {
+            indices.emplace_back(index - min_vertex);
+        }
+    }
+
+    const auto vertex_count = max_vertex - min_vertex + 1;
+
+    std::vector<uint32_t> order(submesh.face_count);
+    std::iota(order.begin(), order.end(), uint32_t(0));
+
+    auto apply = [&](const std::vector<uint32_t>& step)
+    {
+        std::vector<uint32_t> reordered(indices.size());
+        std::vector<uint32_t> combined(step.size());
+        for(size_t i = 0; i < step.size(); ++i)
+        {
+            std::memcpy(&reordered[i * 3], &indices[size_t(step[i]) * 3], sizeof(uint32_t) * 3);
+            combined[i] = order[step[i]];
+        }
+        indices = std::move(reordered);
+        order = std::move(combined);
+    };
+
+    if(options.vertex_cache)
+    {
+        apply(order_for_vertex_cache(indices, vertex_count));
+    }
+
+    if(options.overdraw && !positions.empty())
+    {
+        std::vector<math::vec3> local_positions(positions.begin() + min_vertex,
+                                                positions.begin() + max_vertex + 1);
+        apply(order_for_overdraw(indices, local_positions, options.overdraw_threshold));
+    }
+
+    std::vector<mesh::triangle> triangles(first, last);
+    for(size_t i = 0; i < order.size(); ++i)
+    {
+        *(first + i) = triangles[order[i]];
+    }
+}
+
+void optimize_vertex_fetch(mesh::load_data& data)
+{
+    std::vector<uint32_t> remap(data.vertex_count, invalid_index);
+    uint32_t next = 0;
+    for(const auto& tri : data.triangle_data)
+    {
+        for(auto index : tri.indices)
+        {
+            if(index < data.vertex_count && remap[index] == invalid_index)
+            {
+                remap[index] = next++;
+            }
+        }
+    }
+
+    // Unreferenced vertices keep their relative order at the end.
+    for(auto& index : remap)
+    {
+        if(index == invalid_index)
+        {
+            index = next++;
+        }
+    }
+
+    const auto stride = data.vertex_format.getStride();
+    std::vector<uint8_t> vertex_data(data.vertex_data.size());
+    for(uint32_t v = 0; v < data.vertex_count; ++v)
+    {
+        std::memcpy(vertex_data.data() + size_t(remap[v]) * stride,
+                    data.vertex_data.data() + size_t(v) * stride,
+                    stride);
+    }
+    data.vertex_data = std::move(vertex_data);
+
+    for(auto& tri : data.triangle_data)
+    {
+        for(auto& index : tri.indices)
+        {
+            if(index < data.vertex_count)
+            {
+                index = remap[index];
+            }
+        }
+    }
+
+    data.skin_data.remap_vertices(remap);
+
+    for(auto& submesh : data.submeshes)
+    {
+        if(!is_valid(data, submesh))
+        {
+            continue;
+        }
+
+        uint32_t min_vertex = invalid_index;
+        uint32_t max_vertex = 0;
+        for(uint32_t i = 0; i < submesh.face_count; ++i)
+        {
+            for(auto index : data.triangle_data[submesh.face_start + i].indices)
+            {
+                min_vertex = std::min(min_vertex, index);
+                max_vertex = std::max(max_vertex, index);
+            }
+        }
+        submesh.vertex_start = int32_t(min_vertex);
+        submesh.vertex_count = max_vertex - min_vertex + 1;
+    }
+}
+
+} // namespace
+
+auto analyze_vertex_cache(const uint32_t* indices, size_t index_count, uint32_t cache_size) -> vertex_cache_stats
+{
+    vertex_cache_stats stats;
+    if(index_count < 3)
+    {
+        return stats;
+    }
+
+    auto [min_it, max_it] = std::minmax_element(indices, indices + index_count);
+    const auto min_vertex = *min_it;
+    const auto vertex_count = *max_it - min_vertex + 1;
+
+    std::vector<uint32_t> local(indices, indices + index_count);
+    std::vector<uint8_t> used(vertex_count, 0);
+    uint32_t used_count = 0;
+    for(auto& index : local)
+    {
+        index -= min_vertex;
+        if(!used[index])
+        {
+            used[index] = 1;
+            used_count++;
+        }
+    }
+
+    fifo_cache cache(vertex_count, cache_size);
+    uint64_t misses = 0;
+    const auto face_count = index_count / 3;
+    for(size_t i = 0; i < face_count; ++i)
+    {
+        misses += cache.add(&local[i * 3]);
+    }
+
+    stats.acmr = float(double(misses) / double(face_count));
+    stats.atvr = float(double(misses) / double(used_count));
+    return stats;
+}
+
+auto analyze_vertex_cache(const mesh::load_data& data, uint32_t cache_size) -> std::vector<vertex_cache_stats>
+{
+    std::vector<vertex_cache_stats> result(data.submeshes.size());
+
+    std::vector<uint32_t> indices;
+    for(size_t s = 0; s < data.submeshes.size(); ++s)
+    {
+        const auto& submesh = data.submeshes[s];
+        if(!is_valid(data, submesh))
+        {
+            continue;
+        }
+
+        indices.clear();
+        for(uint32_t i = 0; i < submesh.face_count; ++i)
+        {
+            const auto& tri = data.triangle_data[submesh.face_start + i];
+            indices.insert(indices.end(), tri.indices.begin(), tri.indices.end());
+        }
+
+        result[s] = analyze_vertex_cache(indices.data(), indices.size(), cache_size);
+    }
+
+    return result;
+}
+
+void optimize_mesh(mesh::load_data& data, const mesh_optimize_options& options)
+{
+    APPLOG_TRACE_PERF_NAMED(std::chrono::milliseconds, "Mesh Importer: Optimize Vertex Order");
+
+    if(data.triangle_count == 0 || data.vertex_count == 0)
+    {
+        return;
+    }
+
+    if(options.vertex_cache || options.overdraw)
+    {
+        std::vector<math::vec3> positions;
+        if(options.overdraw && data.vertex_format.has(gfx::attribute::Position))
+        {
+            positions.resize(data.vertex_count);
+            for(uint32_t v = 0; v < data.vertex_count; ++v)
+            {
+                float position[4];
+                gfx::vertex_unpack(position, gfx::attribute::Position, data.vertex_format, data.vertex_data.data(), v);
+                positions[v] = math::vec3(position[0], position[1], position[2]);
+            }
+        }
+
+        // Submeshes own disjoint ranges of triangles.
+        std::for_each(std::execution::par,
+                      data.submeshes.begin(),
+                      data.submeshes.end(),
+                      [&](const mesh::submesh& submesh)
+                      {
+                          if(is_valid(data, submesh))
+                          {
+                              optimize_submesh(data, positions, submesh, options);
+                          }
+                      });
+    }
+
+    if(options.vertex_fetch)
+    {
+        optimize_vertex_fetch(data);
+    }
+}
+
+} // namespace importer
+} // namespace unravel
@@ -0,0 +1,56 @@
+#pragma once
+#include <engine/rendering/mesh.h>
+
+#include <vector>
+
+namespace unravel
+{
+namespace importer
+{
+
+/// Post transform vertex cache efficiency of a triangle list.
+struct vertex_cache_stats
+{
+    /// Average cache miss ratio. Transformed vertices per triangle, 3 is the worst case.
+    float acmr{};
+    /// Average transform to vertex ratio. Transformed vertices per referenced vertex, 1 is ideal.
+    float atvr{};
+};
+
+struct mesh_optimize_options
+{
+    /// Reorder triangles to reuse the post transform cache.
+    bool vertex_cache{true};
+    /// Reorder clusters of triangles so outer facing ones are drawn first.
+    bool overdraw{true};
+    /// Reorder vertices in the order they are first referenced.
+    bool vertex_fetch{true};
+    /// How much worse than the optimized ACMR a cluster may get to allow finer overdraw sorting.
+    float overdraw_threshold{1.05f};
+};
+
+/**
+ * @brief Simulates a FIFO post transform cache over a triangle list.
+ *
+ * @param indices Three indices per triangle.
+ * @param index_count Number of indices.
+ * @param cache_size Number of cache entries.
+ */
+auto analyze_vertex_cache(const uint32_t* indices, size_t index_count, uint32_t cache_size = 16)
+    -> vertex_cache_stats;
+
+/// Cache statistics for every submesh of the mesh.
+auto analyze_vertex_cache(const mesh::load_data& data, uint32_t cache_size = 16) -> std::vector<vertex_cache_stats>;
+
+/**
+ * @brief Reorders the triangles and vertices of a mesh for the GPU.
+ *
+ * Triangles of every submesh are ordered for the post transform cache with Tipsify, then split
+ * into clusters that are sorted so triangles facing away from the mesh center are drawn first,
+ * which lowers overdraw for any view direction. Finally vertices are reordered by first use so
+ * the vertex fetch walks memory linearly. Submeshes are processed in parallel.
+ */
+void optimize_mesh(mesh::load_data& data, const mesh_optimize_options& options);
+
+} // namespace importer
+} // namespace unravel
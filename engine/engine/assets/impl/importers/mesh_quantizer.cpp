@@ -0,0 +1,275 @@
+#include "mesh_quantizer.h"
+
+#include <logging/logging.h>
+
+#include <bx/math.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+#define POOLSTL_STD_SUPPLEMENT 1
+#include <poolstl/poolstl.hpp>
+
+namespace unravel
+{
+namespace importer
+{
+namespace
+{
+
+constexpr int32_t unassigned = -1;
+
+auto unpack_vec3(gfx::attribute attr, const mesh::load_data& data, uint32_t index) -> math::vec3
+{
+    float value[4];
+    gfx::vertex_unpack(value, attr, data.vertex_format, data.vertex_data.data(), index);
+    return {value[0], value[1], value[2]};
+}
+
+auto from_unorm8(uint8_t value) -> float
+{
+    return float(value) / 255.0f * 2.0f - 1.0f;
+}
+
+auto to_snorm16(float value) -> int16_t
+{
+    return static_cast<int16_t>(std::lround(math::clamp(value, -1.0f, 1.0f) * 32767.0f));
+}
+
+/// Same decode as octahedralDecode in shaderlib.sh.
+auto octahedral_decode(math::vec2 e) -> math::vec3
+{
+    math::vec3 n(e.x, e.y, 1.0f - math::abs(e.x) - math::abs(e.y));
+    float t = math::max(-n.z, 0.0f);
+    n.x += n.x >= 0.0f ? -t : t;
+    n.y += n.y >= 0.0f ? -t : t;
+    return math::normalize(n);
+}
+
+/// Octahedral encoding into two bytes. The four nearest byte pairs are tried and the one that
+/// decodes closest to the input is kept, which roughly halves the error of plain rounding.
+void octahedral_encode(const math::vec3& v, uint8_t* output)
+{
+    math::vec3 n = v / (math::abs(v.x) + math::abs(v.y) + math::abs(v.z));
+    math::vec2 e(n.x, n.y);
+    if(n.z < 0.0f)
+    {
+        e.x = (1.0f - math::abs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f);
+        e.y = (1.0f - math::abs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f);
+    }
+
+    math::vec2 scaled = (e * 0.5f + 0.5f) * 255.0f;
+    math::vec2 base = math::floor(scaled);
+
+    float best = -2.0f;
+    for(int i = 0; i < 4; ++i)
+    {
+        float x = math::clamp(base.x + float(i & 1), 0.0f, 255.0f);
+        float y = math::clamp(base.y + float(i >> 1), 0.0f, 255.0f);
+
+        auto ex = static_cast<uint8_t>(x);
+        auto ey = static_cast<uint8_t>(y);
+        float similarity = math::dot(octahedral_decode({from_unorm8(ex), from_unorm8(ey)}), v);
+        if(similarity > best)
+        {
+            best = similarity;
+            output[0] = ex;
+            output[1] = ey;
+        }
+    }
+}
+
+/// Any unit vector perpendicular to n.
+auto perpendicular(const math::vec3& n) -> math::vec3
+{
+    math::vec3 axis = math::abs(n.x) < 0.9f ? math::vec3(1.0f, 0.0f, 0.0f) : math::vec3(0.0f, 1.0f, 0.0f);
+    return math::normalize(math::cross(n, axis));
+}
+
+auto is_supported(const gfx::vertex_layout& layout) -> bool
+{
+    if(!layout.has(gfx::attribute::Position))
+    {
+        return false;
+    }
+
+    for(uint32_t i = 0; i < gfx::attribute::Count; ++i)
+    {
+        auto attr = static_cast<gfx::attribute>(i);
+        bool known = attr == gfx::attribute::Position || attr == gfx::attribute::Normal ||
+                     attr == gfx::attribute::Tangent || attr == gfx::attribute::Bitangent ||
+                     attr == gfx::attribute::TexCoord0;
+        if(layout.has(attr) && !known)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// Assigns every vertex to the submesh that references it. Fails if a vertex is referenced by more than one.
+auto assign_owners(const mesh::load_data& data, std::vector<int32_t>& owners) -> bool
+{
+    owners.assign(data.vertex_count, unassigned);
+
+    for(size_t s = 0; s < data.submeshes.size(); ++s)
+    {
+        const auto& submesh = data.submeshes[s];
+        if(submesh.face_start < 0)
+        {
+            continue;
+        }
+
+        auto face_end = std::min<size_t>(size_t(submesh.face_start) + submesh.face_count, data.triangle_data.size());
+        for(size_t f = size_t(submesh.face_start); f < face_end; ++f)
+        {
+            for(auto index : data.triangle_data[f].indices)
+            {
+                if(index >= data.vertex_count)
+                {
+                    return false;
+                }
+
+                auto& owner = owners[index];
+                if(owner == unassigned)
+                {
+                    owner = int32_t(s);
+                }
+                else if(owner != int32_t(s))
+                {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+auto quantize_vertices(mesh::load_data& data) -> bool
+{
+    APPLOG_TRACE_PERF_NAMED(std::chrono::milliseconds, "Mesh Importer: Quantize Vertices");
+
+    if(data.vertex_count == 0 || !is_supported(data.vertex_format))
+    {
+        return false;
+    }
+
+    std::vector<int32_t> owners;
+    if(!assign_owners(data, owners))
+    {
+        APPLOG_WARNING("Mesh Importer: vertices are shared between submeshes, keeping the full precision layout.");
+        return false;
+    }
+
+    std::vector<math::vec3> positions(data.vertex_count);
+    for(uint32_t v = 0; v < data.vertex_count; ++v)
+    {
+        positions[v] = unpack_vec3(gfx::attribute::Position, data, v);
+    }
+
+    // Refit the submesh bounds so they enclose exactly the vertices they decode.
+    std::vector<math::bbox> bounds(data.submeshes.size());
+    for(uint32_t v = 0; v < data.vertex_count; ++v)
+    {
+        if(owners[v] != unassigned)
+        {
+            bounds[size_t(owners[v])].add_point(positions[v]);
+        }
+    }
+
+    std::vector<math::mat4> quantize(data.submeshes.size());
+    for(size_t s = 0; s < data.submeshes.size(); ++s)
+    {
+        if(bounds[s].is_populated())
+        {
+            data.submeshes[s].bbox = bounds[s];
+        }
+        quantize[s] = math::inverse(mesh::get_dequantize_transform(data.submeshes[s].bbox));
+    }
+
+    const auto& source_format = data.vertex_format;
+    const auto& format = gfx::mesh_vertex_compressed::get_layout();
+    const bool has_normal = source_format.has(gfx::attribute::Normal);
+    const bool has_tangent = source_format.has(gfx::attribute::Tangent);
+    const bool has_bitangent = source_format.has(gfx::attribute::Bitangent);
+    const bool has_texcoord = source_format.has(gfx::attribute::TexCoord0);
+
+    const uint16_t stride = format.getStride();
+    const uint16_t position_offset = format.getOffset(gfx::attribute::Position);
+    const uint16_t normal_offset = format.getOffset(gfx::attribute::Normal);
+    const uint16_t texcoord_offset = format.getOffset(gfx::attribute::TexCoord0);
+
+    std::vector<uint8_t> vertex_data(size_t(data.vertex_count) * stride, 0);
+
+    std::vector<uint32_t> vertices(data.vertex_count);
+    std::iota(vertices.begin(), vertices.end(), uint32_t(0));
+    std::for_each(std::execution::par,
+                  vertices.begin(),
+                  vertices.end(),
+                  [&](uint32_t v)
+                  {
+                      uint8_t* output = vertex_data.data() + size_t(v) * stride;
+
+                      math::vec3 normal(0.0f, 0.0f, 1.0f);
+                      if(has_normal)
+                      {
+                          auto unpacked = unpack_vec3(gfx::attribute::Normal, data, v);
+                          if(math::dot(unpacked, unpacked) > 0.0f)
+                          {
+                              normal = math::normalize(unpacked);
+                          }
+                      }
+
+                      // The tangent is decoded without its bitangent, keep it orthogonal to the normal.
+                      math::vec3 tangent = has_tangent ? unpack_vec3(gfx::attribute::Tangent, data, v) : math::vec3(0.0f);
+                      tangent -= normal * math::dot(normal, tangent);
+                      tangent = math::dot(tangent, tangent) > 1e-12f ? math::normalize(tangent) : perpendicular(normal);
+
+                      float handedness = 1.0f;
+                      if(has_bitangent)
+                      {
+                          auto bitangent = unpack_vec3(gfx::attribute::Bitangent, data, v);
+                          handedness = math::dot(math::cross(normal, tangent), bitangent) < 0.0f ? -1.0f : 1.0f;
+                      }
+
+                      const auto& transform = owners[v] != unassigned ? quantize[size_t(owners[v])] : math::mat4(1.0f);
+                      auto local = math::vec3(transform * math::vec4(positions[v], 1.0f));
+
+                      int16_t position[4] = {to_snorm16(local.x), to_snorm16(local.y), to_snorm16(local.z),
+                                             to_snorm16(handedness)};
+                      std::memcpy(output + position_offset, position, sizeof(position));
+
+                      octahedral_encode(normal, output + normal_offset);
+                      octahedral_encode(tangent, output + normal_offset + 2);
+
+                      if(has_texcoord)
+                      {
+                          float texcoord[4];
+                          gfx::vertex_unpack(texcoord,
+                                             gfx::attribute::TexCoord0,
+                                             source_format,
+                                             data.vertex_data.data(),
+                                             v);
+                          uint16_t halfs[2] = {bx::halfFromFloat(texcoord[0]), bx::halfFromFloat(texcoord[1])};
+                          std::memcpy(output + texcoord_offset, halfs, sizeof(halfs));
+                      }
+                  });
+
+    APPLOG_TRACE("Mesh Importer: quantized {} vertices, {} -> {} bytes",
+                 data.vertex_count,
+                 data.vertex_data.size(),
+                 vertex_data.size());
+
+    data.vertex_data = std::move(vertex_data);
+    data.vertex_format = format;
+    return true;
+}
+
+} // namespace importer
+} // namespace unravel
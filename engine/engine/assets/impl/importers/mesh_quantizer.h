@@ -0,0 +1,26 @@
+#pragma once
+#include <engine/rendering/mesh.h>
+
+namespace unravel
+{
+namespace importer
+{
+
+/**
+ * @brief Converts the vertices of a mesh to the compact gfx::mesh_vertex_compressed layout.
+ *
+ * Positions become 16 bit normalized offsets from the center of their submesh bounds (see
+ * mesh::get_dequantize_transform) with the bitangent sign in w. Normals and tangents are
+ * octahedral encoded into one 4 byte attribute and uvs become half floats, which halves the
+ * size of the default layout. Skin weights are packed into bytes when the skin is bound.
+ *
+ * Vertices shared between submeshes can only be decoded with one set of bounds, so such
+ * meshes are left untouched.
+ *
+ * @param data The mesh to convert. Submesh bounds are refitted to their vertices.
+ * @return True if the mesh was converted.
+ */
+auto quantize_vertices(mesh::load_data& data) -> bool;
+
+} // namespace importer
+} // namespace unravel
@@ -0,0 +1,821 @@
+#include "mesh_simplifier.h"
+
+#include <logging/logging.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <string_view>
+#include <unordered_map>
+
+#define POOLSTL_STD_SUPPLEMENT 1
+#include <poolstl/poolstl.hpp>
+
+namespace unravel
+{
+namespace importer
+{
+namespace
+{
+
+using face_t = std::array<uint32_t, 3>;
+
+constexpr uint32_t invalid_index = std::numeric_limits<uint32_t>::max();
+
+/// Symmetric 4x4 error quadric, only the upper triangle is stored.
+struct quadric
+{
+    double a00{}, a01{}, a02{}, a03{};
+    double a11{}, a12{}, a13{};
+    double a22{}, a23{};
+    double a33{};
+
+    static auto from_plane(double a, double b, double c, double d, double weight) -> quadric
+    {
+        quadric q;
+        q.a00 = a * a * weight;
+        q.a01 = a * b * weight;
+        q.a02 = a * c * weight;
+        q.a03 = a * d * weight;
+        q.a11 = b * b * weight;
+        q.a12 = b * c * weight;
+        q.a13 = b * d * weight;
+        q.a22 = c * c * weight;
+        q.a23 = c * d * weight;
+        q.a33 = d * d * weight;
+        return q;
+    }
+
+    void add(const quadric& q)
+    {
+        a00 += q.a00;
+        a01 += q.a01;
+        a02 += q.a02;
+        a03 += q.a03;
+        a11 += q.a11;
+        a12 += q.a12;
+        a13 += q.a13;
+        a22 += q.a22;
+        a23 += q.a23;
+        a33 += q.a33;
+    }
+
+    auto evaluate(const math::vec3& p) const -> double
+    {
+        const double x = p.x;
+        const double y = p.y;
+        const double z = p.z;
+
+        return a00 * x * x + 2.0 * a01 * x * y + 2.0 * a02 * x * z + 2.0 * a03 * x + a11 * y * y +
+               2.0 * a12 * y * z + 2.0 * a13 * y + a22 * z * z + 2.0 * a23 * z + a33;
+    }
+};
+
+struct position_key
+{
+    uint32_t x{};
+    uint32_t y{};
+    uint32_t z{};
+
+    auto operator==(const position_key& rhs) const -> bool = default;
+};
+
+struct position_key_hash
+{
+    auto operator()(const position_key& k) const -> size_t
+    {
+        uint64_t h = k.x;
+        h = h * 0x9E3779B97F4A7C15ull ^ k.y;
+        h = h * 0x9E3779B97F4A7C15ull ^ k.z;
+        return size_t(h ^ (h >> 29));
+    }
+};
+
+auto make_position_key(const math::vec3& p) -> position_key
+{
+    position_key key;
+    std::memcpy(&key.x, &p.x, sizeof(float));
+    std::memcpy(&key.y, &p.y, sizeof(float));
+    std::memcpy(&key.z, &p.z, sizeof(float));
+    return key;
+}
+
+/**
+ * @brief Reduces a triangle list with half edge collapses ordered by quadric error.
+ *
+ * Collapses work on positions: vertices sharing a position (the wedges of an attribute seam) move
+ * together. Each wedge of the collapsed position is merged into the wedge of the target it shares
+ * a face with, so a seam can only collapse along itself and both of its sides keep their own
+ * attributes. Positions on open or non-manifold edges stay where they are, and collapses between
+ * vertices with a different dominant bone are rejected, so borders and skinning boundaries keep
+ * their shape.
+ */
+class simplifier
+{
+public:
+    simplifier(const std::vector<math::vec3>& positions, const std::vector<int32_t>& bones, std::vector<face_t> faces)
+        : positions_(positions)
+        , bones_(bones)
+        , faces_(std::move(faces))
+    {
+        face_alive_.assign(faces_.size(), true);
+        alive_faces_ = faces_.size();
+
+        vertex_faces_.resize(positions_.size());
+
+        build_groups();
+
+        const auto group_count = group_vertices_.size();
+        group_dead_.assign(group_count, false);
+        group_locked_.assign(group_count, false);
+        versions_.assign(group_count, 0);
+        quadrics_.resize(group_count);
+
+        build_locks();
+        build_quadrics();
+    }
+
+    auto run(size_t target_faces) -> std::vector<std::pair<uint32_t, face_t>>
+    {
+        for(uint32_t g = 0; g < group_vertices_.size(); ++g)
+        {
+            push_candidates(g);
+        }
+
+        while(alive_faces_ > target_faces && !queue_.empty())
+        {
+            auto c = queue_.top();
+            queue_.pop();
+
+            if(group_dead_[c.from] || group_dead_[c.to] || versions_[c.from] != c.version)
+            {
+                continue;
+            }
+
+            if(!can_collapse(c.from, c.to))
+            {
+                continue;
+            }
+
+            collapse(c.from, c.to);
+
+            neighbours_.clear();
+            gather_neighbour_groups(c.to, neighbours_);
+
+            versions_[c.to]++;
+            push_candidates(c.to);
+            for(auto n : neighbours_)
+            {
+                versions_[n]++;
+                push_candidates(n);
+            }
+        }
+
+        std::vector<std::pair<uint32_t, face_t>> result;
+        result.reserve(alive_faces_);
+        for(uint32_t f = 0; f < faces_.size(); ++f)
+        {
+            if(face_alive_[f])
+            {
+                result.emplace_back(f, faces_[f]);
+            }
+        }
+        return result;
+    }
+
+private:
+    struct candidate
+    {
+        double cost{};
+        uint32_t from{};
+        uint32_t to{};
+        uint32_t version{};
+
+        auto operator>(const candidate& rhs) const -> bool
+        {
+            return cost > rhs.cost;
+        }
+    };
+
+    /// Wedge of the collapsed position and the wedge of the target it is merged into.
+    struct wedge_target
+    {
+        uint32_t from{};
+        uint32_t to{};
+    };
+
+    auto get_position(uint32_t group) const -> const math::vec3&
+    {
+        return positions_[group_vertices_[group].front()];
+    }
+
+    void build_groups()
+    {
+        std::unordered_map<position_key, uint32_t, position_key_hash> lookup;
+        lookup.reserve(positions_.size());
+
+        groups_.resize(positions_.size());
+        for(uint32_t v = 0; v < positions_.size(); ++v)
+        {
+            auto it = lookup.emplace(make_position_key(positions_[v]), uint32_t(group_vertices_.size())).first;
+            if(it->second == group_vertices_.size())
+            {
+                group_vertices_.emplace_back();
+            }
+            groups_[v] = it->second;
+            group_vertices_[it->second].emplace_back(v);
+        }
+
+        for(uint32_t f = 0; f < faces_.size(); ++f)
+        {
+            for(auto v : faces_[f])
+            {
+                vertex_faces_[v].emplace_back(f);
+            }
+        }
+    }
+
+    void build_locks()
+    {
+        // Open and non-manifold edges, counted on positions so seams between wedges are not borders.
+        std::unordered_map<uint64_t, uint32_t> edge_uses;
+        edge_uses.reserve(faces_.size() * 3);
+        for(const auto& face : faces_)
+        {
+            for(int e = 0; e < 3; ++e)
+            {
+                auto a = groups_[face[e]];
+                auto b = groups_[face[(e + 1) % 3]];
+                if(a == b)
+                {
+                    group_locked_[a] = true;
+                    continue;
+                }
+                auto key = (uint64_t(std::min(a, b)) << 32) | uint64_t(std::max(a, b));
+                edge_uses[key]++;
+            }
+        }
+
+        for(const auto& [key, uses] : edge_uses)
+        {
+            if(uses != 2)
+            {
+                group_locked_[uint32_t(key >> 32)] = true;
+                group_locked_[uint32_t(key & 0xffffffff)] = true;
+            }
+        }
+    }
+
+    void build_quadrics()
+    {
+        for(const auto& face : faces_)
+        {
+            const auto& p0 = positions_[face[0]];
+            const auto& p1 = positions_[face[1]];
+            const auto& p2 = positions_[face[2]];
+
+            auto n = math::cross(p1 - p0, p2 - p0);
+            auto len = math::length(n);
+            if(len <= std::numeric_limits<float>::epsilon())
+            {
+                continue;
+            }
+            n /= len;
+
+            // Weighted by area so large faces dominate the error.
+            auto q = quadric::from_plane(n.x, n.y, n.z, -math::dot(n, p0), double(len) * 0.5);
+            for(auto v : face)
+            {
+                quadrics_[groups_[v]].add(q);
+            }
+        }
+    }
+
+    void gather_neighbour_groups(uint32_t group, std::vector<uint32_t>& out) const
+    {
+        for(auto wedge : group_vertices_[group])
+        {
+            for(auto f : vertex_faces_[wedge])
+            {
+                if(!face_alive_[f])
+                {
+                    continue;
+                }
+                for(auto n : faces_[f])
+                {
+                    auto g = groups_[n];
+                    if(g != group && std::find(out.begin(), out.end(), g) == out.end())
+                    {
+                        out.emplace_back(g);
+                    }
+                }
+            }
+        }
+    }
+
+    void push_candidates(uint32_t from)
+    {
+        if(group_locked_[from] || group_dead_[from])
+        {
+            return;
+        }
+
+        candidates_.clear();
+        gather_neighbour_groups(from, candidates_);
+
+        for(auto to : candidates_)
+        {
+            quadric q = quadrics_[from];
+            q.add(quadrics_[to]);
+
+            queue_.push(candidate{q.evaluate(get_position(to)), from, to, versions_[from]});
+        }
+    }
+
+    /// Pairs every wedge of 'from' still in use with the one wedge of 'to' it shares faces with.
+    /// Fails when a wedge touches none, its attributes would have to be moved to the target
+    /// position, or several, the collapse would merge wedges across a seam.
+    auto get_wedge_targets(uint32_t from, uint32_t to, std::vector<wedge_target>& out) const -> bool
+    {
+        out.clear();
+        for(auto wedge : group_vertices_[from])
+        {
+            uint32_t target = invalid_index;
+            bool used = false;
+            for(auto f : vertex_faces_[wedge])
+            {
+                if(!face_alive_[f])
+                {
+                    continue;
+                }
+                used = true;
+
+                for(auto n : faces_[f])
+                {
+                    if(groups_[n] != to)
+                    {
+                        continue;
+                    }
+                    if(target != invalid_index && target != n)
+                    {
+                        return false;
+                    }
+                    target = n;
+                }
+            }
+
+            if(!used)
+            {
+                continue;
+            }
+
+            if(target == invalid_index)
+            {
+                return false;
+            }
+
+            if(!bones_.empty() && bones_[wedge] != bones_[target])
+            {
+                return false;
+            }
+
+            out.push_back({wedge, target});
+        }
+
+        return !out.empty();
+    }
+
+    auto can_collapse(uint32_t from, uint32_t to) -> bool
+    {
+        if(!get_wedge_targets(from, to, wedge_targets_))
+        {
+            return false;
+        }
+
+        const auto& target_position = get_position(to);
+
+        size_t shared = 0;
+        for(const auto& wedge : wedge_targets_)
+        {
+            for(auto f : vertex_faces_[wedge.from])
+            {
+                if(!face_alive_[f])
+                {
+                    continue;
+                }
+
+                const auto& face = faces_[f];
+                if(std::find(face.begin(), face.end(), wedge.to) != face.end())
+                {
+                    shared++;
+                    continue;
+                }
+
+                // Reject collapses that fold a remaining face over.
+                const auto& p0 = positions_[face[0]];
+                const auto& p1 = positions_[face[1]];
+                const auto& p2 = positions_[face[2]];
+                auto before = math::cross(p1 - p0, p2 - p0);
+
+                auto moved = [&](uint32_t i) -> const math::vec3&
+                {
+                    return face[i] == wedge.from ? target_position : positions_[face[i]];
+                };
+                auto after = math::cross(moved(1) - moved(0), moved(2) - moved(0));
+
+                auto before_len = math::length(before);
+                auto after_len = math::length(after);
+                if(after_len <= std::numeric_limits<float>::epsilon())
+                {
+                    return false;
+                }
+                if(before_len > std::numeric_limits<float>::epsilon() &&
+                   math::dot(before / before_len, after / after_len) < 0.25f)
+                {
+                    return false;
+                }
+            }
+        }
+
+        if(shared == 0)
+        {
+            return false;
+        }
+
+        // Link condition, the edge may only share as many neighbours as it has faces.
+        from_groups_.clear();
+        to_groups_.clear();
+        gather_neighbour_groups(from, from_groups_);
+        gather_neighbour_groups(to, to_groups_);
+
+        size_t common = 0;
+        for(auto g : from_groups_)
+        {
+            if(std::find(to_groups_.begin(), to_groups_.end(), g) != to_groups_.end())
+            {
+                common++;
+            }
+        }
+
+        return common == shared;
+    }
+
+    /// Uses the wedge targets found by the can_collapse call that accepted this collapse.
+    void collapse(uint32_t from, uint32_t to)
+    {
+        for(const auto& wedge : wedge_targets_)
+        {
+            for(auto f : vertex_faces_[wedge.from])
+            {
+                if(!face_alive_[f])
+                {
+                    continue;
+                }
+
+                auto& face = faces_[f];
+                if(std::find(face.begin(), face.end(), wedge.to) != face.end())
+                {
+                    face_alive_[f] = false;
+                    alive_faces_--;
+                    continue;
+                }
+
+                for(auto& n : face)
+                {
+                    if(n == wedge.from)
+                    {
+                        n = wedge.to;
+                    }
+                }
+                vertex_faces_[wedge.to].emplace_back(f);
+            }
+            vertex_faces_[wedge.from].clear();
+        }
+
+        quadrics_[to].add(quadrics_[from]);
+        group_dead_[from] = true;
+    }
+
+    const std::vector<math::vec3>& positions_;
+    const std::vector<int32_t>& bones_;
+
+    std::vector<face_t> faces_;
+    std::vector<bool> face_alive_;
+    size_t alive_faces_{};
+
+    std::vector<uint32_t> groups_;
+    std::vector<std::vector<uint32_t>> group_vertices_;
+    std::vector<std::vector<uint32_t>> vertex_faces_;
+
+    std::vector<bool> group_dead_;
+    std::vector<bool> group_locked_;
+    std::vector<uint32_t> versions_;
+    std::vector<quadric> quadrics_;
+
+    std::priority_queue<candidate, std::vector<candidate>, std::greater<>> queue_;
+
+    std::vector<uint32_t> neighbours_;
+    std::vector<uint32_t> candidates_;
+    std::vector<uint32_t> from_groups_;
+    std::vector<uint32_t> to_groups_;
+    std::vector<wedge_target> wedge_targets_;
+};
+
+/// Maps every vertex of a range to the first vertex of the range with the same data. Meshes exported
+/// unwelded repeat identical vertices for every face, merged they collapse as one surface.
+auto weld_identical_vertices(const mesh::load_data& source, uint32_t vertex_start, uint32_t vertex_count)
+    -> std::vector<uint32_t>
+{
+    const auto stride = source.vertex_format.getStride();
+
+    std::unordered_map<std::string_view, uint32_t> lookup;
+    lookup.reserve(vertex_count);
+
+    std::vector<uint32_t> result(vertex_count);
+    for(uint32_t v = 0; v < vertex_count; ++v)
+    {
+        const auto* data = reinterpret_cast<const char*>(source.vertex_data.data()) + size_t(vertex_start + v) * stride;
+        result[v] = lookup.emplace(std::string_view(data, stride), v).first->second;
+    }
+    return result;
+}
+
+struct simplified_submesh
+{
+    /// Source vertices kept by this submesh, in output order.
+    std::vector<uint32_t> vertices;
+    /// Triangles indexing into 'vertices'.
+    mesh::triangle_array_t triangles;
+};
+
+auto simplify_submesh(const mesh::load_data& source,
+                      const std::vector<math::vec3>& positions,
+                      const std::vector<int32_t>& bones,
+                      const mesh::submesh& submesh,
+                      float ratio) -> simplified_submesh
+{
+    simplified_submesh result;
+
+    if(submesh.vertex_start < 0 || submesh.face_start < 0)
+    {
+        return result;
+    }
+
+    const auto vertex_start = uint32_t(submesh.vertex_start);
+    const auto vertex_end = vertex_start + submesh.vertex_count;
+    const auto face_start = uint32_t(submesh.face_start);
+    const auto face_end = std::min<uint32_t>(face_start + submesh.face_count, uint32_t(source.triangle_data.size()));
+
+    bool in_range = vertex_end <= positions.size();
+    // Skin influences live outside the vertex data, skinned vertices are never welded.
+    std::vector<uint32_t> welded(submesh.vertex_count);
+    std::iota(welded.begin(), welded.end(), uint32_t(0));
+    if(in_range && !submesh.skinned)
+    {
+        welded = weld_identical_vertices(source, vertex_start, submesh.vertex_count);
+    }
+
+    std::vector<face_t> faces;
+    faces.reserve(face_end - face_start);
+    for(uint32_t f = face_start; f < face_end && in_range; ++f)
+    {
+        const auto& tri = source.triangle_data[f];
+        face_t face;
+        for(int i = 0; i < 3; ++i)
+        {
+            in_range &= tri.indices[i] >= vertex_start && tri.indices[i] < vertex_end;
+            face[i] = in_range ? welded[tri.indices[i] - vertex_start] : 0;
+        }
+        faces.emplace_back(face);
+    }
+
+    std::vector<std::pair<uint32_t, face_t>> kept;
+    if(in_range)
+    {
+        std::vector<math::vec3> local_positions(positions.begin() + vertex_start, positions.begin() + vertex_end);
+
+        std::vector<int32_t> local_bones;
+        if(submesh.skinned && !bones.empty())
+        {
+            local_bones.assign(bones.begin() + vertex_start, bones.begin() + vertex_end);
+        }
+
+        auto target = size_t(std::max(1.0f, float(faces.size()) * std::clamp(ratio, 0.0f, 1.0f)));
+
+        simplifier s(local_positions, local_bones, std::move(faces));
+        kept = s.run(target);
+    }
+    else
+    {
+        // Faces reference vertices of other submeshes, keep it as it is.
+        for(uint32_t f = face_start; f < face_end; ++f)
+        {
+            const auto& tri = source.triangle_data[f];
+            if(std::any_of(tri.indices.begin(),
+                           tri.indices.end(),
+                           [&](uint32_t index)
+                           {
+                               return index >= positions.size();
+                           }))
+            {
+                continue;
+            }
+            kept.emplace_back(f - face_start,
+                              face_t{tri.indices[0] - vertex_start,
+                                     tri.indices[1] - vertex_start,
+                                     tri.indices[2] - vertex_start});
+        }
+    }
+
+    std::unordered_map<uint32_t, uint32_t> remap;
+    result.triangles.reserve(kept.size());
+    for(const auto& [origin, face] : kept)
+    {
+        auto& tri = result.triangles.emplace_back();
+        tri.data_group_id = source.triangle_data[face_start + origin].data_group_id;
+        tri.flags = source.triangle_data[face_start + origin].flags;
+
+        for(int i = 0; i < 3; ++i)
+        {
+            auto vertex = face[i] + vertex_start;
+            auto it = remap.emplace(vertex, uint32_t(result.vertices.size())).first;
+            if(it->second == result.vertices.size())
+            {
+                result.vertices.emplace_back(vertex);
+            }
+            tri.indices[i] = it->second;
+        }
+    }
+
+    return result;
+}
+
+auto clone_armature(const std::unique_ptr<mesh::armature_node>& node) -> std::unique_ptr<mesh::armature_node>
+{
+    if(!node)
+    {
+        return nullptr;
+    }
+
+    auto result = std::make_unique<mesh::armature_node>();
+    result->name = node->name;
+    result->local_transform = node->local_transform;
+    result->submeshes = node->submeshes;
+    result->index = node->index;
+    result->children.reserve(node->children.size());
+    for(const auto& child : node->children)
+    {
+        result->children.emplace_back(clone_armature(child));
+    }
+    return result;
+}
+
+auto assemble_lod(const mesh::load_data& source, const std::vector<simplified_submesh>& submeshes) -> mesh::load_data
+{
+    mesh::load_data lod;
+    lod.vertex_format = source.vertex_format;
+    lod.material_count = source.material_count;
+    lod.bbox = source.bbox;
+    lod.root_node = clone_armature(source.root_node);
+
+    const auto stride = source.vertex_format.getStride();
+
+    size_t vertex_total = 0;
+    size_t face_total = 0;
+    for(const auto& s : submeshes)
+    {
+        vertex_total += s.vertices.size();
+        face_total += s.triangles.size();
+    }
+    lod.vertex_data.resize(vertex_total * stride);
+    lod.triangle_data.reserve(face_total);
+    lod.submeshes.reserve(submeshes.size());
+
+    std::vector<uint32_t> remap(source.vertex_count, invalid_index);
+
+    for(size_t i = 0; i < submeshes.size(); ++i)
+    {
+        const auto& simplified = submeshes[i];
+
+        auto& submesh = lod.submeshes.emplace_back(source.submeshes[i]);
+        submesh.vertex_start = int32_t(lod.vertex_count);
+        submesh.vertex_count = uint32_t(simplified.vertices.size());
+        submesh.face_start = int32_t(lod.triangle_count);
+        submesh.face_count = uint32_t(simplified.triangles.size());
+
+        for(auto vertex : simplified.vertices)
+        {
+            std::memcpy(lod.vertex_data.data() + size_t(lod.vertex_count) * stride,
+                        source.vertex_data.data() + size_t(vertex) * stride,
+                        stride);
+            remap[vertex] = lod.vertex_count++;
+        }
+
+        for(auto tri : simplified.triangles)
+        {
+            for(auto& index : tri.indices)
+            {
+                index += uint32_t(submesh.vertex_start);
+            }
+            lod.triangle_data.emplace_back(tri);
+        }
+        lod.triangle_count += submesh.face_count;
+    }
+
+    for(const auto& bone : source.skin_data.get_bones())
+    {
+        auto lod_bone = bone;
+        lod_bone.influences.clear();
+        for(const auto& influence : bone.influences)
+        {
+            if(influence.vertex_index < remap.size() && remap[influence.vertex_index] != invalid_index)
+            {
+                lod_bone.influences.emplace_back(
+                    skin_bind_data::vertex_influence{remap[influence.vertex_index], influence.weight});
+            }
+        }
+        lod.skin_data.add_bone(lod_bone);
+    }
+
+    return lod;
+}
+
+} // namespace
+
+auto generate_mesh_lods(const mesh::load_data& source, const std::vector<float>& ratios)
+    -> std::vector<mesh::load_data>
+{
+    APPLOG_TRACE_PERF_NAMED(std::chrono::milliseconds, "Mesh Importer: Generate LODs");
+
+    std::vector<mesh::load_data> lods;
+    if(ratios.empty() || source.vertex_count == 0 || !source.vertex_format.has(gfx::attribute::Position))
+    {
+        return lods;
+    }
+
+    std::vector<math::vec3> positions(source.vertex_count);
+    for(uint32_t v = 0; v < source.vertex_count; ++v)
+    {
+        float position[4];
+        gfx::vertex_unpack(position, gfx::attribute::Position, source.vertex_format, source.vertex_data.data(), v);
+        positions[v] = math::vec3(position[0], position[1], position[2]);
+    }
+
+    // Dominant bone of every vertex, collapses never cross from one to another.
+    std::vector<int32_t> bones;
+    if(source.skin_data.has_bones())
+    {
+        bones.assign(source.vertex_count, -1);
+        std::vector<float> weights(source.vertex_count, 0.0f);
+
+        const auto& skin_bones = source.skin_data.get_bones();
+        for(size_t b = 0; b < skin_bones.size(); ++b)
+        {
+            for(const auto& influence : skin_bones[b].influences)
+            {
+                if(influence.vertex_index < source.vertex_count && influence.weight > weights[influence.vertex_index])
+                {
+                    weights[influence.vertex_index] = influence.weight;
+                    bones[influence.vertex_index] = int32_t(b);
+                }
+            }
+        }
+    }
+
+    const auto submesh_count = source.submeshes.size();
+    std::vector<std::vector<simplified_submesh>> results(ratios.size());
+    for(auto& level : results)
+    {
+        level.resize(submesh_count);
+    }
+
+    std::vector<size_t> jobs(ratios.size() * submesh_count);
+    std::iota(jobs.begin(), jobs.end(), size_t(0));
+
+    std::for_each(std::execution::par,
+                  jobs.begin(),
+                  jobs.end(),
+                  [&](size_t job)
+                  {
+                      auto level = job / submesh_count;
+                      auto submesh = job % submesh_count;
+                      results[level][submesh] =
+                          simplify_submesh(source, positions, bones, source.submeshes[submesh], ratios[level]);
+                  });
+
+    lods.reserve(ratios.size());
+    for(size_t level = 0; level < ratios.size(); ++level)
+    {
+        auto& lod = lods.emplace_back(assemble_lod(source, results[level]));
+
+        APPLOG_TRACE("Mesh Importer: LOD{} {} -> {} triangles", level + 1, source.triangle_count, lod.triangle_count);
+    }
+
+    return lods;
+}
+
+} // namespace importer
+} // namespace unravel
@@ -0,0 +1,29 @@
+#pragma once
+#include <engine/rendering/mesh.h>
+
+#include <vector>
+
+namespace unravel
+{
+namespace importer
+{
+
+/**
+ * @brief Generates simplified copies of a mesh, one for each of the given triangle ratios.
+ *
+ * Every submesh is simplified on its own with quadric error metrics using half edge collapses,
+ * so surviving vertices keep their original attributes. Identical vertices are welded and
+ * collapses move every vertex sharing a position together, so UV and normal seams collapse
+ * along themselves with consistent attributes on both sides. Only open and non-manifold
+ * borders are locked and collapses across skin weight boundaries are rejected. Levels and
+ * submeshes are simplified in parallel.
+ *
+ * @param source The mesh to simplify.
+ * @param ratios Fraction of the source triangles to keep for each generated level.
+ * @return One mesh per ratio.
+ */
+auto generate_mesh_lods(const mesh::load_data& source, const std::vector<float>& ratios)
+    -> std::vector<mesh::load_data>;
+
+} // namespace importer
+} // namespace unravel
@@ -0,0 +1,655 @@
+#include "texture_importer.h"
+
+#include <graphics/graphics.h>
+#include <logging/logging.h>
+#include <math/math.h>
+
+#include <bimg/bimg.h>
+#include <bimg/decode.h>
+#include <bimg/encode.h>
+#include <bx/allocator.h>
+#include <bx/file.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+
+#define POOLSTL_STD_SUPPLEMENT 1
+#include <poolstl/poolstl.hpp>
+
+namespace unravel
+{
+namespace importer
+{
+namespace
+{
+
+// Rows processed by a single job. Must be a multiple of every block height (4 for BCn).
+constexpr uint32_t strip_rows = 64;
+
+auto get_allocator() -> bx::AllocatorI*
+{
+    static bx::DefaultAllocator allocator;
+    return &allocator;
+}
+
+struct image_deleter
+{
+    void operator()(bimg::ImageContainer* image) const
+    {
+        if(image)
+        {
+            bimg::imageFree(image);
+        }
+    }
+};
+
+using image_ptr = std::unique_ptr<bimg::ImageContainer, image_deleter>;
+
+enum class color_space
+{
+    gamma,
+    linear,
+    normal
+};
+
+template<typename F>
+void for_each_strip(uint32_t height, uint32_t rows, F&& func)
+{
+    std::vector<uint32_t> starts;
+    starts.reserve((height + rows - 1) / rows);
+    for(uint32_t y = 0; y < height; y += rows)
+    {
+        starts.emplace_back(y);
+    }
+
+    std::for_each(std::execution::par,
+                  starts.begin(),
+                  starts.end(),
+                  [&](uint32_t y)
+                  {
+                      func(y, std::min(y + rows, height));
+                  });
+}
+
+auto srgb_to_linear(float c) -> float
+{
+    return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+}
+
+auto linear_to_srgb(float c) -> float
+{
+    c = math::clamp(c, 0.0f, 1.0f);
+    return c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+}
+
+void normalize_rgb(float* rgba)
+{
+    float len = std::sqrt(rgba[0] * rgba[0] + rgba[1] * rgba[1] + rgba[2] * rgba[2]);
+    if(len > 0.0f)
+    {
+        float inv = 1.0f / len;
+        rgba[0] *= inv;
+        rgba[1] *= inv;
+        rgba[2] *= inv;
+    }
+    else
+    {
+        rgba[0] = 0.0f;
+        rgba[1] = 0.0f;
+        rgba[2] = 1.0f;
+    }
+}
+
+// Moves the source data into the space used for filtering.
+void to_working_space(std::vector<float>& pixels, uint32_t width, uint32_t height, color_space space)
+{
+    if(space == color_space::linear)
+    {
+        return;
+    }
+
+    for_each_strip(height,
+                   strip_rows,
+                   [&](uint32_t y0, uint32_t y1)
+                   {
+                       float* rgba = pixels.data() + size_t(y0) * width * 4;
+                       float* end = pixels.data() + size_t(y1) * width * 4;
+                       for(; rgba < end; rgba += 4)
+                       {
+                           if(space == color_space::gamma)
+                           {
+                               rgba[0] = srgb_to_linear(rgba[0]);
+                               rgba[1] = srgb_to_linear(rgba[1]);
+                               rgba[2] = srgb_to_linear(rgba[2]);
+                           }
+                           else
+                           {
+                               rgba[0] = rgba[0] * 2.0f - 1.0f;
+                               rgba[1] = rgba[1] * 2.0f - 1.0f;
+                               rgba[2] = rgba[2] * 2.0f - 1.0f;
+                               normalize_rgb(rgba);
+                           }
+                       }
+                   });
+}
+
+// Moves filtered data back into the space expected by the encoder.
+void from_working_space(std::vector<float>& pixels, uint32_t width, uint32_t height, color_space space)
+{
+    if(space == color_space::linear)
+    {
+        return;
+    }
+
+    for_each_strip(height,
+                   strip_rows,
+                   [&](uint32_t y0, uint32_t y1)
+                   {
+                       float* rgba = pixels.data() + size_t(y0) * width * 4;
+                       float* end = pixels.data() + size_t(y1) * width * 4;
+                       for(; rgba < end; rgba += 4)
+                       {
+                           if(space == color_space::gamma)
+                           {
+                               rgba[0] = linear_to_srgb(rgba[0]);
+                               rgba[1] = linear_to_srgb(rgba[1]);
+                               rgba[2] = linear_to_srgb(rgba[2]);
+                           }
+                           else
+                           {
+                               rgba[0] = rgba[0] * 0.5f + 0.5f;
+                               rgba[1] = rgba[1] * 0.5f + 0.5f;
+                               rgba[2] = rgba[2] * 0.5f + 0.5f;
+                           }
+                       }
+                   });
+}
+
+// 2x2 box filter. Odd edges are clamped, normals are renormalized.
+auto downsample(const std::vector<float>& src, uint32_t width, uint32_t height, color_space space)
+    -> std::vector<float>
+{
+    const uint32_t dst_width = std::max(1u, width >> 1);
+    const uint32_t dst_height = std::max(1u, height >> 1);
+
+    std::vector<float> dst(size_t(dst_width) * dst_height * 4);
+
+    for_each_strip(dst_height,
+                   strip_rows,
+                   [&](uint32_t y0, uint32_t y1)
+                   {
+                       for(uint32_t y = y0; y < y1; ++y)
+                       {
+                           const uint32_t sy0 = std::min(y * 2, height - 1);
+                           const uint32_t sy1 = std::min(y * 2 + 1, height - 1);
+
+                           for(uint32_t x = 0; x < dst_width; ++x)
+                           {
+                               const uint32_t sx0 = std::min(x * 2, width - 1);
+                               const uint32_t sx1 = std::min(x * 2 + 1, width - 1);
+
+                               const float* s00 = &src[(size_t(sy0) * width + sx0) * 4];
+                               const float* s01 = &src[(size_t(sy0) * width + sx1) * 4];
+                               const float* s10 = &src[(size_t(sy1) * width + sx0) * 4];
+                               const float* s11 = &src[(size_t(sy1) * width + sx1) * 4];
+
+                               float* d = &dst[(size_t(y) * dst_width + x) * 4];
+                               for(uint32_t c = 0; c < 4; ++c)
+                               {
+                                   d[c] = (s00[c] + s01[c] + s10[c] + s11[c]) * 0.25f;
+                               }
+
+                               if(space == color_space::normal)
+                               {
+                                   normalize_rgb(d);
+                               }
+                           }
+                       }
+                   });
+
+    return dst;
+}
+
+// Encodes a single mip. Block rows are independent so the image is split into strips of whole
+// blocks which are compressed in parallel straight into their final location.
+auto encode_mip(uint8_t* dst,
+                const std::vector<float>& src,
+                uint32_t width,
+                uint32_t height,
+                bimg::TextureFormat::Enum format,
+                bimg::Quality::Enum quality) -> bool
+{
+    const auto& block_info = bimg::getBlockInfo(format);
+    const uint32_t block_width = block_info.blockWidth;
+    const uint32_t block_height = block_info.blockHeight;
+    const uint32_t blocks_x = std::max<uint32_t>(block_info.minBlockX, (width + block_width - 1) / block_width);
+    const uint32_t block_row_pitch = blocks_x * block_info.blockSize;
+
+    if(height <= strip_rows || height % block_height != 0)
+    {
+        bx::Error err;
+        bimg::imageEncodeFromRgba32f(get_allocator(), dst, src.data(), width, height, 1, format, quality, &err);
+        return err.isOk();
+    }
+
+    std::atomic_bool ok{true};
+    for_each_strip(height,
+                   strip_rows,
+                   [&](uint32_t y0, uint32_t y1)
+                   {
+                       bx::Error err;
+                       bimg::imageEncodeFromRgba32f(get_allocator(),
+                                                    dst + size_t(y0 / block_height) * block_row_pitch,
+                                                    src.data() + size_t(y0) * width * 4,
+                                                    width,
+                                                    y1 - y0,
+                                                    1,
+                                                    format,
+                                                    quality,
+                                                    &err);
+                       if(!err.isOk())
+                       {
+                           ok = false;
+                       }
+                   });
+
+    return ok;
+}
+
+auto get_max_size(texture_importer_meta::texture_size size) -> uint32_t
+{
+    switch(size)
+    {
+        case texture_importer_meta::texture_size::size_32:
+            return 32;
+        case texture_importer_meta::texture_size::size_64:
+            return 64;
+        case texture_importer_meta::texture_size::size_128:
+            return 128;
+        case texture_importer_meta::texture_size::size_256:
+            return 256;
+        case texture_importer_meta::texture_size::size_512:
+            return 512;
+        case texture_importer_meta::texture_size::size_1024:
+            return 1024;
+        case texture_importer_meta::texture_size::size_2048:
+            return 2048;
+        case texture_importer_meta::texture_size::size_4096:
+            return 4096;
+        case texture_importer_meta::texture_size::size_8192:
+            return 8192;
+        case texture_importer_meta::texture_size::size_16384:
+            return 16384;
+        default:
+            return 0;
+    }
+}
+
+auto get_quality(gfx::texture_format format, const texture_importer_meta& import_meta) -> bimg::Quality::Enum
+{
+    bool highest = import_meta.quality.compression == texture_importer_meta::compression_quality::high_quality;
+
+    // BC6H/BC7 highest mode searches every partition. Default already beats BC1/BC3 at highest.
+    if(format == gfx::texture_format::BC6H || format == gfx::texture_format::BC7)
+    {
+        highest = false;
+    }
+
+    if(import_meta.type == texture_importer_meta::texture_type::normal_map)
+    {
+        return highest ? bimg::Quality::NormalMapHighest : bimg::Quality::NormalMapDefault;
+    }
+
+    return highest ? bimg::Quality::Highest : bimg::Quality::Default;
+}
+
+auto select_compressed_format(gfx::texture_format input_format,
+                              const fs::path& extension,
+                              texture_importer_meta::compression_quality quality) -> gfx::texture_format
+{
+    if(quality == texture_importer_meta::compression_quality::none)
+    {
+        return gfx::texture_format::Unknown;
+    }
+
+    auto info = gfx::get_format_info(input_format);
+
+    if(extension == ".hdr" || extension == ".exr")
+    {
+        info.is_hdr = true;
+    }
+
+    // 1) HDR? Use BC6H for color data, ignoring alpha (HDR with alpha is non-trivial).
+    if(info.is_hdr)
+    {
+        // BC6H: color (RGB) 16F
+        // No standard BC format for HDR alpha in the block-compression range.
+        return gfx::texture_format::BC6H;
+    }
+
+    // 2) Single channel => BC4
+    //    e.g., for grayscale height map or single-channel mask
+    if(info.num_hannels == 1)
+    {
+        return gfx::texture_format::BC4;
+    }
+
+    // 3) Two channel => BC5
+    //    e.g., typical for 2D vector data, normal map XY
+    if(info.num_hannels == 2)
+    {
+        return gfx::texture_format::BC5;
+    }
+
+    // 4) If we reach here, we have 3 or 4 channels in LDR.
+
+    // 4a) No alpha needed => choose BC1 or BC7, etc.
+    if(!info.has_alpha_channel)
+    {
+        switch(quality)
+        {
+            case texture_importer_meta::compression_quality::low_quality:
+                // BC1 is cheap and has no alpha
+                return gfx::texture_format::BC1;
+            case texture_importer_meta::compression_quality::normal_quality:
+                // BC1 is standard for color w/out alpha
+                return gfx::texture_format::BC1;
+            case texture_importer_meta::compression_quality::high_quality:
+                // BC7 is higher quality for color, also supports alpha but not needed here.
+                return gfx::texture_format::BC7;
+            default:
+                break;
+        }
+        // fallback
+        return gfx::texture_format::BC1;
+    }
+    else
+    {
+        // 4b) We do have alpha => choose BC2, BC3, or BC7.
+        // BC2 (DXT3) is old and rarely used except for sharp alpha transitions.
+        // BC3 (DXT5) is the typical solution for alpha textures if BC7 is not an option.
+        // BC7 is better (but bigger decode cost).
+        switch(quality)
+        {
+            case texture_importer_meta::compression_quality::low_quality:
+                return gfx::texture_format::BC3;
+            case texture_importer_meta::compression_quality::normal_quality:
+                return gfx::texture_format::BC3; // DXT5
+            case texture_importer_meta::compression_quality::high_quality:
+                //  BC7 is best BC for RGBA
+                return gfx::texture_format::BC7;
+            default:
+                break;
+        }
+        // fallback
+        return gfx::texture_format::BC3;
+    }
+}
+
+// The RGBA32F conversion puts gray in red and gray+alpha in red and green, spread them to rgb and alpha.
+void expand_gray_channels(bimg::ImageContainer& image, bool has_alpha)
+{
+    auto* data = reinterpret_cast<float*>(image.m_data);
+    const size_t count = image.m_size / (sizeof(float) * 4);
+    for(size_t i = 0; i < count; ++i)
+    {
+        float* pixel = data + i * 4;
+        pixel[3] = has_alpha ? pixel[1] : 1.0f;
+        pixel[1] = pixel[0];
+        pixel[2] = pixel[0];
+    }
+}
+
+auto write_dds(const fs::path& output_path, bimg::ImageContainer& image) -> bool
+{
+    bx::FileWriter writer;
+    bx::Error err;
+
+    if(!bx::open(&writer, output_path.string().c_str(), false, &err))
+    {
+        return false;
+    }
+
+    bimg::imageWriteDds(&writer, image, image.m_data, image.m_size, &err);
+    bx::close(&writer);
+
+    return err.isOk();
+}
+
+auto load_image(const fs::path& input_path) -> image_ptr
+{
+    std::ifstream stream(input_path, std::ios::in | std::ios::binary);
+    if(!stream.is_open())
+    {
+        return nullptr;
+    }
+
+    auto data = fs::read_stream(stream);
+    if(data.empty())
+    {
+        return nullptr;
+    }
+
+    bx::Error err;
+    return image_ptr(bimg::imageParse(get_allocator(),
+                                      data.data(),
+                                      static_cast<uint32_t>(data.size()),
+                                      bimg::TextureFormat::Count,
+                                      &err));
+}
+
+} // namespace
+
+auto compile_texture_to_file(const fs::path& input_path,
+                             const fs::path& output_path,
+                             const texture_importer_meta& import_meta,
+                             bool allow_compression) -> bool
+{
+    using clock_t = std::chrono::steady_clock;
+    const auto start = clock_t::now();
+
+    std::string str_input = input_path.string();
+
+    auto input = load_image(input_path);
+    if(!input)
+    {
+        APPLOG_ERROR("Failed compilation of {0} with error: Unable to decode image.", str_input);
+        return false;
+    }
+
+    const auto extension = input_path.extension();
+    const auto input_format = static_cast<gfx::texture_format>(input->m_format);
+    const auto input_info = gfx::get_format_info(input_format);
+    const bool is_hdr = input_info.is_hdr || extension == ".hdr" || extension == ".exr";
+    const bool is_normal_map = import_meta.type == texture_importer_meta::texture_type::normal_map;
+    const bool is_equirect = import_meta.type == texture_importer_meta::texture_type::equirect;
+    const bool is_mask = import_meta.type == texture_importer_meta::texture_type::mask;
+
+    // Decoders often hand out RGBA8 for opaque images, don't pay for an alpha block we don't need.
+    auto selection_format = input_format;
+    if(input_info.num_hannels == 4 && !input->m_hasAlpha && !is_hdr)
+    {
+        selection_format = gfx::texture_format::RGB8;
+    }
+
+    // BC4 and BC5 only keep red and green. Grayscale (with alpha) color is compressed as color instead,
+    // with the gray value spread over rgb, unless the texture holds data read from those channels.
+    const bool expand_gray = !is_hdr && !is_normal_map && !is_mask &&
+                             (input_info.num_hannels == 1 || input_info.num_hannels == 2);
+    if(expand_gray)
+    {
+        selection_format = input_info.num_hannels == 1 ? gfx::texture_format::RGB8 : gfx::texture_format::RGBA8;
+    }
+
+    auto format = gfx::texture_format::Unknown;
+    if(allow_compression)
+    {
+        format = select_compressed_format(selection_format, extension, import_meta.quality.compression);
+    }
+
+    auto output_format = format != gfx::texture_format::Unknown ? static_cast<bimg::TextureFormat::Enum>(format)
+                                                                 : input->m_format;
+
+    uint32_t width = input->m_width;
+    uint32_t height = input->m_height;
+    const uint32_t max_size = get_max_size(import_meta.quality.max_size);
+    const bool can_resize = !input->m_cubeMap && input->m_depth <= 1;
+    if(can_resize && max_size > 0 && (width > max_size || height > max_size))
+    {
+        const float scale = float(max_size) / float(std::max(width, height));
+        width = std::max(1u, uint32_t(float(width) * scale));
+        height = std::max(1u, uint32_t(float(height) * scale));
+    }
+
+    const bool needs_resize = width != input->m_width || height != input->m_height;
+    const bool needs_mips = import_meta.generate_mipmaps && input->m_numMips <= 1;
+    const bool needs_processing = output_format != input->m_format || needs_resize || needs_mips || is_normal_map ||
+                                  is_equirect;
+    const bool needs_gray_expansion = expand_gray && bimg::isCompressed(output_format);
+
+    // Volume textures and arrays are passed through as they are.
+    if(!needs_processing || input->m_depth > 1 || input->m_numLayers > 1)
+    {
+        if(!write_dds(output_path, *input))
+        {
+            APPLOG_ERROR("Failed compilation of {0} with error: Unable to write {1}.", str_input, output_path.string());
+            return false;
+        }
+        return true;
+    }
+
+    if(bimg::isCompressed(output_format))
+    {
+        APPLOG_TRACE("Compressing {0} to {1}.", str_input, gfx::to_string(static_cast<gfx::texture_format>(output_format)));
+    }
+
+    image_ptr source(bimg::imageConvert(get_allocator(), bimg::TextureFormat::RGBA32F, *input, false));
+    input.reset();
+
+    if(!source)
+    {
+        APPLOG_ERROR("Failed compilation of {0} with error: Unable to convert image.", str_input);
+        return false;
+    }
+
+    if(needs_gray_expansion)
+    {
+        expand_gray_channels(*source, input_info.num_hannels == 2);
+    }
+
+    if(needs_resize)
+    {
+        image_ptr resized(bimg::imageAlloc(get_allocator(),
+                                           bimg::TextureFormat::RGBA32F,
+                                           uint16_t(width),
+                                           uint16_t(height),
+                                           1,
+                                           1,
+                                           false,
+                                           false));
+
+        if(!bimg::imageResizeRgba32fLinear(resized.get(), source.get()))
+        {
+            APPLOG_ERROR("Failed compilation of {0} with error: Unable to resize image.", str_input);
+            return false;
+        }
+        source = std::move(resized);
+    }
+
+    if(is_equirect && !source->m_cubeMap)
+    {
+        bx::Error err;
+        image_ptr cube(bimg::imageCubemapFromLatLongRgba32F(get_allocator(), *source, true, &err));
+        if(!cube || !err.isOk())
+        {
+            APPLOG_ERROR("Failed compilation of {0} with error: Unable to convert equirect image to cubemap.",
+                         str_input);
+            return false;
+        }
+        source = std::move(cube);
+    }
+
+    width = source->m_width;
+    height = source->m_height;
+
+    image_ptr output(bimg::imageAlloc(get_allocator(),
+                                      output_format,
+                                      uint16_t(width),
+                                      uint16_t(height),
+                                      1,
+                                      1,
+                                      source->m_cubeMap,
+                                      import_meta.generate_mipmaps));
+    if(!output)
+    {
+        APPLOG_ERROR("Failed compilation of {0} with error: Unable to allocate output image.", str_input);
+        return false;
+    }
+
+    const auto space = is_normal_map ? color_space::normal : (is_hdr ? color_space::linear : color_space::gamma);
+    const auto quality = get_quality(static_cast<gfx::texture_format>(output_format), import_meta);
+    const uint16_t sides = source->m_cubeMap ? 6 : 1;
+
+    for(uint16_t side = 0; side < sides; ++side)
+    {
+        bimg::ImageMip src_mip;
+        bimg::imageGetRawData(*source, side, 0, source->m_data, source->m_size, src_mip);
+
+        const auto* src_data = reinterpret_cast<const float*>(src_mip.m_data);
+        std::vector<float> level(src_data, src_data + size_t(width) * height * 4);
+        to_working_space(level, width, height, space);
+
+        uint32_t level_width = width;
+        uint32_t level_height = height;
+
+        for(uint8_t lod = 0; lod < output->m_numMips; ++lod)
+        {
+            bimg::ImageMip dst_mip;
+            bimg::imageGetRawData(*output, side, lod, output->m_data, output->m_size, dst_mip);
+
+            std::vector<float> encode_src = level;
+            from_working_space(encode_src, level_width, level_height, space);
+
+            if(!encode_mip(const_cast<uint8_t*>(dst_mip.m_data),
+                           encode_src,
+                           level_width,
+                           level_height,
+                           output_format,
+                           quality))
+            {
+                APPLOG_ERROR("Failed compilation of {0} with error: Unable to encode mip {1}.", str_input, lod);
+                return false;
+            }
+
+            if(lod + 1 < output->m_numMips)
+            {
+                level = downsample(level, level_width, level_height, space);
+                level_width = std::max(1u, level_width >> 1);
+                level_height = std::max(1u, level_height >> 1);
+            }
+        }
+    }
+
+    if(!write_dds(output_path, *output))
+    {
+        APPLOG_ERROR("Failed compilation of {0} with error: Unable to write {1}.", str_input, output_path.string());
+        return false;
+    }
+
+    const auto elapsed = std::chrono::duration<double>(clock_t::now() - start).count();
+    const double mpixels = double(width) * double(height) * double(sides) / 1000000.0;
+    APPLOG_TRACE("Compiled {0} ({1}x{2} {3}) in {4:.2f}ms - {5:.2f} MPix/s",
+                 str_input,
+                 width,
+                 height,
+                 gfx::to_string(static_cast<gfx::texture_format>(output_format)),
+                 elapsed * 1000.0,
+                 elapsed > 0.0 ? mpixels / elapsed : 0.0);
+
+    return true;
+}
+
+} // namespace importer
+} // namespace unravel
@@ -0,0 +1,28 @@
+#pragma once
+#include <engine/assets/asset_manager.h>
+#include <filesystem/filesystem.h>
+
+namespace unravel
+{
+namespace importer
+{
+
+/**
+ * @brief Compiles a source image into a dds texture without spawning an external process.
+ *
+ * Decoding, resizing, mip generation and block compression all run in-process. Block compression
+ * is split into horizontal strips of whole blocks which are encoded in parallel.
+ *
+ * @param input_path The source image.
+ * @param output_path The dds file to write.
+ * @param import_meta The importer settings. Project defaults must already be resolved.
+ * @param allow_compression Whether block compression is allowed for this texture.
+ * @return True on success.
+ */
+auto compile_texture_to_file(const fs::path& input_path,
+                             const fs::path& output_path,
+                             const texture_importer_meta& import_meta,
+                             bool allow_compression) -> bool;
+
+} // namespace importer
+} // namespace unravel
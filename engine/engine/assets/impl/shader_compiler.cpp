@@ -0,0 +1,608 @@
+#include "shader_compiler.h"
+#include "asset_compiler.h"
+#include "asset_writer.h"
+
+#include <logging/logging.h>
+
+#include <hpp/crc.hpp>
+#include <hpp/string_view.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <unordered_set>
+
+#define POOLSTL_STD_SUPPLEMENT 1
+#include <poolstl/poolstl.hpp>
+
+namespace unravel
+{
+namespace shader_compiler
+{
+namespace
+{
+
+struct target
+{
+    std::string platform;
+    std::string profile;
+    std::string type;
+    std::string opt = "3";
+};
+
+// Keys currently being compiled. Jobs producing the same key wait for the first one and then
+// pick the result up from the cache.
+struct in_flight_keys
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::unordered_set<uint64_t> keys;
+
+    void acquire(uint64_t key)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock,
+                [&]()
+                {
+                    return !keys.contains(key);
+                });
+        keys.insert(key);
+    }
+
+    void release(uint64_t key)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            keys.erase(key);
+        }
+        cv.notify_all();
+    }
+};
+
+auto get_in_flight_keys() -> in_flight_keys&
+{
+    static in_flight_keys keys;
+    return keys;
+}
+
+// Bytes the cache may hold before its least recently used entries are removed.
+constexpr uintmax_t cache_budget = 256ull * 1024 * 1024;
+// Compiles between two checks of the cache size.
+constexpr uint32_t cache_trim_interval = 64;
+
+auto get_target(const std::string& file, gfx::renderer_type renderer) -> target
+{
+    target result;
+
+    bool vs = hpp::string_view(file).starts_with("vs_");
+    bool fs = hpp::string_view(file).starts_with("fs_");
+    bool cs = hpp::string_view(file).starts_with("cs_");
+
+    if(renderer == gfx::renderer_type::Vulkan)
+    {
+        result.platform = "windows";
+        result.profile = "spirv";
+    }
+
+    if(renderer == gfx::renderer_type::Direct3D11 || renderer == gfx::renderer_type::Direct3D12)
+    {
+        result.platform = "windows";
+
+        if(vs || fs)
+        {
+            result.profile = "s_5_0";
+            result.opt = "3";
+        }
+        else if(cs)
+        {
+            result.profile = "s_5_0";
+            result.opt = "1";
+        }
+    }
+    else if(renderer == gfx::renderer_type::OpenGLES)
+    {
+        result.platform = "android";
+        result.profile = "100_es";
+    }
+    else if(renderer == gfx::renderer_type::OpenGL)
+    {
+        result.platform = "linux";
+
+        if(vs || fs)
+            result.profile = "140";
+        else if(cs)
+            result.profile = "430";
+    }
+    else if(renderer == gfx::renderer_type::Metal)
+    {
+        result.platform = "osx";
+        result.profile = "metal";
+    }
+
+    if(vs)
+        result.type = "vertex";
+    else if(fs)
+        result.type = "fragment";
+    else if(cs)
+        result.type = "compute";
+    else
+        result.type = "unknown";
+
+    return result;
+}
+
+auto get_defines() -> std::vector<std::string>
+{
+    return {"BGFX_CONFIG_MAX_BONES=" + std::to_string(gfx::get_max_blend_transforms())};
+}
+
+auto find_varying(const fs::path& input) -> fs::path
+{
+    std::string file = input.stem().string();
+    fs::path dir = input.parent_path();
+
+    fs::path varying = dir / (file + ".io");
+
+    fs::error_code err;
+    if(!fs::exists(varying, err))
+    {
+        varying = dir / "varying.def.io";
+    }
+    if(!fs::exists(varying, err))
+    {
+        varying = dir / "varying.def.sc";
+    }
+
+    return varying;
+}
+
+// Removes comments and collapses whitespace so that edits which cannot change the generated
+// code do not change the key.
+auto normalize_line(const std::string& line, bool& in_block_comment) -> std::string
+{
+    std::string result;
+    result.reserve(line.size());
+
+    bool pending_space = false;
+    for(size_t i = 0; i < line.size(); ++i)
+    {
+        char c = line[i];
+        char next = i + 1 < line.size() ? line[i + 1] : '\0';
+
+        if(in_block_comment)
+        {
+            if(c == '*' && next == '/')
+            {
+                in_block_comment = false;
+                ++i;
+            }
+            continue;
+        }
+
+        if(c == '/' && next == '/')
+        {
+            break;
+        }
+
+        if(c == '/' && next == '*')
+        {
+            in_block_comment = true;
+            pending_space = true;
+            ++i;
+            continue;
+        }
+
+        if(c == ' ' || c == '\t' || c == '\r')
+        {
+            pending_space = true;
+            continue;
+        }
+
+        if(pending_space && !result.empty())
+        {
+            result.push_back(' ');
+        }
+        pending_space = false;
+        result.push_back(c);
+    }
+
+    return result;
+}
+
+auto resolve_include(const std::string& line, const fs::path& current_dir, const std::vector<fs::path>& include_dirs)
+    -> fs::path
+{
+    size_t start = line.find_first_of("\"<");
+    size_t end = line.find_last_of("\">");
+
+    if(start == std::string::npos || end == std::string::npos || start >= end)
+    {
+        return {};
+    }
+
+    std::string include_path = line.substr(start + 1, end - start - 1);
+    fs::error_code err;
+
+    if(line[start] == '"')
+    {
+        auto local = current_dir / include_path;
+        if(fs::exists(local, err))
+        {
+            return fs::absolute(local, err);
+        }
+    }
+
+    for(const auto& dir : include_dirs)
+    {
+        auto candidate = dir / include_path;
+        if(fs::exists(candidate, err))
+        {
+            return fs::absolute(candidate, err);
+        }
+    }
+
+    return {};
+}
+
+// Expands includes in place. Each file is expanded once, mirroring the include guards
+// every bgfx shader header uses.
+void expand_source(const fs::path& file_path,
+                   const std::vector<fs::path>& include_dirs,
+                   std::set<fs::path>& visited,
+                   std::string& out)
+{
+    if(!visited.insert(file_path).second)
+    {
+        return;
+    }
+
+    std::ifstream file(file_path);
+    if(!file.is_open())
+    {
+        return;
+    }
+
+    static const std::string include_keyword = "#include";
+
+    bool in_block_comment = false;
+    std::string line;
+    while(std::getline(file, line))
+    {
+        auto normalized = normalize_line(line, in_block_comment);
+        if(normalized.empty())
+        {
+            continue;
+        }
+
+        if(normalized.compare(0, include_keyword.length(), include_keyword) == 0)
+        {
+            auto resolved = resolve_include(normalized, file_path.parent_path(), include_dirs);
+            if(!resolved.empty())
+            {
+                expand_source(resolved, include_dirs, visited, out);
+                continue;
+            }
+        }
+
+        out += normalized;
+        out += '\n';
+    }
+}
+
+auto get_tool_stamp(const fs::path& tool) -> std::string
+{
+    fs::error_code err;
+    auto time = fs::last_write_time(tool, err);
+    auto size = fs::file_size(tool, err);
+    return std::to_string(time.time_since_epoch().count()) + ":" + std::to_string(err ? 0 : size);
+}
+
+auto make_key(const std::string& source, const target& tgt, const std::vector<std::string>& defines, const std::string& tool_stamp)
+    -> uint64_t
+{
+    std::string signature = source;
+    signature += "\n#target " + tgt.type + " " + tgt.platform + " " + tgt.profile + " O" + tgt.opt;
+    for(const auto& define : defines)
+    {
+        signature += "\n#define " + define;
+    }
+    signature += "\n#tool " + tool_stamp;
+
+    return hpp::crc64(signature.data(), signature.size());
+}
+
+auto get_cache_file(const fs::path& cache_dir, uint64_t key) -> fs::path
+{
+    return cache_dir / fmt::format("{:016x}.bin", key);
+}
+
+auto files_equal(const fs::path& lhs, const fs::path& rhs) -> bool
+{
+    fs::error_code err;
+    if(!fs::exists(lhs, err) || !fs::exists(rhs, err))
+    {
+        return false;
+    }
+
+    if(fs::file_size(lhs, err) != fs::file_size(rhs, err) || err)
+    {
+        return false;
+    }
+
+    std::ifstream lhs_stream(lhs, std::ios::in | std::ios::binary);
+    std::ifstream rhs_stream(rhs, std::ios::in | std::ios::binary);
+
+    return fs::read_stream(lhs_stream) == fs::read_stream(rhs_stream);
+}
+
+auto run_shaderc(const fs::path& input,
+                 const fs::path& output,
+                 const fs::path& varying,
+                 const fs::path& include,
+                 const target& tgt,
+                 const std::vector<std::string>& defines,
+                 std::string& err) -> bool
+{
+    std::vector<std::string> args_array = {
+        "-f",
+        input.string(),
+        "-o",
+        output.string(),
+        "-i",
+        include.string(),
+        "--varyingdef",
+        varying.string(),
+        "--type",
+        tgt.type,
+        //        "--Werror"
+    };
+
+    for(const auto& define : defines)
+    {
+        args_array.emplace_back("--define");
+        args_array.emplace_back(define);
+    }
+
+    if(!tgt.platform.empty())
+    {
+        args_array.emplace_back("--platform");
+        args_array.emplace_back(tgt.platform);
+    }
+
+    if(!tgt.profile.empty())
+    {
+        args_array.emplace_back("-p");
+        args_array.emplace_back(tgt.profile);
+    }
+
+    if(!tgt.opt.empty())
+    {
+        args_array.emplace_back("-O");
+        args_array.emplace_back(tgt.opt);
+    }
+
+    // Create an empty file at the output location
+    {
+        std::ofstream output_file(output.string());
+        (void)output_file;
+    }
+
+    auto shaderc = fs::resolve_protocol("binary:/shaderc");
+    return asset_compiler::run_process(shaderc.string(), args_array, true, err);
+}
+
+// Hits refresh the write time of their entry, which orders the entries for eviction.
+void touch_cache_file(const fs::path& cache_file)
+{
+    fs::error_code err;
+    fs::last_write_time(cache_file, fs::now(), err);
+}
+
+// Removes the least recently used entries once the cache grows past its budget, down to three
+// quarters of it so the next trims have nothing to do for a while.
+void trim_cache(const fs::path& cache_dir)
+{
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock(mutex);
+
+    struct entry
+    {
+        fs::path path;
+        fs::file_time_type time;
+        uintmax_t size{};
+    };
+
+    std::vector<entry> entries;
+    uintmax_t total = 0;
+
+    fs::error_code err;
+    for(const auto& it : fs::directory_iterator(cache_dir, err))
+    {
+        if(!it.is_regular_file(err) || it.path().extension() != ".bin")
+        {
+            continue;
+        }
+
+        auto& e = entries.emplace_back();
+        e.path = it.path();
+        e.time = it.last_write_time(err);
+        e.size = it.file_size(err);
+        total += e.size;
+    }
+
+    if(total <= cache_budget)
+    {
+        return;
+    }
+
+    std::sort(entries.begin(),
+              entries.end(),
+              [](const entry& lhs, const entry& rhs)
+              {
+                  return lhs.time < rhs.time;
+              });
+
+    size_t removed = 0;
+    for(const auto& e : entries)
+    {
+        if(total <= cache_budget / 4 * 3)
+        {
+            break;
+        }
+
+        if(fs::remove(e.path, err))
+        {
+            total -= e.size;
+            removed++;
+        }
+    }
+
+    APPLOG_TRACE("Removed {0} least recently used entries from the shader cache.", removed);
+}
+
+// Makes sure the cache holds the bytecode for the key, invoking shaderc only on a miss.
+auto ensure_cached(const fs::path& input,
+                   const fs::path& cache_file,
+                   const fs::path& varying,
+                   const fs::path& include,
+                   const target& tgt,
+                   const std::vector<std::string>& defines) -> bool
+{
+    fs::error_code err;
+    if(fs::exists(cache_file, err))
+    {
+        touch_cache_file(cache_file);
+        return true;
+    }
+
+    fs::path temp;
+    if(!asset_writer::make_temp_path(cache_file.parent_path(), temp, err))
+    {
+        APPLOG_ERROR("Failed compilation of {0} with error: {1}", input.string(), err.message());
+        return false;
+    }
+
+    std::string error;
+    if(!run_shaderc(input, temp, varying, include, tgt, defines, error))
+    {
+        fs::remove(temp, err);
+        APPLOG_ERROR("Failed compilation of {0} ({1} {2}) with error: {3}",
+                     input.string(),
+                     tgt.platform,
+                     tgt.profile,
+                     error);
+        return false;
+    }
+
+    if(!asset_writer::atomic_rename_file(temp, cache_file, err))
+    {
+        fs::remove(temp, err);
+        APPLOG_ERROR("Failed compilation of {0} with error: {1}", input.string(), err.message());
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace
+
+auto compile(const fs::path& input, const std::vector<variant>& variants, const fs::path& cache_dir) -> bool
+{
+    if(variants.empty())
+    {
+        return true;
+    }
+
+    fs::error_code err;
+    fs::create_directories(cache_dir, err);
+
+    const fs::path include = fs::resolve_protocol("engine:/data/shaders");
+    const fs::path varying = find_varying(input);
+    const std::vector<fs::path> include_dirs = {include};
+    const auto defines = get_defines();
+    const auto tool_stamp = get_tool_stamp(fs::resolve_protocol("binary:/shaderc"));
+
+    // The preprocessed source is the same for every variant.
+    std::string source;
+    {
+        std::set<fs::path> visited;
+        expand_source(fs::absolute(input, err), include_dirs, visited, source);
+        source += "\n#varying\n";
+        expand_source(fs::absolute(varying, err), include_dirs, visited, source);
+    }
+
+    struct job
+    {
+        target tgt;
+        std::vector<fs::path> outputs;
+    };
+
+    std::map<uint64_t, job> jobs;
+    const auto file = input.stem().string();
+    for(const auto& v : variants)
+    {
+        auto tgt = get_target(file, v.renderer);
+        auto key = make_key(source, tgt, defines, tool_stamp);
+
+        auto& j = jobs[key];
+        j.tgt = tgt;
+        j.outputs.emplace_back(v.output);
+    }
+
+    std::atomic_bool result{true};
+
+    std::for_each(std::execution::par,
+                  jobs.begin(),
+                  jobs.end(),
+                  [&](const auto& kvp)
+                  {
+                      const auto& [key, j] = kvp;
+                      const auto cache_file = get_cache_file(cache_dir, key);
+
+                      auto& in_flight = get_in_flight_keys();
+                      in_flight.acquire(key);
+                      bool cached = ensure_cached(input, cache_file, varying, include, j.tgt, defines);
+                      in_flight.release(key);
+
+                      if(!cached)
+                      {
+                          result = false;
+                          return;
+                      }
+
+                      for(const auto& output : j.outputs)
+                      {
+                          // Leave identical outputs alone so watchers don't reload them.
+                          if(files_equal(cache_file, output))
+                          {
+                              APPLOG_TRACE("Shader {0} is up to date.", output.filename().string());
+                              continue;
+                          }
+
+                          fs::error_code ec;
+                          if(!asset_writer::atomic_copy_file(cache_file, output, ec))
+                          {
+                              APPLOG_ERROR("Failed compilation of {0} -> {1} with error: {2}",
+                                           input.string(),
+                                           output.filename().string(),
+                                           ec.message());
+                              result = false;
+                          }
+                      }
+                  });
+
+    static std::atomic<uint32_t> compiles{};
+    if(compiles++ % cache_trim_interval == 0)
+    {
+        trim_cache(cache_dir);
+    }
+
+    return result;
+}
+
+} // namespace shader_compiler
+} // namespace unravel
@@ -0,0 +1,41 @@
+#pragma once
+#include <filesystem/filesystem.h>
+#include <graphics/graphics.h>
+
+#include <vector>
+
+namespace unravel
+{
+namespace shader_compiler
+{
+
+/**
+ * @struct variant
+ * @brief A single compiled output of a shader source.
+ */
+struct variant
+{
+    /// The compiled file to produce.
+    fs::path output;
+    /// The renderer the output targets.
+    gfx::renderer_type renderer{gfx::renderer_type::Noop};
+};
+
+/**
+ * @brief Compiles a shader source into all requested variants.
+ *
+ * Every variant is keyed by a hash of its preprocessed source (includes expanded, comments and
+ * whitespace normalized), defines and target. Variants sharing a key are compiled once, keys that
+ * are already in the cache are not compiled at all and outputs whose content is unchanged are left
+ * untouched. The remaining variants are compiled in parallel. Cache hits refresh their entry and
+ * the least recently used entries are removed once the cache grows past its size budget.
+ *
+ * @param input The shader source.
+ * @param variants The outputs to produce.
+ * @param cache_dir Directory where compiled bytecode is cached by key.
+ * @return True if every variant was produced.
+ */
+auto compile(const fs::path& input, const std::vector<variant>& variants, const fs::path& cache_dir) -> bool;
+
+} // namespace shader_compiler
+} // namespace unravel
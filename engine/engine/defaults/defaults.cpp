@@ -1,6 +1,7 @@
 #include "defaults.h"
 
 #include <engine/assets/asset_manager.h>
+#include <engine/assets/impl/asset_extensions.h>
 
 #include <engine/animation/ecs/components/animation_component.h>
 #include <engine/audio/ecs/components/audio_listener_component.h>
@@ -455,6 +456,17 @@ auto defaults::create_mesh_entity_at(rtti::context& ctx, scene& scn, const std::
     model mdl;
     mdl.set_lod(asset, 0);
 
+    // Levels of detail generated by the importer.
+    for(uint32_t lod = 1;; ++lod)
+    {
+        auto lod_asset = am.find_asset<mesh>(ex::get_mesh_lod_key(key, lod));
+        if(!lod_asset)
+        {
+            break;
+        }
+        mdl.set_lod(lod_asset, lod);
+    }
+
     std::string name = fs::path(key).stem().string();
     auto object = scn.create_entity(name);
 
@@ -4,11 +4,14 @@
 #include <logging/logging.h>
 
 #include <algorithm>
+#include <array>
 
 namespace unravel
 {
 namespace
 {
+std::array<transform_component::dirty_listener, 32> dirty_listeners{};
+
 auto is_ancestor_of(entt::handle potential_parent, entt::handle child) -> bool
 {
     if(!child)
@@ -808,6 +811,17 @@ auto transform_component::is_dirty(uint8_t id) const noexcept -> bool
 void transform_component::set_dirty(uint8_t id, bool dirty) noexcept
 {
     transform_dirty_.set(id, dirty);
+
+    // Listeners are only told about clean to dirty changes, resolve a pending change so the next one is seen.
+    if(!dirty && dirty_listeners[id] && transform_.dirty)
+    {
+        transform_.get_global_value(this, false);
+    }
+}
+
+void transform_component::set_dirty_listener(uint8_t id, dirty_listener listener) noexcept
+{
+    dirty_listeners[id] = listener;
 }
 
 auto transform_component::get_children() const noexcept -> const std::vector<entt::handle>&
@@ -824,7 +838,16 @@ void transform_component::on_dirty_transform(bool dirty) noexcept
 {
     if(dirty)
     {
+        auto notify = ~transform_dirty_;
         transform_dirty_.set();
+
+        for(uint8_t id = 0; id < dirty_listeners.size(); ++id)
+        {
+            if(notify[id] && dirty_listeners[id])
+            {
+                dirty_listeners[id](get_owner());
+            }
+        }
     }
 
     if(transform_.has_auto_resolve())
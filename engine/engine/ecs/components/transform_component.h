@@ -493,6 +493,20 @@ public:
      */
     auto is_dirty(uint8_t id) const noexcept -> bool;
 
+    /**
+     * @brief Function called when the transform becomes dirty for a specific index.
+     *
+     * Called once per clean to dirty change, from whichever thread moved the transform.
+     */
+    using dirty_listener = void (*)(entt::handle owner);
+
+    /**
+     * @brief Sets the listener notified when the transform becomes dirty for a specific index.
+     * @param id The index of the flag.
+     * @param listener The listener, or nullptr to remove it.
+     */
+    static void set_dirty_listener(uint8_t id, dirty_listener listener) noexcept;
+
     /**
      * @brief Clears the relationships of the component.
      */
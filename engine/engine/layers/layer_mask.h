@@ -20,6 +20,8 @@ enum layer_reserved
 struct layer_mask
 {
     int mask{layer_reserved::default_layer};
+
+    friend auto operator==(const layer_mask& lhs, const layer_mask& rhs) -> bool = default;
 };
 
 auto get_reserved_layers() -> const std::vector<std::string>&;
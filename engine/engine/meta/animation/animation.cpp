@@ -2,6 +2,8 @@
 #include <engine/meta/core/math/quaternion.hpp>
 #include <engine/meta/core/math/transform.hpp>
 
+#include <engine/animation/animation_compression.h>
+
 #include <fstream>
 #include <serialization/associative_archive.h>
 #include <serialization/binary_archive.h>
@@ -98,7 +100,7 @@ REFLECT(animation_channel)
         .property_readonly("node_name", &animation_channel::node_name)(rttr::metadata("pretty_name", "Name"))
         .property_readonly("position_keys_count", &animation_channel::get_position_keys_count)(rttr::metadata("pretty_name", "Positions"))
         .property_readonly("rotation_keys_count", &animation_channel::get_rotation_keys_count)(rttr::metadata("pretty_name", "Rotations"))
-        .property_readonly("scaling_keys_count", &animation_channel::get_position_keys_count)(rttr::metadata("pretty_name", "Scalings"));
+        .property_readonly("scaling_keys_count", &animation_channel::get_scaling_keys_count)(rttr::metadata("pretty_name", "Scalings"));
 
     // Register animation_channel with entt
     entt::meta_factory<animation_channel>{}
@@ -121,7 +123,7 @@ REFLECT(animation_channel)
             entt::attribute{"name", "rotation_keys_count"},
             entt::attribute{"pretty_name", "Rotations"},
         })
-        .data<nullptr, &animation_channel::get_position_keys_count>("scaling_keys_count"_hs)
+        .data<nullptr, &animation_channel::get_scaling_keys_count>("scaling_keys_count"_hs)
         .custom<entt::attributes>(entt::attributes{
             entt::attribute{"name", "scaling_keys_count"},
             entt::attribute{"pretty_name", "Scalings"},
@@ -134,6 +136,7 @@ REFLECT(animation_clip)
         .property_readonly("name", &animation_clip::name)(rttr::metadata("pretty_name", "Name"))
         .property_readonly("duration", &animation_clip::duration)(rttr::metadata("pretty_name", "Duration"))
         .property_readonly("root_motion", &animation_clip::root_motion)(rttr::metadata("pretty_name", "Root Motion"))
+        .property_readonly("compressed", &animation_clip::is_compressed)(rttr::metadata("pretty_name", "Compressed"))
         .property_readonly("channels", &animation_clip::channels)(rttr::metadata("pretty_name", "Channels"));
 
     // Register animation_clip with entt
@@ -157,6 +160,11 @@ REFLECT(animation_clip)
             entt::attribute{"name", "root_motion"},
             entt::attribute{"pretty_name", "Root Motion"},
         })
+        .data<nullptr, &animation_clip::is_compressed>("compressed"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "compressed"},
+            entt::attribute{"pretty_name", "Compressed"},
+        })
         .data<nullptr, &animation_clip::channels>("channels"_hs)
         .custom<entt::attributes>(entt::attributes{
             entt::attribute{"name", "channels"},
@@ -192,6 +200,7 @@ SAVE(animation_clip)
     try_save(ar, ser20::make_nvp("duration", obj.duration));
     try_save(ar, ser20::make_nvp("channels", obj.channels));
     try_save(ar, ser20::make_nvp("root_motion", obj.root_motion));
+    try_save(ar, ser20::make_nvp("compressed_tracks", obj.compressed_tracks));
 }
 SAVE_INSTANTIATE(animation_clip, ser20::oarchive_associative_t);
 SAVE_INSTANTIATE(animation_clip, ser20::oarchive_binary_t);
@@ -202,6 +211,9 @@ LOAD(animation_clip)
     try_load(ar, ser20::make_nvp("duration", obj.duration));
     try_load(ar, ser20::make_nvp("channels", obj.channels));
     try_load(ar, ser20::make_nvp("root_motion", obj.root_motion));
+    try_load(ar, ser20::make_nvp("compressed_tracks", obj.compressed_tracks));
+
+    update_compressed_key_counts(obj);
 }
 LOAD_INSTANTIATE(animation_clip, ser20::iarchive_associative_t);
 LOAD_INSTANTIATE(animation_clip, ser20::iarchive_binary_t);
@@ -21,8 +21,28 @@ REFLECT(animation_importer_meta)
         .property("keep_in_place", &animation_importer_meta::root_motion_meta::keep_in_place)(
         rttr::metadata("pretty_name", "Keep In Place"));
 
+    rttr::registration::class_<animation_importer_meta::compression_meta>("compression_meta")
+        .property("compress", &animation_importer_meta::compression_meta::compress)(
+            rttr::metadata("pretty_name", "Compress"),
+            rttr::metadata("tooltip",
+                           "Drops keys that can be interpolated within the tolerances and\n"
+                           "stores the rest quantized to 16 bits."))
+        .property("position_tolerance", &animation_importer_meta::compression_meta::position_tolerance)(
+            rttr::metadata("pretty_name", "Position Tolerance"),
+            rttr::metadata("tooltip", "Maximum position error in model units."),
+            rttr::metadata("min", 0.0f))
+        .property("rotation_tolerance", &animation_importer_meta::compression_meta::rotation_tolerance)(
+            rttr::metadata("pretty_name", "Rotation Tolerance"),
+            rttr::metadata("tooltip", "Maximum rotation error in degrees."),
+            rttr::metadata("min", 0.0f))
+        .property("scaling_tolerance", &animation_importer_meta::compression_meta::scaling_tolerance)(
+            rttr::metadata("pretty_name", "Scaling Tolerance"),
+            rttr::metadata("tooltip", "Maximum scaling error."),
+            rttr::metadata("min", 0.0f));
+
     rttr::registration::class_<animation_importer_meta>("animation_importer_meta")
-        .property("root_motion", &animation_importer_meta::root_motion)(rttr::metadata("pretty_name", "Root Motion"));
+        .property("root_motion", &animation_importer_meta::root_motion)(rttr::metadata("pretty_name", "Root Motion"))
+        .property("compression", &animation_importer_meta::compression)(rttr::metadata("pretty_name", "Compression"));
 
     // Register root_motion_meta with entt
     entt::meta_factory<animation_importer_meta::root_motion_meta>{}
@@ -51,6 +71,40 @@ REFLECT(animation_importer_meta)
             entt::attribute{"pretty_name", "Keep In Place"},
         });
 
+    // Register compression_meta with entt
+    entt::meta_factory<animation_importer_meta::compression_meta>{}
+        .type("compression_meta"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "compression_meta"},
+        })
+        .data<&animation_importer_meta::compression_meta::compress>("compress"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "compress"},
+            entt::attribute{"pretty_name", "Compress"},
+            entt::attribute{"tooltip", "Drops keys that can be interpolated within the tolerances and\nstores the rest quantized to 16 bits."},
+        })
+        .data<&animation_importer_meta::compression_meta::position_tolerance>("position_tolerance"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "position_tolerance"},
+            entt::attribute{"pretty_name", "Position Tolerance"},
+            entt::attribute{"tooltip", "Maximum position error in model units."},
+            entt::attribute{"min", 0.0f},
+        })
+        .data<&animation_importer_meta::compression_meta::rotation_tolerance>("rotation_tolerance"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "rotation_tolerance"},
+            entt::attribute{"pretty_name", "Rotation Tolerance"},
+            entt::attribute{"tooltip", "Maximum rotation error in degrees."},
+            entt::attribute{"min", 0.0f},
+        })
+        .data<&animation_importer_meta::compression_meta::scaling_tolerance>("scaling_tolerance"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "scaling_tolerance"},
+            entt::attribute{"pretty_name", "Scaling Tolerance"},
+            entt::attribute{"tooltip", "Maximum scaling error."},
+            entt::attribute{"min", 0.0f},
+        });
+
     // Register animation_importer_meta with entt
     entt::meta_factory<animation_importer_meta>{}
         .type("animation_importer_meta"_hs)
@@ -61,6 +115,11 @@ REFLECT(animation_importer_meta)
         .custom<entt::attributes>(entt::attributes{
             entt::attribute{"name", "root_motion"},
             entt::attribute{"pretty_name", "Root Motion"},
+        })
+        .data<&animation_importer_meta::compression>("compression"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "compression"},
+            entt::attribute{"pretty_name", "Compression"},
         });
 }
 
@@ -86,10 +145,31 @@ LOAD(animation_importer_meta::root_motion_meta)
 LOAD_INSTANTIATE(animation_importer_meta::root_motion_meta, ser20::iarchive_associative_t);
 LOAD_INSTANTIATE(animation_importer_meta::root_motion_meta, ser20::iarchive_binary_t);
 
+SAVE(animation_importer_meta::compression_meta)
+{
+    try_save(ar, ser20::make_nvp("compress", obj.compress));
+    try_save(ar, ser20::make_nvp("position_tolerance", obj.position_tolerance));
+    try_save(ar, ser20::make_nvp("rotation_tolerance", obj.rotation_tolerance));
+    try_save(ar, ser20::make_nvp("scaling_tolerance", obj.scaling_tolerance));
+}
+SAVE_INSTANTIATE(animation_importer_meta::compression_meta, ser20::oarchive_associative_t);
+SAVE_INSTANTIATE(animation_importer_meta::compression_meta, ser20::oarchive_binary_t);
+
+LOAD(animation_importer_meta::compression_meta)
+{
+    try_load(ar, ser20::make_nvp("compress", obj.compress));
+    try_load(ar, ser20::make_nvp("position_tolerance", obj.position_tolerance));
+    try_load(ar, ser20::make_nvp("rotation_tolerance", obj.rotation_tolerance));
+    try_load(ar, ser20::make_nvp("scaling_tolerance", obj.scaling_tolerance));
+}
+LOAD_INSTANTIATE(animation_importer_meta::compression_meta, ser20::iarchive_associative_t);
+LOAD_INSTANTIATE(animation_importer_meta::compression_meta, ser20::iarchive_binary_t);
+
 SAVE(animation_importer_meta)
 {
     try_save(ar, ser20::make_nvp("base_type", ser20::base_class<asset_importer_meta>(&obj)));
     try_save(ar, ser20::make_nvp("root_motion", obj.root_motion));
+    try_save(ar, ser20::make_nvp("compression", obj.compression));
 }
 SAVE_INSTANTIATE(animation_importer_meta, ser20::oarchive_associative_t);
 SAVE_INSTANTIATE(animation_importer_meta, ser20::oarchive_binary_t);
@@ -98,6 +178,7 @@ LOAD(animation_importer_meta)
 {
     try_load(ar, ser20::make_nvp("base_type", ser20::base_class<asset_importer_meta>(&obj)));
     try_load(ar, ser20::make_nvp("root_motion", obj.root_motion));
+    try_load(ar, ser20::make_nvp("compression", obj.compression));
 }
 LOAD_INSTANTIATE(animation_importer_meta, ser20::iarchive_associative_t);
 LOAD_INSTANTIATE(animation_importer_meta, ser20::iarchive_binary_t);
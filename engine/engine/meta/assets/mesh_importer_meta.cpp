@@ -5,6 +5,7 @@
 #include <serialization/associative_archive.h>
 #include <serialization/binary_archive.h>
 #include <serialization/types/map.hpp>
+#include <serialization/types/vector.hpp>
 
 namespace unravel
 {
@@ -37,7 +38,57 @@ REFLECT(mesh_importer_meta)
             rttr::metadata("tooltip",
                            "This step searches all meshes for invalid data, such as zeroed\n"
                            "normal vectors or invalid UV coords and removes/fixes them. This is\n"
-                           "intended to get rid of some common exporter errors."));
+                           "intended to get rid of some common exporter errors."))
+        .property("optimize_vertex_cache", &mesh_importer_meta::model_meta::optimize_vertex_cache)(
+            rttr::metadata("pretty_name", "Optimize Vertex Cache"),
+            rttr::metadata("tooltip",
+                           "Reorders triangles so vertices are reused from the\n"
+                           "post transform cache instead of being shaded again."))
+        .property("optimize_overdraw", &mesh_importer_meta::model_meta::optimize_overdraw)(
+            rttr::metadata("pretty_name", "Optimize Overdraw"),
+            rttr::metadata("tooltip",
+                           "Reorders clusters of triangles so the outer ones are drawn first,\n"
+                           "reducing overdraw from any view direction."))
+        .property("optimize_vertex_fetch", &mesh_importer_meta::model_meta::optimize_vertex_fetch)(
+            rttr::metadata("pretty_name", "Optimize Vertex Fetch"),
+            rttr::metadata("tooltip",
+                           "Reorders vertices in the order triangles use them\n"
+                           "so vertex fetch reads memory linearly."))
+        .property("compress_vertices", &mesh_importer_meta::model_meta::compress_vertices)(
+            rttr::metadata("pretty_name", "Compress Vertices"),
+            rttr::metadata("tooltip",
+                           "Stores positions as 16 bit values relative to the submesh bounds,\n"
+                           "normals and tangents octahedral encoded, half float uvs and\n"
+                           "8 bit skin weights. Halves the vertex memory at a small precision cost."))
+        .property("generate_clusters", &mesh_importer_meta::model_meta::generate_clusters)(
+            rttr::metadata("pretty_name", "Generate Clusters"),
+            rttr::metadata("tooltip",
+                           "Splits large submeshes into clusters of up to 128 triangles with their own\n"
+                           "bounds and normal cone, so parts outside the view or facing away\n"
+                           "are not drawn."));
+
+    rttr::registration::class_<mesh_importer_meta::lods_meta>("lods_meta")
+        .property("generate_lods", &mesh_importer_meta::lods_meta::generate_lods)(
+            rttr::metadata("pretty_name", "Generate LODs"),
+            rttr::metadata("tooltip",
+                           "Generates simplified copies of the mesh and uses them\n"
+                           "as additional levels of detail."))
+        .property("ratios", &mesh_importer_meta::lods_meta::ratios)(
+            rttr::metadata("pretty_name", "Triangle Ratios"),
+            rttr::metadata("tooltip",
+                           "Fraction of the original triangles kept by each generated level,\n"
+                           "starting at LOD1."));
+
+    rttr::registration::class_<mesh_importer_meta::collision_meta>("collision_meta")
+        .property("generate_collision", &mesh_importer_meta::collision_meta::generate_collision)(
+            rttr::metadata("pretty_name", "Generate Collision"),
+            rttr::metadata("tooltip",
+                           "Bakes a triangle mesh and a convex hull of the mesh\n"
+                           "for use by mesh colliders."))
+        .property("hull_vertex_limit", &mesh_importer_meta::collision_meta::hull_vertex_limit)(
+            rttr::metadata("pretty_name", "Hull Vertex Limit"),
+            rttr::metadata("min", 4),
+            rttr::metadata("tooltip", "Maximum number of points kept on the baked convex hull."));
 
     rttr::registration::class_<mesh_importer_meta::rig_meta>("rig_meta");
 
@@ -53,6 +104,8 @@ REFLECT(mesh_importer_meta)
 
     rttr::registration::class_<mesh_importer_meta>("mesh_importer_meta")
         .property("model", &mesh_importer_meta::model)(rttr::metadata("pretty_name", "Model"))
+        .property("lods", &mesh_importer_meta::lods)(rttr::metadata("pretty_name", "LODs"))
+        .property("collision", &mesh_importer_meta::collision)(rttr::metadata("pretty_name", "Collision"))
         .property("rig", &mesh_importer_meta::rig)(rttr::metadata("pretty_name", "Rig"))
         .property("animations", &mesh_importer_meta::animations)(rttr::metadata("pretty_name", "Animations"))
         .property("materials", &mesh_importer_meta::materials)(rttr::metadata("pretty_name", "Materials"));
@@ -95,6 +148,75 @@ REFLECT(mesh_importer_meta)
             entt::attribute{"name", "find_invalid_data"},
             entt::attribute{"pretty_name", "Find Invalid Data"},
             entt::attribute{"tooltip", "This step searches all meshes for invalid data, such as zeroed\nnormal vectors or invalid UV coords and removes/fixes them. This is\nintended to get rid of some common exporter errors."},
+        })
+        .data<&mesh_importer_meta::model_meta::optimize_vertex_cache>("optimize_vertex_cache"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "optimize_vertex_cache"},
+            entt::attribute{"pretty_name", "Optimize Vertex Cache"},
+            entt::attribute{"tooltip", "Reorders triangles so vertices are reused from the\npost transform cache instead of being shaded again."},
+        })
+        .data<&mesh_importer_meta::model_meta::optimize_overdraw>("optimize_overdraw"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "optimize_overdraw"},
+            entt::attribute{"pretty_name", "Optimize Overdraw"},
+            entt::attribute{"tooltip", "Reorders clusters of triangles so the outer ones are drawn first,\nreducing overdraw from any view direction."},
+        })
+        .data<&mesh_importer_meta::model_meta::optimize_vertex_fetch>("optimize_vertex_fetch"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "optimize_vertex_fetch"},
+            entt::attribute{"pretty_name", "Optimize Vertex Fetch"},
+            entt::attribute{"tooltip", "Reorders vertices in the order triangles use them\nso vertex fetch reads memory linearly."},
+        })
+        .data<&mesh_importer_meta::model_meta::compress_vertices>("compress_vertices"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "compress_vertices"},
+            entt::attribute{"pretty_name", "Compress Vertices"},
+            entt::attribute{"tooltip", "Stores positions as 16 bit values relative to the submesh bounds,\nnormals and tangents octahedral encoded, half float uvs and\n8 bit skin weights. Halves the vertex memory at a small precision cost."},
+        })
+        .data<&mesh_importer_meta::model_meta::generate_clusters>("generate_clusters"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "generate_clusters"},
+            entt::attribute{"pretty_name", "Generate Clusters"},
+            entt::attribute{"tooltip", "Splits large submeshes into clusters of up to 128 triangles with their own\nbounds and normal cone, so parts outside the view or facing away\nare not drawn."},
+        });
+
+    // Register mesh_importer_meta::lods_meta with entt
+    entt::meta_factory<mesh_importer_meta::lods_meta>{}
+        .type("lods_meta"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "lods_meta"},
+        })
+        .data<&mesh_importer_meta::lods_meta::generate_lods>("generate_lods"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "generate_lods"},
+            entt::attribute{"pretty_name", "Generate LODs"},
+            entt::attribute{"tooltip", "Generates simplified copies of the mesh and uses them\nas additional levels of detail."},
+        })
+        .data<&mesh_importer_meta::lods_meta::ratios>("ratios"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "ratios"},
+            entt::attribute{"pretty_name", "Triangle Ratios"},
+            entt::attribute{"tooltip", "Fraction of the original triangles kept by each generated level,\nstarting at LOD1."},
+        });
+
+    // Register mesh_importer_meta::collision_meta with entt
+    entt::meta_factory<mesh_importer_meta::collision_meta>{}
+        .type("collision_meta"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "collision_meta"},
+        })
+        .data<&mesh_importer_meta::collision_meta::generate_collision>("generate_collision"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "generate_collision"},
+            entt::attribute{"pretty_name", "Generate Collision"},
+            entt::attribute{"tooltip", "Bakes a triangle mesh and a convex hull of the mesh\nfor use by mesh colliders."},
+        })
+        .data<&mesh_importer_meta::collision_meta::hull_vertex_limit>("hull_vertex_limit"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "hull_vertex_limit"},
+            entt::attribute{"pretty_name", "Hull Vertex Limit"},
+            entt::attribute{"min", 4},
+            entt::attribute{"tooltip", "Maximum number of points kept on the baked convex hull."},
         });
 
     // Register mesh_importer_meta::rig_meta with entt
@@ -144,6 +266,16 @@ REFLECT(mesh_importer_meta)
             entt::attribute{"name", "model"},
             entt::attribute{"pretty_name", "Model"},
         })
+        .data<&mesh_importer_meta::lods>("lods"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "lods"},
+            entt::attribute{"pretty_name", "LODs"},
+        })
+        .data<&mesh_importer_meta::collision>("collision"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "collision"},
+            entt::attribute{"pretty_name", "Collision"},
+        })
         .data<&mesh_importer_meta::rig>("rig"_hs)
         .custom<entt::attributes>(entt::attributes{
             entt::attribute{"name", "rig"},
@@ -168,6 +300,11 @@ SAVE(mesh_importer_meta::model_meta)
     try_save(ar, ser20::make_nvp("split_large_meshes", obj.split_large_meshes));
     try_save(ar, ser20::make_nvp("find_degenerates", obj.find_degenerates));
     try_save(ar, ser20::make_nvp("find_invalid_data", obj.find_invalid_data));
+    try_save(ar, ser20::make_nvp("optimize_vertex_cache", obj.optimize_vertex_cache));
+    try_save(ar, ser20::make_nvp("optimize_overdraw", obj.optimize_overdraw));
+    try_save(ar, ser20::make_nvp("optimize_vertex_fetch", obj.optimize_vertex_fetch));
+    try_save(ar, ser20::make_nvp("compress_vertices", obj.compress_vertices));
+    try_save(ar, ser20::make_nvp("generate_clusters", obj.generate_clusters));
 }
 SAVE_INSTANTIATE(mesh_importer_meta::model_meta, ser20::oarchive_associative_t);
 SAVE_INSTANTIATE(mesh_importer_meta::model_meta, ser20::oarchive_binary_t);
@@ -179,10 +316,47 @@ LOAD(mesh_importer_meta::model_meta)
     try_load(ar, ser20::make_nvp("split_large_meshes", obj.split_large_meshes));
     try_load(ar, ser20::make_nvp("find_degenerates", obj.find_degenerates));
     try_load(ar, ser20::make_nvp("find_invalid_data", obj.find_invalid_data));
+    try_load(ar, ser20::make_nvp("optimize_vertex_cache", obj.optimize_vertex_cache));
+    try_load(ar, ser20::make_nvp("optimize_overdraw", obj.optimize_overdraw));
+    try_load(ar, ser20::make_nvp("optimize_vertex_fetch", obj.optimize_vertex_fetch));
+    try_load(ar, ser20::make_nvp("compress_vertices", obj.compress_vertices));
+    try_load(ar, ser20::make_nvp("generate_clusters", obj.generate_clusters));
 }
 LOAD_INSTANTIATE(mesh_importer_meta::model_meta, ser20::iarchive_associative_t);
 LOAD_INSTANTIATE(mesh_importer_meta::model_meta, ser20::iarchive_binary_t);
 
+SAVE(mesh_importer_meta::lods_meta)
+{
+    try_save(ar, ser20::make_nvp("generate_lods", obj.generate_lods));
+    try_save(ar, ser20::make_nvp("ratios", obj.ratios));
+}
+SAVE_INSTANTIATE(mesh_importer_meta::lods_meta, ser20::oarchive_associative_t);
+SAVE_INSTANTIATE(mesh_importer_meta::lods_meta, ser20::oarchive_binary_t);
+
+LOAD(mesh_importer_meta::lods_meta)
+{
+    try_load(ar, ser20::make_nvp("generate_lods", obj.generate_lods));
+    try_load(ar, ser20::make_nvp("ratios", obj.ratios));
+}
+LOAD_INSTANTIATE(mesh_importer_meta::lods_meta, ser20::iarchive_associative_t);
+LOAD_INSTANTIATE(mesh_importer_meta::lods_meta, ser20::iarchive_binary_t);
+
+SAVE(mesh_importer_meta::collision_meta)
+{
+    try_save(ar, ser20::make_nvp("generate_collision", obj.generate_collision));
+    try_save(ar, ser20::make_nvp("hull_vertex_limit", obj.hull_vertex_limit));
+}
+SAVE_INSTANTIATE(mesh_importer_meta::collision_meta, ser20::oarchive_associative_t);
+SAVE_INSTANTIATE(mesh_importer_meta::collision_meta, ser20::oarchive_binary_t);
+
+LOAD(mesh_importer_meta::collision_meta)
+{
+    try_load(ar, ser20::make_nvp("generate_collision", obj.generate_collision));
+    try_load(ar, ser20::make_nvp("hull_vertex_limit", obj.hull_vertex_limit));
+}
+LOAD_INSTANTIATE(mesh_importer_meta::collision_meta, ser20::iarchive_associative_t);
+LOAD_INSTANTIATE(mesh_importer_meta::collision_meta, ser20::iarchive_binary_t);
+
 SAVE(mesh_importer_meta::rig_meta)
 {
 }
@@ -229,9 +403,11 @@ SAVE(mesh_importer_meta)
 {
     try_save(ar, ser20::make_nvp("base_type", ser20::base_class<asset_importer_meta>(&obj)));
     try_save(ar, ser20::make_nvp("model", obj.model));
+    try_save(ar, ser20::make_nvp("lods", obj.lods));
     try_save(ar, ser20::make_nvp("rig", obj.rig));
     try_save(ar, ser20::make_nvp("animations", obj.animations));
     try_save(ar, ser20::make_nvp("materials", obj.materials));
+    try_save(ar, ser20::make_nvp("collision", obj.collision));
 }
 SAVE_INSTANTIATE(mesh_importer_meta, ser20::oarchive_associative_t);
 SAVE_INSTANTIATE(mesh_importer_meta, ser20::oarchive_binary_t);
@@ -240,9 +416,11 @@ LOAD(mesh_importer_meta)
 {
     try_load(ar, ser20::make_nvp("base_type", ser20::base_class<asset_importer_meta>(&obj)));
     try_load(ar, ser20::make_nvp("model", obj.model));
+    try_load(ar, ser20::make_nvp("lods", obj.lods));
     try_load(ar, ser20::make_nvp("rig", obj.rig));
     try_load(ar, ser20::make_nvp("animations", obj.animations));
     try_load(ar, ser20::make_nvp("materials", obj.materials));
+    try_load(ar, ser20::make_nvp("collision", obj.collision));
 }
 LOAD_INSTANTIATE(mesh_importer_meta, ser20::iarchive_associative_t);
 LOAD_INSTANTIATE(mesh_importer_meta, ser20::iarchive_binary_t);
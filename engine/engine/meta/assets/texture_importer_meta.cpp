@@ -28,7 +28,8 @@ REFLECT(texture_importer_meta)
     rttr::registration::enumeration<texture_importer_meta::texture_type>("texture_type")(
         rttr::value("Auto", texture_importer_meta::texture_type::automatic),
         rttr::value("Normal Map", texture_importer_meta::texture_type::normal_map),
-        rttr::value("Equirect. Proj.", texture_importer_meta::texture_type::equirect));
+        rttr::value("Equirect. Proj.", texture_importer_meta::texture_type::equirect),
+        rttr::value("Mask", texture_importer_meta::texture_type::mask));
 
     rttr::registration::enumeration<texture_importer_meta::compression_quality>("compression_quality")(
         rttr::value("Project Default", texture_importer_meta::compression_quality::project_default),
@@ -131,6 +132,11 @@ REFLECT(texture_importer_meta)
         .custom<entt::attributes>(entt::attributes{
             entt::attribute{"name", "equirect"},
             entt::attribute{"pretty_name", "Equirect. Proj."},
+        })
+        .data<texture_importer_meta::texture_type::mask>("mask"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "mask"},
+            entt::attribute{"pretty_name", "Mask"},
         });
 
     // Register texture_importer_meta::compression_quality enum with entt
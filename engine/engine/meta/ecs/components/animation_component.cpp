@@ -3,6 +3,8 @@
 #include <engine/meta/ecs/entity.hpp>
 #include <serialization/associative_archive.h>
 #include <serialization/binary_archive.h>
+#include <serialization/types/string.hpp>
+#include <serialization/types/vector.hpp>
 
 namespace unravel
 {
@@ -34,7 +36,45 @@ REFLECT(animation_component)
                   &animation_component::set_speed)(rttr::metadata("pretty_name", "Speed"),
                                                    rttr::metadata("tooltip", "Controls the playback speed of the animation. 1.0 = normal speed, 2.0 = double speed, 0.5 = half speed."),
                                                    rttr::metadata("min", 0.0f),
-                                                   rttr::metadata("max", 10.0f));
+                                                   rttr::metadata("max", 10.0f))
+        .property("update_rate_lod",
+                  &animation_component::get_update_rate_lod,
+                  &animation_component::set_update_rate_lod)(
+            rttr::metadata("pretty_name", "Update Rate LOD"),
+            rttr::metadata("tooltip", "Evaluates the animation less often when the model is small on screen."))
+        .property("half_rate_coverage",
+                  &animation_component::get_half_rate_coverage,
+                  &animation_component::set_half_rate_coverage)(
+            rttr::metadata("pretty_name", "Half Rate Coverage"),
+            rttr::metadata("tooltip", "Screen height percent below which the pose is evaluated every 2nd frame."),
+            rttr::metadata("min", 0.0f),
+            rttr::metadata("max", 100.0f))
+        .property("quarter_rate_coverage",
+                  &animation_component::get_quarter_rate_coverage,
+                  &animation_component::set_quarter_rate_coverage)(
+            rttr::metadata("pretty_name", "Quarter Rate Coverage"),
+            rttr::metadata("tooltip", "Screen height percent below which the pose is evaluated every 4th frame."),
+            rttr::metadata("min", 0.0f),
+            rttr::metadata("max", 100.0f))
+        .property("reduced_bones_coverage",
+                  &animation_component::get_reduced_bones_coverage,
+                  &animation_component::set_reduced_bones_coverage)(
+            rttr::metadata("pretty_name", "Reduced Bones Coverage"),
+            rttr::metadata("tooltip", "Screen height percent below which the reduced bones are not evaluated."),
+            rttr::metadata("min", 0.0f),
+            rttr::metadata("max", 100.0f))
+        .property("reduced_bones", &animation_component::get_reduced_bones, &animation_component::set_reduced_bones)(
+            rttr::metadata("pretty_name", "Reduced Bones"),
+            rttr::metadata("tooltip", "Bones whose descendants are skipped at the lowest LOD, e.g. hands and head."))
+        .property("pose_sharing_step",
+                  &animation_component::get_pose_sharing_step,
+                  &animation_component::set_pose_sharing_step)(
+            rttr::metadata("pretty_name", "Pose Sharing Step"),
+            rttr::metadata("tooltip",
+                           "Snaps the sampling time to this step in seconds so instances playing the same clip "
+                           "share one evaluation. 0 samples independently."),
+            rttr::metadata("min", 0.0f),
+            rttr::metadata("max", 1.0f));
 
     // Register animation_component::culling_mode enum with entt
     entt::meta_factory<animation_component::culling_mode>{}
@@ -91,6 +131,57 @@ REFLECT(animation_component)
             entt::attribute{"tooltip", "Controls the playback speed of the animation. 1.0 = normal speed, 2.0 = double speed, 0.5 = half speed."},
             entt::attribute{"min", 0.0f},
             entt::attribute{"max", 10.0f},
+        })
+        .data<&animation_component::set_update_rate_lod, &animation_component::get_update_rate_lod>(
+            "update_rate_lod"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "update_rate_lod"},
+            entt::attribute{"pretty_name", "Update Rate LOD"},
+            entt::attribute{"tooltip", "Evaluates the animation less often when the model is small on screen."},
+        })
+        .data<&animation_component::set_half_rate_coverage, &animation_component::get_half_rate_coverage>(
+            "half_rate_coverage"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "half_rate_coverage"},
+            entt::attribute{"pretty_name", "Half Rate Coverage"},
+            entt::attribute{"tooltip", "Screen height percent below which the pose is evaluated every 2nd frame."},
+            entt::attribute{"min", 0.0f},
+            entt::attribute{"max", 100.0f},
+        })
+        .data<&animation_component::set_quarter_rate_coverage, &animation_component::get_quarter_rate_coverage>(
+            "quarter_rate_coverage"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "quarter_rate_coverage"},
+            entt::attribute{"pretty_name", "Quarter Rate Coverage"},
+            entt::attribute{"tooltip", "Screen height percent below which the pose is evaluated every 4th frame."},
+            entt::attribute{"min", 0.0f},
+            entt::attribute{"max", 100.0f},
+        })
+        .data<&animation_component::set_reduced_bones_coverage, &animation_component::get_reduced_bones_coverage>(
+            "reduced_bones_coverage"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "reduced_bones_coverage"},
+            entt::attribute{"pretty_name", "Reduced Bones Coverage"},
+            entt::attribute{"tooltip", "Screen height percent below which the reduced bones are not evaluated."},
+            entt::attribute{"min", 0.0f},
+            entt::attribute{"max", 100.0f},
+        })
+        .data<&animation_component::set_reduced_bones, &animation_component::get_reduced_bones>("reduced_bones"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "reduced_bones"},
+            entt::attribute{"pretty_name", "Reduced Bones"},
+            entt::attribute{"tooltip", "Bones whose descendants are skipped at the lowest LOD, e.g. hands and head."},
+        })
+        .data<&animation_component::set_pose_sharing_step, &animation_component::get_pose_sharing_step>(
+            "pose_sharing_step"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "pose_sharing_step"},
+            entt::attribute{"pretty_name", "Pose Sharing Step"},
+            entt::attribute{"tooltip",
+                            "Snaps the sampling time to this step in seconds so instances playing the same clip "
+                            "share one evaluation. 0 samples independently."},
+            entt::attribute{"min", 0.0f},
+            entt::attribute{"max", 1.0f},
         });
 }
 
@@ -101,6 +192,12 @@ SAVE(animation_component)
     try_save(ar, ser20::make_nvp("culling_mode", obj.get_culling_mode()));
     try_save(ar, ser20::make_nvp("apply_root_motion", obj.get_apply_root_motion()));
     try_save(ar, ser20::make_nvp("speed", obj.get_speed()));
+    try_save(ar, ser20::make_nvp("update_rate_lod", obj.get_update_rate_lod()));
+    try_save(ar, ser20::make_nvp("half_rate_coverage", obj.get_half_rate_coverage()));
+    try_save(ar, ser20::make_nvp("quarter_rate_coverage", obj.get_quarter_rate_coverage()));
+    try_save(ar, ser20::make_nvp("reduced_bones_coverage", obj.get_reduced_bones_coverage()));
+    try_save(ar, ser20::make_nvp("reduced_bones", obj.get_reduced_bones()));
+    try_save(ar, ser20::make_nvp("pose_sharing_step", obj.get_pose_sharing_step()));
 }
 SAVE_INSTANTIATE(animation_component, ser20::oarchive_associative_t);
 SAVE_INSTANTIATE(animation_component, ser20::oarchive_binary_t);
@@ -136,6 +233,42 @@ LOAD(animation_component)
     {
         obj.set_speed(speed);
     }
+
+    bool update_rate_lod{};
+    if(try_load(ar, ser20::make_nvp("update_rate_lod", update_rate_lod)))
+    {
+        obj.set_update_rate_lod(update_rate_lod);
+    }
+
+    float half_rate_coverage{};
+    if(try_load(ar, ser20::make_nvp("half_rate_coverage", half_rate_coverage)))
+    {
+        obj.set_half_rate_coverage(half_rate_coverage);
+    }
+
+    float quarter_rate_coverage{};
+    if(try_load(ar, ser20::make_nvp("quarter_rate_coverage", quarter_rate_coverage)))
+    {
+        obj.set_quarter_rate_coverage(quarter_rate_coverage);
+    }
+
+    float reduced_bones_coverage{};
+    if(try_load(ar, ser20::make_nvp("reduced_bones_coverage", reduced_bones_coverage)))
+    {
+        obj.set_reduced_bones_coverage(reduced_bones_coverage);
+    }
+
+    std::vector<std::string> reduced_bones;
+    if(try_load(ar, ser20::make_nvp("reduced_bones", reduced_bones)))
+    {
+        obj.set_reduced_bones(reduced_bones);
+    }
+
+    float pose_sharing_step{};
+    if(try_load(ar, ser20::make_nvp("pose_sharing_step", pose_sharing_step)))
+    {
+        obj.set_pose_sharing_step(pose_sharing_step);
+    }
 }
 LOAD_INSTANTIATE(animation_component, ser20::iarchive_associative_t);
 LOAD_INSTANTIATE(animation_component, ser20::iarchive_binary_t);
@@ -7,6 +7,7 @@
 
 #include <serialization/associative_archive.h>
 #include <serialization/binary_archive.h>
+#include <serialization/types/string.hpp>
 #include <serialization/types/vector.hpp>
 
 namespace unravel
@@ -32,7 +33,14 @@ REFLECT(model_component)
             rttr::metadata("pretty_name", "Casts Reflection"),
             rttr::metadata("tooltip", "Is the model participating in reflection generation?"))
         .property("model", &model_component::get_model, &model_component::set_model)(
-            rttr::metadata("pretty_name", "Model"));
+            rttr::metadata("pretty_name", "Model"))
+        .property("compact_skeleton", &model_component::is_compact_skeleton, &model_component::set_compact_skeleton)(
+            rttr::metadata("pretty_name", "Compact Skeleton"),
+            rttr::metadata("tooltip",
+                           "Keeps the armature pose in arrays on the model instead of one entity per node."))
+        .property("exposed_bones", &model_component::get_exposed_bones, &model_component::set_exposed_bones)(
+            rttr::metadata("pretty_name", "Exposed Bones"),
+            rttr::metadata("tooltip", "Bones which still get an entity when the skeleton is compact."));
 
     // Register model_component class with entt
     entt::meta_factory<model_component>{}
@@ -71,6 +79,18 @@ REFLECT(model_component)
         .custom<entt::attributes>(entt::attributes{
             entt::attribute{"name", "model"},
             entt::attribute{"pretty_name", "Model"},
+        })
+        .data<&model_component::set_compact_skeleton, &model_component::is_compact_skeleton>("compact_skeleton"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "compact_skeleton"},
+            entt::attribute{"pretty_name", "Compact Skeleton"},
+            entt::attribute{"tooltip", "Keeps the armature pose in arrays on the model instead of one entity per node."},
+        })
+        .data<&model_component::set_exposed_bones, &model_component::get_exposed_bones>("exposed_bones"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "exposed_bones"},
+            entt::attribute{"pretty_name", "Exposed Bones"},
+            entt::attribute{"tooltip", "Bones which still get an entity when the skeleton is compact."},
         });
 }
 
@@ -81,6 +101,8 @@ SAVE(model_component)
     try_save(ar, ser20::make_nvp("casts_shadow", obj.casts_shadow()));
     try_save(ar, ser20::make_nvp("casts_reflection", obj.casts_reflection()));
     try_save(ar, ser20::make_nvp("model", obj.get_model()));
+    try_save(ar, ser20::make_nvp("compact_skeleton", obj.is_compact_skeleton()));
+    try_save(ar, ser20::make_nvp("exposed_bones", obj.get_exposed_bones()));
 }
 SAVE_INSTANTIATE(model_component, ser20::oarchive_associative_t);
 SAVE_INSTANTIATE(model_component, ser20::oarchive_binary_t);
@@ -116,6 +138,18 @@ LOAD(model_component)
     {
         obj.set_model(mod);
     }
+
+    bool compact_skeleton{};
+    if(try_load(ar, ser20::make_nvp("compact_skeleton", compact_skeleton)))
+    {
+        obj.set_compact_skeleton(compact_skeleton);
+    }
+
+    std::vector<std::string> exposed_bones;
+    if(try_load(ar, ser20::make_nvp("exposed_bones", exposed_bones)))
+    {
+        obj.set_exposed_bones(exposed_bones);
+    }
 }
 LOAD_INSTANTIATE(model_component, ser20::iarchive_associative_t);
 LOAD_INSTANTIATE(model_component, ser20::iarchive_binary_t);
@@ -2,6 +2,7 @@
 #include <engine/meta/assets/asset_handle.hpp>
 #include <engine/meta/core/math/vector.hpp>
 #include <engine/meta/layers/layer_mask.hpp>
+#include <engine/rendering/mesh.h>
 
 #include <serialization/associative_archive.h>
 #include <serialization/binary_archive.h>
@@ -240,14 +241,78 @@ LOAD(physics_cylinder_shape)
 LOAD_INSTANTIATE(physics_cylinder_shape, ser20::iarchive_associative_t);
 LOAD_INSTANTIATE(physics_cylinder_shape, ser20::iarchive_binary_t);
 
+REFLECT(physics_mesh_shape)
+{
+    rttr::registration::class_<physics_mesh_shape>(
+        "physics_mesh_shape")(rttr::metadata("category", "PHYSICS"), rttr::metadata("pretty_name", "Mesh"))
+        .constructor<>()()
+        .property("center", &physics_mesh_shape::center)(rttr::metadata("pretty_name", "Center"),
+                                                         rttr::metadata("tooltip", "The center of the collider."))
+        .property("mesh", &physics_mesh_shape::mesh)(
+            rttr::metadata("pretty_name", "Mesh"),
+            rttr::metadata("tooltip", "Mesh imported with collision generation enabled."))
+        .property("convex", &physics_mesh_shape::convex)(
+            rttr::metadata("pretty_name", "Convex"),
+            rttr::metadata("tooltip",
+                           "Use the baked convex hull instead of the triangle mesh.\n"
+                           "Dynamic rigidbodies always use the convex hull."));
+
+    // Register physics_mesh_shape with entt
+    entt::meta_factory<physics_mesh_shape>{}
+        .type("physics_mesh_shape"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "physics_mesh_shape"},
+            entt::attribute{"category", "PHYSICS"},
+            entt::attribute{"pretty_name", "Mesh"},
+        })
+        .data<&physics_mesh_shape::center>("center"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "center"},
+            entt::attribute{"pretty_name", "Center"},
+            entt::attribute{"tooltip", "The center of the collider."},
+        })
+        .data<&physics_mesh_shape::mesh>("mesh"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "mesh"},
+            entt::attribute{"pretty_name", "Mesh"},
+            entt::attribute{"tooltip", "Mesh imported with collision generation enabled."},
+        })
+        .data<&physics_mesh_shape::convex>("convex"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "convex"},
+            entt::attribute{"pretty_name", "Convex"},
+            entt::attribute{"tooltip", "Use the baked convex hull instead of the triangle mesh.\nDynamic rigidbodies always use the convex hull."},
+        });
+}
+
+SAVE(physics_mesh_shape)
+{
+    try_save(ar, ser20::make_nvp("center", obj.center));
+    try_save(ar, ser20::make_nvp("mesh", obj.mesh));
+    try_save(ar, ser20::make_nvp("convex", obj.convex));
+}
+SAVE_INSTANTIATE(physics_mesh_shape, ser20::oarchive_associative_t);
+SAVE_INSTANTIATE(physics_mesh_shape, ser20::oarchive_binary_t);
+
+LOAD(physics_mesh_shape)
+{
+    try_load(ar, ser20::make_nvp("center", obj.center));
+    try_load(ar, ser20::make_nvp("mesh", obj.mesh));
+    try_load(ar, ser20::make_nvp("convex", obj.convex));
+}
+
+LOAD_INSTANTIATE(physics_mesh_shape, ser20::iarchive_associative_t);
+LOAD_INSTANTIATE(physics_mesh_shape, ser20::iarchive_binary_t);
+
 REFLECT(physics_compound_shape)
 {
     static const auto& ps = rttr::type::get<physics_box_shape>();
     static const auto& ss = rttr::type::get<physics_sphere_shape>();
     static const auto& cs = rttr::type::get<physics_capsule_shape>();
     static const auto& cys = rttr::type::get<physics_cylinder_shape>();
+    static const auto& ms = rttr::type::get<physics_mesh_shape>();
 
-    std::vector<const rttr::type*> variant_types{&ps, &ss, &cs, &cys};
+    std::vector<const rttr::type*> variant_types{&ps, &ss, &cs, &cys, &ms};
 
     rttr::registration::class_<physics_compound_shape>("physics_compound_shape")(
         rttr::metadata("category", "PHYSICS"),
@@ -260,8 +325,9 @@ REFLECT(physics_compound_shape)
         static const auto& ss = entt::resolve<physics_sphere_shape>();
         static const auto& cs = entt::resolve<physics_capsule_shape>();
         static const auto& cys = entt::resolve<physics_cylinder_shape>();
+        static const auto& ms = entt::resolve<physics_mesh_shape>();
 
-        std::vector<entt::meta_type> variant_types{ps, ss, cs, cys};
+        std::vector<entt::meta_type> variant_types{ps, ss, cs, cys, ms};
 
         // Register physics_compound_shape with entt
         entt::meta_factory<physics_compound_shape>{}
@@ -342,6 +408,23 @@ REFLECT(physics_component)
             rttr::metadata("min", 0.0f),
             rttr::metadata("pretty_name", "Mass"),
             rttr::metadata("tooltip", "Mass for dynamic rigidbodies."))
+        .property("can_sleep", &physics_component::can_sleep, &physics_component::set_can_sleep)(
+            rttr::metadata("pretty_name", "Can Sleep"),
+            rttr::metadata("tooltip", "Allows the rigidbody to fall asleep when it comes to rest."))
+        .property("sleep_linear_threshold",
+                  &physics_component::get_sleep_linear_threshold,
+                  &physics_component::set_sleep_linear_threshold)(
+            rttr::metadata("pretty_name", "Sleep Linear Threshold"),
+            rttr::metadata("tooltip", "Linear velocity under which the rigidbody rests. Negative uses the project setting."))
+        .property("sleep_angular_threshold",
+                  &physics_component::get_sleep_angular_threshold,
+                  &physics_component::set_sleep_angular_threshold)(
+            rttr::metadata("pretty_name", "Sleep Angular Threshold"),
+            rttr::metadata("tooltip", "Angular velocity under which the rigidbody rests. Negative uses the project setting."))
+        .property_readonly("is_sleeping", &physics_component::is_sleeping)(rttr::metadata("pretty_name", "Is Sleeping"))
+        .property_readonly("island", &physics_component::get_island)(
+            rttr::metadata("pretty_name", "Island"),
+            rttr::metadata("tooltip", "Simulation island of the rigidbody, bodies touching each other share it."))
         .property("freeze_position", &physics_component::get_freeze_position, &physics_component::set_freeze_position)(
             rttr::metadata("pretty_name", "Freeze Position"),
             rttr::metadata("tooltip", "Freeze."))
@@ -423,6 +506,35 @@ REFLECT(physics_component)
             entt::attribute{"name", "angular_velocity"},
             entt::attribute{"pretty_name", "Angular Velocity"},
         })
+        .data<&physics_component::set_can_sleep, &physics_component::can_sleep>("can_sleep"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "can_sleep"},
+            entt::attribute{"pretty_name", "Can Sleep"},
+            entt::attribute{"tooltip", "Allows the rigidbody to fall asleep when it comes to rest."},
+        })
+        .data<&physics_component::set_sleep_linear_threshold, &physics_component::get_sleep_linear_threshold>("sleep_linear_threshold"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "sleep_linear_threshold"},
+            entt::attribute{"pretty_name", "Sleep Linear Threshold"},
+            entt::attribute{"tooltip", "Linear velocity under which the rigidbody rests. Negative uses the project setting."},
+        })
+        .data<&physics_component::set_sleep_angular_threshold, &physics_component::get_sleep_angular_threshold>("sleep_angular_threshold"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "sleep_angular_threshold"},
+            entt::attribute{"pretty_name", "Sleep Angular Threshold"},
+            entt::attribute{"tooltip", "Angular velocity under which the rigidbody rests. Negative uses the project setting."},
+        })
+        .data<nullptr, &physics_component::is_sleeping>("is_sleeping"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "is_sleeping"},
+            entt::attribute{"pretty_name", "Is Sleeping"},
+        })
+        .data<nullptr, &physics_component::get_island>("island"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "island"},
+            entt::attribute{"pretty_name", "Island"},
+            entt::attribute{"tooltip", "Simulation island of the rigidbody, bodies touching each other share it."},
+        })
         .data<&physics_component::set_freeze_position, &physics_component::get_freeze_position>("freeze_position"_hs)
         .custom<entt::attributes>(entt::attributes{
             entt::attribute{"name", "freeze_position"},
@@ -460,6 +572,9 @@ SAVE(physics_component)
     try_save(ar, ser20::make_nvp("exclude_layers", obj.get_collision_exclude_mask()));
     try_save(ar, ser20::make_nvp("freeze_position", obj.get_freeze_position()));
     try_save(ar, ser20::make_nvp("freeze_rotation", obj.get_freeze_rotation()));
+    try_save(ar, ser20::make_nvp("can_sleep", obj.can_sleep()));
+    try_save(ar, ser20::make_nvp("sleep_linear_threshold", obj.get_sleep_linear_threshold()));
+    try_save(ar, ser20::make_nvp("sleep_angular_threshold", obj.get_sleep_angular_threshold()));
 
     try_save(ar, ser20::make_nvp("material", obj.get_material()));
     try_save(ar, ser20::make_nvp("shapes", obj.get_shapes()));
@@ -522,6 +637,24 @@ LOAD(physics_component)
         obj.set_freeze_rotation(freeze_rotation);
     }
 
+    bool can_sleep{true};
+    if(try_load(ar, ser20::make_nvp("can_sleep", can_sleep)))
+    {
+        obj.set_can_sleep(can_sleep);
+    }
+
+    float sleep_linear_threshold{-1.0f};
+    if(try_load(ar, ser20::make_nvp("sleep_linear_threshold", sleep_linear_threshold)))
+    {
+        obj.set_sleep_linear_threshold(sleep_linear_threshold);
+    }
+
+    float sleep_angular_threshold{-1.0f};
+    if(try_load(ar, ser20::make_nvp("sleep_angular_threshold", sleep_angular_threshold)))
+    {
+        obj.set_sleep_angular_threshold(sleep_angular_threshold);
+    }
+
     asset_handle<physics_material> material;
     if(try_load(ar, ser20::make_nvp("material", material)))
     {
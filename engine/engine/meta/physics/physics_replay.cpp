@@ -0,0 +1,80 @@
+#include "physics_replay.hpp"
+#include <engine/meta/core/common/basetypes.hpp>
+#include <engine/meta/core/math/quaternion.hpp>
+#include <engine/meta/core/math/vector.hpp>
+
+#include <fstream>
+#include <serialization/associative_archive.h>
+#include <serialization/binary_archive.h>
+#include <serialization/types/vector.hpp>
+
+namespace unravel
+{
+
+SAVE(physics_replay_event)
+{
+    try_save(ar, ser20::make_nvp("step", obj.step));
+    try_save(ar, ser20::make_nvp("type", obj.type));
+    try_save(ar, ser20::make_nvp("id", obj.id));
+    try_save(ar, ser20::make_nvp("position", obj.position));
+    try_save(ar, ser20::make_nvp("rotation", obj.rotation));
+    try_save(ar, ser20::make_nvp("vector", obj.vector));
+    try_save(ar, ser20::make_nvp("angular_velocity", obj.angular_velocity));
+    try_save(ar, ser20::make_nvp("mode", obj.mode));
+}
+SAVE_INSTANTIATE(physics_replay_event, ser20::oarchive_associative_t);
+SAVE_INSTANTIATE(physics_replay_event, ser20::oarchive_binary_t);
+
+LOAD(physics_replay_event)
+{
+    try_load(ar, ser20::make_nvp("step", obj.step));
+    try_load(ar, ser20::make_nvp("type", obj.type));
+    try_load(ar, ser20::make_nvp("id", obj.id));
+    try_load(ar, ser20::make_nvp("position", obj.position));
+    try_load(ar, ser20::make_nvp("rotation", obj.rotation));
+    try_load(ar, ser20::make_nvp("vector", obj.vector));
+    try_load(ar, ser20::make_nvp("angular_velocity", obj.angular_velocity));
+    try_load(ar, ser20::make_nvp("mode", obj.mode));
+}
+LOAD_INSTANTIATE(physics_replay_event, ser20::iarchive_associative_t);
+LOAD_INSTANTIATE(physics_replay_event, ser20::iarchive_binary_t);
+
+SAVE(physics_recording)
+{
+    try_save(ar, ser20::make_nvp("fixed_timestep", obj.fixed_timestep));
+    try_save(ar, ser20::make_nvp("events", obj.events));
+    try_save(ar, ser20::make_nvp("hashes", obj.hashes));
+}
+SAVE_INSTANTIATE(physics_recording, ser20::oarchive_associative_t);
+SAVE_INSTANTIATE(physics_recording, ser20::oarchive_binary_t);
+
+LOAD(physics_recording)
+{
+    try_load(ar, ser20::make_nvp("fixed_timestep", obj.fixed_timestep));
+    try_load(ar, ser20::make_nvp("events", obj.events));
+    try_load(ar, ser20::make_nvp("hashes", obj.hashes));
+}
+LOAD_INSTANTIATE(physics_recording, ser20::iarchive_associative_t);
+LOAD_INSTANTIATE(physics_recording, ser20::iarchive_binary_t);
+
+// Recordings are compared bit for bit, so they are only stored in the binary archive.
+void save_to_file_bin(const std::string& absolute_path, const physics_recording& obj)
+{
+    std::ofstream stream(absolute_path, std::ios::binary);
+    if(stream.good())
+    {
+        ser20::oarchive_binary_t ar(stream);
+        try_save(ar, ser20::make_nvp("physics_recording", obj));
+    }
+}
+
+void load_from_file_bin(const std::string& absolute_path, physics_recording& obj)
+{
+    std::ifstream stream(absolute_path, std::ios::binary);
+    if(stream.good())
+    {
+        ser20::iarchive_binary_t ar(stream);
+        try_load(ar, ser20::make_nvp("physics_recording", obj));
+    }
+}
+} // namespace unravel
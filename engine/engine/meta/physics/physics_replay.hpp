@@ -0,0 +1,17 @@
+#pragma once
+
+#include <engine/physics/physics_replay.h>
+
+#include <serialization/serialization.h>
+
+namespace unravel
+{
+SAVE_EXTERN(physics_replay_event);
+LOAD_EXTERN(physics_replay_event);
+SAVE_EXTERN(physics_recording);
+LOAD_EXTERN(physics_recording);
+
+void save_to_file_bin(const std::string& absolute_path, const physics_recording& obj);
+void load_from_file_bin(const std::string& absolute_path, physics_recording& obj);
+
+} // namespace unravel
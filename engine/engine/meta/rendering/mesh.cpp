@@ -3,6 +3,7 @@
 #include <engine/meta/core/math/quaternion.hpp>
 #include <engine/meta/core/math/transform.hpp>
 #include <engine/meta/core/math/bbox.hpp>
+#include <engine/meta/core/math/vector.hpp>
 
 #include <fstream>
 #include <serialization/associative_archive.h>
@@ -46,7 +47,13 @@ REFLECT(mesh::info)
         .property_readonly("submeshes", &mesh::info::submeshes)(rttr::metadata("pretty_name", "Submeshes"),
                                                             rttr::metadata("tooltip", "submeshes count."))
         .property_readonly("data_groups", &mesh::info::data_groups)(rttr::metadata("pretty_name", "Material Groups"),
-                                                            rttr::metadata("tooltip", "Materials count."));
+                                                            rttr::metadata("tooltip", "Materials count."))
+        .property_readonly("acmr", &mesh::info::acmr)(
+            rttr::metadata("pretty_name", "ACMR"),
+            rttr::metadata("tooltip", "Average cache miss ratio. Transformed vertices per triangle, lower is better."))
+        .property_readonly("atvr", &mesh::info::atvr)(
+            rttr::metadata("pretty_name", "ATVR"),
+            rttr::metadata("tooltip", "Average transform to vertex ratio. Transformed vertices per vertex, 1 is ideal."));
 
     // Register mesh::info with entt
     entt::meta_factory<mesh::info>{}
@@ -77,6 +84,18 @@ REFLECT(mesh::info)
             entt::attribute{"name", "data_groups"},
             entt::attribute{"pretty_name", "Material Groups"},
             entt::attribute{"tooltip", "Materials count."},
+        })
+        .data<nullptr, &mesh::info::acmr>("acmr"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "acmr"},
+            entt::attribute{"pretty_name", "ACMR"},
+            entt::attribute{"tooltip", "Average cache miss ratio. Transformed vertices per triangle, lower is better."},
+        })
+        .data<nullptr, &mesh::info::atvr>("atvr"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "atvr"},
+            entt::attribute{"pretty_name", "ATVR"},
+            entt::attribute{"tooltip", "Average transform to vertex ratio. Transformed vertices per vertex, 1 is ideal."},
         });
 }
 
@@ -111,6 +130,50 @@ LOAD(mesh::submesh)
 LOAD_INSTANTIATE(mesh::submesh, ser20::iarchive_binary_t);
 LOAD_INSTANTIATE(mesh::submesh, ser20::iarchive_associative_t);
 
+SAVE(mesh::cluster)
+{
+    try_save(ar, ser20::make_nvp("submesh_index", obj.submesh_index));
+    try_save(ar, ser20::make_nvp("face_start", obj.face_start));
+    try_save(ar, ser20::make_nvp("face_count", obj.face_count));
+    try_save(ar, ser20::make_nvp("center", obj.center));
+    try_save(ar, ser20::make_nvp("radius", obj.radius));
+    try_save(ar, ser20::make_nvp("cone_axis", obj.cone_axis));
+    try_save(ar, ser20::make_nvp("cone_cutoff", obj.cone_cutoff));
+}
+SAVE_INSTANTIATE(mesh::cluster, ser20::oarchive_binary_t);
+SAVE_INSTANTIATE(mesh::cluster, ser20::oarchive_associative_t);
+
+LOAD(mesh::cluster)
+{
+    try_load(ar, ser20::make_nvp("submesh_index", obj.submesh_index));
+    try_load(ar, ser20::make_nvp("face_start", obj.face_start));
+    try_load(ar, ser20::make_nvp("face_count", obj.face_count));
+    try_load(ar, ser20::make_nvp("center", obj.center));
+    try_load(ar, ser20::make_nvp("radius", obj.radius));
+    try_load(ar, ser20::make_nvp("cone_axis", obj.cone_axis));
+    try_load(ar, ser20::make_nvp("cone_cutoff", obj.cone_cutoff));
+}
+LOAD_INSTANTIATE(mesh::cluster, ser20::iarchive_binary_t);
+LOAD_INSTANTIATE(mesh::cluster, ser20::iarchive_associative_t);
+
+SAVE(mesh::collision_data)
+{
+    try_save(ar, ser20::make_nvp("vertices", obj.vertices));
+    try_save(ar, ser20::make_nvp("indices", obj.indices));
+    try_save(ar, ser20::make_nvp("hull", obj.hull));
+}
+SAVE_INSTANTIATE(mesh::collision_data, ser20::oarchive_binary_t);
+SAVE_INSTANTIATE(mesh::collision_data, ser20::oarchive_associative_t);
+
+LOAD(mesh::collision_data)
+{
+    try_load(ar, ser20::make_nvp("vertices", obj.vertices));
+    try_load(ar, ser20::make_nvp("indices", obj.indices));
+    try_load(ar, ser20::make_nvp("hull", obj.hull));
+}
+LOAD_INSTANTIATE(mesh::collision_data, ser20::iarchive_binary_t);
+LOAD_INSTANTIATE(mesh::collision_data, ser20::iarchive_associative_t);
+
 SAVE(mesh::triangle)
 {
     try_save(ar, ser20::make_nvp("data_group_id", obj.data_group_id));
@@ -211,7 +274,9 @@ SAVE(mesh::load_data)
     try_save(ar, ser20::make_nvp("skin_data", obj.skin_data));
     try_save(ar, ser20::make_nvp("root_node", obj.root_node));
     try_save(ar, ser20::make_nvp("bbox", obj.bbox));
-
+    try_save(ar, ser20::make_nvp("clusters", obj.clusters));
+    try_save(ar, ser20::make_nvp("collision", obj.collision));
+    try_save(ar, ser20::make_nvp("collision_bvh", obj.collision.bvh));
 }
 SAVE_INSTANTIATE(mesh::load_data, ser20::oarchive_binary_t);
 SAVE_INSTANTIATE(mesh::load_data, ser20::oarchive_associative_t);
@@ -228,7 +293,11 @@ LOAD(mesh::load_data)
     try_load(ar, ser20::make_nvp("skin_data", obj.skin_data));
     try_load(ar, ser20::make_nvp("root_node", obj.root_node));
     try_load(ar, ser20::make_nvp("bbox", obj.bbox));
-
+    // Meshes compiled before clusters existed end here.
+    try_load(ar, ser20::make_nvp("clusters", obj.clusters));
+    try_load(ar, ser20::make_nvp("collision", obj.collision));
+    // Meshes compiled before the baked bvh end here.
+    try_load(ar, ser20::make_nvp("collision_bvh", obj.collision.bvh));
 }
 LOAD_INSTANTIATE(mesh::load_data, ser20::iarchive_binary_t);
 LOAD_INSTANTIATE(mesh::load_data, ser20::iarchive_associative_t);
@@ -10,6 +10,12 @@ namespace unravel
 REFLECT_EXTERN(mesh::info);
 
 
+SAVE_EXTERN(mesh::cluster);
+LOAD_EXTERN(mesh::cluster);
+
+SAVE_EXTERN(mesh::collision_data);
+LOAD_EXTERN(mesh::collision_data);
+
 SAVE_EXTERN(mesh::triangle);
 LOAD_EXTERN(mesh::triangle);
 
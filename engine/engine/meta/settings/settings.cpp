@@ -4,10 +4,13 @@
 #include <serialization/associative_archive.h>
 #include <serialization/binary_archive.h>
 #include <serialization/types/array.hpp>
+#include <serialization/types/vector.hpp>
 #include <engine/meta/assets/asset_handle.hpp>
 #include <engine/meta/ecs/entity.hpp>
 #include <engine/meta/input/input.hpp>
 #include <engine/meta/assets/asset_importer_meta.hpp>
+#include <engine/meta/layers/layer_mask.hpp>
+#include <engine/meta/core/math/vector.hpp>
 
 namespace unravel
 {
@@ -200,7 +203,12 @@ REFLECT_INLINE(settings::time_settings)
             rttr::metadata("pretty_name", "Max Fixed Steps"),
             rttr::metadata(
                 "tooltip",
-                "A cap for framerate-idependent worst case scenario. No more than this much fixed updates per frame."));
+                "A cap for framerate-idependent worst case scenario. No more than this much fixed updates per frame."))
+        .property("interpolate_physics", &settings::time_settings::interpolate_physics)(
+            rttr::metadata("pretty_name", "Interpolate Physics"),
+            rttr::metadata("tooltip",
+                           "Renders moving rigidbodies between their last two fixed step poses,\n"
+                           "so a low fixed timestep does not look choppy. Adds up to one fixed step of latency."));
 
     // Register time_settings with entt
     entt::meta_factory<settings::time_settings>{}
@@ -221,6 +229,12 @@ REFLECT_INLINE(settings::time_settings)
             entt::attribute{"name", "max_fixed_steps"},
             entt::attribute{"pretty_name", "Max Fixed Steps"},
             entt::attribute{"tooltip", "A cap for framerate-idependent worst case scenario. No more than this much fixed updates per frame."},
+        })
+        .data<&settings::time_settings::interpolate_physics>("interpolate_physics"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "interpolate_physics"},
+            entt::attribute{"pretty_name", "Interpolate Physics"},
+            entt::attribute{"tooltip", "Renders moving rigidbodies between their last two fixed step poses,\nso a low fixed timestep does not look choppy. Adds up to one fixed step of latency."},
         });
 }
 
@@ -228,12 +242,373 @@ SAVE_INLINE(settings::time_settings)
 {
     try_save(ar, ser20::make_nvp("fixed_timestep", obj.fixed_timestep));
     try_save(ar, ser20::make_nvp("max_fixed_steps", obj.max_fixed_steps));
+    try_save(ar, ser20::make_nvp("interpolate_physics", obj.interpolate_physics));
 }
 
 LOAD_INLINE(settings::time_settings)
 {
     try_load(ar, ser20::make_nvp("fixed_timestep", obj.fixed_timestep));
     try_load(ar, ser20::make_nvp("max_fixed_steps", obj.max_fixed_steps));
+    try_load(ar, ser20::make_nvp("interpolate_physics", obj.interpolate_physics));
+}
+
+REFLECT_INLINE(settings::physics_settings::contact_filter)
+{
+    rttr::registration::class_<settings::physics_settings::contact_filter>("contact_filter")(
+        rttr::metadata("pretty_name", "Contact Filter"))
+        .constructor<>()()
+        .property("layers_a", &settings::physics_settings::contact_filter::layers_a)(
+            rttr::metadata("pretty_name", "Layers A"),
+            rttr::metadata("tooltip", "Layers of one body of the pair."))
+        .property("layers_b", &settings::physics_settings::contact_filter::layers_b)(
+            rttr::metadata("pretty_name", "Layers B"),
+            rttr::metadata("tooltip", "Layers of the other body of the pair."))
+        .property("report_events", &settings::physics_settings::contact_filter::report_events)(
+            rttr::metadata("pretty_name", "Report Events"),
+            rttr::metadata("tooltip", "Whether contacts between these layers are reported to scripts at all."))
+        .property("min_impulse", &settings::physics_settings::contact_filter::min_impulse)(
+            rttr::metadata("pretty_name", "Min Impulse"),
+            rttr::metadata("min", 0.0f),
+            rttr::metadata("tooltip", "Collisions starting with a smaller total impulse are not reported."));
+
+    // Register contact_filter with entt
+    entt::meta_factory<settings::physics_settings::contact_filter>{}
+        .type("contact_filter"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "contact_filter"},
+            entt::attribute{"pretty_name", "Contact Filter"},
+        })
+        .data<&settings::physics_settings::contact_filter::layers_a>("layers_a"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "layers_a"},
+            entt::attribute{"pretty_name", "Layers A"},
+            entt::attribute{"tooltip", "Layers of one body of the pair."},
+        })
+        .data<&settings::physics_settings::contact_filter::layers_b>("layers_b"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "layers_b"},
+            entt::attribute{"pretty_name", "Layers B"},
+            entt::attribute{"tooltip", "Layers of the other body of the pair."},
+        })
+        .data<&settings::physics_settings::contact_filter::report_events>("report_events"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "report_events"},
+            entt::attribute{"pretty_name", "Report Events"},
+            entt::attribute{"tooltip", "Whether contacts between these layers are reported to scripts at all."},
+        })
+        .data<&settings::physics_settings::contact_filter::min_impulse>("min_impulse"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "min_impulse"},
+            entt::attribute{"pretty_name", "Min Impulse"},
+            entt::attribute{"min", 0.0f},
+            entt::attribute{"tooltip", "Collisions starting with a smaller total impulse are not reported."},
+        });
+}
+
+SAVE_INLINE(settings::physics_settings::contact_filter)
+{
+    try_save(ar, ser20::make_nvp("layers_a", obj.layers_a));
+    try_save(ar, ser20::make_nvp("layers_b", obj.layers_b));
+    try_save(ar, ser20::make_nvp("report_events", obj.report_events));
+    try_save(ar, ser20::make_nvp("min_impulse", obj.min_impulse));
+}
+
+LOAD_INLINE(settings::physics_settings::contact_filter)
+{
+    try_load(ar, ser20::make_nvp("layers_a", obj.layers_a));
+    try_load(ar, ser20::make_nvp("layers_b", obj.layers_b));
+    try_load(ar, ser20::make_nvp("report_events", obj.report_events));
+    try_load(ar, ser20::make_nvp("min_impulse", obj.min_impulse));
+}
+
+REFLECT_INLINE(settings::physics_settings)
+{
+    rttr::registration::enumeration<settings::physics_settings::broadphase_type>("broadphase_type")(
+        rttr::value("Dynamic AABB Tree", settings::physics_settings::broadphase_type::dbvt),
+        rttr::value("Sweep And Prune", settings::physics_settings::broadphase_type::sweep_and_prune),
+        rttr::value("Uniform Grid", settings::physics_settings::broadphase_type::uniform_grid));
+
+    rttr::registration::class_<settings::physics_settings>("physics_settings")(rttr::metadata("pretty_name", "Physics"))
+        .constructor<>()()
+        .property("contact_filters", &settings::physics_settings::contact_filters)(
+            rttr::metadata("pretty_name", "Contact Filters"),
+            rttr::metadata("tooltip",
+                           "Filters for the contact events reported to scripts, by layer pair.\n"
+                           "The first filter matching a pair is used, pairs matching none are always reported."))
+        .property("sleep_linear_threshold", &settings::physics_settings::sleep_linear_threshold)(
+            rttr::metadata("pretty_name", "Sleep Linear Threshold"),
+            rttr::metadata("min", 0.0f),
+            rttr::metadata("tooltip", "Linear velocity under which a body is considered at rest."))
+        .property("sleep_angular_threshold", &settings::physics_settings::sleep_angular_threshold)(
+            rttr::metadata("pretty_name", "Sleep Angular Threshold"),
+            rttr::metadata("min", 0.0f),
+            rttr::metadata("tooltip", "Angular velocity under which a body is considered at rest."))
+        .property("time_to_sleep", &settings::physics_settings::time_to_sleep)(
+            rttr::metadata("pretty_name", "Time To Sleep"),
+            rttr::metadata("min", 0.0f),
+            rttr::metadata("tooltip", "Seconds an island has to rest before it falls asleep and stops being simulated."))
+        .property("broadphase", &settings::physics_settings::broadphase)(
+            rttr::metadata("pretty_name", "Broadphase"),
+            rttr::metadata("tooltip",
+                           "How the potentially colliding pairs are found, applied when the simulation starts.\n"
+                           "Dynamic AABB Tree suits most scenes, Sweep And Prune many bodies moving little inside "
+                           "the world bounds and Uniform Grid large flat open worlds."))
+        .property("dbvt_dynamic_updates", &settings::physics_settings::dbvt_dynamic_updates)(
+            rttr::metadata("pretty_name", "Tree Dynamic Updates"),
+            rttr::metadata("min", 0),
+            rttr::metadata("max", 100),
+            rttr::metadata("tooltip", "Percentage of the moving tree nodes rebalanced per step."))
+        .property("dbvt_fixed_updates", &settings::physics_settings::dbvt_fixed_updates)(
+            rttr::metadata("pretty_name", "Tree Fixed Updates"),
+            rttr::metadata("min", 0),
+            rttr::metadata("max", 100),
+            rttr::metadata("tooltip", "Percentage of the resting tree nodes rebalanced per step."))
+        .property("dbvt_prediction", &settings::physics_settings::dbvt_prediction)(
+            rttr::metadata("pretty_name", "Tree Prediction"),
+            rttr::metadata("min", 0.0f),
+            rttr::metadata("step", 0.1f),
+            rttr::metadata("tooltip",
+                           "Fraction of their size moving bounds are extended by along their motion,\n"
+                           "so their nodes are refit less often at the cost of more pairs."))
+        .property("dbvt_deferred_collide", &settings::physics_settings::dbvt_deferred_collide)(
+            rttr::metadata("pretty_name", "Tree Deferred Collide"),
+            rttr::metadata("tooltip", "Find the pairs of added bodies on the next step instead of right away."))
+        .property("world_min", &settings::physics_settings::world_min)(
+            rttr::metadata("pretty_name", "World Min"),
+            rttr::metadata("tooltip", "Lower corner of the bounds sorted by Sweep And Prune."))
+        .property("world_max", &settings::physics_settings::world_max)(
+            rttr::metadata("pretty_name", "World Max"),
+            rttr::metadata("tooltip", "Upper corner of the bounds sorted by Sweep And Prune."))
+        .property("grid_cell_size", &settings::physics_settings::grid_cell_size)(
+            rttr::metadata("pretty_name", "Grid Cell Size"),
+            rttr::metadata("min", 0.1f),
+            rttr::metadata("tooltip",
+                           "Side of the Uniform Grid cells, around the size of the larger moving bodies.\n"
+                           "Queries walk the cells they cross, long rays and queries right after bodies moved "
+                           "outside of a step test every body."))
+        .property("max_bodies", &settings::physics_settings::max_bodies)(
+            rttr::metadata("pretty_name", "Max Bodies"),
+            rttr::metadata("min", 1),
+            rttr::metadata("tooltip",
+                           "Most bodies Sweep And Prune and Uniform Grid can hold.\n"
+                           "Scenes starting with more use the Dynamic AABB Tree, "
+                           "bodies added past it are not simulated."))
+        .property("streaming", &settings::physics_settings::streaming)(
+            rttr::metadata("pretty_name", "Streaming"),
+            rttr::metadata("tooltip",
+                           "Simulate only the bodies near the streaming anchors.\n"
+                           "Bodies streamed out keep their state and resume where they left off."))
+        .property("streaming_camera_anchors", &settings::physics_settings::streaming_camera_anchors)(
+            rttr::metadata("pretty_name", "Stream Around Cameras"),
+            rttr::metadata("tooltip", "Use every camera as a streaming anchor."))
+        .property("streaming_anchor_tag", &settings::physics_settings::streaming_anchor_tag)(
+            rttr::metadata("pretty_name", "Streaming Anchor Tag"),
+            rttr::metadata("tooltip", "Entities with this tag are streaming anchors."))
+        .property("streaming_radius", &settings::physics_settings::streaming_radius)(
+            rttr::metadata("pretty_name", "Streaming Radius"),
+            rttr::metadata("min", 0.0f),
+            rttr::metadata("tooltip", "Bodies closer than this to an anchor are simulated."))
+        .property("streaming_hysteresis", &settings::physics_settings::streaming_hysteresis)(
+            rttr::metadata("pretty_name", "Streaming Hysteresis"),
+            rttr::metadata("min", 0.0f),
+            rttr::metadata("tooltip",
+                           "Extra distance past the radius before a simulated body is streamed out,\n"
+                           "so bodies moving along the border don't enter and leave every step."));
+
+    // Register broadphase_type enum with entt
+    entt::meta_factory<settings::physics_settings::broadphase_type>{}
+        .type("broadphase_type"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "broadphase_type"},
+        })
+        .data<settings::physics_settings::broadphase_type::dbvt>("dbvt"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "dbvt"},
+            entt::attribute{"pretty_name", "Dynamic AABB Tree"},
+        })
+        .data<settings::physics_settings::broadphase_type::sweep_and_prune>("sweep_and_prune"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "sweep_and_prune"},
+            entt::attribute{"pretty_name", "Sweep And Prune"},
+        })
+        .data<settings::physics_settings::broadphase_type::uniform_grid>("uniform_grid"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "uniform_grid"},
+            entt::attribute{"pretty_name", "Uniform Grid"},
+        });
+
+    // Register physics_settings with entt
+    entt::meta_factory<settings::physics_settings>{}
+        .type("physics_settings"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "physics_settings"},
+            entt::attribute{"pretty_name", "Physics"},
+        })
+        .data<&settings::physics_settings::contact_filters>("contact_filters"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "contact_filters"},
+            entt::attribute{"pretty_name", "Contact Filters"},
+            entt::attribute{"tooltip", "Filters for the contact events reported to scripts, by layer pair.\nThe first filter matching a pair is used, pairs matching none are always reported."},
+        })
+        .data<&settings::physics_settings::sleep_linear_threshold>("sleep_linear_threshold"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "sleep_linear_threshold"},
+            entt::attribute{"pretty_name", "Sleep Linear Threshold"},
+            entt::attribute{"min", 0.0f},
+            entt::attribute{"tooltip", "Linear velocity under which a body is considered at rest."},
+        })
+        .data<&settings::physics_settings::sleep_angular_threshold>("sleep_angular_threshold"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "sleep_angular_threshold"},
+            entt::attribute{"pretty_name", "Sleep Angular Threshold"},
+            entt::attribute{"min", 0.0f},
+            entt::attribute{"tooltip", "Angular velocity under which a body is considered at rest."},
+        })
+        .data<&settings::physics_settings::time_to_sleep>("time_to_sleep"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "time_to_sleep"},
+            entt::attribute{"pretty_name", "Time To Sleep"},
+            entt::attribute{"min", 0.0f},
+            entt::attribute{"tooltip", "Seconds an island has to rest before it falls asleep and stops being simulated."},
+        })
+        .data<&settings::physics_settings::broadphase>("broadphase"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "broadphase"},
+            entt::attribute{"pretty_name", "Broadphase"},
+            entt::attribute{"tooltip", "How the potentially colliding pairs are found, applied when the simulation starts.\nDynamic AABB Tree suits most scenes, Sweep And Prune many bodies moving little inside the world bounds and Uniform Grid large flat open worlds."},
+        })
+        .data<&settings::physics_settings::dbvt_dynamic_updates>("dbvt_dynamic_updates"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "dbvt_dynamic_updates"},
+            entt::attribute{"pretty_name", "Tree Dynamic Updates"},
+            entt::attribute{"min", 0},
+            entt::attribute{"max", 100},
+            entt::attribute{"tooltip", "Percentage of the moving tree nodes rebalanced per step."},
+        })
+        .data<&settings::physics_settings::dbvt_fixed_updates>("dbvt_fixed_updates"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "dbvt_fixed_updates"},
+            entt::attribute{"pretty_name", "Tree Fixed Updates"},
+            entt::attribute{"min", 0},
+            entt::attribute{"max", 100},
+            entt::attribute{"tooltip", "Percentage of the resting tree nodes rebalanced per step."},
+        })
+        .data<&settings::physics_settings::dbvt_prediction>("dbvt_prediction"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "dbvt_prediction"},
+            entt::attribute{"pretty_name", "Tree Prediction"},
+            entt::attribute{"min", 0.0f},
+            entt::attribute{"step", 0.1f},
+            entt::attribute{"tooltip", "Fraction of their size moving bounds are extended by along their motion,\nso their nodes are refit less often at the cost of more pairs."},
+        })
+        .data<&settings::physics_settings::dbvt_deferred_collide>("dbvt_deferred_collide"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "dbvt_deferred_collide"},
+            entt::attribute{"pretty_name", "Tree Deferred Collide"},
+            entt::attribute{"tooltip", "Find the pairs of added bodies on the next step instead of right away."},
+        })
+        .data<&settings::physics_settings::world_min>("world_min"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "world_min"},
+            entt::attribute{"pretty_name", "World Min"},
+            entt::attribute{"tooltip", "Lower corner of the bounds sorted by Sweep And Prune."},
+        })
+        .data<&settings::physics_settings::world_max>("world_max"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "world_max"},
+            entt::attribute{"pretty_name", "World Max"},
+            entt::attribute{"tooltip", "Upper corner of the bounds sorted by Sweep And Prune."},
+        })
+        .data<&settings::physics_settings::grid_cell_size>("grid_cell_size"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "grid_cell_size"},
+            entt::attribute{"pretty_name", "Grid Cell Size"},
+            entt::attribute{"min", 0.1f},
+            entt::attribute{"tooltip", "Side of the Uniform Grid cells, around the size of the larger moving bodies.\nQueries walk the cells they cross, long rays and queries right after bodies moved outside of a step test every body."},
+        })
+        .data<&settings::physics_settings::max_bodies>("max_bodies"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "max_bodies"},
+            entt::attribute{"pretty_name", "Max Bodies"},
+            entt::attribute{"min", 1},
+            entt::attribute{"tooltip", "Most bodies Sweep And Prune and Uniform Grid can hold.\nScenes starting with more use the Dynamic AABB Tree, bodies added past it are not simulated."},
+        })
+        .data<&settings::physics_settings::streaming>("streaming"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "streaming"},
+            entt::attribute{"pretty_name", "Streaming"},
+            entt::attribute{"tooltip", "Simulate only the bodies near the streaming anchors.\nBodies streamed out keep their state and resume where they left off."},
+        })
+        .data<&settings::physics_settings::streaming_camera_anchors>("streaming_camera_anchors"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "streaming_camera_anchors"},
+            entt::attribute{"pretty_name", "Stream Around Cameras"},
+            entt::attribute{"tooltip", "Use every camera as a streaming anchor."},
+        })
+        .data<&settings::physics_settings::streaming_anchor_tag>("streaming_anchor_tag"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "streaming_anchor_tag"},
+            entt::attribute{"pretty_name", "Streaming Anchor Tag"},
+            entt::attribute{"tooltip", "Entities with this tag are streaming anchors."},
+        })
+        .data<&settings::physics_settings::streaming_radius>("streaming_radius"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "streaming_radius"},
+            entt::attribute{"pretty_name", "Streaming Radius"},
+            entt::attribute{"min", 0.0f},
+            entt::attribute{"tooltip", "Bodies closer than this to an anchor are simulated."},
+        })
+        .data<&settings::physics_settings::streaming_hysteresis>("streaming_hysteresis"_hs)
+        .custom<entt::attributes>(entt::attributes{
+            entt::attribute{"name", "streaming_hysteresis"},
+            entt::attribute{"pretty_name", "Streaming Hysteresis"},
+            entt::attribute{"min", 0.0f},
+            entt::attribute{"tooltip", "Extra distance past the radius before a simulated body is streamed out,\nso bodies moving along the border don't enter and leave every step."},
+        });
+}
+
+SAVE_INLINE(settings::physics_settings)
+{
+    try_save(ar, ser20::make_nvp("contact_filters", obj.contact_filters));
+    try_save(ar, ser20::make_nvp("sleep_linear_threshold", obj.sleep_linear_threshold));
+    try_save(ar, ser20::make_nvp("sleep_angular_threshold", obj.sleep_angular_threshold));
+    try_save(ar, ser20::make_nvp("time_to_sleep", obj.time_to_sleep));
+    try_save(ar, ser20::make_nvp("broadphase", obj.broadphase));
+    try_save(ar, ser20::make_nvp("dbvt_dynamic_updates", obj.dbvt_dynamic_updates));
+    try_save(ar, ser20::make_nvp("dbvt_fixed_updates", obj.dbvt_fixed_updates));
+    try_save(ar, ser20::make_nvp("dbvt_prediction", obj.dbvt_prediction));
+    try_save(ar, ser20::make_nvp("dbvt_deferred_collide", obj.dbvt_deferred_collide));
+    try_save(ar, ser20::make_nvp("world_min", obj.world_min));
+    try_save(ar, ser20::make_nvp("world_max", obj.world_max));
+    try_save(ar, ser20::make_nvp("grid_cell_size", obj.grid_cell_size));
+    try_save(ar, ser20::make_nvp("max_bodies", obj.max_bodies));
+    try_save(ar, ser20::make_nvp("streaming", obj.streaming));
+    try_save(ar, ser20::make_nvp("streaming_camera_anchors", obj.streaming_camera_anchors));
+    try_save(ar, ser20::make_nvp("streaming_anchor_tag", obj.streaming_anchor_tag));
+    try_save(ar, ser20::make_nvp("streaming_radius", obj.streaming_radius));
+    try_save(ar, ser20::make_nvp("streaming_hysteresis", obj.streaming_hysteresis));
+}
+
+LOAD_INLINE(settings::physics_settings)
+{
+    try_load(ar, ser20::make_nvp("contact_filters", obj.contact_filters));
+    try_load(ar, ser20::make_nvp("sleep_linear_threshold", obj.sleep_linear_threshold));
+    try_load(ar, ser20::make_nvp("sleep_angular_threshold", obj.sleep_angular_threshold));
+    try_load(ar, ser20::make_nvp("time_to_sleep", obj.time_to_sleep));
+    try_load(ar, ser20::make_nvp("broadphase", obj.broadphase));
+    try_load(ar, ser20::make_nvp("dbvt_dynamic_updates", obj.dbvt_dynamic_updates));
+    try_load(ar, ser20::make_nvp("dbvt_fixed_updates", obj.dbvt_fixed_updates));
+    try_load(ar, ser20::make_nvp("dbvt_prediction", obj.dbvt_prediction));
+    try_load(ar, ser20::make_nvp("dbvt_deferred_collide", obj.dbvt_deferred_collide));
+    try_load(ar, ser20::make_nvp("world_min", obj.world_min));
+    try_load(ar, ser20::make_nvp("world_max", obj.world_max));
+    try_load(ar, ser20::make_nvp("grid_cell_size", obj.grid_cell_size));
+    try_load(ar, ser20::make_nvp("max_bodies", obj.max_bodies));
+    try_load(ar, ser20::make_nvp("streaming", obj.streaming));
+    try_load(ar, ser20::make_nvp("streaming_camera_anchors", obj.streaming_camera_anchors));
+    try_load(ar, ser20::make_nvp("streaming_anchor_tag", obj.streaming_anchor_tag));
+    try_load(ar, ser20::make_nvp("streaming_radius", obj.streaming_radius));
+    try_load(ar, ser20::make_nvp("streaming_hysteresis", obj.streaming_hysteresis));
 }
 
 REFLECT_INLINE(settings::layer_settings)
@@ -444,6 +819,7 @@ SAVE(settings)
     try_save(ar, ser20::make_nvp("input", obj.input));
     try_save(ar, ser20::make_nvp("time", obj.time));
     try_save(ar, ser20::make_nvp("resolutions", obj.resolution.resolutions));
+    try_save(ar, ser20::make_nvp("physics", obj.physics));
 }
 SAVE_INSTANTIATE(settings, ser20::oarchive_associative_t);
 SAVE_INSTANTIATE(settings, ser20::oarchive_binary_t);
@@ -458,6 +834,7 @@ LOAD(settings)
     try_load(ar, ser20::make_nvp("input", obj.input));
     try_load(ar, ser20::make_nvp("time", obj.time));
     try_load(ar, ser20::make_nvp("resolutions", obj.resolution.resolutions));
+    try_load(ar, ser20::make_nvp("physics", obj.physics));
 }
 LOAD_INSTANTIATE(settings, ser20::iarchive_associative_t);
 LOAD_INSTANTIATE(settings, ser20::iarchive_binary_t);
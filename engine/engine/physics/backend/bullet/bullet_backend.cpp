@@ -1,4 +1,5 @@
 #include "bullet_backend.h"
+#include "concurrentqueue.h"
 
 #include <engine/defaults/defaults.h>
 #include <engine/events.h>
@@ -10,6 +11,8 @@
 #include <engine/ecs/components/transform_component.h>
 #include <engine/ecs/ecs.h>
 #include <engine/engine.h>
+#include <engine/rendering/ecs/components/camera_component.h>
+#include <engine/rendering/mesh.h>
 #include <engine/scripting/ecs/components/script_component.h>
 #include <engine/scripting/ecs/systems/script_system.h>
 #include <engine/settings/settings.h>
@@ -23,9 +26,18 @@
 #include <btBulletCollisionCommon.h>
 #include <btBulletDynamicsCommon.h>
 
+#include <base/hash.hpp>
 #include <hpp/flat_map.hpp>
 #include <logging/logging.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <random>
+#include <unordered_map>
+
 #ifdef NDEBUG
 #define BULLET_MT 1
 #endif
@@ -33,6 +45,9 @@
 #ifdef BULLET_MT
 #include "LinearMath/btThreads.h"
 #include <thread>
+
+#define POOLSTL_STD_SUPPLEMENT 1
+#include <poolstl/poolstl.hpp>
 #endif
 
 namespace
@@ -69,29 +84,6 @@ namespace
 {
 bool enable_logging = false;
 
-enum class manifold_type
-{
-    collision,
-    sensor
-};
-
-enum class event_type
-{
-    enter,
-    exit,
-    stay
-};
-
-struct contact_manifold
-{
-    manifold_type type{};
-    event_type event{};
-    entt::handle a{};
-    entt::handle b{};
-
-    std::vector<unravel::manifold_point> contacts;
-};
-
 const btVector3 gravity_sun(btScalar(0), btScalar(-274), btScalar(0));
 const btVector3 gravity_mercury(btScalar(0), btScalar(-3.7), btScalar(0));
 const btVector3 gravity_venus(btScalar(0), btScalar(-8.87), btScalar(0));
@@ -655,313 +647,1328 @@ struct sphere_overlap_callback : btCollisionWorld::ContactResultCallback
     }
 };
 
-struct rigidbody
+// Static bvh over the collision triangles baked into a mesh. Keeps the mesh alive since the
+// triangles are referenced, not copied.
+ATTRIBUTE_ALIGNED16(class)
+btBvhTriangleMeshShapeOwning : public btBvhTriangleMeshShape
 {
-    std::shared_ptr<btRigidBody> internal{};
-    std::shared_ptr<btCollisionShape> internal_shape{};
-    int collision_filter_group{};
-    int collision_filter_mask{};
-};
+public:
+    BT_DECLARE_ALIGNED_ALLOCATOR();
 
-struct world
-{
-    std::shared_ptr<btBroadphaseInterface> broadphase;
-    std::shared_ptr<btCollisionDispatcher> dispatcher;
-    std::shared_ptr<btConstraintSolver> solver;
-    std::shared_ptr<btConstraintSolverPoolMt> solver_pool;
-    std::shared_ptr<btDefaultCollisionConfiguration> collision_config;
-    std::shared_ptr<btDiscreteDynamicsWorld> dynamics_world;
+    btBvhTriangleMeshShapeOwning(std::shared_ptr<unravel::mesh> source,
+                                 std::unique_ptr<btTriangleIndexVertexArray> triangles)
+        : btBvhTriangleMeshShape(triangles.get(), true)
+        , source_(std::move(source))
+        , triangles_(std::move(triangles))
+    {
+    }
 
-    struct contact_record
+    // Uses the bvh baked at import. Deserializing patches the buffer, so it works on its own aligned copy.
+    btBvhTriangleMeshShapeOwning(std::shared_ptr<unravel::mesh> source,
+                                 std::unique_ptr<btTriangleIndexVertexArray> triangles,
+                                 const std::vector<uint8_t>& bvh)
+        : btBvhTriangleMeshShape(triangles.get(), true, false)
+        , source_(std::move(source))
+        , triangles_(std::move(triangles))
+        , bvh_buffer_(btAlignedAlloc(bvh.size(), 16))
     {
-        contact_record()
+        std::memcpy(bvh_buffer_.get(), bvh.data(), bvh.size());
+        auto baked = btOptimizedBvh::deSerializeInPlace(bvh_buffer_.get(), unsigned(bvh.size()), false);
+        if(baked)
         {
-            // Reserve a small typical number of contacts to avoid per-frame reallocation
-            cm.contacts.reserve(4);
+            setOptimizedBvh(static_cast<btOptimizedBvh*>(baked));
         }
+        else
+        {
+            buildOptimizedBvh();
+        }
+    }
 
-        contact_manifold cm;
-        bool active_this_frame = false;
-    };
-    hpp::flat_map<contact_key, contact_record> contacts_cache;
-    unravel::physics_vector<contact_manifold> to_enter;
-    unravel::physics_vector<contact_manifold> to_exit;
-
-    bool in_simulate{};
-    float elapsed{};
-
-    void add_rigidbody(const rigidbody& body)
+private:
+    struct aligned_free
     {
-        if(body.internal->isInWorld())
+        void operator()(void* buffer) const
         {
-            return;
+            btAlignedFree(buffer);
         }
+    };
 
-        btAssert(in_simulate == false);
+    std::shared_ptr<unravel::mesh> source_;
+    std::unique_ptr<btTriangleIndexVertexArray> triangles_;
+    std::unique_ptr<void, aligned_free> bvh_buffer_;
+};
 
-        dynamics_world->addRigidBody(body.internal.get(), body.collision_filter_group, body.collision_filter_mask);
-    }
+// Scaled instance of a shared bvh, so compound scaling never touches the shared shape.
+ATTRIBUTE_ALIGNED16(class)
+btScaledBvhTriangleMeshShapeOwning : public btScaledBvhTriangleMeshShape
+{
+public:
+    BT_DECLARE_ALIGNED_ALLOCATOR();
 
-    void remove_rigidbody(const rigidbody& body)
+    btScaledBvhTriangleMeshShapeOwning(std::shared_ptr<btBvhTriangleMeshShape> child)
+        : btScaledBvhTriangleMeshShape(child.get(), btVector3(1.0f, 1.0f, 1.0f))
+        , child_(std::move(child))
     {
-        if(!body.internal->isInWorld())
-        {
-            return;
-        }
-        btAssert(in_simulate == false);
-        dynamics_world->removeRigidBody(body.internal.get());
     }
 
-    void process_manifold(unravel::script_system& scripting, const contact_manifold& manifold)
-    {
-        switch(manifold.type)
-        {
-            case manifold_type::sensor:
-            {
-                if(manifold.event == event_type::enter)
-                {
-                    scripting.on_sensor_enter(manifold.a, manifold.b);
-                }
-                else
-                {
-                    scripting.on_sensor_exit(manifold.a, manifold.b);
-                }
+private:
+    std::shared_ptr<btBvhTriangleMeshShape> child_;
+};
 
-                break;
-            }
+void hash_vec3(size_t& seed, const math::vec3& v)
+{
+    utils::hash_combine(seed, v.x);
+    utils::hash_combine(seed, v.y);
+    utils::hash_combine(seed, v.z);
+}
 
-            case manifold_type::collision:
-            {
-                if(manifold.event == event_type::enter)
-                {
-                    scripting.on_collision_enter(manifold.a, manifold.b, manifold.contacts);
-                }
-                else
-                {
-                    scripting.on_collision_exit(manifold.a, manifold.b, manifold.contacts);
-                }
-                break;
-            }
+void hash_shape(size_t& seed, const unravel::physics_box_shape& shape)
+{
+    hash_vec3(seed, shape.center);
+    hash_vec3(seed, shape.extends);
+}
 
-            default:
-            {
-                break;
-            }
-        }
-    }
+void hash_shape(size_t& seed, const unravel::physics_mesh_shape& shape)
+{
+    hash_vec3(seed, shape.center);
+    utils::hash_combine(seed, shape.mesh.id());
+    utils::hash_combine(seed, shape.convex);
+}
 
-    void process_manifolds()
+template<typename Shape>
+void hash_shape(size_t& seed, const Shape& shape)
+{
+    hash_vec3(seed, shape.center);
+    utils::hash_combine(seed, shape.radius);
+    if constexpr(requires { shape.length; })
     {
-        auto& ctx = unravel::engine::context();
-        auto& scripting = ctx.get_cached<unravel::script_system>();
-        auto& ec = ctx.get_cached<unravel::ecs>();
-
-        auto* dispatcher = dynamics_world->getDispatcher();
-        int nm = dispatcher->getNumManifolds();
+        utils::hash_combine(seed, shape.length);
+    }
+}
 
-        // Phase 0: clear active flags
-        for(auto& kv : contacts_cache)
-            kv.second.active_this_frame = false;
+// Collision shapes shared between rigidbodies with the same shape description and scale.
+// Bodies own the shapes, the cache only keeps track of the live ones.
+struct shape_cache
+{
+    struct key
+    {
+        std::vector<unravel::physics_compound_shape> shapes;
+        math::vec3 scale{1.0f};
+        // Only kinematic bodies may collide with triangle meshes.
+        bool kinematic{};
 
-        to_enter.clear();
-        to_exit.clear();
-        to_enter.reserve(nm);
-        to_exit.reserve(contacts_cache.size());
+        auto operator==(const key& rhs) const -> bool = default;
+    };
 
-        // Phase 1: scan all current manifolds
-        for(int i = 0; i < nm; ++i)
+    struct key_hash
+    {
+        auto operator()(const key& k) const -> size_t
         {
-            auto* m = dispatcher->getManifoldByIndexInternal(i);
-            if(m->getNumContacts() == 0)
-                continue;
-
-            // Identify entities and sensor flags
-            auto* objA = m->getBody0();
-            auto* objB = m->getBody1();
-            bool isSensorA = objA->getCollisionFlags() & btCollisionObject::CF_NO_CONTACT_RESPONSE;
-            bool isSensorB = objB->getCollisionFlags() & btCollisionObject::CF_NO_CONTACT_RESPONSE;
-            auto eA = get_entity_from_user_index(ec, objA->getUserIndex());
-            auto eB = get_entity_from_user_index(ec, objB->getUserIndex());
-
-            // Handle trigger overlaps: A->B and B->A
-            if(isSensorA || isSensorB)
+            size_t seed = 0;
+            for(const auto& s : k.shapes)
             {
-                // A->B if A is sensor
-                {
-                    contact_key key{eA, eB};
-                    auto it = contacts_cache.find(key);
-                    if(it != contacts_cache.end())
-                    {
-                        it->second.active_this_frame = true;
-                    }
-                    else
-                    {
-                        contact_manifold cm{manifold_type::sensor, event_type::enter, eA, eB, {}};
-                        to_enter.push_back(cm);
-                        auto& rec = contacts_cache.emplace(key, contact_record{}).first->second;
-                        rec.cm = cm;
-                        rec.active_this_frame = true;
-                    }
-                }
-                // B->A if B is sensor
-                {
-                    contact_key key{eB, eA};
-                    auto it = contacts_cache.find(key);
-                    if(it != contacts_cache.end())
-                    {
-                        it->second.active_this_frame = true;
-                    }
-                    else
+                utils::hash_combine(seed, s.shape.index());
+                hpp::visit(
+                    [&](const auto& shape)
                     {
-                        contact_manifold cm{manifold_type::sensor, event_type::enter, eB, eA, {}};
-                        to_enter.push_back(cm);
-                        auto& rec = contacts_cache.emplace(key, contact_record{}).first->second;
-                        rec.cm = cm;
-                        rec.active_this_frame = true;
-                    }
-                }
-                continue;
-            }
-
-            // Handle collisions: only new ones cause ENTER
-            contact_key key{eA, eB};
-            auto it = contacts_cache.find(key);
-            if(it != contacts_cache.end())
-            {
-                // existing: refresh
-                it->second.active_this_frame = true;
-            }
-            else
-            {
-                // new collision
-                contact_manifold cm;
-                cm.type = manifold_type::collision;
-                cm.event = event_type::enter;
-                cm.a = eA;
-                cm.b = eB;
-                cm.contacts.reserve(m->getNumContacts());
-                for(int j = 0; j < m->getNumContacts(); ++j)
-                {
-                    auto const& p = m->getContactPoint(j);
-                    unravel::manifold_point mp;
-                    mp.a = from_bullet(p.getPositionWorldOnA());
-                    mp.b = from_bullet(p.getPositionWorldOnB());
-                    mp.normal_on_b = from_bullet(p.m_normalWorldOnB);
-                    mp.normal_on_a = -mp.normal_on_b;
-                    mp.impulse = p.getAppliedImpulse();
-                    mp.distance = p.getDistance();
-                    cm.contacts.push_back(mp);
-                }
-                to_enter.push_back(cm);
-                auto& rec = contacts_cache.emplace(key, contact_record{}).first->second;
-                rec.cm = cm;
-                rec.active_this_frame = true;
+                        hash_shape(seed, shape);
+                    },
+                    s.shape);
             }
+            hash_vec3(seed, k.scale);
+            utils::hash_combine(seed, k.kinematic);
+            return seed;
         }
+    };
 
-        // Phase 2: EXIT for stale entries
-        for(auto it = contacts_cache.begin(); it != contacts_cache.end();)
+    auto find(const key& k) -> std::shared_ptr<btCompoundShape>
+    {
+        requests++;
+
+        auto it = entries.find(k);
+        if(it == entries.end())
         {
-            if(!it->second.active_this_frame)
-            {
-                auto cm = it->second.cm;
-                cm.event = event_type::exit;
-                to_exit.push_back(cm);
-                it = contacts_cache.erase(it);
-            }
-            else
-            {
-                ++it;
-            }
+            return nullptr;
         }
 
-        // Phase 3: dispatch
-        for(auto& cm : to_enter)
+        return it->second.lock();
+    }
+
+    void insert(key k, const std::shared_ptr<btCompoundShape>& shape)
+    {
+        created++;
+
+        // Drop the entries of shapes released by all their bodies from time to time.
+        if(created % 64 == 0)
         {
-            process_manifold(scripting, cm);
+            std::erase_if(entries,
+                          [](const auto& kv)
+                          {
+                              return kv.second.expired();
+                          });
+            std::erase_if(triangle_meshes,
+                          [](const auto& kv)
+                          {
+                              return kv.second.expired();
+                          });
         }
-        for(auto& cm : to_exit)
+
+        entries[std::move(k)] = shape;
+    }
+
+    // The bvh of a mesh is built once and shared by every shape using the mesh.
+    auto get_triangle_mesh(const std::shared_ptr<unravel::mesh>& source) -> std::shared_ptr<btBvhTriangleMeshShape>
+    {
+        auto& entry = triangle_meshes[source.get()];
+        if(auto shape = entry.lock())
         {
-            process_manifold(scripting, cm);
+            return shape;
         }
+
+        auto& collision = const_cast<unravel::mesh::collision_data&>(source->get_collision_data());
+        auto triangles =
+            std::make_unique<btTriangleIndexVertexArray>(int(collision.indices.size() / 3),
+                                                         reinterpret_cast<int*>(collision.indices.data()),
+                                                         int(3 * sizeof(uint32_t)),
+                                                         int(collision.vertices.size()),
+                                                         &collision.vertices[0].x,
+                                                         int(sizeof(math::vec3)));
+
+        // Meshes compiled before the bvh was baked build it here.
+        auto shape = collision.bvh.empty()
+                         ? std::make_shared<btBvhTriangleMeshShapeOwning>(source, std::move(triangles))
+                         : std::make_shared<btBvhTriangleMeshShapeOwning>(source, std::move(triangles), collision.bvh);
+        entry = shape;
+        return shape;
     }
 
-    void simulate(btScalar dt, btScalar fixed_time_step = 1.0 / 60.0, int max_subs_steps = 10)
+    auto get_live_count() const -> size_t
     {
-        in_simulate = true;
+        return std::count_if(entries.begin(),
+                             entries.end(),
+                             [](const auto& kv)
+                             {
+                                 return !kv.second.expired();
+                             });
+    }
 
-        dynamics_world->stepSimulation(dt, max_subs_steps, fixed_time_step);
+    std::unordered_map<key, std::weak_ptr<btCompoundShape>, key_hash> entries;
+    std::unordered_map<const unravel::mesh*, std::weak_ptr<btBvhTriangleMeshShape>> triangle_meshes;
+    size_t requests{};
+    size_t created{};
+};
 
-        in_simulate = false;
+// Reports the bodies Bullet moves. Bullet only synchronizes motion states of active dynamic bodies,
+// so sleeping, static and kinematic bodies never show up in the list.
+ATTRIBUTE_ALIGNED16(struct)
+motion_state : public btMotionState
+{
+    BT_DECLARE_ALIGNED_ALLOCATOR();
+
+    motion_state(const btRigidBody* b, std::vector<entt::entity>* m)
+        : body(b)
+        , moved(m)
+    {
     }
 
-    auto ray_cast_closest(const math::vec3& origin,
-                          const math::vec3& direction,
-                          float max_distance,
-                          int layer_mask,
-                          bool query_sensors) -> hpp::optional<unravel::raycast_hit>
+    void getWorldTransform(btTransform & world_trans) const override
     {
-        if(!dynamics_world)
+        // The body transform is the source of truth, kinematic bodies are moved through it directly.
+        world_trans = body->getWorldTransform();
+    }
+
+    void setWorldTransform(const btTransform& world_trans) override
+    {
+        previous = current;
+        current = body->getWorldTransform();
+        moved->emplace_back(entt::entity(body->getUserIndex()));
+    }
+
+    // Teleports are not interpolated.
+    void reset(const btTransform& pose)
+    {
+        previous = pose;
+        current = pose;
+    }
+
+    // Pose between the last two steps, 'alpha' 0 being the previous one.
+    auto blend(float alpha) const -> btTransform
+    {
+        btTransform result;
+        result.setOrigin(previous.getOrigin().lerp(current.getOrigin(), alpha));
+        result.setRotation(previous.getRotation().slerp(current.getRotation(), alpha));
+        return result;
+    }
+
+    const btRigidBody* body{};
+    std::vector<entt::entity>* moved{};
+    btTransform previous{btTransform::getIdentity()};
+    btTransform current{btTransform::getIdentity()};
+};
+
+// Where the phases of a step add their time, nothing is measured while 'timing' is null.
+struct step_profiler
+{
+    template<typename F>
+    void measure(float unravel::physics_step_timing::*phase, F&& f)
+    {
+        if(!timing)
         {
-            return {};
+            f();
+            return;
         }
 
-        auto ray_origin = to_bullet(origin);
-        auto ray_end = to_bullet(origin + direction * max_distance);
+        auto start = std::chrono::steady_clock::now();
+        f();
+        timing->*phase += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
 
-        filter_closest_ray_callback ray_callback(ray_origin, ray_end, layer_mask, query_sensors);
+    unravel::physics_step_timing* timing{};
+};
 
-        ray_callback.m_flags |= btTriangleRaycastCallback::kF_UseGjkConvexCastRaytest;
-        dynamics_world->rayTest(ray_origin, ray_end, ray_callback);
-        if(ray_callback.hasHit())
-        {
-            const btRigidBody* body = btRigidBody::upcast(ray_callback.m_collisionObject);
-            if(body)
-            {
-                unravel::raycast_hit hit;
-                hit.entity = get_entity_id_from_user_index(body->getUserIndex());
-                hit.point = from_bullet(ray_callback.m_hitPointWorld);
-                hit.normal = from_bullet(ray_callback.m_hitNormalWorld);
-                hit.distance = math::distance(origin, hit.point);
+// Dynamics world reporting the time spent in the broadphase, narrowphase and solver.
+template<typename Base>
+ATTRIBUTE_ALIGNED16(class)
+profiled_dynamics_world : public Base
+{
+public:
+    BT_DECLARE_ALIGNED_ALLOCATOR();
 
-                return hit;
-            }
-        }
-        return {};
+    template<typename... Args>
+    profiled_dynamics_world(std::shared_ptr<step_profiler> profiler, Args&&... args)
+        : Base(std::forward<Args>(args)...)
+        , profiler_(std::move(profiler))
+    {
     }
 
-    auto ray_cast_all(const math::vec3& origin,
-                      const math::vec3& direction,
-                      float max_distance,
-                      int layer_mask,
-                      bool query_sensors) -> unravel::physics_vector<unravel::raycast_hit>
+    void updateAabbs() override
     {
-        if(!dynamics_world)
-        {
-            return {};
-        }
+        profiler_->measure(&unravel::physics_step_timing::broadphase,
+                           [&]()
+                           {
+                               Base::updateAabbs();
+                           });
+    }
 
-        auto ray_origin = to_bullet(origin);
-        auto ray_end = to_bullet(origin + direction * max_distance);
+    void computeOverlappingPairs() override
+    {
+        profiler_->measure(&unravel::physics_step_timing::broadphase,
+                           [&]()
+                           {
+                               Base::computeOverlappingPairs();
+                           });
+    }
 
-        filter_all_hits_ray_callback ray_callback(ray_origin, ray_end, layer_mask, query_sensors);
+    // Runs the broadphase then dispatches the pairs, whatever is not broadphase is narrowphase.
+    void performDiscreteCollisionDetection() override
+    {
+        float broadphase = profiler_->timing ? profiler_->timing->broadphase : 0.0f;
 
-        ray_callback.m_flags |= btTriangleRaycastCallback::kF_UseGjkConvexCastRaytest;
-        dynamics_world->rayTest(ray_origin, ray_end, ray_callback);
+        profiler_->measure(&unravel::physics_step_timing::narrowphase,
+                           [&]()
+                           {
+                               Base::performDiscreteCollisionDetection();
+                           });
 
-        if(!ray_callback.hasHit())
+        if(profiler_->timing)
         {
-            return {};
+            profiler_->timing->narrowphase -= profiler_->timing->broadphase - broadphase;
         }
+    }
 
-        unravel::physics_vector<unravel::raycast_hit> hits;
+protected:
+    void solveConstraints(btContactSolverInfo & solver_info) override
+    {
+        profiler_->measure(&unravel::physics_step_timing::solver,
+                           [&]()
+                           {
+                               Base::solveConstraints(solver_info);
+                           });
+    }
 
-        // Collect all hits
-        hits.reserve(ray_callback.m_hitPointWorld.size());
-        for(int i = 0; i < ray_callback.m_hitPointWorld.size(); ++i)
-        {
-            const btCollisionObject* collision_object = ray_callback.m_collisionObjects[i];
-            const btRigidBody* body = btRigidBody::upcast(collision_object);
+private:
+    std::shared_ptr<step_profiler> profiler_;
+};
+
+auto is_static_proxy(const btBroadphaseProxy* proxy) -> bool
+{
+    auto object = static_cast<const btCollisionObject*>(proxy->m_clientObject);
+    return object && object->isStaticObject() && !object->isKinematicObject();
+}
+
+// Group and mask test of bullet, also keeping pairs of two static bodies out of the pair cache.
+// Statics never move nor collide with each other, whatever the broadphase they only need pairs with the others.
+struct static_pair_filter : btOverlapFilterCallback
+{
+    auto needBroadphaseCollision(btBroadphaseProxy* proxy0, btBroadphaseProxy* proxy1) const -> bool override
+    {
+        bool collides = (proxy0->m_collisionFilterGroup & proxy1->m_collisionFilterMask) != 0 &&
+                        (proxy1->m_collisionFilterGroup & proxy0->m_collisionFilterMask) != 0;
+
+        return collides && !(is_static_proxy(proxy0) && is_static_proxy(proxy1));
+    }
+};
+
+// Broadphase for flat open worlds. The aabbs are hashed into square cells on the ground plane (x, z)
+// and pairs are only searched between the proxies sharing a cell, proxies spanning too many cells
+// are tested against all the others. Ray and aabb queries walk the cells they cross, they test every
+// proxy when the cells are out of date (bodies added, removed or moved since the last step) or the
+// query spans too many cells.
+ATTRIBUTE_ALIGNED16(class)
+grid_broadphase : public btSimpleBroadphase
+{
+public:
+    BT_DECLARE_ALIGNED_ALLOCATOR();
+
+    grid_broadphase(int max_proxies, btScalar cell_size)
+        : btSimpleBroadphase(max_proxies)
+        , inv_cell_size_(btScalar(1) / btMax(cell_size, btScalar(0.01)))
+    {
+    }
+
+    auto createProxy(const btVector3& aabb_min,
+                     const btVector3& aabb_max,
+                     int shape_type,
+                     void* user_ptr,
+                     int collision_filter_group,
+                     int collision_filter_mask,
+                     btDispatcher* dispatcher) -> btBroadphaseProxy* override
+    {
+        cells_valid_ = false;
+        return btSimpleBroadphase::createProxy(aabb_min,
+                                               aabb_max,
+                                               shape_type,
+                                               user_ptr,
+                                               collision_filter_group,
+                                               collision_filter_mask,
+                                               dispatcher);
+    }
+
+    void destroyProxy(btBroadphaseProxy* proxy, btDispatcher* dispatcher) override
+    {
+        cells_valid_ = false;
+        btSimpleBroadphase::destroyProxy(proxy, dispatcher);
+    }
+
+    void setAabb(btBroadphaseProxy* proxy,
+                 const btVector3& aabb_min,
+                 const btVector3& aabb_max,
+                 btDispatcher* dispatcher) override
+    {
+        cells_valid_ = false;
+        btSimpleBroadphase::setAabb(proxy, aabb_min, aabb_max, dispatcher);
+    }
+
+    void calculateOverlappingPairs(btDispatcher* dispatcher) override
+    {
+        remove_separated_pairs(dispatcher);
+        fill_cells();
+        add_cell_pairs();
+        add_large_pairs();
+    }
+
+    // Queries only read the cells, they can run side by side.
+    void aabbTest(const btVector3& aabb_min, const btVector3& aabb_max, btBroadphaseAabbCallback& callback) override
+    {
+        std::vector<int> found(large_.begin(), large_.end());
+        if(!collect_proxies(aabb_min, aabb_max, found))
+        {
+            btSimpleBroadphase::aabbTest(aabb_min, aabb_max, callback);
+            return;
+        }
+
+        std::sort(found.begin(), found.end());
+        found.erase(std::unique(found.begin(), found.end()), found.end());
+        for(int i : found)
+        {
+            auto& proxy = m_pHandles[i];
+            if(TestAabbAgainstAabb2(aabb_min, aabb_max, proxy.m_aabbMin, proxy.m_aabbMax))
+            {
+                callback.process(&proxy);
+            }
+        }
+    }
+
+    // Walks the ray a cell at a time, each part covering the cells of its bounds grown by the cast shape.
+    void rayTest(const btVector3& ray_from,
+                 const btVector3& ray_to,
+                 btBroadphaseRayCallback& callback,
+                 const btVector3& aabb_min = btVector3(0, 0, 0),
+                 const btVector3& aabb_max = btVector3(0, 0, 0)) override
+    {
+        const btVector3 delta = ray_to - ray_from;
+        const btScalar length = btSqrt(delta.x() * delta.x() + delta.z() * delta.z()) * inv_cell_size_;
+
+        // Also catches infinite rays.
+        if(!(length < btScalar(max_cells_per_query)))
+        {
+            btSimpleBroadphase::rayTest(ray_from, ray_to, callback, aabb_min, aabb_max);
+            return;
+        }
+
+        std::vector<int> found(large_.begin(), large_.end());
+        const int parts = btMax(int(std::ceil(length)), 1);
+        for(int p = 0; p < parts; ++p)
+        {
+            btVector3 a = ray_from + delta * (btScalar(p) / btScalar(parts));
+            btVector3 b = ray_from + delta * (btScalar(p + 1) / btScalar(parts));
+
+            btVector3 part_min = a;
+            part_min.setMin(b);
+            btVector3 part_max = a;
+            part_max.setMax(b);
+
+            if(!collect_proxies(part_min + aabb_min, part_max + aabb_max, found))
+            {
+                btSimpleBroadphase::rayTest(ray_from, ray_to, callback, aabb_min, aabb_max);
+                return;
+            }
+        }
+
+        std::sort(found.begin(), found.end());
+        found.erase(std::unique(found.begin(), found.end()), found.end());
+        for(int i : found)
+        {
+            callback.process(&m_pHandles[i]);
+        }
+    }
+
+private:
+    // Cells an aabb can span before its proxy is tested against all the others.
+    static constexpr int64_t max_cells_per_proxy = 64;
+    // Cells a query can walk before it tests every proxy instead.
+    static constexpr int64_t max_cells_per_query = 4096;
+
+    struct cell_entry
+    {
+        uint64_t cell{};
+        int proxy{};
+    };
+
+    struct separated_pairs_callback : btOverlapCallback
+    {
+        auto processOverlap(btBroadphasePair& pair) -> bool override
+        {
+            return !btSimpleBroadphase::aabbOverlap(static_cast<btSimpleBroadphaseProxy*>(pair.m_pProxy0),
+                                                    static_cast<btSimpleBroadphaseProxy*>(pair.m_pProxy1));
+        }
+    };
+
+    auto cell_of(btScalar v) const -> int32_t
+    {
+        // Clamped so that huge aabbs end up spanning too many cells rather than overflowing.
+        return int32_t(std::floor(btClamped(v * inv_cell_size_, btScalar(-1e9), btScalar(1e9))));
+    }
+
+    static auto cell_key(int32_t x, int32_t z) -> uint64_t
+    {
+        return (uint64_t(uint32_t(x)) << 32) | uint64_t(uint32_t(z));
+    }
+
+    void remove_separated_pairs(btDispatcher* dispatcher)
+    {
+        separated_pairs_callback callback;
+        m_pairCache->processAllOverlappingPairs(&callback, dispatcher);
+    }
+
+    void fill_cells()
+    {
+        entries_.clear();
+        large_.clear();
+
+        for(int i = 0; i <= m_LastHandleIndex; ++i)
+        {
+            const auto& proxy = m_pHandles[i];
+            if(!proxy.m_clientObject)
+            {
+                continue;
+            }
+
+            int32_t x0 = cell_of(proxy.m_aabbMin.x());
+            int32_t x1 = cell_of(proxy.m_aabbMax.x());
+            int32_t z0 = cell_of(proxy.m_aabbMin.z());
+            int32_t z1 = cell_of(proxy.m_aabbMax.z());
+
+            if((int64_t(x1) - x0 + 1) * (int64_t(z1) - z0 + 1) > max_cells_per_proxy)
+            {
+                large_.emplace_back(i);
+                continue;
+            }
+
+            for(int32_t x = x0; x <= x1; ++x)
+            {
+                for(int32_t z = z0; z <= z1; ++z)
+                {
+                    entries_.push_back({cell_key(x, z), i});
+                }
+            }
+        }
+
+        std::sort(entries_.begin(),
+                  entries_.end(),
+                  [](const cell_entry& lhs, const cell_entry& rhs)
+                  {
+                      return lhs.cell < rhs.cell || (lhs.cell == rhs.cell && lhs.proxy < rhs.proxy);
+                  });
+
+        cells_valid_ = true;
+    }
+
+    void add_pair(btSimpleBroadphaseProxy& a, btSimpleBroadphaseProxy& b)
+    {
+        if(aabbOverlap(&a, &b))
+        {
+            // Existing pairs are found and kept as they are.
+            m_pairCache->addOverlappingPair(&a, &b);
+        }
+    }
+
+    void add_cell_pairs()
+    {
+        for(size_t begin = 0; begin < entries_.size();)
+        {
+            const auto cell = entries_[begin].cell;
+            size_t end = begin + 1;
+            while(end < entries_.size() && entries_[end].cell == cell)
+            {
+                ++end;
+            }
+
+            for(size_t i = begin; i < end; ++i)
+            {
+                auto& a = m_pHandles[entries_[i].proxy];
+                for(size_t j = i + 1; j < end; ++j)
+                {
+                    auto& b = m_pHandles[entries_[j].proxy];
+
+                    // Proxies sharing several cells are only paired in the one holding the corner of their overlap.
+                    auto corner = cell_key(cell_of(btMax(a.m_aabbMin.x(), b.m_aabbMin.x())),
+                                           cell_of(btMax(a.m_aabbMin.z(), b.m_aabbMin.z())));
+                    if(corner == cell)
+                    {
+                        add_pair(a, b);
+                    }
+                }
+            }
+
+            begin = end;
+        }
+    }
+
+    // Appends the proxies sharing a cell with the bounds, a proxy is appended once per shared cell.
+    // Returns false when the cells are out of date or the bounds span too many cells.
+    auto collect_proxies(const btVector3& aabb_min, const btVector3& aabb_max, std::vector<int>& found) const -> bool
+    {
+        if(!cells_valid_)
+        {
+            return false;
+        }
+
+        int32_t x0 = cell_of(aabb_min.x());
+        int32_t x1 = cell_of(aabb_max.x());
+        int32_t z0 = cell_of(aabb_min.z());
+        int32_t z1 = cell_of(aabb_max.z());
+        if((int64_t(x1) - x0 + 1) * (int64_t(z1) - z0 + 1) > max_cells_per_query)
+        {
+            return false;
+        }
+
+        for(int32_t x = x0; x <= x1; ++x)
+        {
+            for(int32_t z = z0; z <= z1; ++z)
+            {
+                const auto cell = cell_key(x, z);
+                auto it = std::lower_bound(entries_.begin(),
+                                           entries_.end(),
+                                           cell,
+                                           [](const cell_entry& entry, uint64_t key)
+                                           {
+                                               return entry.cell < key;
+                                           });
+                for(; it != entries_.end() && it->cell == cell; ++it)
+                {
+                    found.emplace_back(it->proxy);
+                }
+            }
+        }
+
+        return true;
+    }
+
+    void add_large_pairs()
+    {
+        for(int large : large_)
+        {
+            auto& a = m_pHandles[large];
+            for(int i = 0; i <= m_LastHandleIndex; ++i)
+            {
+                auto& b = m_pHandles[i];
+                if(!b.m_clientObject || i == large)
+                {
+                    continue;
+                }
+
+                // Pairs of two large proxies are added once, by the first of them.
+                if(i < large && std::binary_search(large_.begin(), large_.end(), i))
+                {
+                    continue;
+                }
+
+                add_pair(a, b);
+            }
+        }
+    }
+
+    btScalar inv_cell_size_{};
+    // Whether the cells still match the proxies, they are filled again by the next step otherwise.
+    bool cells_valid_{};
+    // Proxy per covered cell, sorted by cell. Kept to reuse the allocations.
+    std::vector<cell_entry> entries_;
+    // Proxies spanning too many cells, in handle order.
+    std::vector<int> large_;
+};
+
+auto create_broadphase(const unravel::settings::physics_settings& settings) -> std::shared_ptr<btBroadphaseInterface>
+{
+    using broadphase_type = unravel::settings::physics_settings::broadphase_type;
+
+    auto max_bodies = unsigned(std::max(settings.max_bodies, 1));
+
+    switch(settings.broadphase)
+    {
+        case broadphase_type::sweep_and_prune:
+        {
+            return std::make_shared<bt32BitAxisSweep3>(to_bullet(math::min(settings.world_min, settings.world_max)),
+                                                       to_bullet(math::max(settings.world_min, settings.world_max)),
+                                                       max_bodies);
+        }
+
+        case broadphase_type::uniform_grid:
+        {
+            return std::make_shared<grid_broadphase>(int(max_bodies), settings.grid_cell_size);
+        }
+
+        case broadphase_type::dbvt:
+        default:
+        {
+            auto broadphase = std::make_shared<btDbvtBroadphase>();
+            broadphase->m_dupdates = math::clamp(settings.dbvt_dynamic_updates, 0, 100);
+            broadphase->m_fupdates = math::clamp(settings.dbvt_fixed_updates, 0, 100);
+            broadphase->m_prediction = std::max(settings.dbvt_prediction, 0.0f);
+            broadphase->m_deferedcollide = settings.dbvt_deferred_collide;
+            return broadphase;
+        }
+    }
+}
+
+struct rigidbody
+{
+    std::shared_ptr<motion_state> motion{};
+    std::shared_ptr<btRigidBody> internal{};
+    std::shared_ptr<btCollisionShape> internal_shape{};
+    int collision_filter_group{};
+    int collision_filter_mask{};
+    // Kept out of the dynamics world by region streaming, its state is left untouched until streamed back in.
+    bool streamed_out{};
+    // Streaming grid cell the body is bucketed in, by the center of its bounds.
+    uint64_t streaming_cell{};
+    bool has_streaming_cell{};
+};
+
+struct streaming_cell
+{
+    std::vector<entt::entity> bodies;
+    // Union of the bounds the bodies had when bucketed, only grows until the cell gets emptied.
+    btVector3 aabb_min{BT_LARGE_FLOAT, BT_LARGE_FLOAT, BT_LARGE_FLOAT};
+    btVector3 aabb_max{-BT_LARGE_FLOAT, -BT_LARGE_FLOAT, -BT_LARGE_FLOAT};
+};
+
+struct world
+{
+    std::shared_ptr<btBroadphaseInterface> broadphase;
+    std::shared_ptr<btOverlapFilterCallback> pair_filter;
+    std::shared_ptr<btCollisionDispatcher> dispatcher;
+    std::shared_ptr<btConstraintSolver> solver;
+    std::shared_ptr<btConstraintSolverPoolMt> solver_pool;
+    std::shared_ptr<btDefaultCollisionConfiguration> collision_config;
+    std::shared_ptr<btDiscreteDynamicsWorld> dynamics_world;
+
+    struct contact_record
+    {
+        unravel::contact_event_type type{};
+        entt::handle a{};
+        entt::handle b{};
+        // Points of the first contact, also reported when the pair separates.
+        unravel::physics_vector<unravel::manifold_point, 4> points;
+        bool active_this_frame = false;
+    };
+    hpp::flat_map<contact_key, contact_record> contacts_cache;
+    shape_cache shapes;
+
+    // Contact events of the steps since the last flush, pooled to keep their capacity across frames.
+    std::vector<unravel::contact_event> events;
+    std::vector<unravel::manifold_point> event_points;
+
+    // Bodies the broadphase can hold, 0 when it grows as needed.
+    int broadphase_capacity{};
+    bool broadphase_full_reported{};
+
+    // Project sleep thresholds, used by the bodies that don't set their own.
+    float sleep_linear_threshold{0.8f};
+    float sleep_angular_threshold{1.0f};
+
+    // Region streaming, bodies away from every anchor are kept out of the dynamics world.
+    bool streaming{};
+    float streaming_radius{};
+    float streaming_hysteresis{};
+    // Anchor positions, gathered once per frame. Without anchors every body is simulated.
+    std::vector<btVector3> streaming_anchors;
+    // Anchor positions the cells were last evaluated against.
+    std::vector<btVector3> streaming_evaluated_anchors;
+    // Bodies bucketed by grid cell, only the moved ones are re-tested until an anchor moves.
+    std::unordered_map<uint64_t, streaming_cell> streaming_cells;
+    // Bodies moved, synced or activated since the last streaming update.
+    std::vector<entt::entity> streaming_moved;
+    float streaming_cell_size{};
+    // Forces every cell to be evaluated by the next streaming update.
+    bool streaming_invalidated{true};
+    uint32_t streamed_out{};
+
+    unravel::physics_island_stats island_stats;
+    // Bodies and awake bodies per island tag, kept to reuse the allocations.
+    std::vector<uint32_t> island_bodies;
+    std::vector<uint32_t> island_active_bodies;
+
+    // Entities whose transform or physics properties changed since the last step.
+    std::vector<entt::entity> dirty;
+    // Physics entities whose transform became dirty, queued from whichever thread moved them.
+    std::shared_ptr<moodycamel::ConcurrentQueue<entt::entity>> dirty_transforms =
+        std::make_shared<moodycamel::ConcurrentQueue<entt::entity>>();
+    // Entities whose bodies were moved by the last step.
+    std::vector<entt::entity> moved;
+    // Dirty entities being synced, swapped with 'dirty' to keep both allocations around.
+    std::vector<entt::entity> syncing;
+    // Entities moved by the last step, rendered between their last two poses when interpolating.
+    std::vector<entt::entity> interpolated;
+    // Interpolated entities not moved by the last step, kept to reuse the allocation.
+    std::vector<entt::entity> settled;
+
+    // Phase timings of the dynamics world, shared with it as this struct gets moved around.
+    std::shared_ptr<step_profiler> profiler;
+
+    // Set while recording the inputs of the simulation for a replay.
+    unravel::physics_recording* recording{};
+    const entt::registry* recording_registry{};
+
+    bool in_simulate{};
+    float elapsed{};
+    uint32_t step{};
+
+    void mark_dirty(entt::entity e)
+    {
+        dirty.emplace_back(e);
+    }
+
+    void record(const btRigidBody& body, unravel::physics_replay_event event)
+    {
+        if(!recording)
+        {
+            return;
+        }
+
+        auto id = recording_registry->try_get<unravel::id_component>(get_entity_id_from_user_index(body.getUserIndex()));
+        if(!id)
+        {
+            return;
+        }
+
+        event.step = step;
+        event.id = id->id;
+        recording->events.emplace_back(event);
+    }
+
+    // Records the exact pose the body was set to, converting back from bullet could differ in the last bits.
+    void record_teleport(const btRigidBody& body, const math::vec3& position, const math::quat& rotation)
+    {
+        if(!recording)
+        {
+            return;
+        }
+
+        unravel::physics_replay_event event;
+        event.type = unravel::physics_replay_event_type::teleport;
+        event.position = position;
+        event.rotation = rotation;
+        event.vector = from_bullet(body.getLinearVelocity());
+        event.angular_velocity = from_bullet(body.getAngularVelocity());
+        record(body, event);
+    }
+
+    // Records velocities set from outside the simulation, both are captured whichever was set.
+    void record_velocity(const btRigidBody& body)
+    {
+        if(!recording)
+        {
+            return;
+        }
+
+        unravel::physics_replay_event event;
+        event.type = unravel::physics_replay_event_type::velocity;
+        event.vector = from_bullet(body.getLinearVelocity());
+        event.angular_velocity = from_bullet(body.getAngularVelocity());
+        record(body, event);
+    }
+
+    void record_force(const btRigidBody& body,
+                      unravel::physics_replay_event_type type,
+                      const btVector3& vector,
+                      unravel::force_mode mode)
+    {
+        if(!recording)
+        {
+            return;
+        }
+
+        unravel::physics_replay_event event;
+        event.type = type;
+        event.vector = from_bullet(vector);
+        event.mode = mode;
+        record(body, event);
+    }
+
+    // Hash of the pose and velocities of every body in the simulation. Bodies are summed up so the
+    // result does not depend on the order they were added in.
+    auto state_hash(const entt::registry& registry) const -> uint64_t
+    {
+        uint64_t result{};
+
+        const auto& objects = dynamics_world->getCollisionObjectArray();
+        for(int i = 0; i < objects.size(); ++i)
+        {
+            const btRigidBody* body = btRigidBody::upcast(objects[i]);
+            if(!body)
+            {
+                continue;
+            }
+
+            uint64_t hash = 14695981039346656037ull;
+            auto add = [&](const void* data, size_t size)
+            {
+                auto bytes = reinterpret_cast<const uint8_t*>(data);
+                for(size_t b = 0; b < size; ++b)
+                {
+                    hash = (hash ^ bytes[b]) * 1099511628211ull;
+                }
+            };
+            auto add_vector = [&](const btVector3& v)
+            {
+                btScalar values[] = {v.x(), v.y(), v.z()};
+                add(values, sizeof(values));
+            };
+
+            auto entity = get_entity_id_from_user_index(body->getUserIndex());
+            if(auto id = registry.try_get<unravel::id_component>(entity))
+            {
+                auto bytes = id->id.as_bytes();
+                add(bytes.data(), bytes.size());
+            }
+
+            const auto& trans = body->getWorldTransform();
+            add_vector(trans.getOrigin());
+            add_vector(trans.getBasis().getRow(0));
+            add_vector(trans.getBasis().getRow(1));
+            add_vector(trans.getBasis().getRow(2));
+            add_vector(body->getLinearVelocity());
+            add_vector(body->getAngularVelocity());
+
+            result += hash;
+        }
+
+        return result;
+    }
+
+    void add_rigidbody(const rigidbody& body)
+    {
+        if(body.internal->isInWorld())
+        {
+            return;
+        }
+
+        btAssert(in_simulate == false);
+
+        if(broadphase_capacity > 0 && dynamics_world->getNumCollisionObjects() >= broadphase_capacity)
+        {
+            if(!broadphase_full_reported)
+            {
+                APPLOG_ERROR("Physics: The broadphase is full with {} bodies, further bodies are not simulated. "
+                             "Raise Max Bodies or use the Dynamic AABB Tree broadphase.",
+                             broadphase_capacity);
+                broadphase_full_reported = true;
+            }
+            return;
+        }
+
+        dynamics_world->addRigidBody(body.internal.get(), body.collision_filter_group, body.collision_filter_mask);
+
+        unravel::physics_replay_event event;
+        event.type = unravel::physics_replay_event_type::spawn;
+        record(*body.internal, event);
+    }
+
+    void remove_rigidbody(const rigidbody& body)
+    {
+        if(!body.internal->isInWorld())
+        {
+            return;
+        }
+        btAssert(in_simulate == false);
+        dynamics_world->removeRigidBody(body.internal.get());
+
+        unravel::physics_replay_event event;
+        event.type = unravel::physics_replay_event_type::despawn;
+        record(*body.internal, event);
+    }
+
+    void push_event(unravel::contact_event_type type, const contact_record& rec)
+    {
+        unravel::contact_event event;
+        event.type = type;
+        event.a = rec.a.entity();
+        event.b = rec.b.entity();
+
+        // Sensor events carry no points.
+        if(type == unravel::contact_event_type::collision_enter || type == unravel::contact_event_type::collision_exit)
+        {
+            event.first_point = static_cast<uint32_t>(event_points.size());
+            event.point_count = static_cast<uint32_t>(rec.points.size());
+            for(const auto& point : rec.points)
+            {
+                event.impulse += point.impulse;
+                event_points.emplace_back(point);
+            }
+        }
+
+        events.emplace_back(event);
+    }
+
+    // The first filter matching the layers of the pair, in either order.
+    static auto find_contact_filter(const unravel::settings::physics_settings* settings,
+                                    const btCollisionObject* obj_a,
+                                    const btCollisionObject* obj_b)
+        -> const unravel::settings::physics_settings::contact_filter*
+    {
+        if(!settings || settings->contact_filters.empty())
+        {
+            return nullptr;
+        }
+
+        auto* proxy_a = obj_a->getBroadphaseHandle();
+        auto* proxy_b = obj_b->getBroadphaseHandle();
+        if(!proxy_a || !proxy_b)
+        {
+            return nullptr;
+        }
+
+        int group_a = proxy_a->m_collisionFilterGroup;
+        int group_b = proxy_b->m_collisionFilterGroup;
+        for(const auto& filter : settings->contact_filters)
+        {
+            bool matches_ab = (group_a & filter.layers_a.mask) != 0 && (group_b & filter.layers_b.mask) != 0;
+            bool matches_ba = (group_b & filter.layers_a.mask) != 0 && (group_a & filter.layers_b.mask) != 0;
+            if(matches_ab || matches_ba)
+            {
+                return &filter;
+            }
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * @brief Finds the pairs that started or stopped touching in the last step and queues their events.
+     *
+     * Events are queued until flush_events so that the steps of a frame are delivered together.
+     * @param settings Optional per layer pair filters of the reported events.
+     */
+    void process_manifolds(const unravel::settings::physics_settings* settings)
+    {
+        auto& ctx = unravel::engine::context();
+        auto& ec = ctx.get_cached<unravel::ecs>();
+
+        auto* dispatcher = dynamics_world->getDispatcher();
+        int nm = dispatcher->getNumManifolds();
+
+        // Phase 0: clear active flags
+        for(auto& kv : contacts_cache)
+            kv.second.active_this_frame = false;
+
+        auto begin_sensor = [&](entt::handle a, entt::handle b)
+        {
+            contact_key key{a, b};
+            auto it = contacts_cache.find(key);
+            if(it != contacts_cache.end())
+            {
+                it->second.active_this_frame = true;
+                return;
+            }
+
+            auto& rec = contacts_cache.emplace(key, contact_record{}).first->second;
+            rec.type = unravel::contact_event_type::sensor_enter;
+            rec.a = a;
+            rec.b = b;
+            rec.active_this_frame = true;
+            push_event(unravel::contact_event_type::sensor_enter, rec);
+        };
+
+        // Phase 1: scan all current manifolds
+        for(int i = 0; i < nm; ++i)
+        {
+            auto* m = dispatcher->getManifoldByIndexInternal(i);
+            if(m->getNumContacts() == 0)
+                continue;
+
+            // Identify entities and sensor flags
+            auto* objA = m->getBody0();
+            auto* objB = m->getBody1();
+            bool isSensorA = objA->getCollisionFlags() & btCollisionObject::CF_NO_CONTACT_RESPONSE;
+            bool isSensorB = objB->getCollisionFlags() & btCollisionObject::CF_NO_CONTACT_RESPONSE;
+            auto eA = get_entity_from_user_index(ec, objA->getUserIndex());
+            auto eB = get_entity_from_user_index(ec, objB->getUserIndex());
+
+            // Handle trigger overlaps: A->B and B->A
+            if(isSensorA || isSensorB)
+            {
+                auto it = contacts_cache.find(contact_key{eA, eB});
+                if(it != contacts_cache.end())
+                {
+                    it->second.active_this_frame = true;
+                    if(auto rit = contacts_cache.find(contact_key{eB, eA}); rit != contacts_cache.end())
+                    {
+                        rit->second.active_this_frame = true;
+                    }
+                    continue;
+                }
+
+                auto filter = find_contact_filter(settings, objA, objB);
+                if(filter && !filter->report_events)
+                {
+                    continue;
+                }
+
+                begin_sensor(eA, eB);
+                begin_sensor(eB, eA);
+                continue;
+            }
+
+            // Handle collisions: only new ones cause ENTER
+            contact_key key{eA, eB};
+            auto it = contacts_cache.find(key);
+            if(it != contacts_cache.end())
+            {
+                // existing: refresh
+                it->second.active_this_frame = true;
+                continue;
+            }
+
+            // new collision
+            auto filter = find_contact_filter(settings, objA, objB);
+            if(filter && !filter->report_events)
+            {
+                continue;
+            }
+
+            float impulse = 0.0f;
+            for(int j = 0; j < m->getNumContacts(); ++j)
+            {
+                impulse += m->getContactPoint(j).getAppliedImpulse();
+            }
+
+            // Too soft to report yet, checked again on the next step while the pair keeps touching.
+            if(filter && impulse < filter->min_impulse)
+            {
+                continue;
+            }
+
+            auto& rec = contacts_cache.emplace(key, contact_record{}).first->second;
+            rec.type = unravel::contact_event_type::collision_enter;
+            rec.a = eA;
+            rec.b = eB;
+            rec.active_this_frame = true;
+            for(int j = 0; j < m->getNumContacts(); ++j)
+            {
+                auto const& p = m->getContactPoint(j);
+                unravel::manifold_point mp;
+                mp.a = from_bullet(p.getPositionWorldOnA());
+                mp.b = from_bullet(p.getPositionWorldOnB());
+                mp.normal_on_b = from_bullet(p.m_normalWorldOnB);
+                mp.normal_on_a = -mp.normal_on_b;
+                mp.impulse = p.getAppliedImpulse();
+                mp.distance = p.getDistance();
+                rec.points.push_back(mp);
+            }
+            push_event(unravel::contact_event_type::collision_enter, rec);
+        }
+
+        // Phase 2: EXIT for stale entries
+        for(auto it = contacts_cache.begin(); it != contacts_cache.end();)
+        {
+            if(!it->second.active_this_frame)
+            {
+                const auto& rec = it->second;
+                push_event(rec.type == unravel::contact_event_type::sensor_enter
+                               ? unravel::contact_event_type::sensor_exit
+                               : unravel::contact_event_type::collision_exit,
+                           rec);
+                it = contacts_cache.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    /**
+     * @brief Delivers the queued contact events to the scripts in one batch and clears the queue.
+     */
+    void flush_events(unravel::script_system& scripting)
+    {
+        if(events.empty())
+        {
+            return;
+        }
+
+        scripting.on_contact_events(events, event_points);
+
+        events.clear();
+        event_points.clear();
+    }
+
+    void update_island_stats()
+    {
+        island_stats = {};
+        island_bodies.clear();
+        island_active_bodies.clear();
+
+        const auto& objects = dynamics_world->getCollisionObjectArray();
+        for(int i = 0; i < objects.size(); ++i)
+        {
+            const auto* obj = objects[i];
+            if(obj->isStaticOrKinematicObject())
+            {
+                continue;
+            }
+
+            bool active = obj->isActive();
+            island_stats.bodies++;
+            island_stats.active_bodies += active;
+
+            int tag = obj->getIslandTag();
+            if(tag < 0)
+            {
+                continue;
+            }
+
+            if(size_t(tag) >= island_bodies.size())
+            {
+                island_bodies.resize(tag + 1);
+                island_active_bodies.resize(tag + 1);
+            }
+            island_bodies[tag]++;
+            island_active_bodies[tag] += active;
+        }
+
+        for(size_t i = 0; i < island_bodies.size(); ++i)
+        {
+            if(island_bodies[i] == 0)
+            {
+                continue;
+            }
+
+            island_stats.islands++;
+            island_stats.active_islands += island_active_bodies[i] > 0;
+            island_stats.largest_island = std::max(island_stats.largest_island, island_bodies[i]);
+        }
+
+        island_stats.streamed_out = streamed_out;
+    }
+
+    void simulate(btScalar dt, btScalar fixed_time_step = 1.0 / 60.0, int max_subs_steps = 10)
+    {
+        in_simulate = true;
+
+        dynamics_world->stepSimulation(dt, max_subs_steps, fixed_time_step);
+
+        in_simulate = false;
+    }
+
+    auto ray_cast_closest(const math::vec3& origin,
+                          const math::vec3& direction,
+                          float max_distance,
+                          int layer_mask,
+                          bool query_sensors) -> hpp::optional<unravel::raycast_hit>
+    {
+        if(!dynamics_world)
+        {
+            return {};
+        }
+
+        auto ray_origin = to_bullet(origin);
+        auto ray_end = to_bullet(origin + direction * max_distance);
+
+        filter_closest_ray_callback ray_callback(ray_origin, ray_end, layer_mask, query_sensors);
+
+        ray_callback.m_flags |= btTriangleRaycastCallback::kF_UseGjkConvexCastRaytest;
+        dynamics_world->rayTest(ray_origin, ray_end, ray_callback);
+        if(ray_callback.hasHit())
+        {
+            const btRigidBody* body = btRigidBody::upcast(ray_callback.m_collisionObject);
+            if(body)
+            {
+                unravel::raycast_hit hit;
+                hit.entity = get_entity_id_from_user_index(body->getUserIndex());
+                hit.point = from_bullet(ray_callback.m_hitPointWorld);
+                hit.normal = from_bullet(ray_callback.m_hitNormalWorld);
+                hit.distance = math::distance(origin, hit.point);
+
+                return hit;
+            }
+        }
+        return {};
+    }
+
+    auto ray_cast_all(const math::vec3& origin,
+                      const math::vec3& direction,
+                      float max_distance,
+                      int layer_mask,
+                      bool query_sensors) -> unravel::physics_vector<unravel::raycast_hit>
+    {
+        if(!dynamics_world)
+        {
+            return {};
+        }
+
+        auto ray_origin = to_bullet(origin);
+        auto ray_end = to_bullet(origin + direction * max_distance);
+
+        filter_all_hits_ray_callback ray_callback(ray_origin, ray_end, layer_mask, query_sensors);
+
+        ray_callback.m_flags |= btTriangleRaycastCallback::kF_UseGjkConvexCastRaytest;
+        dynamics_world->rayTest(ray_origin, ray_end, ray_callback);
+
+        if(!ray_callback.hasHit())
+        {
+            return {};
+        }
+
+        unravel::physics_vector<unravel::raycast_hit> hits;
+
+        // Collect all hits
+        hits.reserve(ray_callback.m_hitPointWorld.size());
+        for(int i = 0; i < ray_callback.m_hitPointWorld.size(); ++i)
+        {
+            const btCollisionObject* collision_object = ray_callback.m_collisionObjects[i];
+            const btRigidBody* body = btRigidBody::upcast(collision_object);
 
             if(body)
             {
@@ -1112,6 +2119,11 @@ struct world
     auto sphere_overlap(const math::vec3& origin, float radius, int layer_mask, bool query_sensors)
         -> unravel::physics_vector<entt::entity>
     {
+        if(!dynamics_world)
+        {
+            return {};
+        }
+
         btSphereShape sphere(radius);
         btCollisionObject tempObj;
         tempObj.setCollisionShape(&sphere);
@@ -1141,6 +2153,71 @@ struct world
 
         return hits;
     }
+
+    void cast_batch(hpp::span<const unravel::physics_cast_query> queries, hpp::span<unravel::raycast_hit> results)
+    {
+        for_each_query(queries,
+                       [&](const unravel::physics_cast_query& query, size_t index)
+                       {
+                           auto hit = query.radius > 0.0f ? sphere_cast_closest(query.origin,
+                                                                                query.direction,
+                                                                                query.radius,
+                                                                                query.max_distance,
+                                                                                query.layer_mask,
+                                                                                query.query_sensors)
+                                                          : ray_cast_closest(query.origin,
+                                                                             query.direction,
+                                                                             query.max_distance,
+                                                                             query.layer_mask,
+                                                                             query.query_sensors);
+                           if(hit)
+                           {
+                               results[index] = *hit;
+                           }
+                           else
+                           {
+                               results[index] = {};
+                               results[index].entity = entt::null;
+                           }
+                       });
+    }
+
+    void sphere_overlap_batch(hpp::span<const unravel::physics_overlap_query> queries,
+                              hpp::span<entt::entity> results,
+                              hpp::span<uint32_t> counts)
+    {
+        const size_t capacity = queries.empty() ? 0 : results.size() / queries.size();
+
+        for_each_query(queries,
+                       [&](const unravel::physics_overlap_query& query, size_t index)
+                       {
+                           auto hits = sphere_overlap(query.origin, query.radius, query.layer_mask, query.query_sensors);
+
+                           auto count = std::min(hits.size(), capacity);
+                           std::copy_n(hits.begin(), count, results.begin() + index * capacity);
+                           counts[index] = uint32_t(count);
+                       });
+    }
+
+    /// Queries only read the broadphase, so they can run side by side when bullet is built thread safe.
+    template<typename Query, typename F>
+    void for_each_query(hpp::span<const Query> queries, F&& f)
+    {
+#ifdef BULLET_MT
+        std::for_each(std::execution::par,
+                      queries.begin(),
+                      queries.end(),
+                      [&](const Query& query)
+                      {
+                          f(query, size_t(&query - queries.data()));
+                      });
+#else
+        for(size_t i = 0; i < queries.size(); ++i)
+        {
+            f(queries[i], i);
+        }
+#endif
+    }
 };
 
 auto get_world_from_user_pointer(void* pointer) -> world&
@@ -1149,40 +2226,50 @@ auto get_world_from_user_pointer(void* pointer) -> world&
     return *world;
 }
 
-auto create_dynamics_world() -> bullet::world
+auto create_dynamics_world(const unravel::settings::physics_settings& settings) -> bullet::world
 {
     bullet::world world{};
     /// collision configuration contains default setup for memory, collision setup
     auto collision_config = std::make_shared<btDefaultCollisionConfiguration>();
     // collision_config->setConvexConvexMultipointIterations();
 
-    auto broadphase = std::make_shared<btDbvtBroadphase>();
+    auto broadphase = create_broadphase(settings);
+    auto pair_filter = std::make_shared<static_pair_filter>();
+    broadphase->getOverlappingPairCache()->setOverlapFilterCallback(pair_filter.get());
+    auto profiler = std::make_shared<step_profiler>();
 
 #ifdef BULLET_MT
     auto dispatcher = std::make_shared<btCollisionDispatcherMt>(collision_config.get());
     auto solver_pool = std::make_shared<btConstraintSolverPoolMt>(std::thread::hardware_concurrency() - 1);
     auto solver = std::make_shared<btSequentialImpulseConstraintSolverMt>();
-    world.dynamics_world = std::make_shared<btDiscreteDynamicsWorldMt>(dispatcher.get(),
-                                                                       broadphase.get(),
-                                                                       solver_pool.get(),
-                                                                       solver.get(),
-                                                                       collision_config.get());
+    world.dynamics_world = std::make_shared<profiled_dynamics_world<btDiscreteDynamicsWorldMt>>(profiler,
+                                                                                                dispatcher.get(),
+                                                                                                broadphase.get(),
+                                                                                                solver_pool.get(),
+                                                                                                solver.get(),
+                                                                                                collision_config.get());
     world.solver_pool = solver_pool;
 #else
 
     auto dispatcher = std::make_shared<btCollisionDispatcher>(collision_config.get());
     auto solver = std::make_shared<btSequentialImpulseConstraintSolver>();
-    world.dynamics_world = std::make_shared<btDiscreteDynamicsWorld>(dispatcher.get(),
-                                                                     broadphase.get(),
-                                                                     solver.get(),
-                                                                     collision_config.get());
+    world.dynamics_world = std::make_shared<profiled_dynamics_world<btDiscreteDynamicsWorld>>(profiler,
+                                                                                              dispatcher.get(),
+                                                                                              broadphase.get(),
+                                                                                              solver.get(),
+                                                                                              collision_config.get());
 #endif
+    world.profiler = profiler;
     world.collision_config = collision_config;
     world.dispatcher = dispatcher;
     world.broadphase = broadphase;
+    world.pair_filter = pair_filter;
     world.solver = solver;
     world.dynamics_world->setGravity(gravity_earth);
     world.dynamics_world->setForceUpdateAllAabbs(false);
+
+    using broadphase_type = unravel::settings::physics_settings::broadphase_type;
+    world.broadphase_capacity = settings.broadphase == broadphase_type::dbvt ? 0 : std::max(settings.max_bodies, 1);
     return world;
 }
 
@@ -1211,6 +2298,34 @@ namespace
 {
 const uint8_t system_id = 1;
 
+auto get_physics_settings(rtti::context& ctx) -> settings::physics_settings
+{
+    return ctx.has<settings>() ? ctx.get<settings>().physics : settings::physics_settings{};
+}
+
+// Sweep and prune and the uniform grid hold a fixed number of bodies, scenes with more use the dbvt instead.
+auto fit_broadphase(settings::physics_settings world_settings, const entt::registry& registry)
+    -> settings::physics_settings
+{
+    using broadphase_type = settings::physics_settings::broadphase_type;
+    if(world_settings.broadphase == broadphase_type::dbvt)
+    {
+        return world_settings;
+    }
+
+    auto bodies = registry.view<physics_component>().size();
+    if(bodies > size_t(std::max(world_settings.max_bodies, 1)))
+    {
+        APPLOG_ERROR("Physics: The scene has {} bodies, more than the {} Max Bodies of the broadphase. "
+                     "Using the Dynamic AABB Tree broadphase instead.",
+                     bodies,
+                     world_settings.max_bodies);
+        world_settings.broadphase = broadphase_type::dbvt;
+    }
+
+    return world_settings;
+}
+
 void wake_up(bullet::rigidbody& body)
 {
     if(body.internal)
@@ -1219,12 +2334,44 @@ void wake_up(bullet::rigidbody& body)
     }
 }
 
-auto make_rigidbody_shape(physics_component& comp) -> std::shared_ptr<btCompoundShape>
+auto make_mesh_shape(bullet::shape_cache& cache, const physics_mesh_shape& shape, bool kinematic)
+    -> btCollisionShape*
+{
+    if(!shape.mesh)
+    {
+        return nullptr;
+    }
+
+    auto mesh = shape.mesh.get();
+    const auto& collision = mesh->get_collision_data();
+    if(collision.empty())
+    {
+        APPLOG_WARNING("Physics: Mesh {} has no baked collision, enable it in the mesh import settings.",
+                       shape.mesh.id());
+        return nullptr;
+    }
+
+    // Triangle meshes are static geometry, dynamic bodies collide with the hull.
+    if(kinematic && !shape.convex && !collision.indices.empty())
+    {
+        return new bullet::btScaledBvhTriangleMeshShapeOwning(cache.get_triangle_mesh(mesh));
+    }
+
+    if(collision.hull.empty())
+    {
+        return nullptr;
+    }
+
+    return new btConvexHullShape(&collision.hull[0].x, int(collision.hull.size()), int(sizeof(math::vec3)));
+}
+
+auto make_rigidbody_shape(bullet::shape_cache& cache, const bullet::shape_cache::key& key)
+    -> std::shared_ptr<btCompoundShape>
 {
-    // use an ownning compound shape. When sharing is implemented we can go back to non owning
+    // use an ownning compound shape. It is shared through the shape cache so its children are never shared.
     auto cp = std::make_shared<bullet::btCompoundShapeOwning>();
 
-    auto compound_shapes = comp.get_shapes();
+    const auto& compound_shapes = key.shapes;
     if(compound_shapes.empty())
     {
         return cp;
@@ -1274,29 +2421,104 @@ auto make_rigidbody_shape(physics_component& comp) -> std::shared_ptr<btCompound
             local_transform.setOrigin(bullet::to_bullet(shape.center));
             cp->addChildShape(local_transform, cylinder_shape);
         }
+        else if(hpp::holds_alternative<physics_mesh_shape>(s.shape))
+        {
+            const auto& shape = hpp::get<physics_mesh_shape>(s.shape);
+
+            btCollisionShape* mesh_shape = make_mesh_shape(cache, shape, key.kinematic);
+            if(!mesh_shape)
+            {
+                continue;
+            }
+
+            btTransform local_transform = btTransform::getIdentity();
+            local_transform.setOrigin(bullet::to_bullet(shape.center));
+            cp->addChildShape(local_transform, mesh_shape);
+        }
     }
 
     return cp;
 }
 
-void update_rigidbody_shape(bullet::rigidbody& body, physics_component& comp)
+auto get_rigidbody_shape_scale(physics_component& comp) -> math::vec3
+{
+    if(comp.is_autoscaled())
+    {
+        if(auto transform = comp.get_owner().try_get<transform_component>())
+        {
+            return transform->get_scale_global();
+        }
+    }
+
+    return math::vec3(1.0f);
+}
+
+auto get_rigidbody_shape(bullet::world& world, physics_component& comp, const math::vec3& scale)
+    -> std::shared_ptr<btCompoundShape>
+{
+    const auto& shapes = comp.get_shapes();
+    bool has_mesh = std::any_of(shapes.begin(),
+                                shapes.end(),
+                                [](const auto& s)
+                                {
+                                    return hpp::holds_alternative<physics_mesh_shape>(s.shape);
+                                });
+
+    // The body kind only changes the shape of meshes, keep sharing the others between kinds.
+    bullet::shape_cache::key key{shapes, scale, has_mesh && comp.is_kinematic()};
+    if(auto shape = world.shapes.find(key))
+    {
+        return shape;
+    }
+
+    auto shape = make_rigidbody_shape(world.shapes, key);
+    shape->setLocalScaling(bullet::to_bullet(scale));
+
+    world.shapes.insert(std::move(key), shape);
+    return shape;
+}
+
+void set_rigidbody_shape(bullet::world& world, bullet::rigidbody& body, const std::shared_ptr<btCompoundShape>& shape)
 {
-    auto shape = make_rigidbody_shape(comp);
+    if(body.internal_shape == shape)
+    {
+        return;
+    }
+
+    // Collision algorithms cached for the body's pairs were made for the previous shape.
+    if(auto proxy = body.internal->getBroadphaseHandle())
+    {
+        world.dynamics_world->getBroadphase()->getOverlappingPairCache()->cleanProxyFromPairs(
+            proxy,
+            world.dynamics_world->getDispatcher());
+    }
 
     body.internal->setCollisionShape(shape.get());
     body.internal_shape = shape;
 }
 
-void update_rigidbody_shape_scale(bullet::world& world, bullet::rigidbody& body, const math::vec3& s)
+void update_rigidbody_shape(bullet::world& world, bullet::rigidbody& body, physics_component& comp)
+{
+    auto shape = get_rigidbody_shape(world, comp, get_rigidbody_shape_scale(comp));
+    set_rigidbody_shape(world, body, shape);
+}
+
+void update_rigidbody_shape_scale(bullet::world& world,
+                                  bullet::rigidbody& body,
+                                  physics_component& comp,
+                                  const math::vec3& s)
 {
     auto bt_scale = body.internal_shape->getLocalScaling();
     auto scale = bullet::from_bullet(bt_scale);
 
     if(math::any(math::epsilonNotEqual(scale, s, math::epsilon<float>())))
     {
-        bt_scale = bullet::to_bullet(s);
-        body.internal_shape->setLocalScaling(bt_scale);
-        world.dynamics_world->updateSingleAabb(body.internal.get());
+        // Shapes are shared, so switch to the one with the new scale instead of rescaling ours.
+        set_rigidbody_shape(world, body, get_rigidbody_shape(world, comp, s));
+        if(body.internal->isInWorld())
+        {
+            world.dynamics_world->updateSingleAabb(body.internal.get());
+        }
     }
 }
 
@@ -1380,112 +2602,400 @@ void update_rigidbody_collision_layer(bullet::world& world, bullet::rigidbody& b
     btBroadphaseProxy* proxy = body.internal->getBroadphaseHandle();
     if(!proxy)
     {
-        return; // or handle error
-    }
+        return; // or handle error
+    }
+
+    if(body.collision_filter_group != proxy->m_collisionFilterGroup ||
+       body.collision_filter_mask != proxy->m_collisionFilterMask)
+    {
+        // 2) Clean up any old pair cache usage
+        world.dynamics_world->getBroadphase()->getOverlappingPairCache()->cleanProxyFromPairs(
+            proxy,
+            world.dynamics_world->getDispatcher());
+
+        // 3) Update filter group / mask
+        proxy->m_collisionFilterGroup = body.collision_filter_group;
+        proxy->m_collisionFilterMask = body.collision_filter_mask;
+
+        // 4) Re-insert it into the broadphase
+        world.dynamics_world->refreshBroadphaseProxy(body.internal.get());
+        wake_up(body);
+    }
+}
+
+void update_rigidbody_mass_and_inertia(bullet::rigidbody& body, physics_component& comp)
+{
+    btScalar mass(0);
+    btVector3 local_inertia(0, 0, 0);
+    if(!comp.is_kinematic())
+    {
+        auto shape = body.internal->getCollisionShape();
+        if(shape)
+        {
+            mass = comp.get_mass();
+            shape->calculateLocalInertia(mass, local_inertia);
+        }
+    }
+    body.internal->setMassProps(mass, local_inertia);
+}
+
+void update_rigidbody_gravity(bullet::world& world, bullet::rigidbody& body, physics_component& comp)
+{
+    if(comp.is_using_gravity())
+    {
+        body.internal->setGravity(world.dynamics_world->getGravity());
+    }
+    else
+    {
+        body.internal->setGravity(btVector3{0, 0, 0});
+        body.internal->setLinearVelocity(btVector3(0, 0, 0));
+    }
+}
+
+void update_rigidbody_material(bullet::rigidbody& body, physics_component& comp)
+{
+    auto mat = comp.get_material().get();
+
+    int packed = bullet::encode_combine_modes(mat->friction_combine, mat->restitution_combine);
+    if(body.internal->getUserIndex2() != packed)
+    {
+        body.internal->setUserIndex2(packed);
+    }
+
+    if(math::epsilonNotEqual(body.internal->getRestitution(), mat->restitution, math::epsilon<float>()))
+    {
+        body.internal->setRestitution(mat->restitution);
+    }
+    if(math::epsilonNotEqual(body.internal->getFriction(), mat->friction, math::epsilon<float>()))
+    {
+        body.internal->setFriction(mat->friction);
+    }
+
+    auto stiffness = mat->get_stiffness();
+    if(math::epsilonNotEqual(body.internal->getContactStiffness(), stiffness, math::epsilon<float>()) ||
+       math::epsilonNotEqual(body.internal->getContactDamping(), mat->damping, math::epsilon<float>()))
+    {
+        body.internal->setContactStiffnessAndDamping(stiffness, mat->damping);
+    }
+}
+
+void update_rigidbody_sensor(bullet::rigidbody& body, physics_component& comp)
+{
+    auto flags = body.internal->getCollisionFlags();
+    if(comp.is_sensor())
+    {
+        body.internal->setCollisionFlags(flags | btCollisionObject::CF_NO_CONTACT_RESPONSE);
+    }
+    else
+    {
+        body.internal->setCollisionFlags(flags & ~btCollisionObject::CF_NO_CONTACT_RESPONSE);
+    }
+}
+
+void set_rigidbody_active(bullet::world& world, bullet::rigidbody& body, bool enabled)
+{
+    if(enabled)
+    {
+        // Streamed out bodies are added back by the streaming update once an anchor comes close.
+        if(!body.streamed_out)
+        {
+            world.add_rigidbody(body);
+        }
+
+        if(world.streaming)
+        {
+            world.streaming_moved.emplace_back(bullet::get_entity_id_from_user_index(body.internal->getUserIndex()));
+        }
+    }
+    else
+    {
+        world.remove_rigidbody(body);
+    }
+}
+
+void update_streaming_anchors(bullet::world& world,
+                              entt::registry& registry,
+                              const settings::physics_settings& settings)
+{
+    world.streaming_anchors.clear();
+
+    if(settings.streaming_camera_anchors)
+    {
+        registry.view<camera_component, transform_component, active_component>().each(
+            [&](auto e, auto&& camera, auto&& transform)
+            {
+                world.streaming_anchors.emplace_back(bullet::to_bullet(transform.get_position_global()));
+            });
+    }
+
+    if(!settings.streaming_anchor_tag.empty())
+    {
+        registry.view<tag_component, transform_component, active_component>().each(
+            [&](auto e, auto&& tag, auto&& transform)
+            {
+                if(tag.tag == settings.streaming_anchor_tag)
+                {
+                    world.streaming_anchors.emplace_back(bullet::to_bullet(transform.get_position_global()));
+                }
+            });
+    }
+}
+
+auto get_streaming_cell_key(const btVector3& position, float cell_size) -> uint64_t
+{
+    auto coord = [&](btScalar value)
+    {
+        return uint64_t(int64_t(std::floor(value / cell_size))) & 0x1fffff;
+    };
 
-    if(body.collision_filter_group != proxy->m_collisionFilterGroup ||
-       body.collision_filter_mask != proxy->m_collisionFilterMask)
+    return coord(position.x()) | (coord(position.y()) << 21) | (coord(position.z()) << 42);
+}
+
+void remove_from_streaming_cell(bullet::world& world, entt::entity e, uint64_t key)
+{
+    auto it = world.streaming_cells.find(key);
+    if(it == world.streaming_cells.end())
     {
-        // 2) Clean up any old pair cache usage
-        world.dynamics_world->getBroadphase()->getOverlappingPairCache()->cleanProxyFromPairs(
-            proxy,
-            world.dynamics_world->getDispatcher());
+        return;
+    }
 
-        // 3) Update filter group / mask
-        proxy->m_collisionFilterGroup = body.collision_filter_group;
-        proxy->m_collisionFilterMask = body.collision_filter_mask;
+    auto& bodies = it->second.bodies;
+    auto body_it = std::find(bodies.begin(), bodies.end(), e);
+    if(body_it != bodies.end())
+    {
+        *body_it = bodies.back();
+        bodies.pop_back();
+    }
 
-        // 4) Re-insert it into the broadphase
-        world.dynamics_world->refreshBroadphaseProxy(body.internal.get());
-        wake_up(body);
+    if(bodies.empty())
+    {
+        world.streaming_cells.erase(it);
     }
 }
 
-void update_rigidbody_mass_and_inertia(bullet::rigidbody& body, physics_component& comp)
+// Distance from the closest anchor to the bounds of the body, so large colliders stream in as soon as their
+// border gets close.
+auto should_stream_in(const bullet::world& world,
+                      const bullet::rigidbody& body,
+                      const btVector3& aabb_min,
+                      const btVector3& aabb_max) -> bool
 {
-    btScalar mass(0);
-    btVector3 local_inertia(0, 0, 0);
-    if(!comp.is_kinematic())
+    if(world.streaming_anchors.empty())
     {
-        auto shape = body.internal->getCollisionShape();
-        if(shape)
-        {
-            mass = comp.get_mass();
-            shape->calculateLocalInertia(mass, local_inertia);
-        }
+        return true;
     }
-    body.internal->setMassProps(mass, local_inertia);
+
+    btScalar distance2 = BT_LARGE_FLOAT;
+    for(const auto& anchor : world.streaming_anchors)
+    {
+        btVector3 closest = anchor;
+        closest.setMax(aabb_min);
+        closest.setMin(aabb_max);
+        distance2 = btMin(distance2, closest.distance2(anchor));
+    }
+
+    float radius = body.streamed_out ? world.streaming_radius : world.streaming_radius + world.streaming_hysteresis;
+    return distance2 <= radius * radius;
 }
 
-void update_rigidbody_gravity(bullet::world& world, bullet::rigidbody& body, physics_component& comp)
+void set_streamed_out(bullet::world& world, bullet::rigidbody& body, bool streamed_out)
 {
-    if(comp.is_using_gravity())
+    if(body.streamed_out == streamed_out)
     {
-        body.internal->setGravity(world.dynamics_world->getGravity());
+        return;
+    }
+
+    body.streamed_out = streamed_out;
+    if(streamed_out)
+    {
+        world.remove_rigidbody(body);
+        world.streamed_out++;
     }
     else
     {
-        body.internal->setGravity(btVector3{0, 0, 0});
-        body.internal->setLinearVelocity(btVector3(0, 0, 0));
+        world.add_rigidbody(body);
+        world.streamed_out--;
     }
 }
 
-void update_rigidbody_material(bullet::rigidbody& body, physics_component& comp)
+// Adds the bodies that came within the radius of an anchor and removes the ones farther than the radius plus
+// the hysteresis. Bodies keep their pose, velocities and sleep state while out of the world.
+// Bodies are bucketed into a grid by the center of their bounds. Only the bodies moved since the last update get
+// re-bucketed and re-tested, every cell is evaluated again once an anchor moved by more than half the hysteresis.
+// Cells entirely past the radius or entirely within it decide their bodies without testing them.
+void update_streaming(bullet::world& world, entt::registry& registry)
 {
-    auto mat = comp.get_material().get();
+    const float stream_in = world.streaming_radius;
+    const float stream_out = world.streaming_radius + world.streaming_hysteresis;
+    const bool has_anchors = !world.streaming_anchors.empty();
 
-    int packed = bullet::encode_combine_modes(mat->friction_combine, mat->restitution_combine);
-    if(body.internal->getUserIndex2() != packed)
+    // A new radius changes the cell size, every body gets bucketed again.
+    const float cell_size = std::max(stream_out * 0.25f, 1.0f);
+    if(cell_size != world.streaming_cell_size)
     {
-        body.internal->setUserIndex2(packed);
+        world.streaming_cell_size = cell_size;
+        world.streaming_cells.clear();
+        world.streaming_moved.clear();
+        world.streaming_invalidated = true;
+
+        registry.view<bullet::rigidbody>().each(
+            [&](auto e, auto&& body)
+            {
+                body.has_streaming_cell = false;
+                world.streaming_moved.emplace_back(e);
+            });
     }
 
-    if(math::epsilonNotEqual(body.internal->getRestitution(), mat->restitution, math::epsilon<float>()))
+    bool evaluate_cells = world.streaming_invalidated ||
+                          world.streaming_anchors.size() != world.streaming_evaluated_anchors.size();
+    const float tolerance = world.streaming_hysteresis * 0.5f;
+    for(size_t i = 0; i < world.streaming_anchors.size() && !evaluate_cells; ++i)
     {
-        body.internal->setRestitution(mat->restitution);
+        evaluate_cells = world.streaming_anchors[i].distance2(world.streaming_evaluated_anchors[i]) >
+                         tolerance * tolerance;
     }
-    if(math::epsilonNotEqual(body.internal->getFriction(), mat->friction, math::epsilon<float>()))
+
+    if(evaluate_cells)
     {
-        body.internal->setFriction(mat->friction);
+        world.streaming_evaluated_anchors = world.streaming_anchors;
+        world.streaming_invalidated = false;
     }
 
-    auto stiffness = mat->get_stiffness();
-    if(math::epsilonNotEqual(body.internal->getContactStiffness(), stiffness, math::epsilon<float>()) ||
-       math::epsilonNotEqual(body.internal->getContactDamping(), mat->damping, math::epsilon<float>()))
+    std::sort(world.streaming_moved.begin(), world.streaming_moved.end());
+    world.streaming_moved.erase(std::unique(world.streaming_moved.begin(), world.streaming_moved.end()),
+                                world.streaming_moved.end());
+
+    for(auto e : world.streaming_moved)
     {
-        body.internal->setContactStiffnessAndDamping(stiffness, mat->damping);
+        auto body = registry.valid(e) ? registry.try_get<bullet::rigidbody>(e) : nullptr;
+        if(!body || !body->internal || !body->internal_shape)
+        {
+            continue;
+        }
+
+        btVector3 aabb_min;
+        btVector3 aabb_max;
+        body->internal_shape->getAabb(body->internal->getWorldTransform(), aabb_min, aabb_max);
+
+        auto key = get_streaming_cell_key((aabb_min + aabb_max) * btScalar(0.5), cell_size);
+        if(!body->has_streaming_cell || body->streaming_cell != key)
+        {
+            if(body->has_streaming_cell)
+            {
+                remove_from_streaming_cell(world, e, body->streaming_cell);
+            }
+
+            world.streaming_cells[key].bodies.emplace_back(e);
+            body->streaming_cell = key;
+            body->has_streaming_cell = true;
+        }
+
+        auto& cell = world.streaming_cells[key];
+        cell.aabb_min.setMin(aabb_min);
+        cell.aabb_max.setMax(aabb_max);
+
+        // Tested with the rest of its cell otherwise.
+        if(!evaluate_cells && registry.all_of<active_component>(e))
+        {
+            set_streamed_out(world, *body, !should_stream_in(world, *body, aabb_min, aabb_max));
+        }
     }
-}
+    world.streaming_moved.clear();
 
-void update_rigidbody_sensor(bullet::rigidbody& body, physics_component& comp)
-{
-    auto flags = body.internal->getCollisionFlags();
-    if(comp.is_sensor())
+    if(!evaluate_cells)
     {
-        body.internal->setCollisionFlags(flags | btCollisionObject::CF_NO_CONTACT_RESPONSE);
+        return;
     }
-    else
+
+    uint32_t streamed_out = 0;
+    for(auto it = world.streaming_cells.begin(); it != world.streaming_cells.end();)
     {
-        body.internal->setCollisionFlags(flags & ~btCollisionObject::CF_NO_CONTACT_RESPONSE);
+        const auto key = it->first;
+        auto& cell = it->second;
+
+        const btVector3 center = (cell.aabb_min + cell.aabb_max) * btScalar(0.5);
+        const btVector3 extents = (cell.aabb_max - cell.aabb_min) * btScalar(0.5);
+
+        bool all_in = !has_anchors;
+        bool all_out = has_anchors;
+        for(const auto& anchor : world.streaming_anchors)
+        {
+            btVector3 closest = anchor;
+            closest.setMax(cell.aabb_min);
+            closest.setMin(cell.aabb_max);
+            all_out &= closest.distance2(anchor) > stream_out * stream_out;
+
+            // Every body in reach of the anchor, even from the farthest corner of the cell.
+            btVector3 farthest = (anchor - center).absolute() + extents;
+            all_in |= farthest.length2() <= stream_in * stream_in;
+        }
+
+        for(size_t i = 0; i < cell.bodies.size();)
+        {
+            auto e = cell.bodies[i];
+            auto body = registry.valid(e) ? registry.try_get<bullet::rigidbody>(e) : nullptr;
+
+            // Destroyed or recreated since it was bucketed.
+            if(!body || !body->internal || !body->has_streaming_cell || body->streaming_cell != key)
+            {
+                cell.bodies[i] = cell.bodies.back();
+                cell.bodies.pop_back();
+                continue;
+            }
+            ++i;
+
+            if(!body->internal_shape || !registry.all_of<active_component>(e))
+            {
+                continue;
+            }
+
+            bool simulate = all_in;
+            if(!all_in && !all_out)
+            {
+                btVector3 aabb_min;
+                btVector3 aabb_max;
+                body->internal_shape->getAabb(body->internal->getWorldTransform(), aabb_min, aabb_max);
+                simulate = should_stream_in(world, *body, aabb_min, aabb_max);
+            }
+
+            set_streamed_out(world, *body, !simulate);
+            streamed_out += body->streamed_out;
+        }
+
+        if(cell.bodies.empty())
+        {
+            it = world.streaming_cells.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
     }
+
+    world.streamed_out = streamed_out;
 }
 
-void set_rigidbody_active(bullet::world& world, bullet::rigidbody& body, bool enabled)
+void update_rigidbody_sleep(const bullet::world& world, bullet::rigidbody& body, const physics_component& comp)
 {
-    if(enabled)
+    float linear = comp.get_sleep_linear_threshold();
+    float angular = comp.get_sleep_angular_threshold();
+    body.internal->setSleepingThresholds(linear < 0.0f ? world.sleep_linear_threshold : linear,
+                                         angular < 0.0f ? world.sleep_angular_threshold : angular);
+
+    if(!comp.can_sleep())
     {
-        world.add_rigidbody(body);
+        body.internal->forceActivationState(DISABLE_DEACTIVATION);
     }
-    else
+    else if(body.internal->getActivationState() == DISABLE_DEACTIVATION)
     {
-        world.remove_rigidbody(body);
+        body.internal->forceActivationState(ACTIVE_TAG);
     }
 }
 
 void update_rigidbody_full(bullet::world& world, bullet::rigidbody& body, physics_component& comp)
 {
     update_rigidbody_kind(body, comp);
-    update_rigidbody_shape(body, comp);
+    update_rigidbody_shape(world, body, comp);
     update_rigidbody_mass_and_inertia(body, comp);
     update_rigidbody_material(body, comp);
     update_rigidbody_sensor(body, comp);
@@ -1494,6 +3004,7 @@ void update_rigidbody_full(bullet::world& world, bullet::rigidbody& body, physic
     update_rigidbody_angular_velocity(body, comp);
     update_rigidbody_gravity(world, body, comp);
     update_rigidbody_collision_layer(world, body, comp);
+    update_rigidbody_sleep(world, body, comp);
 }
 
 void make_rigidbody(bullet::world& world, entt::handle entity, physics_component& comp)
@@ -1504,12 +3015,18 @@ void make_rigidbody(bullet::world& world, entt::handle entity, physics_component
     body.internal->setUserIndex(int(entity.entity()));
     body.internal->setUserPointer(&world);
     body.internal->setFlags(BT_DISABLE_WORLD_GRAVITY);
+    body.motion = std::make_shared<bullet::motion_state>(body.internal.get(), &world.moved);
+    body.internal->setMotionState(body.motion.get());
 
     update_rigidbody_full(world, body, comp);
 
+    // While streaming the body waits for the next streaming update, once its transform is synced.
+    body.streamed_out = world.streaming;
+    world.streamed_out += body.streamed_out;
+
     if(entity.all_of<active_component>())
     {
-        world.add_rigidbody(body);
+        set_rigidbody_active(world, body, true);
     }
 }
 
@@ -1522,6 +3039,18 @@ void destroy_phyisics_body(bullet::world& world, entt::handle entity, bool from_
         world.remove_rigidbody(*body);
     }
 
+    if(body && body->streamed_out)
+    {
+        body->streamed_out = false;
+        world.streamed_out--;
+    }
+
+    if(body && body->has_streaming_cell)
+    {
+        body->has_streaming_cell = false;
+        remove_from_streaming_cell(world, entity.entity(), body->streaming_cell);
+    }
+
     if(from_physics_component)
     {
         entity.remove<bullet::rigidbody>();
@@ -1546,14 +3075,18 @@ void sync_physics_body(bullet::world& world, physics_component& comp, bool force
             set_rigidbody_active(world, body, false);
             update_rigidbody_full(world, body, comp);
             set_rigidbody_active(world, body, true);
+            world.record_velocity(*body.internal);
         }
         else
         {
             if(comp.is_property_dirty(physics_property::shape))
             {
                 comp.set_property_dirty(physics_property::mass, true);
-                update_rigidbody_shape(body, comp);
-                world.dynamics_world->updateSingleAabb(body.internal.get());
+                update_rigidbody_shape(world, body, comp);
+                if(body.internal->isInWorld())
+                {
+                    world.dynamics_world->updateSingleAabb(body.internal.get());
+                }
             }
             if(comp.is_property_dirty(physics_property::mass))
             {
@@ -1578,12 +3111,22 @@ void sync_physics_body(bullet::world& world, physics_component& comp, bool force
             {
                 update_rigidbody_angular_velocity(body, comp);
             }
+            if(comp.is_property_dirty(physics_property::velocity) ||
+               comp.is_property_dirty(physics_property::angular_velocity))
+            {
+                world.record_velocity(*body.internal);
+            }
 
             if(comp.is_property_dirty(physics_property::gravity))
             {
                 update_rigidbody_gravity(world, body, comp);
             }
 
+            if(comp.is_property_dirty(physics_property::sleep))
+            {
+                update_rigidbody_sleep(world, body, comp);
+            }
+
             // here we check internally for a change
             update_rigidbody_material(body, comp);
             update_rigidbody_collision_layer(world, body, comp);
@@ -1618,14 +3161,29 @@ auto sync_transforms(bullet::world& world, physics_component& comp, const transf
     auto bt_pos = bullet::to_bullet(p);
     auto bt_rot = bullet::to_bullet(q);
     btTransform bt_trans(bt_rot, bt_pos);
+
+    // Only a pose that really changed wakes the body, and with it its island.
+    const auto& current = body.internal->getWorldTransform();
+    constexpr btScalar tolerance = btScalar(1e-4);
+    bool moved = current.getOrigin().distance2(bt_pos) > tolerance * tolerance ||
+                 btFabs(current.getRotation().dot(bt_rot)) < btScalar(1) - tolerance * tolerance;
+
     body.internal->setWorldTransform(bt_trans);
+    body.motion->reset(bt_trans);
 
     if(body.internal_shape && comp.is_autoscaled())
     {
-        update_rigidbody_shape_scale(world, body, s);
+        auto shape = body.internal_shape;
+        update_rigidbody_shape_scale(world, body, comp, s);
+        moved |= shape != body.internal_shape;
     }
 
-    wake_up(body);
+    if(moved)
+    {
+        wake_up(body);
+    }
+
+    world.record_teleport(*body.internal, p, q);
 
     return true;
 }
@@ -1681,17 +3239,45 @@ auto to_physics(bullet::world& world, transform_component& transform, physics_co
     bool transform_dirty = transform.is_dirty(system_id);
     bool rigidbody_dirty = comp.is_dirty(system_id);
 
-    // if(rigidbody_dirty)
+    if(!transform_dirty && !rigidbody_dirty)
+    {
+        return false;
+    }
+
+    if(rigidbody_dirty)
     {
         sync_physics_body(world, comp);
     }
 
-    if(transform_dirty || rigidbody_dirty)
+    bool result = sync_transforms(world, comp, transform);
+
+    transform.set_dirty(system_id, false);
+
+    return result;
+}
+
+// Transforms are also moved from worker threads (animation, skinning), so the physics entities among them
+// are queued here and handed to the dirty list on the main thread before each step.
+void on_dirty_transform(entt::handle e)
+{
+    if(!e.all_of<physics_component>())
+    {
+        return;
+    }
+
+    if(auto world = e.registry()->ctx().find<bullet::world>())
     {
-        return sync_transforms(world, comp, transform);
+        world->dirty_transforms->enqueue(e.entity());
     }
+}
 
-    return false;
+void collect_dirty_transforms(bullet::world& world)
+{
+    entt::entity e{};
+    while(world.dirty_transforms->try_dequeue(e))
+    {
+        world.mark_dirty(e);
+    }
 }
 
 auto from_physics(bullet::world& world, transform_component& transform, physics_component& comp) -> bool
@@ -1706,6 +3292,43 @@ auto from_physics(bullet::world& world, transform_component& transform, physics_
     return result;
 }
 
+auto interpolate(bullet::rigidbody& body, transform_component& transform, float alpha) -> bool
+{
+    auto pose = body.motion->blend(alpha);
+    auto p = bullet::from_bullet(pose.getOrigin());
+    auto q = bullet::from_bullet(pose.getRotation());
+
+    bool result = transform.set_position_and_rotation_global(p, q, 0.009f);
+
+    // The rendered pose is not an input for the next step.
+    transform.set_dirty(system_id, false);
+
+    return result;
+}
+
+// Calls 'f' once for every entity of 'entities' that still has an active physics body, leaving
+// 'entities' without duplicates.
+template<typename F>
+void for_each_body(entt::registry& registry, std::vector<entt::entity>& entities, F&& f)
+{
+    std::sort(entities.begin(), entities.end());
+    entities.erase(std::unique(entities.begin(), entities.end()), entities.end());
+
+    for(auto e : entities)
+    {
+        if(!registry.valid(e) || !registry.all_of<active_component, bullet::rigidbody>(e))
+        {
+            continue;
+        }
+
+        auto [transform, comp] = registry.try_get<transform_component, physics_component>(e);
+        if(transform && comp)
+        {
+            f(*transform, *comp);
+        }
+    }
+}
+
 auto add_force(btRigidBody* body, const btVector3& force, force_mode mode) -> bool
 {
     if(force.fuzzyZero())
@@ -1726,57 +3349,184 @@ auto add_force(btRigidBody* body, const btVector3& force, force_mode mode) -> bo
             break;
         }
 
-        case force_mode::impulse: // Instantaneous impulse
-            body->applyCentralImpulse(force);
+        case force_mode::impulse: // Instantaneous impulse
+            body->applyCentralImpulse(force);
+            break;
+
+        case force_mode::velocity_change: // Direct velocity change
+        {
+            btVector3 new_velocity = body->getLinearVelocity() + force; // Accumulate velocity
+            body->setLinearVelocity(new_velocity);
+            break;
+        }
+    }
+    return true;
+}
+
+auto add_torque(btRigidBody* body, const btVector3& torque, force_mode mode) -> bool
+{
+    if(torque.fuzzyZero())
+    {
+        return false;
+    }
+    // Apply force based on ForceMode
+    switch(mode)
+    {
+        case force_mode::force: // Continuous torque
+            body->applyTorque(torque);
+            break;
+
+        case force_mode::acceleration: // Angular acceleration
+        {
+            btVector3 inertia_tensor = body->getInvInertiaDiagLocal();
+            btVector3 angular_acceleration(
+                inertia_tensor.getX() != 0 ? torque.getX() * (1.0f / inertia_tensor.getX()) : 0.0f,
+                inertia_tensor.getY() != 0 ? torque.getY() * (1.0f / inertia_tensor.getY()) : 0.0f,
+                inertia_tensor.getZ() != 0 ? torque.getZ() * (1.0f / inertia_tensor.getZ()) : 0.0f);
+            body->applyTorque(angular_acceleration);
+        }
+        break;
+
+        case force_mode::impulse: // Angular impulse
+            body->applyTorqueImpulse(torque);
+            break;
+
+        case force_mode::velocity_change: // Direct angular velocity change
+        {
+            btVector3 new_velocity = body->getLinearVelocity() + torque; // Accumulate velocity
+            body->setAngularVelocity(new_velocity);
+            break;
+        }
+    }
+
+    return true;
+}
+
+void apply_replay_event(bullet::world& world, entt::handle entity, const physics_replay_event& event)
+{
+    if(event.type == physics_replay_event_type::spawn)
+    {
+        if(!entity.all_of<bullet::rigidbody>())
+        {
+            make_rigidbody(world, entity, entity.get<physics_component>());
+        }
+        world.add_rigidbody(entity.get<bullet::rigidbody>());
+        return;
+    }
+
+    auto body = entity.try_get<bullet::rigidbody>();
+    if(!body || !body->internal)
+    {
+        return;
+    }
+
+    switch(event.type)
+    {
+        case physics_replay_event_type::despawn:
+        {
+            world.remove_rigidbody(*body);
+            break;
+        }
+
+        case physics_replay_event_type::teleport:
+        {
+            btTransform bt_trans(bullet::to_bullet(event.rotation), bullet::to_bullet(event.position));
+            body->internal->setWorldTransform(bt_trans);
+            body->motion->reset(bt_trans);
+            body->internal->setLinearVelocity(bullet::to_bullet(event.vector));
+            body->internal->setAngularVelocity(bullet::to_bullet(event.angular_velocity));
+            wake_up(*body);
+            break;
+        }
+
+        case physics_replay_event_type::force:
+        {
+            add_force(body->internal.get(), bullet::to_bullet(event.vector), event.mode);
+            wake_up(*body);
+            break;
+        }
+
+        case physics_replay_event_type::torque:
+        {
+            add_torque(body->internal.get(), bullet::to_bullet(event.vector), event.mode);
+            wake_up(*body);
             break;
+        }
 
-        case force_mode::velocity_change: // Direct velocity change
+        case physics_replay_event_type::velocity:
+        {
+            body->internal->setLinearVelocity(bullet::to_bullet(event.vector));
+            body->internal->setAngularVelocity(bullet::to_bullet(event.angular_velocity));
+            wake_up(*body);
+            break;
+        }
+
+        default:
         {
-            btVector3 new_velocity = body->getLinearVelocity() + force; // Accumulate velocity
-            body->setLinearVelocity(new_velocity);
             break;
         }
     }
-    return true;
 }
 
-auto add_torque(btRigidBody* body, const btVector3& torque, force_mode mode) -> bool
+// Contact manifolds, warm starting and deactivation timers live in the dynamics world and the bodies and are
+// not part of a recording. A replay starts from a new world with new bodies, so recording does the same: every
+// body is rebuilt from its component at its current pose, keeping its velocities.
+void reset_world(entt::registry& registry, bullet::world& world, const settings::physics_settings& settings)
 {
-    if(torque.fuzzyZero())
-    {
-        return false;
-    }
-    // Apply force based on ForceMode
-    switch(mode)
+    struct body_velocity
     {
-        case force_mode::force: // Continuous torque
-            body->applyTorque(torque);
-            break;
+        entt::entity entity{};
+        btVector3 linear{};
+        btVector3 angular{};
+    };
 
-        case force_mode::acceleration: // Angular acceleration
+    std::vector<body_velocity> velocities;
+    registry.view<bullet::rigidbody>().each(
+        [&](auto e, auto&& body)
         {
-            btVector3 inertia_tensor = body->getInvInertiaDiagLocal();
-            btVector3 angular_acceleration(
-                inertia_tensor.getX() != 0 ? torque.getX() * (1.0f / inertia_tensor.getX()) : 0.0f,
-                inertia_tensor.getY() != 0 ? torque.getY() * (1.0f / inertia_tensor.getY()) : 0.0f,
-                inertia_tensor.getZ() != 0 ? torque.getZ() * (1.0f / inertia_tensor.getZ()) : 0.0f);
-            body->applyTorque(angular_acceleration);
-        }
-        break;
+            if(body.internal)
+            {
+                velocities.push_back({e, body.internal->getLinearVelocity(), body.internal->getAngularVelocity()});
+                world.remove_rigidbody(body);
+            }
+        });
+    registry.clear<bullet::rigidbody>();
+
+    // The old dynamics world goes first, it still points to the old broadphase and dispatcher.
+    auto fresh = bullet::create_dynamics_world(settings);
+    world.dynamics_world = std::move(fresh.dynamics_world);
+    world.solver_pool = std::move(fresh.solver_pool);
+    world.solver = std::move(fresh.solver);
+    world.dispatcher = std::move(fresh.dispatcher);
+    world.pair_filter = std::move(fresh.pair_filter);
+    world.broadphase = std::move(fresh.broadphase);
+    world.broadphase_capacity = fresh.broadphase_capacity;
+    world.broadphase_full_reported = false;
+    world.collision_config = std::move(fresh.collision_config);
+    world.profiler = std::move(fresh.profiler);
+    world.contacts_cache.clear();
+    world.moved.clear();
+    world.interpolated.clear();
+    world.streaming_cells.clear();
+    world.streaming_moved.clear();
+    world.streaming_invalidated = true;
+    world.streamed_out = 0;
 
-        case force_mode::impulse: // Angular impulse
-            body->applyTorqueImpulse(torque);
-            break;
+    registry.view<physics_component>().each(
+        [&](auto e, auto&& comp)
+        {
+            sync_physics_body(world, comp, true);
+            world.mark_dirty(e);
+        });
 
-        case force_mode::velocity_change: // Direct angular velocity change
+    for(const auto& velocity : velocities)
+    {
+        if(auto body = registry.try_get<bullet::rigidbody>(velocity.entity); body && body->internal)
         {
-            btVector3 new_velocity = body->getLinearVelocity() + torque; // Accumulate velocity
-            body->setAngularVelocity(new_velocity);
-            break;
+            body->internal->setLinearVelocity(velocity.linear);
+            body->internal->setAngularVelocity(velocity.angular);
         }
     }
-
-    return true;
 }
 
 } // namespace
@@ -1785,10 +3535,14 @@ void bullet_backend::init()
 {
     bullet::setup_task_scheduler();
     bullet::override_combine_callbacks();
+
+    transform_component::set_dirty_listener(system_id, &on_dirty_transform);
 }
 
 void bullet_backend::deinit()
 {
+    transform_component::set_dirty_listener(system_id, nullptr);
+
     bullet::cleanup_task_scheduler();
 }
 
@@ -1801,6 +3555,7 @@ void bullet_backend::on_create_component(entt::registry& r, entt::entity e)
         entt::handle entity(r, e);
         auto& phisics = entity.get<physics_component>();
         sync_physics_body(*world, phisics, true);
+        world->mark_dirty(e);
     }
 }
 
@@ -1837,10 +3592,32 @@ void bullet_backend::on_create_active_component(entt::registry& r, entt::entity
         if(body)
         {
             set_rigidbody_active(*world, *body, true);
+
+            // Changes made while inactive were not synced.
+            world->mark_dirty(e);
         }
     }
 }
 
+void bullet_backend::on_update_component(entt::registry& r, entt::entity e)
+{
+    // physics properties changed from the main thread, transforms are collected before each step
+    auto world = r.ctx().find<bullet::world>();
+    if(world && r.all_of<physics_component>(e))
+    {
+        world->mark_dirty(e);
+    }
+}
+
+void bullet_backend::on_update_layer_component(entt::registry& r, entt::entity e)
+{
+    if(auto comp = r.try_get<physics_component>(e))
+    {
+        comp->set_dirty(system_id, true);
+        comp->set_property_dirty(physics_property::layer, true);
+    }
+}
+
 void bullet_backend::on_destroy_active_component(entt::registry& r, entt::entity e)
 {
     // this function will be called for both physics_component and bullet::rigidbody
@@ -1911,6 +3688,9 @@ void bullet_backend::apply_explosion_force(physics_component& comp,
                 comp.set_velocity(bullet::from_bullet(body->getLinearVelocity()));
 
                 wake_up(*bbody);
+
+                auto& world = bullet::get_world_from_user_pointer(body->getUserPointer());
+                world.record_force(*body, physics_replay_event_type::force, force, mode);
             }
         }
     }
@@ -1929,6 +3709,9 @@ void bullet_backend::apply_force(physics_component& comp, const math::vec3& forc
         {
             comp.set_velocity(bullet::from_bullet(body->getLinearVelocity()));
             wake_up(*bbody);
+
+            auto& world = bullet::get_world_from_user_pointer(body->getUserPointer());
+            world.record_force(*body, physics_replay_event_type::force, vector, mode);
         }
     }
 }
@@ -1946,6 +3729,9 @@ void bullet_backend::apply_torque(physics_component& comp, const math::vec3& tor
         {
             comp.set_angular_velocity(bullet::from_bullet(body->getAngularVelocity()));
             wake_up(*bbody);
+
+            auto& world = bullet::get_world_from_user_pointer(body->getUserPointer());
+            world.record_force(*body, physics_replay_event_type::torque, vector, mode);
         }
     }
 }
@@ -1968,6 +3754,68 @@ void bullet_backend::clear_kinematic_velocities(physics_component& comp)
     }
 }
 
+void bullet_backend::sleep(physics_component& comp)
+{
+    auto owner = comp.get_owner();
+    auto bbody = owner.try_get<bullet::rigidbody>();
+    if(!bbody || !bbody->internal || bbody->internal->getActivationState() == DISABLE_DEACTIVATION)
+    {
+        return;
+    }
+
+    bbody->internal->setLinearVelocity(btVector3(0, 0, 0));
+    bbody->internal->setAngularVelocity(btVector3(0, 0, 0));
+    bbody->internal->clearForces();
+    bbody->internal->setActivationState(ISLAND_SLEEPING);
+}
+
+void bullet_backend::wake(physics_component& comp)
+{
+    auto owner = comp.get_owner();
+    if(auto bbody = owner.try_get<bullet::rigidbody>())
+    {
+        wake_up(*bbody);
+    }
+}
+
+auto bullet_backend::is_sleeping(const physics_component& comp) -> bool
+{
+    auto owner = comp.get_owner();
+    auto bbody = owner.try_get<bullet::rigidbody>();
+    if(!bbody || !bbody->internal || !bbody->internal->isInWorld())
+    {
+        return false;
+    }
+
+    return !bbody->internal->isActive();
+}
+
+auto bullet_backend::get_island(const physics_component& comp) -> int
+{
+    auto owner = comp.get_owner();
+    auto bbody = owner.try_get<bullet::rigidbody>();
+    if(!bbody || !bbody->internal || !bbody->internal->isInWorld() || bbody->internal->isStaticOrKinematicObject())
+    {
+        return -1;
+    }
+
+    return bbody->internal->getIslandTag();
+}
+
+auto bullet_backend::get_island_stats() -> physics_island_stats
+{
+    auto& ctx = engine::context();
+    auto& ec = ctx.get_cached<ecs>();
+    auto& registry = *ec.get_scene().registry;
+    auto world = registry.ctx().find<bullet::world>();
+    if(!world)
+    {
+        return {};
+    }
+
+    return world->island_stats;
+}
+
 auto bullet_backend::ray_cast(const math::vec3& origin,
                               const math::vec3& direction,
                               float max_distance,
@@ -2042,22 +3890,328 @@ auto bullet_backend::sphere_overlap(const math::vec3& origin, float radius, int
     return world.sphere_overlap(origin, radius, layer_mask, query_sensors);
 }
 
+void bullet_backend::cast_batch(hpp::span<const physics_cast_query> queries, hpp::span<raycast_hit> results)
+{
+    assert(results.size() >= queries.size());
+
+    auto& ctx = engine::context();
+    auto& ec = ctx.get_cached<ecs>();
+    auto& registry = *ec.get_scene().registry;
+
+    auto& world = registry.ctx().get<bullet::world>();
+
+    world.cast_batch(queries, results);
+}
+
+void bullet_backend::sphere_overlap_batch(hpp::span<const physics_overlap_query> queries,
+                                          hpp::span<entt::entity> results,
+                                          hpp::span<uint32_t> counts)
+{
+    assert(counts.size() >= queries.size());
+
+    auto& ctx = engine::context();
+    auto& ec = ctx.get_cached<ecs>();
+    auto& registry = *ec.get_scene().registry;
+
+    auto& world = registry.ctx().get<bullet::world>();
+
+    world.sphere_overlap_batch(queries, results, counts);
+}
+
+void bullet_backend::start_recording(physics_recording& recording)
+{
+    auto& ctx = engine::context();
+    auto& ec = ctx.get_cached<ecs>();
+    auto& registry = *ec.get_scene().registry;
+
+    auto world = registry.ctx().find<bullet::world>();
+    if(!world)
+    {
+        APPLOG_WARNING("Physics can only be recorded while playing.");
+        return;
+    }
+
+    recording = {};
+    if(ctx.has<settings>())
+    {
+        recording.fixed_timestep = ctx.get<settings>().time.fixed_timestep;
+    }
+
+    reset_world(registry, *world, fit_broadphase(get_physics_settings(ctx), registry));
+
+    world->recording = &recording;
+    world->recording_registry = &registry;
+    world->step = 0;
+
+    // The rebuilt bodies are the starting point. Their pose is set back from the recorded values
+    // so the replay starts from the exact same transforms.
+    const auto& objects = world->dynamics_world->getCollisionObjectArray();
+    for(int i = 0; i < objects.size(); ++i)
+    {
+        btRigidBody* body = btRigidBody::upcast(objects[i]);
+        if(!body)
+        {
+            continue;
+        }
+
+        physics_replay_event spawn;
+        spawn.type = physics_replay_event_type::spawn;
+        world->record(*body, spawn);
+
+        auto p = bullet::from_bullet(body->getWorldTransform().getOrigin());
+        auto q = bullet::from_bullet(body->getWorldTransform().getRotation());
+        btTransform bt_trans(bullet::to_bullet(q), bullet::to_bullet(p));
+        body->setWorldTransform(bt_trans);
+        if(auto motion = static_cast<bullet::motion_state*>(body->getMotionState()))
+        {
+            motion->reset(bt_trans);
+        }
+
+        world->record_teleport(*body, p, q);
+    }
+}
+
+void bullet_backend::stop_recording()
+{
+    auto& ctx = engine::context();
+    auto& ec = ctx.get_cached<ecs>();
+    auto& registry = *ec.get_scene().registry;
+
+    if(auto world = registry.ctx().find<bullet::world>())
+    {
+        world->recording = nullptr;
+        world->recording_registry = nullptr;
+    }
+}
+
+auto bullet_backend::replay(scene& scn, const physics_recording& recording) -> physics_replay_report
+{
+    physics_replay_report report;
+
+    auto& registry = *scn.registry;
+    if(registry.ctx().contains<bullet::world>())
+    {
+        APPLOG_ERROR("Physics can only be replayed on a scene that is not playing.");
+        return report;
+    }
+
+    const auto physics_settings = fit_broadphase(get_physics_settings(engine::context()), registry);
+    auto& world = registry.ctx().emplace<bullet::world>(bullet::create_dynamics_world(physics_settings));
+
+    std::unordered_map<hpp::uuid, entt::entity> entities;
+    registry.view<id_component, physics_component>().each(
+        [&](auto e, auto&& id, auto&& comp)
+        {
+            entities.emplace(id.id, e);
+        });
+
+    const auto& events = recording.events;
+    size_t next_event = 0;
+
+    report.steps.resize(recording.hashes.size());
+    for(size_t step = 0; step < recording.hashes.size(); ++step)
+    {
+        auto& timing = report.steps[step];
+        world.profiler->timing = &timing;
+        world.profiler->measure(
+            &physics_step_timing::total,
+            [&]()
+            {
+                world.profiler->measure(&physics_step_timing::sync,
+                                        [&]()
+                                        {
+                                            for(; next_event < events.size() && events[next_event].step <= step;
+                                                ++next_event)
+                                            {
+                                                const auto& event = events[next_event];
+                                                auto it = entities.find(event.id);
+                                                if(it == entities.end())
+                                                {
+                                                    report.unresolved_events++;
+                                                    continue;
+                                                }
+
+                                                apply_replay_event(world, entt::handle(registry, it->second), event);
+                                            }
+                                        });
+
+                world.simulate(recording.fixed_timestep, recording.fixed_timestep, 1);
+
+                world.profiler->measure(&physics_step_timing::sync,
+                                        [&]()
+                                        {
+                                            for_each_body(registry,
+                                                          world.moved,
+                                                          [&](auto&& transform, auto&& rigidbody)
+                                                          {
+                                                              from_physics(world, transform, rigidbody);
+                                                          });
+                                            world.moved.clear();
+                                        });
+            });
+        world.profiler->timing = nullptr;
+
+        report.final_hash = world.state_hash(registry);
+        if(report.first_mismatch < 0 && report.final_hash != recording.hashes[step])
+        {
+            report.first_mismatch = int64_t(step);
+        }
+    }
+
+    registry.view<bullet::rigidbody>().each(
+        [&](auto e, auto&& body)
+        {
+            if(body.internal)
+            {
+                world.remove_rigidbody(body);
+            }
+        });
+    registry.clear<bullet::rigidbody>();
+    registry.ctx().erase<bullet::world>();
+
+    return report;
+}
+
+auto bullet_backend::benchmark_broadphases(const settings::physics_settings& settings, uint32_t body_count, uint32_t steps)
+    -> std::vector<physics_broadphase_benchmark>
+{
+    using broadphase_type = settings::physics_settings::broadphase_type;
+
+    std::vector<physics_broadphase_benchmark> results;
+    if(body_count == 0 || steps == 0)
+    {
+        return results;
+    }
+
+    // A flat open world: bodies on a square grid two meters apart, every fourth one a static box
+    // and the others spheres moving around between them without gravity.
+    const auto side = uint32_t(std::ceil(std::sqrt(float(body_count))));
+    const float spacing = 2.0f;
+    const float half_extent = float(side) * spacing * 0.5f;
+    const float fixed_time_step = 1.0f / 50.0f;
+
+    auto sphere = std::make_shared<btSphereShape>(btScalar(0.5));
+    auto box = std::make_shared<btBoxShape>(btVector3(0.75f, 0.75f, 0.75f));
+
+    btVector3 sphere_inertia(0, 0, 0);
+    sphere->calculateLocalInertia(btScalar(1), sphere_inertia);
+
+    // Removes every pair so the bodies can be removed without searching the pair cache for each of them.
+    struct remove_pairs_callback : btOverlapCallback
+    {
+        auto processOverlap(btBroadphasePair& pair) -> bool override
+        {
+            return true;
+        }
+    };
+
+    for(auto type : {broadphase_type::dbvt, broadphase_type::sweep_and_prune, broadphase_type::uniform_grid})
+    {
+        auto world_settings = settings;
+        world_settings.broadphase = type;
+        world_settings.max_bodies = std::max(world_settings.max_bodies, int(body_count) + 1);
+        world_settings.world_min = math::min(world_settings.world_min, math::vec3(-half_extent - 16.0f));
+        world_settings.world_max = math::max(world_settings.world_max, math::vec3(half_extent + 16.0f));
+
+        auto world = bullet::create_dynamics_world(world_settings);
+        world.dynamics_world->setGravity(btVector3(0, 0, 0));
+
+        physics_broadphase_benchmark result;
+        result.broadphase = type;
+        result.bodies = body_count;
+
+        std::mt19937 rng(1337);
+        std::uniform_real_distribution<float> velocity(-4.0f, 4.0f);
+
+        std::vector<std::unique_ptr<btRigidBody>> bodies;
+        bodies.reserve(body_count);
+
+        auto start = std::chrono::steady_clock::now();
+        for(uint32_t i = 0; i < body_count; ++i)
+        {
+            bool fixed = i % 4 == 0;
+
+            btRigidBody::btRigidBodyConstructionInfo info(fixed ? btScalar(0) : btScalar(1),
+                                                          nullptr,
+                                                          fixed ? static_cast<btCollisionShape*>(box.get())
+                                                                : static_cast<btCollisionShape*>(sphere.get()),
+                                                          fixed ? btVector3(0, 0, 0) : sphere_inertia);
+            info.m_startWorldTransform.setOrigin(btVector3(float(i % side) * spacing - half_extent,
+                                                           0.0f,
+                                                           float(i / side) * spacing - half_extent));
+
+            auto body = std::make_unique<btRigidBody>(info);
+            if(!fixed)
+            {
+                body->setLinearVelocity(btVector3(velocity(rng), 0.0f, velocity(rng)));
+                body->setActivationState(DISABLE_DEACTIVATION);
+            }
+
+            world.dynamics_world->addRigidBody(body.get());
+            bodies.emplace_back(std::move(body));
+        }
+        result.create =
+            std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        physics_step_timing timing;
+        world.profiler->timing = &timing;
+        for(uint32_t step = 0; step < steps; ++step)
+        {
+            world.profiler->measure(&physics_step_timing::total,
+                                    [&]()
+                                    {
+                                        world.dynamics_world->stepSimulation(fixed_time_step, 1, fixed_time_step);
+                                    });
+        }
+        world.profiler->timing = nullptr;
+
+        result.pairs = uint32_t(world.dynamics_world->getPairCache()->getNumOverlappingPairs());
+        result.pair_update = timing.broadphase / float(steps);
+        result.step = timing.total / float(steps);
+        results.emplace_back(result);
+
+        APPLOG_INFO("Physics Broadphase Benchmark: type {}, {} bodies, {} pairs, create {:.2f}ms, pair update "
+                    "{:.3f}ms, step {:.3f}ms",
+                    int(type),
+                    result.bodies,
+                    result.pairs,
+                    result.create,
+                    result.pair_update,
+                    result.step);
+
+        remove_pairs_callback remove_pairs;
+        world.dynamics_world->getPairCache()->processAllOverlappingPairs(&remove_pairs,
+                                                                         world.dynamics_world->getDispatcher());
+        for(auto it = bodies.rbegin(); it != bodies.rend(); ++it)
+        {
+            world.dynamics_world->removeRigidBody(it->get());
+        }
+    }
+
+    return results;
+}
+
 void bullet_backend::on_play_begin(rtti::context& ctx)
 {
     auto& ec = ctx.get_cached<ecs>();
     auto& scn = ec.get_scene();
     auto& registry = *scn.registry;
 
-    auto& world = registry.ctx().emplace<bullet::world>(bullet::create_dynamics_world());
+    const auto physics_settings = fit_broadphase(get_physics_settings(ctx), registry);
+    auto& world = registry.ctx().emplace<bullet::world>(bullet::create_dynamics_world(physics_settings));
+    world.streaming = physics_settings.streaming;
 
     registry.on_destroy<bullet::rigidbody>().connect<&on_destroy_bullet_rigidbody_component>();
     registry.on_construct<active_component>().connect<&on_create_active_component>();
     registry.on_destroy<active_component>().connect<&on_destroy_active_component>();
+    registry.on_update<physics_component>().connect<&on_update_component>();
+    registry.on_update<layer_component>().connect<&on_update_layer_component>();
 
     registry.view<physics_component>().each(
         [&](auto e, auto&& comp)
         {
             sync_physics_body(world, comp, true);
+            world.mark_dirty(e);
         });
 }
 
@@ -2068,12 +4222,19 @@ void bullet_backend::on_play_end(rtti::context& ctx)
 
     auto& world = registry.ctx().get<bullet::world>();
 
+    APPLOG_TRACE("Physics Shapes: {} live shapes, {} created for {} requests",
+                 world.shapes.get_live_count(),
+                 world.shapes.created,
+                 world.shapes.requests);
+
     registry.view<physics_component>().each(
         [&](auto e, auto&& comp)
         {
             destroy_phyisics_body(world, comp.get_owner(), true);
         });
 
+    registry.on_update<layer_component>().disconnect<&on_update_layer_component>();
+    registry.on_update<physics_component>().disconnect<&on_update_component>();
     registry.on_construct<active_component>().disconnect<&on_create_active_component>();
     registry.on_destroy<active_component>().disconnect<&on_destroy_active_component>();
     registry.on_destroy<bullet::rigidbody>().disconnect<&on_destroy_bullet_rigidbody_component>();
@@ -2107,12 +4268,46 @@ void bullet_backend::on_frame_update(rtti::context& ctx, delta_t dt)
     {
         float fixed_time_step = 1.0f / 50.0f;
         int max_subs_steps = 3;
+        bool interpolate_physics = false;
+        const settings::physics_settings* physics_settings = nullptr;
 
         if(ctx.has<settings>())
         {
             auto& ss = ctx.get<settings>();
             fixed_time_step = ss.time.fixed_timestep;
             max_subs_steps = ss.time.max_fixed_steps;
+            interpolate_physics = ss.time.interpolate_physics;
+            physics_settings = &ss.physics;
+
+            gDeactivationTime = ss.physics.time_to_sleep;
+            if(world.sleep_linear_threshold != ss.physics.sleep_linear_threshold ||
+               world.sleep_angular_threshold != ss.physics.sleep_angular_threshold)
+            {
+                world.sleep_linear_threshold = ss.physics.sleep_linear_threshold;
+                world.sleep_angular_threshold = ss.physics.sleep_angular_threshold;
+
+                registry.view<physics_component, bullet::rigidbody>().each(
+                    [&](auto e, auto&& comp, auto&& body)
+                    {
+                        if(body.internal)
+                        {
+                            update_rigidbody_sleep(world, body, comp);
+                        }
+                    });
+            }
+
+            world.streaming_radius = std::max(ss.physics.streaming_radius, 0.0f);
+            world.streaming_hysteresis = std::max(ss.physics.streaming_hysteresis, 0.0f);
+            if(world.streaming)
+            {
+                update_streaming_anchors(world, registry, ss.physics);
+            }
+        }
+
+        // A recording is replayed with the timestep it was made with.
+        if(world.recording)
+        {
+            fixed_time_step = world.recording->fixed_timestep;
         }
 
         // Accumulate time
@@ -2124,19 +4319,34 @@ void bullet_backend::on_frame_update(rtti::context& ctx, delta_t dt)
             delta_t step_dt(fixed_time_step);
             ev.on_frame_fixed_update(ctx, step_dt);
 
-            // update phyiscs spatial properties from transform
+            // update phyiscs spatial properties from the transforms changed since the last step
             uint64_t physics_entities{};
             uint64_t physics_entities_synced{};
 
-            registry.view<transform_component, physics_component, active_component>().each(
-                [&](auto e, auto&& transform, auto&& rigidbody, auto&& active_comp)
-                {
-                    physics_entities++;
-                    if(to_physics(world, transform, rigidbody))
-                    {
-                        physics_entities_synced++;
-                    }
-                });
+            // syncing can mark more entities dirty, they are picked up by the next step
+            collect_dirty_transforms(world);
+            world.syncing.swap(world.dirty);
+            for_each_body(registry,
+                          world.syncing,
+                          [&](auto&& transform, auto&& rigidbody)
+                          {
+                              physics_entities++;
+                              if(to_physics(world, transform, rigidbody))
+                              {
+                                  physics_entities_synced++;
+                              }
+                          });
+            if(world.streaming)
+            {
+                world.streaming_moved.insert(world.streaming_moved.end(), world.syncing.begin(), world.syncing.end());
+            }
+            world.syncing.clear();
+
+            // once per frame, after the sync so bodies are streamed by their current pose
+            if(world.streaming && steps == 0)
+            {
+                update_streaming(world, registry);
+            }
 
             // APPLOG_TRACE("Physics Update: entities {} -> synced to physics {}",
             //              physics_entities,
@@ -2144,28 +4354,80 @@ void bullet_backend::on_frame_update(rtti::context& ctx, delta_t dt)
             // update physics
             world.simulate(fixed_time_step, fixed_time_step, 1);
 
+            if(world.recording)
+            {
+                world.recording->hashes.emplace_back(world.state_hash(registry));
+            }
+            world.step++;
+
             physics_entities = {};
             physics_entities_synced = {};
-            // update transform from phyiscs interpolated spatial properties
-            registry.view<transform_component, physics_component, active_component>().each(
-                [&](auto e, auto&& transform, auto&& rigidbody, auto&& active_comp)
-                {
-                    physics_entities++;
-                    if(from_physics(world, transform, rigidbody))
-                    {
-                        physics_entities_synced++;
-                    }
-                });
+            // update transform from the bodies moved by the step
+            for_each_body(registry,
+                          world.moved,
+                          [&](auto&& transform, auto&& rigidbody)
+                          {
+                              physics_entities++;
+                              if(from_physics(world, transform, rigidbody))
+                              {
+                                  physics_entities_synced++;
+                              }
+                          });
+            if(world.streaming)
+            {
+                world.streaming_moved.insert(world.streaming_moved.end(), world.moved.begin(), world.moved.end());
+            }
+
+            // Bodies that fell asleep, were put to sleep or streamed out are left at their last blended pose,
+            // they are put back at the pose of their last step as they stop being interpolated.
+            std::sort(world.interpolated.begin(), world.interpolated.end());
+            world.interpolated.erase(std::unique(world.interpolated.begin(), world.interpolated.end()),
+                                     world.interpolated.end());
+            world.settled.clear();
+            std::set_difference(world.interpolated.begin(),
+                                world.interpolated.end(),
+                                world.moved.begin(),
+                                world.moved.end(),
+                                std::back_inserter(world.settled));
+            for_each_body(registry,
+                          world.settled,
+                          [&](auto&& transform, auto&& rigidbody)
+                          {
+                              interpolate(rigidbody.get_owner().template get<bullet::rigidbody>(), transform, 1.0f);
+                          });
+
+            world.interpolated.swap(world.moved);
+            world.moved.clear();
 
             // APPLOG_TRACE("Physics Update: entities {} -> synced from physics {}",
             //              physics_entities,
             //              physics_entities_synced);
 
-            world.process_manifolds();
+            world.process_manifolds(physics_settings);
 
             world.elapsed -= fixed_time_step;
             steps++;
         }
+
+        // The events of all the steps above reach the scripts together.
+        world.flush_events(ctx.get_cached<script_system>());
+
+        if(steps > 0)
+        {
+            world.update_island_stats();
+        }
+
+        // Show the bodies moved by the last step between its two poses, by the time left over.
+        if(interpolate_physics)
+        {
+            float alpha = math::clamp(world.elapsed / fixed_time_step, 0.0f, 1.0f);
+            for_each_body(registry,
+                          world.interpolated,
+                          [&](auto&& transform, auto&& rigidbody)
+                          {
+                              interpolate(rigidbody.get_owner().template get<bullet::rigidbody>(), transform, alpha);
+                          });
+        }
     }
 }
 
@@ -5,13 +5,16 @@
 #include <context/context.hpp>
 
 #include <engine/physics/ecs/components/physics_component.h>
+#include <engine/physics/physics_replay.h>
 #include <engine/rendering/camera.h>
 #include <graphics/debugdraw.h>
 #include <hpp/small_vector.hpp>
+#include <hpp/span.hpp>
 
 namespace unravel
 {
 class camera;
+struct scene;
 
 template<typename T, size_t SmallSizeCapacity = 8>
 using physics_vector = hpp::small_vector<T, SmallSizeCapacity>;
@@ -37,6 +40,12 @@ struct bullet_backend
     static void apply_torque(physics_component& comp, const math::vec3& toruqe, force_mode mode);
     static void clear_kinematic_velocities(physics_component& comp);
 
+    static void sleep(physics_component& comp);
+    static void wake(physics_component& comp);
+    static auto is_sleeping(const physics_component& comp) -> bool;
+    static auto get_island(const physics_component& comp) -> int;
+    static auto get_island_stats() -> physics_island_stats;
+
     static auto ray_cast(const math::vec3& origin,
                          const math::vec3& direction,
                          float max_distance,
@@ -66,6 +75,58 @@ struct bullet_backend
     static auto sphere_overlap(const math::vec3& origin, float radius, int layer_mask, bool query_sensors)
         -> physics_vector<entt::entity>;
 
+    /**
+     * @brief Runs a batch of ray and sphere casts in parallel.
+     * @param queries The casts to run.
+     * @param results Closest hit per query, same size as queries. Misses get an entt::null entity.
+     */
+    static void cast_batch(hpp::span<const physics_cast_query> queries, hpp::span<raycast_hit> results);
+
+    /**
+     * @brief Runs a batch of sphere overlaps in parallel.
+     * @param queries The overlaps to run.
+     * @param results Storage split evenly between the queries. Entities past a query's share are dropped.
+     * @param counts Number of entities written per query, same size as queries.
+     */
+    static void sphere_overlap_batch(hpp::span<const physics_overlap_query> queries,
+                                     hpp::span<entt::entity> results,
+                                     hpp::span<uint32_t> counts);
+
+    /**
+     * @brief Starts recording the inputs of the playing scene's simulation.
+     *
+     * The world is rebuilt first so no contact, warm starting or sleep state carries over, then the
+     * bodies are recorded as spawned on the first step. Recording stops with stop_recording or when
+     * play ends, 'recording' must outlive it.
+     * @param recording Where the inputs and state hashes are written.
+     */
+    static void start_recording(physics_recording& recording);
+    static void stop_recording();
+
+    /**
+     * @brief Replays a recording headless on a scene that is not playing, usually a clone of the recorded one.
+     *
+     * Runs one fixed step per recorded hash without scripts or events, timing every phase and comparing
+     * the resulting state hashes with the recorded ones. Moved bodies are written back to their transforms.
+     * @param scn The scene to simulate.
+     * @param recording The recording to replay.
+     * @return Per step timings and the hash comparison.
+     */
+    static auto replay(scene& scn, const physics_recording& recording) -> physics_replay_report;
+
+    /**
+     * @brief Measures the pair update cost of every broadphase on a generated flat scene.
+     *
+     * Builds a standalone world per broadphase with 'body_count' bodies spread over a flat area, a quarter
+     * of them static and the others moving, and simulates 'steps' fixed steps. The playing scene is not touched.
+     * @param settings Settings the broadphases are tuned with, the broadphase type itself is ignored.
+     * @param body_count Bodies in the scene.
+     * @param steps Steps simulated per broadphase.
+     * @return One result per broadphase type.
+     */
+    static auto benchmark_broadphases(const settings::physics_settings& settings, uint32_t body_count, uint32_t steps)
+        -> std::vector<physics_broadphase_benchmark>;
+
     static void on_create_component(entt::registry& r, entt::entity e);
     static void on_destroy_component(entt::registry& r, entt::entity e);
     static void on_destroy_bullet_rigidbody_component(entt::registry& r, entt::entity e);
@@ -73,6 +134,9 @@ struct bullet_backend
     static void on_create_active_component(entt::registry& r, entt::entity e);
     static void on_destroy_active_component(entt::registry& r, entt::entity e);
 
+    static void on_update_component(entt::registry& r, entt::entity e);
+    static void on_update_layer_component(entt::registry& r, entt::entity e);
+
     static void draw_system_gizmos(rtti::context& ctx, const camera& cam, gfx::dd_raii& dd);
     static void draw_gizmo(rtti::context& ctx, physics_component& comp, const camera& cam, gfx::dd_raii& dd);
 };
@@ -157,6 +157,13 @@ auto physics_component::are_all_properties_dirty() const noexcept -> bool
 void physics_component::set_property_dirty(physics_property prop, bool dirty) noexcept
 {
     dirty_properties_[static_cast<std::underlying_type_t<physics_property>>(prop)] = dirty;
+
+    // Let the physics backend know which bodies need syncing.
+    auto owner = get_owner();
+    if(dirty && owner && owner.all_of<physics_component>())
+    {
+        owner.patch<physics_component>();
+    }
 }
 
 auto physics_component::get_shapes_count() const -> size_t
@@ -322,4 +329,78 @@ auto physics_component::get_collision_mask() const -> layer_mask
     return layer_mask{collision_include_mask_.mask & ~collision_exclude_mask_.mask};
 }
 
+void physics_component::set_can_sleep(bool can_sleep)
+{
+    if(can_sleep_ == can_sleep)
+    {
+        return;
+    }
+
+    can_sleep_ = can_sleep;
+
+    dirty_.set();
+    set_property_dirty(physics_property::sleep, true);
+}
+
+auto physics_component::can_sleep() const noexcept -> bool
+{
+    return can_sleep_;
+}
+
+void physics_component::set_sleep_linear_threshold(float threshold)
+{
+    if(math::epsilonEqual(sleep_linear_threshold_, threshold, math::epsilon<float>()))
+    {
+        return;
+    }
+
+    sleep_linear_threshold_ = threshold;
+
+    dirty_.set();
+    set_property_dirty(physics_property::sleep, true);
+}
+
+auto physics_component::get_sleep_linear_threshold() const noexcept -> float
+{
+    return sleep_linear_threshold_;
+}
+
+void physics_component::set_sleep_angular_threshold(float threshold)
+{
+    if(math::epsilonEqual(sleep_angular_threshold_, threshold, math::epsilon<float>()))
+    {
+        return;
+    }
+
+    sleep_angular_threshold_ = threshold;
+
+    dirty_.set();
+    set_property_dirty(physics_property::sleep, true);
+}
+
+auto physics_component::get_sleep_angular_threshold() const noexcept -> float
+{
+    return sleep_angular_threshold_;
+}
+
+void physics_component::sleep()
+{
+    physics_system::sleep(*this);
+}
+
+void physics_component::wake_up()
+{
+    physics_system::wake(*this);
+}
+
+auto physics_component::is_sleeping() const -> bool
+{
+    return physics_system::is_sleeping(*this);
+}
+
+auto physics_component::get_island() const -> int
+{
+    return physics_system::get_island(*this);
+}
+
 } // namespace unravel
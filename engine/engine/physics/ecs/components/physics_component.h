@@ -1,6 +1,7 @@
 #pragma once
 #include <engine/engine_export.h>
 
+#include <engine/assets/asset_handle.h>
 #include <engine/ecs/components/basic_component.h>
 #include <engine/physics/physics_material.h>
 #include <engine/layers/layer_mask.h>
@@ -13,6 +14,8 @@
 namespace unravel
 {
 
+class mesh;
+
 /**
  * @struct physics_box_shape
  * @brief Represents a box shape for physics calculations.
@@ -63,6 +66,22 @@ struct physics_cylinder_shape
     float length{1.0f};  ///< Length of the cylinder.
 };
 
+/**
+ * @struct physics_mesh_shape
+ * @brief Represents a shape built from the collision geometry baked into a mesh asset.
+ *
+ * The mesh must be imported with collision generation enabled. Static and kinematic bodies
+ * collide with the triangle mesh unless 'convex' is set, dynamic bodies always use the hull.
+ */
+struct physics_mesh_shape
+{
+    friend auto operator==(const physics_mesh_shape& lhs, const physics_mesh_shape& rhs) -> bool = default;
+
+    math::vec3 center{};              ///< Center of the mesh.
+    asset_handle<unravel::mesh> mesh; ///< Mesh asset with baked collision.
+    bool convex{};                    ///< Use the convex hull instead of the triangle mesh.
+};
+
 /**
  * @struct physics_compound_shape
  * @brief Represents a compound shape that can contain multiple types of shapes.
@@ -72,7 +91,11 @@ struct physics_compound_shape
     friend auto operator==(const physics_compound_shape& lhs, const physics_compound_shape& rhs) -> bool = default;
 
     using shape_t =
-        hpp::variant<physics_box_shape, physics_sphere_shape, physics_capsule_shape, physics_cylinder_shape>;
+        hpp::variant<physics_box_shape,
+                     physics_sphere_shape,
+                     physics_capsule_shape,
+                     physics_cylinder_shape,
+                     physics_mesh_shape>;
 
     shape_t shape; ///< The shape contained in the compound shape.
 };
@@ -93,6 +116,7 @@ enum class physics_property : uint8_t
     velocity,
     angular_velocity,
     layer,
+    sleep,
     count
 };
 
@@ -128,6 +152,31 @@ struct manifold_point
     float impulse{};
 };
 
+// Mirrored by Ace.Core.ContactEventType in System.cs, keep them in the same order.
+enum class contact_event_type : uint8_t
+{
+    sensor_enter,
+    sensor_exit,
+    collision_enter,
+    collision_exit,
+};
+
+/**
+ * @brief A contact pair that started or stopped touching during a frame.
+ *
+ * Contact points are stored in a shared array, the event references its range in it.
+ * Sensor events carry no points, collision exits carry the points the pair started touching with.
+ */
+struct contact_event
+{
+    contact_event_type type{};
+    entt::entity a{entt::null};
+    entt::entity b{entt::null};
+    uint32_t first_point{};
+    uint32_t point_count{};
+    float impulse{}; ///< Total impulse of the contact points.
+};
+
 struct raycast_hit
 {
     entt::entity entity{};
@@ -136,6 +185,45 @@ struct raycast_hit
     float distance{};
 };
 
+/**
+ * @brief A single cast of a batched scene query.
+ *
+ * A radius of zero casts a ray, anything larger sweeps a sphere of that radius.
+ */
+struct physics_cast_query
+{
+    math::vec3 origin{};
+    math::vec3 direction{};
+    float radius{};
+    float max_distance{};
+    int layer_mask{-1};
+    bool query_sensors{};
+};
+
+/**
+ * @brief A single sphere overlap of a batched scene query.
+ */
+struct physics_overlap_query
+{
+    math::vec3 origin{};
+    float radius{};
+    int layer_mask{-1};
+    bool query_sensors{};
+};
+
+/**
+ * @brief Sleeping statistics of the simulated bodies, updated after every frame with physics steps.
+ */
+struct physics_island_stats
+{
+    uint32_t bodies{};          ///< Dynamic bodies in the simulation.
+    uint32_t active_bodies{};   ///< Dynamic bodies that are awake.
+    uint32_t islands{};         ///< Groups of touching or jointed bodies.
+    uint32_t active_islands{};  ///< Islands with at least one awake body.
+    uint32_t largest_island{};  ///< Bodies in the largest island.
+    uint32_t streamed_out{};    ///< Bodies of any kind kept out of the simulation by region streaming.
+};
+
 /**
  * @class physics_component
  * @brief Component that handles physics properties and behaviors.
@@ -335,6 +423,49 @@ public:
 
     auto get_collision_mask() const -> layer_mask;
 
+    /**
+     * @brief Sets whether the body may fall asleep when it comes to rest.
+     * @param can_sleep True to allow sleeping, false to keep the body always awake.
+     */
+    void set_can_sleep(bool can_sleep);
+    auto can_sleep() const noexcept -> bool;
+
+    /**
+     * @brief Sets the linear velocity under which the body is considered at rest.
+     * @param threshold The threshold, negative to use the project setting.
+     */
+    void set_sleep_linear_threshold(float threshold);
+    auto get_sleep_linear_threshold() const noexcept -> float;
+
+    /**
+     * @brief Sets the angular velocity under which the body is considered at rest.
+     * @param threshold The threshold, negative to use the project setting.
+     */
+    void set_sleep_angular_threshold(float threshold);
+    auto get_sleep_angular_threshold() const noexcept -> float;
+
+    /**
+     * @brief Puts the body to sleep, stopping it. It is woken again if its island is still awake.
+     */
+    void sleep();
+
+    /**
+     * @brief Wakes the body up, it falls asleep again once it rests for long enough.
+     */
+    void wake_up();
+
+    /**
+     * @brief Checks if the body is asleep.
+     * @return True if sleeping, false if awake or not simulated.
+     */
+    auto is_sleeping() const -> bool;
+
+    /**
+     * @brief Gets the simulation island of the body, bodies touching each other share it.
+     * @return The island id, -1 for static, kinematic or not simulated bodies.
+     */
+    auto get_island() const -> int;
+
     /**
      * @brief Clears kinematic velocities.
      */
@@ -381,6 +512,12 @@ private:
     bool is_autoscaled_{true};
     ///< The mass of the component.
     float mass_{1};
+    ///< Indicates if the body may fall asleep.
+    bool can_sleep_{true};
+    ///< Linear velocity under which the body rests, negative for the project setting.
+    float sleep_linear_threshold_{-1.0f};
+    ///< Angular velocity under which the body rests, negative for the project setting.
+    float sleep_angular_threshold_{-1.0f};
 
     layer_mask collision_include_mask_{layer_reserved::everything_layer};
 
@@ -131,6 +131,31 @@ void physics_system::clear_kinematic_velocities(physics_component& comp)
     backend_type::clear_kinematic_velocities(comp);
 }
 
+void physics_system::sleep(physics_component& comp)
+{
+    backend_type::sleep(comp);
+}
+
+void physics_system::wake(physics_component& comp)
+{
+    backend_type::wake(comp);
+}
+
+auto physics_system::is_sleeping(const physics_component& comp) -> bool
+{
+    return backend_type::is_sleeping(comp);
+}
+
+auto physics_system::get_island(const physics_component& comp) -> int
+{
+    return backend_type::get_island(comp);
+}
+
+auto physics_system::get_island_stats() const -> physics_island_stats
+{
+    return backend_type::get_island_stats();
+}
+
 auto physics_system::ray_cast(const math::vec3& origin,
                               const math::vec3& direction,
                               float max_distance,
@@ -175,4 +200,38 @@ auto physics_system::sphere_overlap(const math::vec3& origin, float radius, int
     return backend_type::sphere_overlap(origin, radius, layer_mask, query_sensors);
 }
 
+void physics_system::cast_batch(hpp::span<const physics_cast_query> queries, hpp::span<raycast_hit> results) const
+{
+    backend_type::cast_batch(queries, results);
+}
+
+void physics_system::sphere_overlap_batch(hpp::span<const physics_overlap_query> queries,
+                                          hpp::span<entt::entity> results,
+                                          hpp::span<uint32_t> counts) const
+{
+    backend_type::sphere_overlap_batch(queries, results, counts);
+}
+
+void physics_system::start_recording(physics_recording& recording)
+{
+    backend_type::start_recording(recording);
+}
+
+void physics_system::stop_recording()
+{
+    backend_type::stop_recording();
+}
+
+auto physics_system::replay(scene& scn, const physics_recording& recording) -> physics_replay_report
+{
+    return backend_type::replay(scn, recording);
+}
+
+auto physics_system::benchmark_broadphases(const settings::physics_settings& settings,
+                                           uint32_t body_count,
+                                           uint32_t steps) -> std::vector<physics_broadphase_benchmark>
+{
+    return backend_type::benchmark_broadphases(settings, body_count, steps);
+}
+
 } // namespace unravel
@@ -67,6 +67,27 @@ public:
      */
     static void clear_kinematic_velocities(physics_component& comp);
 
+    /**
+     * @brief Puts the body of the component to sleep.
+     * @param comp The physics component.
+     */
+    static void sleep(physics_component& comp);
+
+    /**
+     * @brief Wakes the body of the component up.
+     * @param comp The physics component.
+     */
+    static void wake(physics_component& comp);
+
+    static auto is_sleeping(const physics_component& comp) -> bool;
+    static auto get_island(const physics_component& comp) -> int;
+
+    /**
+     * @brief Gets the sleeping statistics of the playing scene.
+     * @return The statistics after the last frame with physics steps.
+     */
+    auto get_island_stats() const -> physics_island_stats;
+
     auto ray_cast(const math::vec3& origin,
                   const math::vec3& direction,
                   float max_distance,
@@ -96,6 +117,52 @@ public:
     auto sphere_overlap(const math::vec3& origin, float radius, int layer_mask, bool query_sensors) const
         -> physics_vector<entt::entity>;
 
+    /**
+     * @brief Runs a batch of ray and sphere casts in parallel.
+     * @param queries The casts to run.
+     * @param results Closest hit per query, same size as queries. Misses get an entt::null entity.
+     */
+    void cast_batch(hpp::span<const physics_cast_query> queries, hpp::span<raycast_hit> results) const;
+
+    /**
+     * @brief Runs a batch of sphere overlaps in parallel.
+     * @param queries The overlaps to run.
+     * @param results Storage split evenly between the queries.
+     * @param counts Number of entities written per query, same size as queries.
+     */
+    void sphere_overlap_batch(hpp::span<const physics_overlap_query> queries,
+                              hpp::span<entt::entity> results,
+                              hpp::span<uint32_t> counts) const;
+
+    /**
+     * @brief Starts recording the inputs of the playing scene's simulation.
+     * @param recording Where the inputs and state hashes are written, must outlive the recording.
+     */
+    static void start_recording(physics_recording& recording);
+
+    /**
+     * @brief Stops the recording started with start_recording.
+     */
+    static void stop_recording();
+
+    /**
+     * @brief Replays a recording headless on a scene that is not playing.
+     * @param scn The scene to simulate, usually a clone of the recorded one.
+     * @param recording The recording to replay.
+     * @return Per step timings and the hash comparison.
+     */
+    static auto replay(scene& scn, const physics_recording& recording) -> physics_replay_report;
+
+    /**
+     * @brief Measures the pair update cost of every broadphase on a generated flat scene.
+     * @param settings Settings the broadphases are tuned with.
+     * @param body_count Bodies in the scene.
+     * @param steps Steps simulated per broadphase.
+     * @return One result per broadphase type.
+     */
+    static auto benchmark_broadphases(const settings::physics_settings& settings, uint32_t body_count, uint32_t steps)
+        -> std::vector<physics_broadphase_benchmark>;
+
 private:
     /**
      * @brief Updates the physics system for each frame.
@@ -1,5 +1,7 @@
 #include "gizmos.h"
 
+#include <engine/rendering/mesh.h>
+
 #include <bx/math.h>
 namespace unravel
 {
@@ -44,10 +46,13 @@ void draw(DebugDrawEncoder& dde, const physics_box_shape& sh)
     dde.draw(aabb);
 }
 
-// void draw(DebugDrawEncoder& dde, const physics_mesh_shape& sh)
-// {
-
-// }
+void draw(DebugDrawEncoder& dde, const physics_mesh_shape& sh)
+{
+    auto mesh = sh.mesh.get(false);
+    const auto& bounds = mesh->get_bounds();
+    auto aabb = bx::Aabb{to_bx(sh.center + bounds.min), to_bx(sh.center + bounds.max)};
+    dde.draw(aabb);
+}
 
 void draw(DebugDrawEncoder& dde, const physics_compound_shape& sh)
 {
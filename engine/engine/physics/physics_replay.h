@@ -0,0 +1,110 @@
+#pragma once
+#include <engine/engine_export.h>
+
+#include <engine/physics/ecs/components/physics_component.h>
+#include <engine/settings/settings.h>
+#include <math/math.h>
+#include <uuid/uuid.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace unravel
+{
+
+enum class physics_replay_event_type : uint8_t
+{
+    // The body entered the simulation.
+    spawn,
+
+    // The body left the simulation.
+    despawn,
+
+    // The body pose and velocities were set from outside the simulation.
+    teleport,
+
+    // A force was applied to the body, explosions are recorded as the force they produced.
+    force,
+
+    // A torque was applied to the body.
+    torque,
+
+    // The body velocities were set from outside the simulation, e.g. through the component.
+    velocity,
+};
+
+/**
+ * @struct physics_replay_event
+ * @brief An input to the simulation captured while recording.
+ *
+ * Events are applied in recorded order before their step is simulated. Bodies are identified
+ * by their id_component so a recording can be replayed on a clone of the recorded scene.
+ */
+struct physics_replay_event
+{
+    uint32_t step{};                                          ///< Step the event is applied before.
+    physics_replay_event_type type{};                         ///< What happened to the body.
+    hpp::uuid id{};                                           ///< Id of the entity owning the body.
+    math::vec3 position{};                                    ///< Teleport position.
+    math::quat rotation{math::identity<math::quat>()};        ///< Teleport rotation.
+    math::vec3 vector{};                                      ///< Force, torque or set linear velocity.
+    math::vec3 angular_velocity{};                            ///< Set angular velocity.
+    force_mode mode{};                                        ///< How a force or torque is applied.
+};
+
+/**
+ * @struct physics_recording
+ * @brief Inputs and resulting state hashes of a recorded simulation.
+ */
+struct physics_recording
+{
+    float fixed_timestep{1.0f / 50.0f};        ///< Fixed timestep the recording was simulated with.
+    std::vector<physics_replay_event> events;  ///< Inputs in the order they were applied.
+    std::vector<uint64_t> hashes;              ///< State hash after every recorded step.
+};
+
+/**
+ * @struct physics_step_timing
+ * @brief Time spent in each phase of a step, in milliseconds.
+ */
+struct physics_step_timing
+{
+    float broadphase{};  ///< Aabb updates and pair finding.
+    float narrowphase{}; ///< Contact generation for the found pairs.
+    float solver{};      ///< Constraint and contact solving.
+    float sync{};        ///< Applying the inputs and writing the results back to the transforms.
+    float total{};       ///< The whole step.
+};
+
+/**
+ * @struct physics_replay_report
+ * @brief Result of replaying a recording.
+ */
+struct physics_replay_report
+{
+    std::vector<physics_step_timing> steps; ///< Timings of every replayed step.
+    uint64_t final_hash{};                  ///< State hash after the last step.
+    int64_t first_mismatch{-1};             ///< First step whose hash differs from the recording, -1 if none.
+    uint32_t unresolved_events{};           ///< Events whose entity was not found in the replayed scene.
+
+    auto matches() const -> bool
+    {
+        return first_mismatch < 0 && unresolved_events == 0;
+    }
+};
+
+/**
+ * @struct physics_broadphase_benchmark
+ * @brief Cost of a broadphase on the generated benchmark scene, averaged over the simulated steps.
+ */
+struct physics_broadphase_benchmark
+{
+    settings::physics_settings::broadphase_type broadphase{}; ///< The measured broadphase.
+    uint32_t bodies{};                                        ///< Bodies in the scene.
+    uint32_t pairs{};                                         ///< Overlapping pairs after the last step.
+    float create{};                                           ///< Adding the bodies to the world, in milliseconds.
+    float pair_update{};                                      ///< Aabb updates and pair finding per step, in milliseconds.
+    float step{};                                             ///< Whole step, in milliseconds.
+};
+
+} // namespace unravel
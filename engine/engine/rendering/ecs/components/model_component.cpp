@@ -151,7 +151,7 @@ void get_transforms_for_entities(const std::vector<entt::handle>& entities,
 
 auto model_component::create_armature(bool force) -> bool
 {
-    bool has_processed_armature = !get_armature_entities().empty();
+    bool has_processed_armature = compact_skeleton_ ? !skeleton_nodes_.empty() : !get_armature_entities().empty();
 
     if(force || !has_processed_armature)
     {
@@ -162,6 +162,11 @@ auto model_component::create_armature(bool force) -> bool
         }
         auto mesh = lod.get();
 
+        if(compact_skeleton_)
+        {
+            return create_compact_skeleton(*mesh);
+        }
+
         auto owner = get_owner();
 
         std::vector<entt::handle> armature_entities;
@@ -183,6 +188,130 @@ auto model_component::create_armature(bool force) -> bool
     return false;
 }
 
+auto model_component::create_compact_skeleton(const mesh& render_mesh) -> bool
+{
+    const auto& root = render_mesh.get_armature();
+    if(!root)
+    {
+        return false;
+    }
+
+    auto owner = get_owner();
+    const auto& skin_data = render_mesh.get_skin_bind_data();
+
+    skeleton_nodes_.clear();
+    skeleton_local_pose_.clear();
+    skeleton_model_pose_.clear();
+    bind_pose_.nodes.clear();
+
+    std::vector<entt::handle> exposed_entities;
+
+    // Flatten the armature depth first, the same order process_node uses for the bind pose.
+    std::vector<std::pair<const mesh::armature_node*, int32_t>> stack;
+    stack.emplace_back(root.get(), -1);
+    while(!stack.empty())
+    {
+        auto [node, parent] = stack.back();
+        stack.pop_back();
+
+        auto index = int32_t(skeleton_nodes_.size());
+
+        skeleton_node& flat_node = skeleton_nodes_.emplace_back();
+        flat_node.parent = parent;
+        flat_node.has_submeshes = !node->submeshes.empty();
+
+        auto query = skin_data.find_bone_by_id(node->name);
+        if(query.bone && query.index >= 0)
+        {
+            flat_node.bone_index = query.index;
+        }
+
+        skeleton_local_pose_.emplace_back(node->local_transform);
+
+        animation_pose::node ref_node;
+        ref_node.desc.index = node->index;
+        ref_node.transform = node->local_transform;
+        bind_pose_.nodes.push_back(ref_node);
+
+        bool exposed = std::find(exposed_bones_.begin(), exposed_bones_.end(), node->name) != exposed_bones_.end();
+        if(exposed && owner)
+        {
+            // Exposed bones hang directly under the model and are moved to their node on every update.
+            auto& owner_trans_comp = owner.get<transform_component>();
+            auto entity_node = get_bone_entity(node->name, owner_trans_comp.get_children());
+            if(!entity_node)
+            {
+                auto& reg = *owner.registry();
+                entity_node = scene::create_entity(reg, node->name, owner);
+            }
+
+            if(flat_node.bone_index >= 0)
+            {
+                auto& comp = entity_node.get_or_emplace<bone_component>();
+                comp.bone_index = flat_node.bone_index;
+            }
+
+            flat_node.entity = entity_node;
+            exposed_entities.emplace_back(entity_node);
+        }
+
+        for(auto it = node->children.rbegin(); it != node->children.rend(); ++it)
+        {
+            stack.emplace_back(it->get(), index);
+        }
+    }
+
+    skeleton_model_pose_.resize(skeleton_nodes_.size());
+    set_armature_entities(exposed_entities);
+
+    if(skin_data.has_bones())
+    {
+        set_static(false);
+    }
+
+    return true;
+}
+
+void model_component::update_compact_skeleton(size_t bones_count, size_t submeshes_count)
+{
+    math::mat4 owner_global(1.0f);
+    if(auto owner = get_owner())
+    {
+        owner_global = owner.get<transform_component>().get_transform_global().get_matrix();
+    }
+
+    submesh_pose_.transforms.clear();
+    submesh_pose_.transforms.reserve(submeshes_count);
+    bone_pose_.transforms.resize(bones_count);
+
+    // Parents always come before their children so a single pass resolves the hierarchy.
+    for(size_t i = 0; i < skeleton_nodes_.size(); ++i)
+    {
+        const auto& node = skeleton_nodes_[i];
+        const auto& local = skeleton_local_pose_[i].get_matrix();
+
+        auto& model_space = skeleton_model_pose_[i];
+        model_space = node.parent >= 0 ? skeleton_model_pose_[node.parent] * local : local;
+
+        const auto world = owner_global * model_space;
+
+        if(node.has_submeshes)
+        {
+            submesh_pose_.transforms.emplace_back(world);
+        }
+
+        if(node.bone_index >= 0 && size_t(node.bone_index) < bones_count)
+        {
+            bone_pose_.transforms[node.bone_index] = world;
+        }
+
+        if(node.entity)
+        {
+            node.entity.get<transform_component>().set_transform_local(math::transform(model_space));
+        }
+    }
+}
+
 auto model_component::update_armature() -> bool
 {
     auto lod = model_.get_lod(0);
@@ -199,24 +328,73 @@ auto model_component::update_armature() -> bool
     auto bones_count = skin_data.get_bones().size();
     auto submeshes_count = mesh->get_submeshes_count();
 
-    get_transforms_for_entities(armature_entities, submeshes_count, submesh_pose_, bones_count, bone_pose_);
-
-    // Has skinning data?
-    if(skin_data.has_bones())
+    if(compact_skeleton_)
     {
-        const auto& palettes = mesh->get_bone_palettes();
-        skinning_pose_.resize(palettes.size());
-        for(size_t i = 0; i < palettes.size(); ++i)
-        {
-            const auto& palette = palettes[i];
-            // Apply the bone palette.
-            skinning_pose_[i].transforms = palette.get_skinning_matrices(bone_pose_.transforms, skin_data);
-        }
+        update_compact_skeleton(bones_count, submeshes_count);
+    }
+    else
+    {
+        get_transforms_for_entities(armature_entities, submeshes_count, submesh_pose_, bones_count, bone_pose_);
     }
 
     return true;
 }
 
+auto model_component::get_skinning_matrix_count() const -> size_t
+{
+    auto lod = model_.get_lod(0);
+    if(!lod)
+    {
+        return 0;
+    }
+
+    auto mesh = lod.get();
+    const auto& skin_data = mesh->get_skin_bind_data();
+    if(!skin_data.has_bones() || bone_pose_.transforms.empty())
+    {
+        return 0;
+    }
+
+    size_t count = 0;
+    for(const auto& palette : mesh->get_bone_palettes())
+    {
+        count += palette.get_bones().size();
+    }
+
+    return count;
+}
+
+void model_component::update_skinning(skinning_buffer& buffer, uint32_t offset)
+{
+    skinning_pose_.buffer = &buffer;
+    skinning_pose_.ranges.clear();
+
+    auto lod = model_.get_lod(0);
+    if(!lod)
+    {
+        return;
+    }
+
+    auto mesh = lod.get();
+    const auto& skin_data = mesh->get_skin_bind_data();
+    const auto& palettes = mesh->get_bone_palettes();
+    skinning_pose_.ranges.reserve(palettes.size());
+
+    for(const auto& palette : palettes)
+    {
+        auto count = uint32_t(palette.get_bones().size());
+        palette.compute_skinning_matrices(bone_pose_.transforms, skin_data, buffer.matrices.data() + offset);
+
+        skinning_pose_.ranges.push_back({offset, count});
+        offset += count;
+    }
+}
+
+void model_component::clear_skinning()
+{
+    skinning_pose_ = {};
+}
+
 auto model_component::init_armature(bool force) -> bool
 {
     auto lod = model_.get_lod(0);
@@ -231,7 +409,7 @@ auto model_component::init_armature(bool force) -> bool
 
     bool recreate_armature = force;
     recreate_armature |= armature && submesh_pose_.transforms.empty();
-    recreate_armature |= skin_data.has_bones() && skinning_pose_.empty();
+    recreate_armature |= skin_data.has_bones() && bone_pose_.transforms.empty();
 
     if(recreate_armature)
     {
@@ -307,6 +485,23 @@ auto model_component::was_used_last_frame() const noexcept -> bool
     return is_newly_created || was_used_recently;
 }
 
+void model_component::set_screen_coverage(float coverage)
+{
+    auto current_frame = gfx::get_render_frame();
+    if(screen_coverage_frame_ == current_frame)
+    {
+        coverage = std::max(coverage, screen_coverage_);
+    }
+
+    screen_coverage_ = coverage;
+    screen_coverage_frame_ = current_frame;
+}
+
+auto model_component::get_screen_coverage() const noexcept -> float
+{
+    return screen_coverage_;
+}
+
 auto model_component::is_skinned() const -> bool
 {
     auto lod = model_.get_lod(0);
@@ -428,7 +623,7 @@ auto model_component::get_bone_transforms() const -> const pose_mat4&
     return bone_pose_;
 }
 
-auto model_component::get_skinning_transforms() const -> const std::vector<pose_mat4>&
+auto model_component::get_skinning_transforms() const -> const skinning_palettes&
 {
     return skinning_pose_;
 }
@@ -445,6 +640,123 @@ void model_component::set_armature_entities(const std::vector<entt::handle>& ent
     touch();
 }
 
+void model_component::set_compact_skeleton(bool compact)
+{
+    if(compact_skeleton_ == compact)
+    {
+        return;
+    }
+
+    touch();
+
+    compact_skeleton_ = compact;
+
+    // Force the armature to be rebuilt in the new mode.
+    skeleton_nodes_.clear();
+    skeleton_local_pose_.clear();
+    skeleton_model_pose_.clear();
+    submesh_pose_.transforms.clear();
+    bone_pose_.transforms.clear();
+    skinning_pose_ = {};
+    destroy_armature_entities();
+}
+
+auto model_component::is_compact_skeleton() const -> bool
+{
+    return compact_skeleton_;
+}
+
+void model_component::set_exposed_bones(const std::vector<std::string>& bones)
+{
+    if(exposed_bones_ == bones)
+    {
+        return;
+    }
+
+    touch();
+
+    exposed_bones_ = bones;
+
+    if(compact_skeleton_)
+    {
+        // Bones still exposed keep their entity, and whatever was attached to it.
+        destroy_armature_entities(exposed_bones_);
+        skeleton_nodes_.clear();
+        submesh_pose_.transforms.clear();
+        bone_pose_.transforms.clear();
+        skinning_pose_ = {};
+    }
+}
+
+void model_component::destroy_armature_entities(const std::vector<std::string>& keep)
+{
+    auto owner = get_owner();
+
+    for(auto& e : armature_entities_)
+    {
+        // Already gone with a destroyed ancestor.
+        if(!e.valid())
+        {
+            continue;
+        }
+
+        // Nested nodes are destroyed with the node hanging from the model.
+        if(e.get<transform_component>().get_parent() != owner)
+        {
+            continue;
+        }
+
+        const auto& name = e.get<tag_component>().name;
+        if(std::find(keep.begin(), keep.end(), name) != keep.end())
+        {
+            continue;
+        }
+
+        e.destroy();
+    }
+
+    armature_entities_.clear();
+}
+
+auto model_component::get_exposed_bones() const -> const std::vector<std::string>&
+{
+    return exposed_bones_;
+}
+
+auto model_component::get_skeleton_node_count() const -> size_t
+{
+    return skeleton_local_pose_.size();
+}
+
+auto model_component::get_skeleton_node_transform(size_t index) const -> const math::transform&
+{
+    if(index >= skeleton_local_pose_.size())
+    {
+        return math::transform::identity();
+    }
+
+    return skeleton_local_pose_[index];
+}
+
+void model_component::set_skeleton_node_transform(size_t index, const math::transform& transform)
+{
+    if(index < skeleton_local_pose_.size())
+    {
+        skeleton_local_pose_[index] = transform;
+    }
+}
+
+auto model_component::get_skeleton_node_scale(size_t index) const -> math::vec3
+{
+    math::vec3 scale(1.0f);
+    for(auto i = int32_t(index); i >= 0 && size_t(i) < skeleton_nodes_.size(); i = skeleton_nodes_[i].parent)
+    {
+        scale *= skeleton_local_pose_[i].get_scale();
+    }
+
+    return scale;
+}
+
 auto model_component::get_armature_entities() const -> const std::vector<entt::handle>&
 {
     return armature_entities_;
@@ -106,7 +106,63 @@ public:
     auto get_armature_by_id(const std::string& node_id) const -> entt::handle;
     auto get_armature_index_by_id(const std::string& node_id) const -> int;
     auto get_armature_by_index(size_t index) const -> entt::handle;
-    auto get_skinning_transforms() const -> const std::vector<pose_mat4>&;
+    auto get_skinning_transforms() const -> const skinning_palettes&;
+
+    /**
+     * @brief Sets whether the armature is kept in flat arrays on the model instead of entities.
+     *
+     * In compact mode the local pose of every armature node lives in a contiguous array which
+     * the animation system writes to directly, and only the bones listed in the exposed bones
+     * get an entity. Those entities are children of the model and follow their bone.
+     *
+     * @param compact True to use the compact skeleton, false otherwise.
+     */
+    void set_compact_skeleton(bool compact);
+
+    /**
+     * @brief Checks if the armature is kept in flat arrays on the model.
+     * @return True if the compact skeleton is used, false otherwise.
+     */
+    auto is_compact_skeleton() const -> bool;
+
+    /**
+     * @brief Sets the names of the bones which get an entity in compact mode.
+     * @param bones The names of the armature nodes to expose.
+     */
+    void set_exposed_bones(const std::vector<std::string>& bones);
+
+    /**
+     * @brief Gets the names of the bones which get an entity in compact mode.
+     * @return A constant reference to the names of the exposed armature nodes.
+     */
+    auto get_exposed_bones() const -> const std::vector<std::string>&;
+
+    /**
+     * @brief Gets the number of armature nodes of the compact skeleton.
+     * @return The node count, 0 when not in compact mode.
+     */
+    auto get_skeleton_node_count() const -> size_t;
+
+    /**
+     * @brief Gets the local transform of a node of the compact skeleton.
+     * @param index The node index as used by the bind pose.
+     * @return A constant reference to the local transform.
+     */
+    auto get_skeleton_node_transform(size_t index) const -> const math::transform&;
+
+    /**
+     * @brief Sets the local transform of a node of the compact skeleton.
+     * @param index The node index as used by the bind pose.
+     * @param transform The local transform.
+     */
+    void set_skeleton_node_transform(size_t index, const math::transform& transform);
+
+    /**
+     * @brief Gets the scale of a node of the compact skeleton relative to the model.
+     * @param index The node index as used by the bind pose.
+     * @return The accumulated scale of the node and its parents.
+     */
+    auto get_skeleton_node_scale(size_t index) const -> math::vec3;
 
     /**
      * @brief Updates the armature of the model.
@@ -114,6 +170,24 @@ public:
     auto init_armature(bool force) -> bool;
     auto update_armature() -> bool;
 
+    /**
+     * @brief Gets the number of skinning matrices over all bone palettes of the model.
+     * @return The matrix count, 0 when the model is not skinned or its armature is not ready.
+     */
+    auto get_skinning_matrix_count() const -> size_t;
+
+    /**
+     * @brief Computes the skinning matrices of all bone palettes from the current bone transforms.
+     * @param buffer The buffer receiving the matrices, already large enough.
+     * @param offset The first matrix of the buffer reserved for this model.
+     */
+    void update_skinning(skinning_buffer& buffer, uint32_t offset);
+
+    /**
+     * @brief Drops the skinning matrix ranges, for models that got no part of the buffer this frame.
+     */
+    void clear_skinning();
+
     /**
      * @brief Sets the armature entities.
      * @param submesh_entities A vector of handles to the armature entities.
@@ -135,11 +209,48 @@ public:
     auto get_last_render_frame() const noexcept -> uint64_t;
     auto was_used_last_frame() const noexcept -> bool;
 
+    /**
+     * @brief Records how much of the viewport height the model covered when rendered.
+     *
+     * When rendered by several cameras in a frame the largest coverage is kept.
+     * @param coverage The coverage in percent of the viewport height.
+     */
+    void set_screen_coverage(float coverage);
+
+    /**
+     * @brief Gets the viewport height coverage of the last frame the model was rendered.
+     * @return The coverage in percent of the viewport height.
+     */
+    auto get_screen_coverage() const noexcept -> float;
+
     auto is_skinned() const -> bool;
     auto get_bind_pose() const -> const animation_pose&;
 
 private:
+    /**
+     * @brief Node of the compact skeleton, stored in depth first order.
+     */
+    struct skeleton_node
+    {
+        /// Index of the parent node or -1 for the root.
+        int32_t parent{-1};
+        /// Index of the bone in the skin bind data or -1.
+        int32_t bone_index{-1};
+        /// Whether the node affects submeshes.
+        bool has_submeshes{};
+        /// Entity following the node when it is exposed.
+        entt::handle entity;
+    };
+
     auto create_armature(bool force) -> bool;
+    auto create_compact_skeleton(const mesh& render_mesh) -> bool;
+    void update_compact_skeleton(size_t bones_count, size_t submeshes_count);
+
+    /**
+     * @brief Destroys the armature entities hanging from the model, their descendants go with them.
+     * @param keep Names of the entities to keep, e.g. bones still exposed.
+     */
+    void destroy_armature_entities(const std::vector<std::string>& keep = {});
 
     /**
      * @brief Indicates if the model is enabled.
@@ -171,6 +282,31 @@ private:
      */
     std::vector<entt::handle> armature_entities_;
 
+    /**
+     * @brief Indicates if the armature is kept in flat arrays instead of entities.
+     */
+    bool compact_skeleton_ = false;
+
+    /**
+     * @brief Names of the armature nodes which get an entity in compact mode.
+     */
+    std::vector<std::string> exposed_bones_;
+
+    /**
+     * @brief Nodes of the compact skeleton.
+     */
+    std::vector<skeleton_node> skeleton_nodes_;
+
+    /**
+     * @brief Local transforms of the compact skeleton nodes.
+     */
+    std::vector<math::transform> skeleton_local_pose_;
+
+    /**
+     * @brief Transforms of the compact skeleton nodes relative to the model.
+     */
+    std::vector<math::mat4> skeleton_model_pose_;
+
     /**
      * @brief Bind pose or reference pose.
      */
@@ -186,9 +322,9 @@ private:
     pose_mat4 submesh_pose_;
 
     /**
-     * @brief Skinning pose per palette
+     * @brief Skinning matrices per palette in the skinning buffer of the scene.
      */
-    std::vector<pose_mat4> skinning_pose_;
+    skinning_palettes skinning_pose_;
 
     /**
      * @brief World bounds
@@ -204,6 +340,12 @@ private:
      * @brief Last frame this model was rendered.
      */
     uint64_t last_render_frame_{};
+
+    /**
+     * @brief Largest viewport height coverage in percent and the frame it was recorded.
+     */
+    float screen_coverage_{100.0f};
+    uint64_t screen_coverage_frame_{};
 };
 
 struct bone_component : public component_crtp<bone_component>
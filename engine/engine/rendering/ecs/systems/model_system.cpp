@@ -683,6 +683,54 @@ void model_system::on_frame_before_render(scene& scn, delta_t dt)
 
                       model_comp.update_world_bounds(transform_comp.get_transform_global());
                   });
+
+    update_skinning(scn);
+}
+
+void model_system::update_skinning(scene& scn)
+{
+    APP_SCOPE_PERF("Model/Skinning Palettes");
+
+    auto& registry_ctx = scn.registry->ctx();
+    auto buffer_ptr = registry_ctx.find<std::shared_ptr<skinning_buffer>>();
+    if(!buffer_ptr)
+    {
+        buffer_ptr = &registry_ctx.emplace<std::shared_ptr<skinning_buffer>>(std::make_shared<skinning_buffer>());
+    }
+    auto& buffer = **buffer_ptr;
+
+    // Give every visible skinned model a range of the scene's buffer, then fill all of them in one pass.
+    skinned_models_.clear();
+    size_t total_count = 0;
+
+    // Inactive models and models not rendered last frame drop their ranges, the buffer shrinks under them.
+    // Like the armature update, a model coming into view gets its palette on the frame after it is first drawn.
+    auto view = scn.registry->view<transform_component, model_component>();
+    for(auto entity : view)
+    {
+        auto& model_comp = view.get<model_component>(entity);
+        const bool is_visible = scn.registry->all_of<active_component>(entity) && model_comp.was_used_last_frame();
+        auto count = is_visible ? model_comp.get_skinning_matrix_count() : 0;
+        if(count > 0)
+        {
+            skinned_models_.push_back({&model_comp, uint32_t(total_count)});
+            total_count += count;
+        }
+        else
+        {
+            model_comp.clear_skinning();
+        }
+    }
+
+    buffer.matrices.resize(total_count);
+
+    std::for_each(std::execution::par,
+                  skinned_models_.begin(),
+                  skinned_models_.end(),
+                  [&](const skinned_model& skinned)
+                  {
+                      skinned.model->update_skinning(buffer, skinned.offset);
+                  });
 }
 
 void model_system::on_play_begin(hpp::span<const entt::handle> entities, delta_t dt)
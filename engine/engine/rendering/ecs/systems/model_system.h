@@ -8,6 +8,7 @@
 
 namespace unravel
 {
+class model_component;
 
 auto ik_set_position_ccd(entt::handle end_effector,
                          const math::vec3& target,
@@ -43,6 +44,20 @@ public:
     void on_frame_before_render(scene& scn, delta_t dt);
 
 private:
+    /**
+     * @brief Computes the skinning matrices of all skinned models of a scene into its skinning buffer.
+     */
+    void update_skinning(scene& scn);
+
+    struct skinned_model
+    {
+        model_component* model{};
+        uint32_t offset{};
+    };
+
+    /// Skinned models of the scene being updated and their first matrix in the skinning buffer.
+    std::vector<skinned_model> skinned_models_;
+
     std::shared_ptr<int> sentinel_ = std::make_shared<int>(0);
 };
 } // namespace unravel
@@ -8,8 +8,14 @@
 #include <memory/checked_delete.h>
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstring>
+#include <limits>
+#include <numeric>
+
+#define POOLSTL_STD_SUPPLEMENT 1
+#include <poolstl/poolstl.hpp>
 
 namespace unravel
 {
@@ -110,6 +116,471 @@ void create_mesh(const gfx::vertex_layout& format,
     data.compute_tangents = has_tangents;
 }
 
+/// Orders two vertices attribute by attribute. Components closer than 'tolerance' are treated as equal.
+auto compare_vertices(const uint8_t* vtx1, const uint8_t* vtx2, const gfx::vertex_layout& layout, float tolerance)
+    -> int
+{
+    float diff{};
+    int ndifference{};
+
+    for(uint16_t i = 0; i < gfx::attribute::Count; ++i)
+    {
+        if(!layout.has(static_cast<gfx::attribute>(i)))
+        {
+            continue; // Skip attributes not present in this layout.
+        }
+
+        // Get the offset for this attribute in the vertex data
+        uint16_t offset = layout.getOffset(static_cast<gfx::attribute>(i));
+
+        // Retrieve the vertex data pointers
+        const uint8_t* p1 = vtx1 + offset;
+        const uint8_t* p2 = vtx2 + offset;
+
+        // Decode the attribute information
+        uint8_t num_components{};
+        bgfx::AttribType::Enum type{};
+        bool normalized{}, as_int{};
+        layout.decode(static_cast<gfx::attribute>(i), num_components, type, normalized, as_int);
+
+        // Compare the attributes based on the type
+        switch(type)
+        {
+            case bgfx::AttribType::Float:
+            {
+                for(uint8_t j = 0; j < num_components; ++j)
+                {
+                    diff = ((float*)p1)[j] - ((float*)p2)[j];
+                    if(fabsf(diff) > tolerance)
+                        return (diff < 0) ? -1 : 1;
+                }
+                break;
+            }
+
+            case bgfx::AttribType::Uint8:
+            case bgfx::AttribType::Int16:
+            {
+                if(as_int)
+                {
+                    ndifference = memcmp(p1, p2, num_components * (type == bgfx::AttribType::Uint8 ? 1 : 2));
+                    if(ndifference != 0)
+                    {
+                        return (ndifference < 0) ? -1 : 1;
+                    }
+                }
+                else
+                {
+                    for(uint8_t j = 0; j < num_components; ++j)
+                    {
+                        float f1{}, f2{};
+                        if(type == bgfx::AttribType::Uint8)
+                        {
+                            f1 = normalized ? ((float)p1[j] / 255.0f) : (float)p1[j];
+                            f2 = normalized ? ((float)p2[j] / 255.0f) : (float)p2[j];
+                        }
+                        else // Int16
+                        {
+                            f1 = normalized ? ((float)((int16_t*)p1)[j] / 32767.0f) : (float)((int16_t*)p1)[j];
+                            f2 = normalized ? ((float)((int16_t*)p2)[j] / 32767.0f) : (float)((int16_t*)p2)[j];
+                        }
+                        diff = f1 - f2;
+                        if(fabsf(diff) > tolerance)
+                        {
+                            return (diff < 0) ? -1 : 1;
+                        }
+                    }
+                }
+                break;
+            }
+
+            default:
+                // Handle other types if necessary.
+                break;
+        }
+    }
+
+    // Both vertices are equal for the purposes of this test.
+    return 0;
+}
+
+/**
+ * @brief Spatial hash over quantized vertex positions.
+ *
+ * Cells are larger than the tolerance, so a position within tolerance of another one is either
+ * in the same cell or in the neighbouring cell on the side it is close to. Most lookups touch a
+ * single cell. Cells are identified by a 64 bit hash of their coordinates and stored in an open
+ * addressing table that grows with the number of distinct cells, their values are chained through
+ * a flat array. Two cells sharing a hash only add candidates, the caller still tests every one.
+ */
+class position_grid
+{
+public:
+    static constexpr uint32_t invalid = 0xFFFFFFFF;
+
+    struct cell_key
+    {
+        int64_t x{};
+        int64_t y{};
+        int64_t z{};
+    };
+
+    position_grid(float tolerance, size_t count)
+        : tolerance_(std::max(double(tolerance), 0.0))
+        , cell_size_(std::max(tolerance_ * 16.0, double(std::numeric_limits<float>::epsilon())))
+    {
+        cells_.resize(1024);
+        items_.reserve(count);
+    }
+
+    auto get_cell(const math::vec3& p) const -> cell_key
+    {
+        return {quantize(p.x), quantize(p.y), quantize(p.z)};
+    }
+
+    /// Returns the first value stored near 'p' for which 'equal' returns true, or 'invalid'.
+    template<typename Equal>
+    auto find(const math::vec3& p, const cell_key& base, Equal&& equal) const -> uint32_t
+    {
+        int64_t lo[3];
+        int64_t hi[3];
+        get_range(p.x, base.x, lo[0], hi[0]);
+        get_range(p.y, base.y, lo[1], hi[1]);
+        get_range(p.z, base.z, lo[2], hi[2]);
+
+        for(int64_t x = lo[0]; x <= hi[0]; ++x)
+        {
+            for(int64_t y = lo[1]; y <= hi[1]; ++y)
+            {
+                for(int64_t z = lo[2]; z <= hi[2]; ++z)
+                {
+                    const auto& c = cells_[find_slot(hash({x, y, z}))];
+                    for(uint32_t it = c.head; it != invalid; it = items_[it].next)
+                    {
+                        if(equal(items_[it].value))
+                        {
+                            return items_[it].value;
+                        }
+                    }
+                }
+            }
+        }
+
+        return invalid;
+    }
+
+    void insert(const cell_key& key, uint32_t value)
+    {
+        auto h = hash(key);
+        auto slot = find_slot(h);
+        if(cells_[slot].head == invalid)
+        {
+            if((used_cells_ + 1) * 2 > cells_.size())
+            {
+                grow();
+                slot = find_slot(h);
+            }
+            used_cells_++;
+        }
+
+        auto& c = cells_[slot];
+        c.hash = h;
+        items_.push_back({value, c.head});
+        c.head = uint32_t(items_.size() - 1);
+    }
+
+private:
+    struct cell
+    {
+        uint64_t hash{};
+        uint32_t head{invalid};
+    };
+
+    struct item
+    {
+        uint32_t value{};
+        uint32_t next{invalid};
+    };
+
+    static auto hash(const cell_key& key) -> uint64_t
+    {
+        uint64_t h = uint64_t(key.x) * 0x9E3779B97F4A7C15ull;
+        h = (h ^ uint64_t(key.y)) * 0xC2B2AE3D27D4EB4Full;
+        h = (h ^ uint64_t(key.z)) * 0x165667B19E3779F9ull;
+        return h ^ (h >> 32);
+    }
+
+    auto quantize(float v) const -> int64_t
+    {
+        return std::isfinite(v) ? int64_t(std::floor(double(v) / cell_size_)) : 0;
+    }
+
+    void get_range(float v, int64_t base, int64_t& lo, int64_t& hi) const
+    {
+        lo = base;
+        hi = base;
+        if(!std::isfinite(v))
+        {
+            return;
+        }
+
+        if(double(v) - double(base) * cell_size_ <= tolerance_)
+        {
+            lo--;
+        }
+        if(double(base + 1) * cell_size_ - double(v) <= tolerance_)
+        {
+            hi++;
+        }
+    }
+
+    void grow()
+    {
+        auto cells = std::move(cells_);
+        cells_.clear();
+        cells_.resize(cells.size() * 2);
+        for(const auto& c : cells)
+        {
+            if(c.head != invalid)
+            {
+                cells_[find_slot(c.hash)] = c;
+            }
+        }
+    }
+
+    auto find_slot(uint64_t h) const -> size_t
+    {
+        const size_t mask = cells_.size() - 1;
+        size_t slot = size_t(h) & mask;
+        while(cells_[slot].head != invalid && cells_[slot].hash != h)
+        {
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    double tolerance_{};
+    double cell_size_{};
+    std::vector<cell> cells_;
+    std::vector<item> items_;
+    size_t used_cells_{};
+};
+
+/**
+ * @brief Open addressing table of directed edges between position ids.
+ *
+ * Inserting an edge that already exists replaces its face, matching the behaviour of the
+ * previous ordered edge tree.
+ */
+class edge_table
+{
+public:
+    static constexpr uint32_t invalid = 0xFFFFFFFF;
+
+    explicit edge_table(size_t count)
+    {
+        size_t capacity = 16;
+        while(capacity < count + count / 2)
+        {
+            capacity <<= 1;
+        }
+        keys_.resize(capacity, empty_key);
+        faces_.resize(capacity, invalid);
+    }
+
+    void insert(uint32_t from, uint32_t to, uint32_t face)
+    {
+        auto key = make_key(from, to);
+        auto slot = find_slot(key);
+        keys_[slot] = key;
+        faces_[slot] = face;
+    }
+
+    auto find(uint32_t from, uint32_t to) const -> uint32_t
+    {
+        return faces_[find_slot(make_key(from, to))];
+    }
+
+private:
+    static constexpr uint64_t empty_key = ~0ull;
+
+    static auto make_key(uint32_t from, uint32_t to) -> uint64_t
+    {
+        return (uint64_t(from) << 32) | uint64_t(to);
+    }
+
+    auto find_slot(uint64_t key) const -> size_t
+    {
+        uint64_t h = key * 0x9E3779B97F4A7C15ull;
+        h ^= h >> 32;
+
+        const size_t mask = keys_.size() - 1;
+        size_t slot = size_t(h) & mask;
+        while(keys_[slot] != empty_key && keys_[slot] != key)
+        {
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    std::vector<uint64_t> keys_;
+    std::vector<uint32_t> faces_;
+};
+
+/**
+ * @brief Builds triangle adjacency from vertex positions.
+ *
+ * Positions closer than epsilon share an id, then every directed edge is stored in a hash table
+ * and looked up in reverse to find the neighbouring face across it. The lookups are independent
+ * and run in parallel.
+ *
+ * @param get_face Fills the three vertex indices of a face. Returns false for faces to skip.
+ */
+template<typename GetFace>
+void build_adjacency(const uint8_t* positions,
+                     uint16_t vertex_stride,
+                     uint32_t vertex_count,
+                     uint32_t face_count,
+                     GetFace&& get_face,
+                     std::vector<uint32_t>& adjacency)
+{
+    auto get_position = [&](uint32_t index) -> const math::vec3&
+    {
+        return *reinterpret_cast<const math::vec3*>(positions + (index * vertex_stride));
+    };
+
+    // Give every distinct position an id.
+    const float tolerance = math::epsilon<float>();
+    position_grid grid(tolerance, vertex_count);
+
+    std::vector<uint32_t> position_ids(vertex_count);
+    for(uint32_t i = 0; i < vertex_count; ++i)
+    {
+        const auto& p = get_position(i);
+        auto cell = grid.get_cell(p);
+        auto match = grid.find(p,
+                               cell,
+                               [&](uint32_t candidate)
+                               {
+                                   const auto& c = get_position(candidate);
+                                   return math::all(math::lessThan(math::abs(p - c), math::vec3(tolerance)));
+                               });
+        if(match == position_grid::invalid)
+        {
+            grid.insert(cell, i);
+            position_ids[i] = i;
+        }
+        else
+        {
+            position_ids[i] = position_ids[match];
+        }
+    }
+
+    // Insert all edges into the edge table
+    edge_table edges(size_t(face_count) * 3);
+    for(uint32_t i = 0; i < face_count; ++i)
+    {
+        uint32_t face[3];
+        if(!get_face(i, face))
+        {
+            continue;
+        }
+
+        edges.insert(position_ids[face[0]], position_ids[face[1]], i);
+        edges.insert(position_ids[face[1]], position_ids[face[2]], i);
+        edges.insert(position_ids[face[2]], position_ids[face[0]], i);
+    }
+
+    // Size the output array.
+    adjacency.clear();
+    adjacency.resize(size_t(face_count) * 3, 0xFFFFFFFF);
+
+    // Now, find any adjacent edges for each triangle edge. The order of the edge
+    // vertices is swapped so that we find the matching ADJACENT edge rather than
+    // the same edge that we're currently processing.
+    std::vector<uint32_t> faces(face_count);
+    std::iota(faces.begin(), faces.end(), uint32_t(0));
+    std::for_each(std::execution::par,
+                  faces.begin(),
+                  faces.end(),
+                  [&](uint32_t i)
+                  {
+                      uint32_t face[3];
+                      if(!get_face(i, face))
+                      {
+                          return;
+                      }
+
+                      for(uint32_t e = 0; e < 3; ++e)
+                      {
+                          auto from = position_ids[face[e]];
+                          auto to = position_ids[face[(e + 1) % 3]];
+                          adjacency[(i * 3) + e] = edges.find(to, from);
+                      }
+                  });
+}
+
+// Tests a cluster against a view. The cone test is only valid when the world transform keeps
+// angles, so it is skipped for non uniform scales and mirrors.
+auto is_cluster_visible(const mesh::cluster& cluster,
+                        const math::mat4& world,
+                        float scale,
+                        bool test_cone,
+                        const mesh::cluster_cull_view& view) -> bool
+{
+    const auto center = math::vec3(world * math::vec4(cluster.center, 1.0f));
+    const float radius = cluster.radius * scale;
+
+    if(!view.frustum.test_sphere(math::bsphere(center, radius)))
+    {
+        return false;
+    }
+
+    if(test_cone && cluster.cone_cutoff < 1.0f)
+    {
+        const auto axis = math::vec3(world * math::vec4(cluster.cone_axis, 0.0f)) / scale;
+        const auto to_center = center - view.position;
+        if(math::dot(to_center, axis) >= cluster.cone_cutoff * math::length(to_center) + radius)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Rounds the weights to byte steps that still sum to 255, otherwise the blended transform
+// picks up a scale that grows with the distance from the origin. The result is meant to be
+// packed as is into a normalized byte attribute.
+void quantize_blend_weights(math::vec4& weights)
+{
+    float sum = weights.x + weights.y + weights.z + weights.w;
+    if(sum <= 0.0f)
+    {
+        return;
+    }
+
+    int total = 0;
+    int largest = 0;
+    std::array<int, 4> steps{};
+    for(int i = 0; i < 4; ++i)
+    {
+        steps[i] = static_cast<int>(std::lround(weights[i] / sum * 255.0f));
+        total += steps[i];
+        if(steps[i] > steps[largest])
+        {
+            largest = i;
+        }
+    }
+
+    // The rounding error is at most two steps, give it to the dominant influence.
+    steps[largest] += 255 - total;
+
+    for(int i = 0; i < 4; ++i)
+    {
+        weights[i] = static_cast<float>(steps[i]);
+    }
+}
+
 } // namespace
 
 mesh::mesh() : hardware_vb_(std::make_shared<gfx::vertex_buffer>()), hardware_ib_(std::make_shared<gfx::index_buffer>())
@@ -134,6 +605,9 @@ void mesh::dispose()
     mesh_submeshes_.clear();
     // submesh_lookup_.clear();
     data_groups_.clear();
+    clusters_.clear();
+    submesh_clusters_.clear();
+    collision_ = {};
 
     // Release bone palettes and skin data (if any)
     bone_palettes_.clear();
@@ -320,6 +794,43 @@ auto mesh::set_submeshes(const std::vector<submesh>& submeshes) -> bool
     return true;
 }
 
+auto mesh::set_clusters(std::vector<cluster>&& clusters) -> bool
+{
+    // We can only do this if we are in the process of preparing the mesh
+    if(prepare_status_ != mesh_status::preparing)
+    {
+        APPLOG_ERROR("Attempting to set mesh clusters without first calling "
+                     "'prepareMesh' is not allowed.\n");
+        return false;
+
+    } // End if not preparing
+
+    clusters_ = std::move(clusters);
+    submesh_clusters_.clear();
+    submesh_clusters_.resize(preparation_data_.submeshes.size(), {0, 0});
+
+    for(uint32_t i = 0; i < uint32_t(clusters_.size()); ++i)
+    {
+        const auto& cluster = clusters_[i];
+        if(cluster.submesh_index >= submesh_clusters_.size())
+        {
+            APPLOG_ERROR("Mesh cluster references submesh {0} out of {1}.", cluster.submesh_index, submesh_clusters_.size());
+            clusters_.clear();
+            submesh_clusters_.clear();
+            return false;
+        }
+
+        auto& range = submesh_clusters_[cluster.submesh_index];
+        if(range.second == 0)
+        {
+            range.first = i;
+        }
+        range.second++;
+    }
+
+    return true;
+}
+
 auto mesh::set_primitives(triangle_array_t&& triangles) -> bool
 {
     // APPLOG_TRACE_PERF(std::chrono::milliseconds);
@@ -599,16 +1110,32 @@ auto mesh::bind_skin(const skin_bind_data& bind_data) -> bool
     gfx::vertex_layout original_format = vertex_format_;
     bool has_weights = new_format.has(gfx::attribute::Weight);
     bool has_indices = new_format.has(gfx::attribute::Indices);
+    // Compressed meshes store the palette index and weight of each influence in a byte.
+    bool compressed = has_compressed_vertices();
     if(!has_weights || !has_indices)
     {
         new_format.m_hash = 0;
         if(!has_weights)
         {
-            new_format.add(gfx::attribute::Weight, 4, gfx::attribute_type::Float);
+            if(compressed)
+            {
+                new_format.add(gfx::attribute::Weight, 4, gfx::attribute_type::Uint8, true);
+            }
+            else
+            {
+                new_format.add(gfx::attribute::Weight, 4, gfx::attribute_type::Float);
+            }
         }
         if(!has_indices)
         {
-            new_format.add(gfx::attribute::Indices, 4, gfx::attribute_type::Float, false, true);
+            if(compressed)
+            {
+                new_format.add(gfx::attribute::Indices, 4, gfx::attribute_type::Uint8, false, true);
+            }
+            else
+            {
+                new_format.add(gfx::attribute::Indices, 4, gfx::attribute_type::Float, false, true);
+            }
         }
 
         new_format.end();
@@ -689,6 +1216,11 @@ auto mesh::bind_skin(const skin_bind_data& bind_data) -> bool
                 blend_weights[static_cast<math::vec4::length_type>(j)] = data.weights[j];
             }
 
+            if(compressed)
+            {
+                quantize_blend_weights(blend_weights);
+            }
+
             gfx::vertex_pack(math::value_ptr(blend_weights),
                              false,
                              gfx::attribute::Weight,
@@ -730,6 +1262,8 @@ auto mesh::load_mesh(load_data&& data) -> bool
     result &= set_vertex_source(std::move(data.vertex_data), data.vertex_count, data.vertex_format);
     result &= set_primitives(std::move(data.triangle_data));
     result &= set_submeshes(data.submeshes);
+    result &= set_clusters(std::move(data.clusters));
+    set_collision_data(std::move(data.collision));
     result &= bind_skin(data.skin_data);
     result &= bind_armature(data.root_node);
     result &= end_prepare();
@@ -1130,8 +1664,11 @@ void mesh::build_ib(bool hardware_copy)
 
 auto mesh::generate_adjacency(std::vector<uint32_t>& adjacency) -> bool
 {
-    std::map<adjacent_edge_key, uint32_t> edge_tree;
-    std::map<adjacent_edge_key, uint32_t>::iterator it_edge;
+    APPLOG_TRACE_PERF_NAMED(std::chrono::milliseconds, "Mesh Generate Adjacency");
+
+    // Retrieve useful data offset information.
+    uint16_t position_offset = vertex_format_.getOffset(gfx::attribute::Position);
+    uint16_t vertex_stride = vertex_format_.getStride();
 
     // What is the status of the mesh?
     if(prepare_status_ != mesh_status::prepared)
@@ -1142,108 +1679,25 @@ auto mesh::generate_adjacency(std::vector<uint32_t>& adjacency) -> bool
             return false;
         }
 
-        // Retrieve useful data offset information.
-        uint16_t position_offset = vertex_format_.getOffset(gfx::attribute::Position);
-        uint16_t vertex_stride = vertex_format_.getStride();
-
-        // Insert all edges into the edge tree
-        uint8_t* src_vertices_ptr = preparation_data_.vertex_data.data() + position_offset;
-        for(uint32_t i = 0; i < preparation_data_.triangle_count; ++i)
-        {
-            adjacent_edge_key edge;
-
-            // Degenerate triangles cannot participate.
-            const triangle& tri = preparation_data_.triangle_data[i];
-            if(tri.flags & triangle_flags::degenerate)
-                continue;
-
-            // Retrieve positions of each referenced vertex.
-            const math::vec3* v1 =
-                reinterpret_cast<const math::vec3*>(src_vertices_ptr + (tri.indices[0] * vertex_stride));
-            const math::vec3* v2 =
-                reinterpret_cast<const math::vec3*>(src_vertices_ptr + (tri.indices[1] * vertex_stride));
-            const math::vec3* v3 =
-                reinterpret_cast<const math::vec3*>(src_vertices_ptr + (tri.indices[2] * vertex_stride));
-
-            // edge 1
-            edge.vertex1 = v1;
-            edge.vertex2 = v2;
-            edge_tree[edge] = i;
-
-            // edge 2
-            edge.vertex1 = v2;
-            edge.vertex2 = v3;
-            edge_tree[edge] = i;
-
-            // edge 3
-            edge.vertex1 = v3;
-            edge.vertex2 = v1;
-            edge_tree[edge] = i;
-
-        } // Next Face
-
-        // Size the output array.
-        adjacency.resize(preparation_data_.triangle_count * 3, 0xFFFFFFFF);
-
-        // Now, find any adjacent edges for each triangle edge
-        for(uint32_t i = 0; i < preparation_data_.triangle_count; ++i)
-        {
-            adjacent_edge_key edge;
-
-            // Degenerate triangles cannot participate.
-            const triangle& tri = preparation_data_.triangle_data[i];
-            if(tri.flags & triangle_flags::degenerate)
-            {
-                continue;
-            }
-
-            // Retrieve positions of each referenced vertex.
-            const math::vec3* v1 =
-                reinterpret_cast<const math::vec3*>(src_vertices_ptr + (tri.indices[0] * vertex_stride));
-            const math::vec3* v2 =
-                reinterpret_cast<const math::vec3*>(src_vertices_ptr + (tri.indices[1] * vertex_stride));
-            const math::vec3* v3 =
-                reinterpret_cast<const math::vec3*>(src_vertices_ptr + (tri.indices[2] * vertex_stride));
-
-            // Note: Notice below that the order of the edge vertices
-            //       is swapped. This is because we want to find the
-            //       matching ADJACENT edge, rather than simply finding
-            //       the same edge that we're currently processing.
-
-            // edge 1
-            edge.vertex2 = v1;
-            edge.vertex1 = v2;
-
-            // Find the matching adjacent edge
-            it_edge = edge_tree.find(edge);
-            if(it_edge != edge_tree.end())
-            {
-                adjacency[(i * 3)] = it_edge->second;
-            }
-
-            // edge 2
-            edge.vertex2 = v2;
-            edge.vertex1 = v3;
-
-            // Find the matching adjacent edge
-            it_edge = edge_tree.find(edge);
-            if(it_edge != edge_tree.end())
-            {
-                adjacency[(i * 3) + 1] = it_edge->second;
-            }
-
-            // edge 3
-            edge.vertex2 = v3;
-            edge.vertex1 = v1;
-
-            // Find the matching adjacent edge
-            it_edge = edge_tree.find(edge);
-            if(it_edge != edge_tree.end())
-            {
-                adjacency[(i * 3) + 2] = it_edge->second;
-            }
+        build_adjacency(preparation_data_.vertex_data.data() + position_offset,
+                        vertex_stride,
+                        preparation_data_.vertex_count,
+                        preparation_data_.triangle_count,
+                        [&](uint32_t i, uint32_t(&face)[3])
+                        {
+                            // Degenerate triangles cannot participate.
+                            const triangle& tri = preparation_data_.triangle_data[i];
+                            if(tri.flags & triangle_flags::degenerate)
+                            {
+                                return false;
+                            }
 
-        } // Next Face
+                            face[0] = tri.indices[0];
+                            face[1] = tri.indices[1];
+                            face[2] = tri.indices[2];
+                            return true;
+                        },
+                        adjacency);
 
     } // End if not prepared
     else
@@ -1254,98 +1708,19 @@ auto mesh::generate_adjacency(std::vector<uint32_t>& adjacency) -> bool
             return false;
         }
 
-        // Retrieve useful data offset information.
-        uint16_t position_offset = vertex_format_.getOffset(gfx::attribute::Position);
-        uint16_t vertex_stride = vertex_format_.getStride();
-
-        // Insert all edges into the edge tree
-        uint8_t* src_vertices_ptr = system_vb_ + position_offset;
-        uint32_t* src_indices_ptr = system_ib_;
-        for(uint32_t i = 0; i < face_count_; ++i, src_indices_ptr += 3)
-        {
-            adjacent_edge_key edge;
-
-            // Retrieve positions of each referenced vertex.
-            const auto* v1 =
-                reinterpret_cast<const math::vec3*>(src_vertices_ptr + (src_indices_ptr[0] * vertex_stride));
-            const auto* v2 =
-                reinterpret_cast<const math::vec3*>(src_vertices_ptr + (src_indices_ptr[1] * vertex_stride));
-            const auto* v3 =
-                reinterpret_cast<const math::vec3*>(src_vertices_ptr + (src_indices_ptr[2] * vertex_stride));
-
-            // edge 1
-            edge.vertex1 = v1;
-            edge.vertex2 = v2;
-            edge_tree[edge] = i;
-
-            // edge 2
-            edge.vertex1 = v2;
-            edge.vertex2 = v3;
-            edge_tree[edge] = i;
-
-            // edge 3
-            edge.vertex1 = v3;
-            edge.vertex2 = v1;
-            edge_tree[edge] = i;
-
-        } // Next Face
-
-        // Size the output array.
-        adjacency.resize(face_count_ * 3, 0xFFFFFFFF);
-
-        // Now, find any adjacent edges for each triangle edge
-        src_indices_ptr = system_ib_;
-        for(uint32_t i = 0; i < face_count_; ++i, src_indices_ptr += 3)
-        {
-            adjacent_edge_key edge;
-
-            // Retrieve positions of each referenced vertex.
-            const math::vec3* v1 =
-                reinterpret_cast<const math::vec3*>(src_vertices_ptr + (src_indices_ptr[0] * vertex_stride));
-            const math::vec3* v2 =
-                reinterpret_cast<const math::vec3*>(src_vertices_ptr + (src_indices_ptr[1] * vertex_stride));
-            const math::vec3* v3 =
-                reinterpret_cast<const math::vec3*>(src_vertices_ptr + (src_indices_ptr[2] * vertex_stride));
-
-            // Note: Notice below that the order of the edge vertices
-            //       is swapped. This is because we want to find the
-            //       matching ADJACENT edge, rather than simply finding
-            //       the same edge that we're currently processing.
-
-            // edge 1
-            edge.vertex2 = v1;
-            edge.vertex1 = v2;
-
-            // Find the matching adjacent edge
-            it_edge = edge_tree.find(edge);
-            if(it_edge != edge_tree.end())
-            {
-                adjacency[(i * 3)] = it_edge->second;
-            }
-
-            // edge 2
-            edge.vertex2 = v2;
-            edge.vertex1 = v3;
-
-            // Find the matching adjacent edge
-            it_edge = edge_tree.find(edge);
-            if(it_edge != edge_tree.end())
-            {
-                adjacency[(i * 3) + 1] = it_edge->second;
-            }
-
-            // edge 3
-            edge.vertex2 = v3;
-            edge.vertex1 = v1;
-
-            // Find the matching adjacent edge
-            it_edge = edge_tree.find(edge);
-            if(it_edge != edge_tree.end())
-            {
-                adjacency[(i * 3) + 2] = it_edge->second;
-            }
-
-        } // Next Face
+        build_adjacency(system_vb_ + position_offset,
+                        vertex_stride,
+                        vertex_count_,
+                        face_count_,
+                        [&](uint32_t i, uint32_t(&face)[3])
+                        {
+                            const uint32_t* src_indices_ptr = system_ib_ + (i * 3);
+                            face[0] = src_indices_ptr[0];
+                            face[1] = src_indices_ptr[1];
+                            face[2] = src_indices_ptr[2];
+                            return true;
+                        },
+                        adjacency);
 
     } // End if prepared
 
@@ -1396,6 +1771,32 @@ auto mesh::get_vertex_format() const -> const gfx::vertex_layout&
     return vertex_format_;
 }
 
+auto mesh::has_compressed_vertices() const -> bool
+{
+    if(!vertex_format_.has(gfx::attribute::Position))
+    {
+        return false;
+    }
+
+    uint8_t num{};
+    gfx::attribute_type type{};
+    bool normalized{};
+    bool as_int{};
+    vertex_format_.decode(gfx::attribute::Position, num, type, normalized, as_int);
+    return type == gfx::attribute_type::Int16;
+}
+
+auto mesh::get_dequantize_transform(const math::bbox& bounds) -> math::mat4
+{
+    const auto extents = bounds.get_extents();
+    const float scale =
+        math::max(math::max(extents.x, extents.y), math::max(extents.z, std::numeric_limits<float>::epsilon()));
+
+    math::mat4 result(scale);
+    result[3] = math::vec4(bounds.get_center(), 1.0f);
+    return result;
+}
+
 auto mesh::get_skin_bind_data() const -> const skin_bind_data&
 {
     return skin_bind_data_;
@@ -1445,6 +1846,27 @@ auto mesh::get_submeshes() const -> const submesh_array_t&
     return mesh_submeshes_;
 }
 
+auto mesh::get_submesh_clusters(size_t submesh_index) const -> hpp::span<const cluster>
+{
+    if(submesh_index >= submesh_clusters_.size())
+    {
+        return {};
+    }
+
+    const auto& range = submesh_clusters_[submesh_index];
+    return {clusters_.data() + range.first, range.second};
+}
+
+void mesh::set_collision_data(collision_data&& collision)
+{
+    collision_ = std::move(collision);
+}
+
+auto mesh::get_collision_data() const -> const collision_data&
+{
+    return collision_;
+}
+
 auto mesh::get_submeshes_count() const -> size_t
 {
     return mesh_submeshes_.size();
@@ -1533,142 +1955,11 @@ auto mesh::get_data_groups_count() const -> size_t
     return 0;
 }
 
-auto operator<(const mesh::adjacent_edge_key& key1, const mesh::adjacent_edge_key& key2) -> bool
-{
-    // Test vertex positions.
-    if(math::epsilonNotEqual(key1.vertex1->x, key2.vertex1->x, math::epsilon<float>()))
-    {
-        return (key2.vertex1->x < key1.vertex1->x);
-    }
-    if(math::epsilonNotEqual(key1.vertex1->y, key2.vertex1->y, math::epsilon<float>()))
-    {
-        return (key2.vertex1->y < key1.vertex1->y);
-    }
-    if(math::epsilonNotEqual(key1.vertex1->z, key2.vertex1->z, math::epsilon<float>()))
-    {
-        return (key2.vertex1->z < key1.vertex1->z);
-    }
-
-    if(math::epsilonNotEqual(key1.vertex2->x, key2.vertex2->x, math::epsilon<float>()))
-    {
-        return (key2.vertex2->x < key1.vertex2->x);
-    }
-    if(math::epsilonNotEqual(key1.vertex2->y, key2.vertex2->y, math::epsilon<float>()))
-    {
-        return (key2.vertex2->y < key1.vertex2->y);
-    }
-    if(math::epsilonNotEqual(key1.vertex2->z, key2.vertex2->z, math::epsilon<float>()))
-    {
-        return (key2.vertex2->z < key1.vertex2->z);
-    }
-
-    // Exactly equal
-    return false;
-}
-
 auto operator<(const mesh::mesh_submesh_key& key1, const mesh::mesh_submesh_key& key2) -> bool
 {
     return key1.data_group_id < key2.data_group_id;
 }
 
-auto operator<(const mesh::weld_key& key1, const mesh::weld_key& key2) -> bool
-{
-    auto vertex_compare =
-        [](const uint8_t* pVtx1, const uint8_t* pVtx2, const gfx::vertex_layout& layout, float tolerance) -> int
-    {
-        float diff{};
-        int ndifference{};
-
-        for(uint16_t i = 0; i < gfx::attribute::Count; ++i)
-        {
-            if(!layout.has(static_cast<gfx::attribute>(i)))
-            {
-                continue; // Skip attributes not present in this layout.
-            }
-
-            // Get the offset for this attribute in the vertex data
-            uint16_t offset = layout.getOffset(static_cast<gfx::attribute>(i));
-
-            // Retrieve the vertex data pointers
-            const uint8_t* p1 = pVtx1 + offset;
-            const uint8_t* p2 = pVtx2 + offset;
-
-            // Decode the attribute information
-            uint8_t num_components{};
-            bgfx::AttribType::Enum type{};
-            bool normalized{}, as_int{};
-            layout.decode(static_cast<gfx::attribute>(i), num_components, type, normalized, as_int);
-
-            // Compare the attributes based on the type
-            switch(type)
-            {
-                case bgfx::AttribType::Float:
-                {
-                    for(uint8_t j = 0; j < num_components; ++j)
-                    {
-                        diff = ((float*)p1)[j] - ((float*)p2)[j];
-                        if(fabsf(diff) > tolerance)
-                            return (diff < 0) ? -1 : 1;
-                    }
-                    break;
-                }
-
-                case bgfx::AttribType::Uint8:
-                case bgfx::AttribType::Int16:
-                {
-                    if(as_int)
-                    {
-                        ndifference = memcmp(p1, p2, num_components * (type == bgfx::AttribType::Uint8 ? 1 : 2));
-                        if(ndifference != 0)
-                        {
-                            return (ndifference < 0) ? -1 : 1;
-                        }
-                    }
-                    else
-                    {
-                        for(uint8_t j = 0; j < num_components; ++j)
-                        {
-                            float f1{}, f2{};
-                            if(type == bgfx::AttribType::Uint8)
-                            {
-                                f1 = normalized ? ((float)p1[j] / 255.0f) : (float)p1[j];
-                                f2 = normalized ? ((float)p2[j] / 255.0f) : (float)p2[j];
-                            }
-                            else // Int16
-                            {
-                                f1 = normalized ? ((float)((int16_t*)p1)[j] / 32767.0f) : (float)((int16_t*)p1)[j];
-                                f2 = normalized ? ((float)((int16_t*)p2)[j] / 32767.0f) : (float)((int16_t*)p2)[j];
-                            }
-                            diff = f1 - f2;
-                            if(fabsf(diff) > tolerance)
-                            {
-                                return (diff < 0) ? -1 : 1;
-                            }
-                        }
-                    }
-                    break;
-                }
-
-                default:
-                    // Handle other types if necessary.
-                    break;
-            }
-        }
-
-        // Both vertices are equal for the purposes of this test.
-        return 0;
-    };
-
-    int ndifference = vertex_compare(key1.vertex, key2.vertex, key1.format, key1.tolerance);
-    if(ndifference != 0)
-    {
-        return (ndifference < 0);
-    }
-
-    // Exactly equal
-    return false;
-}
-
 auto operator<(const mesh::bone_combination_key& key1, const mesh::bone_combination_key& key2) -> bool
 {
     // Data group id must match.
@@ -2257,36 +2548,60 @@ auto mesh::generate_vertex_tangents() -> bool
 
 auto mesh::weld_vertices(float tolerance, std::vector<uint32_t>* vertex_remap_ptr /* = nullptr */) -> bool
 {
-    weld_key key;
-    std::map<weld_key, uint32_t> vertex_tree;
-    std::map<weld_key, uint32_t>::const_iterator it_key;
+    APPLOG_TRACE_PERF_NAMED(std::chrono::milliseconds, "Mesh Weld Vertices");
+
+    const uint32_t vertex_count = preparation_data_.vertex_count;
     byte_array_t new_vertex_data, new_vertex_flags;
     uint32_t new_vertex_count = 0;
 
     // Allocate enough space to build the remap array for the existing vertices
     if(vertex_remap_ptr)
     {
-        vertex_remap_ptr->resize(preparation_data_.vertex_count);
+        vertex_remap_ptr->resize(vertex_count);
     }
-    auto collapse_map = new uint32_t[preparation_data_.vertex_count];
+    std::vector<uint32_t> collapse_map(vertex_count);
 
     // Retrieve useful data offset information.
+    bool has_position = vertex_format_.has(gfx::attribute::Position);
+    uint16_t position_offset = vertex_format_.getOffset(gfx::attribute::Position);
     uint16_t vertex_stride = vertex_format_.getStride();
+    const uint8_t* src_vertices_ptr = preparation_data_.vertex_data.data();
 
-    // For each vertex to be welded.
-    for(uint32_t i = 0; i < preparation_data_.vertex_count; ++i)
+    auto get_position = [&](uint32_t index) -> math::vec3
     {
-        // Build a new key structure for inserting
-        key.vertex = (&preparation_data_.vertex_data[0]) + (i * vertex_stride);
-        key.format = vertex_format_;
-        key.tolerance = tolerance;
+        if(!has_position)
+        {
+            return {};
+        }
+        return *reinterpret_cast<const math::vec3*>(src_vertices_ptr + (index * vertex_stride) + position_offset);
+    };
+
+    // Only vertices sharing a position within tolerance can be welded, so candidates
+    // come from a spatial hash instead of a search over every vertex.
+    position_grid grid(tolerance, vertex_count);
 
-        // Does a vertex with matching details already exist in the tree.
-        it_key = vertex_tree.find(key);
-        if(it_key == vertex_tree.end())
+    new_vertex_data.reserve(preparation_data_.vertex_data.size());
+    new_vertex_flags.reserve(vertex_count);
+
+    // For each vertex to be welded.
+    for(uint32_t i = 0; i < vertex_count; ++i)
+    {
+        const uint8_t* vertex = src_vertices_ptr + (i * vertex_stride);
+        auto position = get_position(i);
+        auto cell = grid.get_cell(position);
+
+        // Does a vertex with matching details already exist (value = OLD index of vertex).
+        auto match = grid.find(position,
+                               cell,
+                               [&](uint32_t candidate)
+                               {
+                                   const uint8_t* other = src_vertices_ptr + (candidate * vertex_stride);
+                                   return compare_vertices(vertex, other, vertex_format_, tolerance) == 0;
+                               });
+        if(match == position_grid::invalid)
         {
-            // No matching vertex. Insert into the tree (value = NEW index of vertex).
-            vertex_tree[key] = new_vertex_count;
+            // No matching vertex. Insert into the grid.
+            grid.insert(cell, i);
             collapse_map[i] = new_vertex_count;
             if(vertex_remap_ptr)
             {
@@ -2294,8 +2609,7 @@ auto mesh::weld_vertices(float tolerance, std::vector<uint32_t>* vertex_remap_pt
             }
 
             // Store the vertex in the new buffer
-            new_vertex_data.resize((new_vertex_count + 1) * vertex_stride);
-            std::memcpy(&new_vertex_data[new_vertex_count * vertex_stride], key.vertex, vertex_stride);
+            new_vertex_data.insert(new_vertex_data.end(), vertex, vertex + vertex_stride);
             new_vertex_flags.push_back(preparation_data_.vertex_flags[i]);
             new_vertex_count++;
 
@@ -2304,7 +2618,7 @@ auto mesh::weld_vertices(float tolerance, std::vector<uint32_t>* vertex_remap_pt
         {
             // A vertex already existed at this location.
             // Just mark the 'collapsed' index for this vertex in the remap array.
-            collapse_map[i] = it_key->second;
+            collapse_map[i] = collapse_map[match];
             if(vertex_remap_ptr)
             {
                 (*vertex_remap_ptr)[i] = 0xFFFFFFFF;
@@ -2315,10 +2629,8 @@ auto mesh::weld_vertices(float tolerance, std::vector<uint32_t>* vertex_remap_pt
     } // Next Vertex
 
     // If nothing was welded, just bail
-    if(preparation_data_.vertex_count == new_vertex_count)
+    if(vertex_count == new_vertex_count)
     {
-        checked_array_delete(collapse_map);
-
         if(vertex_remap_ptr)
         {
             vertex_remap_ptr->clear();
@@ -2328,26 +2640,20 @@ auto mesh::weld_vertices(float tolerance, std::vector<uint32_t>* vertex_remap_pt
     } // End if nothing to do
 
     // Otherwise, replace the old preparation vertices and remap
-    preparation_data_.vertex_data.clear();
-    preparation_data_.vertex_data.resize(new_vertex_data.size());
-    std::memcpy(preparation_data_.vertex_data.data(), new_vertex_data.data(), new_vertex_data.size());
-    preparation_data_.vertex_flags.clear();
-    preparation_data_.vertex_flags.resize(new_vertex_flags.size());
-    std::memcpy(preparation_data_.vertex_flags.data(), new_vertex_flags.data(), new_vertex_flags.size());
+    preparation_data_.vertex_data = std::move(new_vertex_data);
+    preparation_data_.vertex_flags = std::move(new_vertex_flags);
     preparation_data_.vertex_count = new_vertex_count;
 
     // Now remap all the triangle indices
-    for(uint32_t i = 0; i < preparation_data_.triangle_count; ++i)
-    {
-        triangle& tri = preparation_data_.triangle_data[i];
-        tri.indices[0] = collapse_map[tri.indices[0]];
-        tri.indices[1] = collapse_map[tri.indices[1]];
-        tri.indices[2] = collapse_map[tri.indices[2]];
-
-    } // Next triangle
-
-    // Clean up
-    checked_array_delete(collapse_map);
+    std::for_each(std::execution::par,
+                  preparation_data_.triangle_data.begin(),
+                  preparation_data_.triangle_data.begin() + preparation_data_.triangle_count,
+                  [&](triangle& tri)
+                  {
+                      tri.indices[0] = collapse_map[tri.indices[0]];
+                      tri.indices[1] = collapse_map[tri.indices[1]];
+                      tri.indices[2] = collapse_map[tri.indices[2]];
+                  });
 
     // Success!
     return true;
@@ -2551,22 +2857,43 @@ auto bone_palette::get_skinning_matrices(const std::vector<math::mat4>& node_tra
     // be referenced by the palette's bone index list.
     const auto& bind_list = bind_data.get_bones();
 
-    // Compute transformation matrix for each bone in the palette
-    auto count = std::min(bones_.size(), node_transforms.size());
     thread_local static std::vector<math::mat4> skinning_transforms_;
-    skinning_transforms_.resize(bones_.size(), math::identity<math::mat4>());
+    skinning_transforms_.resize(bones_.size());
+    compute_skinning_matrices(node_transforms, bind_data, skinning_transforms_.data());
 
-    for(size_t i = 0; i < count; ++i)
+    return skinning_transforms_;
+}
+
+void bone_palette::compute_skinning_matrices(const std::vector<math::mat4>& node_transforms,
+                                             const skin_bind_data& bind_data,
+                                             math::mat4* out) const
+{
+    // Retrieve the main list of bones from the skin bind data that will
+    // be referenced by the palette's bone index list.
+    const auto& bind_list = bind_data.get_bones();
+
+    // Compute transformation matrix for each bone in the palette. Every column of the product
+    // is a weighted sum of the bone matrix columns, which maps directly onto vec4 SIMD lanes.
+    for(size_t i = 0; i < bones_.size(); ++i)
     {
         auto bone = bones_[i];
-        const auto& bone_transform = node_transforms[bone];
-        const auto& bone_data = bind_list[bone];
-        auto& transform = skinning_transforms_[i];
-        transform = bone_transform * bone_data.bind_pose_transform.get_matrix();
+        if(bone >= node_transforms.size() || bone >= bind_list.size())
+        {
+            out[i] = math::identity<math::mat4>();
+            continue;
+        }
 
-    } // Next Bone
+        const auto& a = node_transforms[bone];
+        const auto& b = bind_list[bone].bind_pose_transform.get_matrix();
+        auto& result = out[i];
 
-    return skinning_transforms_;
+        for(int column = 0; column < 4; ++column)
+        {
+            const auto& c = b[column];
+            result[column] = a[0] * c.x + a[1] * c.y + a[2] * c.z + a[3] * c.w;
+        }
+
+    } // Next Bone
 }
 
 void bone_palette::assign_bones(bone_index_map_t& bones, std::vector<uint32_t>& faces)
@@ -2848,6 +3175,86 @@ void mesh::bind_render_buffers_for_submesh(const submesh* submesh)
     } // End if software only copy
 }
 
+auto mesh::bind_render_buffers_for_submesh(size_t submesh_index,
+                                           const math::mat4& world,
+                                           const cluster_cull_view& view,
+                                           bool backface_culled) -> bool
+{
+    const auto* submesh = mesh_submeshes_[submesh_index];
+    auto clusters = get_submesh_clusters(submesh_index);
+    if(clusters.empty() || !hardware_mesh_)
+    {
+        bind_render_buffers_for_submesh(submesh);
+        return true;
+    }
+
+    const float scale_x = math::length(math::vec3(world[0]));
+    const float scale_y = math::length(math::vec3(world[1]));
+    const float scale_z = math::length(math::vec3(world[2]));
+    const float scale = math::max(scale_x, math::max(scale_y, scale_z));
+    const float tolerance = scale * 0.001f;
+    const bool uniform_scale =
+        math::abs(scale_x - scale_y) <= tolerance && math::abs(scale_x - scale_z) <= tolerance;
+    const bool test_cone = backface_culled && uniform_scale && math::determinant(math::mat3(world)) > 0.0f;
+
+    // Visible runs of the index buffer, adjacent clusters are merged.
+    thread_local std::vector<std::pair<uint32_t, uint32_t>> runs;
+    runs.clear();
+    uint32_t visible_faces = 0;
+    for(const auto& cluster : clusters)
+    {
+        if(!is_cluster_visible(cluster, world, scale, test_cone, view))
+        {
+            continue;
+        }
+
+        if(!runs.empty() && runs.back().first + runs.back().second == cluster.face_start)
+        {
+            runs.back().second += cluster.face_count;
+        }
+        else
+        {
+            runs.emplace_back(cluster.face_start, cluster.face_count);
+        }
+        visible_faces += cluster.face_count;
+    }
+
+    if(runs.empty())
+    {
+        return false;
+    }
+
+    auto vb = std::static_pointer_cast<gfx::vertex_buffer>(hardware_vb_);
+    auto ib = std::static_pointer_cast<gfx::index_buffer>(hardware_ib_);
+    gfx::set_vertex_buffer(0, vb->native_handle());
+
+    if(runs.size() == 1)
+    {
+        gfx::set_index_buffer(ib->native_handle(), runs.front().first * 3, runs.front().second * 3);
+        return true;
+    }
+
+    uint32_t index_count = visible_faces * 3;
+    if(index_count != gfx::get_avail_transient_index_buffer(index_count, true))
+    {
+        // Out of transient memory, draw everything.
+        gfx::set_index_buffer(ib->native_handle(), submesh->face_start * 3, submesh->face_count * 3);
+        return true;
+    }
+
+    gfx::transient_index_buffer tib;
+    gfx::alloc_transient_index_buffer(&tib, index_count, true);
+    auto* dst = reinterpret_cast<uint32_t*>(tib.data);
+    for(const auto& run : runs)
+    {
+        std::memcpy(dst, system_ib_ + size_t(run.first) * 3, size_t(run.second) * 3 * sizeof(uint32_t));
+        dst += size_t(run.second) * 3;
+    }
+    gfx::set_index_buffer(&tib, 0, index_count);
+
+    return true;
+}
+
 void mesh::build_optimized_index_buffer(const submesh* submesh,
                                         uint32_t* src_buffer_ptr,
                                         uint32_t* dest_buffer_ptr,
@@ -195,6 +195,17 @@ public:
     auto get_skinning_matrices(const std::vector<math::mat4>& node_transforms, const skin_bind_data& bind_data) const
         -> const std::vector<math::mat4>&;
 
+    /**
+     * @brief Writes the skinning matrices of this palette to external storage.
+     *
+     * @param node_transforms The world transforms of the bones, indexed like the skin bind data.
+     * @param bind_data The skin bind data.
+     * @param out Receives one matrix per bone of the palette, see get_bones.
+     */
+    void compute_skinning_matrices(const std::vector<math::mat4>& node_transforms,
+                                   const skin_bind_data& bind_data,
+                                   math::mat4* out) const;
+
     /**
      * @brief Determines the relevant "fit" information that can be used to discover if and how the specified
      * combination of bones will fit into this palette.
@@ -333,6 +344,58 @@ public:
         bool skinned{};
     };
 
+    /**
+     * @brief A small batch of neighbouring triangles of a submesh with bounds for culling, so only the
+     * visible parts of large submeshes get drawn.
+     */
+    struct cluster
+    {
+        ///< Index of the submesh that owns the cluster.
+        uint32_t submesh_index{0};
+        ///< The initial face, from the index buffer, of the cluster.
+        uint32_t face_start{0};
+        ///< Number of faces in the cluster.
+        uint32_t face_count{0};
+        ///< Bounding sphere of the cluster in mesh space.
+        math::vec3 center{};
+        float radius{0.0f};
+        ///< Average direction of the face normals.
+        math::vec3 cone_axis{0.0f, 0.0f, 1.0f};
+        ///< Sine of the largest angle between a face normal and the axis. 1 if the cone can't be culled.
+        float cone_cutoff{1.0f};
+    };
+
+    /**
+     * @brief Collision geometry baked from the mesh at import, used by mesh colliders.
+     */
+    struct collision_data
+    {
+        ///< Positions of the triangle mesh, welded across seams.
+        std::vector<math::vec3> vertices;
+        ///< Triangle list indexing vertices, without degenerate triangles.
+        std::vector<uint32_t> indices;
+        ///< Points of the convex hull, reduced to the import vertex budget.
+        std::vector<math::vec3> hull;
+        ///< Quantized bvh over the triangles, serialized in place by Bullet. Built at load when empty.
+        std::vector<uint8_t> bvh;
+
+        auto empty() const -> bool
+        {
+            return indices.empty() && hull.empty();
+        }
+    };
+
+    /**
+     * @brief View used to cull clusters, in world space.
+     */
+    struct cluster_cull_view
+    {
+        ///< The view frustum.
+        math::frustum frustum;
+        ///< The view position, used to skip clusters facing away from it.
+        math::vec3 position{};
+    };
+
     struct info
     {
         ///< Total number of vertices.
@@ -343,6 +406,10 @@ public:
         uint32_t submeshes = 0;
         ///< Total number of data groups(materials).
         uint32_t data_groups = 0;
+        ///< Average cache miss ratio of the index buffer.
+        float acmr = 0.0f;
+        ///< Average transform to vertex ratio of the index buffer.
+        float atvr = 0.0f;
     };
 
     /**
@@ -406,6 +473,10 @@ public:
         std::unique_ptr<armature_node> root_node = nullptr;
 
         math::bbox bbox{};
+        ///< Clusters of the submeshes, sorted by submesh. Empty if the mesh was not split.
+        std::vector<cluster> clusters;
+        ///< Baked collision geometry. Empty if the importer did not generate it.
+        collision_data collision;
     };
 
     /**
@@ -459,6 +530,21 @@ public:
 
     auto set_submeshes(const std::vector<submesh>& submeshes) -> bool;
 
+    /**
+     * @brief Sets the culling clusters of the submeshes. Must be called after set_submeshes.
+     *
+     * @param clusters The clusters, sorted by submesh.
+     * @return true If the clusters were set.
+     */
+    auto set_clusters(std::vector<cluster>&& clusters) -> bool;
+
+    /**
+     * @brief Sets the collision geometry baked for the mesh.
+     *
+     * @param collision The collision geometry.
+     */
+    void set_collision_data(collision_data&& collision);
+
     /**
      * @brief Adds primitives (triangles) to the mesh.
      *
@@ -761,6 +847,24 @@ public:
      */
     auto get_vertex_format() const -> const gfx::vertex_layout&;
 
+    /**
+     * @brief Checks if the vertex data uses the compressed layout (see gfx::mesh_vertex_compressed).
+     *
+     * @return bool True if positions are quantized and normals are octahedral encoded.
+     */
+    auto has_compressed_vertices() const -> bool;
+
+    /**
+     * @brief Gets the transform that expands compressed positions back to mesh space.
+     *
+     * Compressed positions are normalized offsets from the center of the submesh bounds, scaled
+     * by the largest half extent. The scale is uniform so it does not skew the normals.
+     *
+     * @param bounds The bounds of the submesh.
+     * @return math::mat4 The decode transform, to be applied before the world transform.
+     */
+    static auto get_dequantize_transform(const math::bbox& bounds) -> math::mat4;
+
     /**
      * @brief Retrieves the skin bind data if this mesh has been bound as a skin.
      *
@@ -799,6 +903,40 @@ public:
      */
     auto get_submeshes() const -> const submesh_array_t&;
     auto get_submesh(uint32_t submesh_index = 0) const -> const mesh::submesh&;
+
+    /**
+     * @brief Gets the culling clusters of a submesh.
+     *
+     * @param submesh_index The submesh index.
+     * @return hpp::span<const cluster> The clusters, empty if the submesh was not split.
+     */
+    auto get_submesh_clusters(size_t submesh_index) const -> hpp::span<const cluster>;
+
+    /**
+     * @brief Binds the buffers for only the clusters of a submesh that can be seen from the view.
+     *
+     * Clusters outside the frustum, and when back faces are culled the ones facing away from the
+     * view position, are skipped. When the visible clusters form a single run of the index buffer
+     * it is bound directly, otherwise their indices are compacted into a transient index buffer.
+     * Submeshes without clusters are bound whole.
+     *
+     * @param submesh_index The submesh index.
+     * @param world The world transform of the submesh.
+     * @param view The view to cull against.
+     * @param backface_culled Whether the material culls back faces.
+     * @return false If nothing is visible and the draw should be skipped.
+     */
+    auto bind_render_buffers_for_submesh(size_t submesh_index,
+                                         const math::mat4& world,
+                                         const cluster_cull_view& view,
+                                         bool backface_culled) -> bool;
+    /**
+     * @brief Gets the collision geometry baked for the mesh.
+     *
+     * @return const collision_data& The collision geometry, empty if none was baked.
+     */
+    auto get_collision_data() const -> const collision_data&;
+
     /**
      * @brief Gets the local bounding box for this mesh.
      *
@@ -900,14 +1038,6 @@ protected:
         bool added{false};
     };
 
-    struct adjacent_edge_key
-    {
-        ///< Pointer to the first vertex in the edge.
-        const math::vec3* vertex1{nullptr};
-        ///< Pointer to the second vertex in the edge.
-        const math::vec3* vertex2{nullptr};
-    };
-
     struct mesh_submesh_key
     {
         ///< The data group identifier for this submesh.
@@ -917,16 +1047,6 @@ protected:
     using submesh_key_map_t = std::map<mesh_submesh_key, submesh*>;
     using submesh_key_array_t = std::vector<mesh_submesh_key>;
 
-    struct weld_key
-    {
-        ///< Pointer to the vertex.
-        uint8_t* vertex{nullptr};
-        ///< Format of the vertex.
-        gfx::vertex_layout format;
-        ///< Tolerance for welding vertices.
-        float tolerance{};
-    };
-
     struct face_influences
     {
         ///< List of unique bones that influence a given number of faces.
@@ -943,9 +1063,7 @@ protected:
 
     using bone_combination_map_t = std::map<bone_combination_key, std::vector<uint32_t>*>;
 
-    friend auto operator<(const adjacent_edge_key& key1, const adjacent_edge_key& key2) -> bool;
     friend auto operator<(const mesh_submesh_key& key1, const mesh_submesh_key& key2) -> bool;
-    friend auto operator<(const weld_key& key1, const weld_key& key2) -> bool;
     friend auto operator<(const bone_combination_key& key1, const bone_combination_key& key2) -> bool;
 
     void check_for_degenerates();
@@ -1064,6 +1182,14 @@ protected:
     ///< Lookup information mapping data groups to submeshes batched by material.
     data_group_submesh_map_t data_groups_;
 
+    ///< Culling clusters of all submeshes, sorted by submesh.
+    std::vector<cluster> clusters_;
+    ///< Range of clusters_ for each submesh, as first and count.
+    std::vector<std::pair<uint32_t, uint32_t>> submesh_clusters_;
+
+    ///< Collision geometry baked at import.
+    collision_data collision_;
+
     ///< Whether the mesh uses a hardware vertex/index buffer.
     bool hardware_mesh_ = true;
     ///< Whether the mesh was optimized when it was prepared.
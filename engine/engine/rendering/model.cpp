@@ -193,9 +193,10 @@ void model::set_lod_limits(const std::vector<urange32_t>& limits)
 void model::submit(const math::mat4& world_transform,
                    const pose_mat4& submesh_transforms,
                    const pose_mat4& bone_transforms,
-                   const std::vector<pose_mat4>& skinning_matrices_per_palette,
+                   const skinning_palettes& skinning_matrices_per_palette,
                    unsigned int lod,
-                   const submit_callbacks& callbacks) const
+                   const submit_callbacks& callbacks,
+                   const mesh::cluster_cull_view* cull_view) const
 {
     const auto lod_mesh = get_lod(lod);
     if(!lod_mesh)
@@ -209,6 +210,7 @@ void model::submit(const math::mat4& world_transform,
     auto non_skinned_submeshes_count = mesh->get_non_skinned_submeshes_count();
 
     submit_callbacks::params params;
+    params.compressed = mesh->has_compressed_vertices();
 
     // NON SKINNED
     if(non_skinned_submeshes_count > 0)
@@ -225,7 +227,7 @@ void model::submit(const math::mat4& world_transform,
             callbacks.setup_params_per_instance(params);
         }
 
-        auto render_submesh = [this](const std::shared_ptr<unravel::mesh>& mesh,
+        auto render_submesh = [this, cull_view](const std::shared_ptr<unravel::mesh>& mesh,
                                      uint32_t group_id,
                                      const math::mat4& matrix,
                                      const pose_mat4& pose,
@@ -245,18 +247,36 @@ void model::submit(const math::mat4& world_transform,
             {
                 const auto& submesh = submeshes[index];
 
-                if(index < pose.transforms.size())
+                const auto& world = index < pose.transforms.size() ? pose.transforms[index] : matrix;
+                params.preserve_state = &index != &indices.back();
+
+                if(cull_view)
                 {
-                    const auto& world = pose.transforms[index];
-                    gfx::set_world_transform(world);
+                    bool backface_culled = mat->get_cull_type() == cull_type::counter_clockwise;
+                    if(!mesh->bind_render_buffers_for_submesh(index, world, *cull_view, backface_culled))
+                    {
+                        // Every cluster was culled, drop the state kept for this submit.
+                        if(!params.preserve_state)
+                        {
+                            gfx::discard();
+                        }
+                        continue;
+                    }
                 }
                 else
                 {
-                    gfx::set_world_transform(matrix);
+                    mesh->bind_render_buffers_for_submesh(submesh);
+                }
+
+                if(params.compressed)
+                {
+                    gfx::set_world_transform(world * unravel::mesh::get_dequantize_transform(submesh->bbox));
+                }
+                else
+                {
+                    gfx::set_world_transform(world);
                 }
 
-                mesh->bind_render_buffers_for_submesh(submesh);
-                params.preserve_state = &index != &indices.back();
                 callbacks.setup_params_per_submesh(params, *mat);
             }
         };
@@ -289,7 +309,7 @@ void model::submit(const math::mat4& world_transform,
 
         auto render_submesh_skinned = [this](const std::shared_ptr<unravel::mesh>& mesh,
                                              uint32_t group_id,
-                                             const std::vector<pose_mat4>& skinning_matrices_per_palette,
+                                             const skinning_palettes& skinning_matrices_per_palette,
                                              submit_callbacks::params& params,
                                              const submit_callbacks& callbacks)
         {
@@ -304,11 +324,37 @@ void model::submit(const math::mat4& world_transform,
             const auto& palettes = mesh->get_bone_palettes();
             const auto& skin_data = mesh->get_skin_bind_data();
 
+            thread_local static std::vector<math::mat4> dequantized;
             for(const auto& index : indices)
             {
+                if(index >= skinning_matrices_per_palette.size())
+                {
+                    continue;
+                }
+
                 const auto& submesh = submeshes[index];
-                const auto& skinning_matrices = skinning_matrices_per_palette[index];
-                gfx::set_world_transform(skinning_matrices.transforms);
+                const auto* skinning_matrices = skinning_matrices_per_palette.get_matrices(index);
+                const auto skinning_count = skinning_matrices_per_palette.get_count(index);
+                if(skinning_count == 0)
+                {
+                    continue;
+                }
+
+                if(params.compressed)
+                {
+                    const auto dequantize = unravel::mesh::get_dequantize_transform(submesh->bbox);
+                    dequantized.resize(skinning_count);
+                    for(uint32_t i = 0; i < skinning_count; ++i)
+                    {
+                        dequantized[i] = skinning_matrices[i] * dequantize;
+                    }
+                    gfx::set_world_transform(dequantized);
+                }
+                else
+                {
+                    // Uploaded straight from the scene's skinning buffer.
+                    gfx::set_world_transform(skinning_matrices, static_cast<uint16_t>(skinning_count));
+                }
 
                 mesh->bind_render_buffers_for_submesh(submesh);
                 params.preserve_state = &index != &indices.back();
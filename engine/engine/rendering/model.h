@@ -34,6 +34,65 @@ struct pose_transform
      */
     std::vector<math::transform> transforms;
 };
+
+/**
+ * @brief Skinning matrices of all the skinned models of a scene, filled once per frame.
+ */
+struct skinning_buffer
+{
+    /**
+     * @brief Matrices of every bone palette, one range per palette.
+     */
+    std::vector<math::mat4> matrices;
+};
+
+/**
+ * @brief Ranges of the skinning matrices of the bone palettes of a model in a skinning buffer.
+ */
+struct skinning_palettes
+{
+    struct range
+    {
+        uint32_t offset{};
+        uint32_t count{};
+    };
+
+    auto empty() const -> bool
+    {
+        return buffer == nullptr || ranges.empty();
+    }
+
+    auto size() const -> size_t
+    {
+        return ranges.size();
+    }
+
+    /**
+     * @brief Gets the first skinning matrix of a palette.
+     */
+    auto get_matrices(size_t palette) const -> const math::mat4*
+    {
+        return buffer->matrices.data() + ranges[palette].offset;
+    }
+
+    /**
+     * @brief Gets the number of skinning matrices of a palette.
+     */
+    auto get_count(size_t palette) const -> uint32_t
+    {
+        return ranges[palette].count;
+    }
+
+    /**
+     * @brief The buffer holding the matrices.
+     */
+    const skinning_buffer* buffer{};
+
+    /**
+     * @brief Range of each palette in the buffer.
+     */
+    std::vector<range> ranges;
+};
 /**
  * @class model
  * @brief Structure describing a LOD group (set of meshes), LOD transitions, and their materials.
@@ -133,6 +192,8 @@ public:
         {
             /// Indicates if the model is skinned.
             bool skinned{};
+            /// Indicates if the mesh uses the compressed vertex layout.
+            bool compressed{};
             bool preserve_state{};
         };
 
@@ -150,15 +211,18 @@ public:
      * @brief Submits the model for rendering.
      * @param world_transform The world transform of the model.
      * @param bone_transforms The bone transforms for skinned models.
+     * @param skinning_matrices The skinning matrices of each bone palette.
      * @param lod The level of detail to render.
      * @param callbacks The submit callbacks.
+     * @param cull_view Optional view used to skip the invisible clusters of non skinned submeshes.
      */
     void submit(const math::mat4& world_transform,
                 const pose_mat4& submesh_transforms,
                 const pose_mat4& bone_transforms,
-                const std::vector<pose_mat4>& skinning_matrices,
+                const skinning_palettes& skinning_matrices,
                 unsigned int lod,
-                const submit_callbacks& callbacks) const;
+                const submit_callbacks& callbacks,
+                const mesh::cluster_cull_view* cull_view = nullptr) const;
 
     /**
      * @brief Gets the default material.
@@ -222,13 +222,14 @@ auto update_lod_data(lod_data& data,
     if(!mesh)
         return false;
 
-    if(total_lods <= 1)
-        return true;
-
     const auto& viewport = cam.get_viewport_size();
     auto rect = mesh.get()->calculate_screen_rect(world, cam);
 
     float percent = math::clamp((float(rect.height()) / float(viewport.height)) * 100.0f, 0.0f, 100.0f);
+    data.screen_coverage = percent;
+
+    if(total_lods <= 1)
+        return true;
 
     std::size_t lod = 0;
     for(size_t i = 0; i < lod_limits.size(); ++i)
@@ -293,6 +294,16 @@ auto deferred::get_light_program_no_shadows(const light& l) const -> const color
     return color_lighting_no_shadow_[uint8_t(l.type)];
 }
 
+auto deferred::get_geom_program(bool skinned, bool compressed) -> geom_program&
+{
+    if(compressed)
+    {
+        return skinned ? geom_program_skinned_compressed_ : geom_program_compressed_;
+    }
+
+    return skinned ? geom_program_skinned_ : geom_program_;
+}
+
 void deferred::submit_pbr_material(geom_program& program, const pbr_material& mat)
 {
     const auto& color_map = mat.get_color_map();
@@ -609,6 +620,10 @@ void deferred::run_g_buffer_pass(const visibility_set_models_t& visibility_set,
     pass.set_view_proj(view, proj);
     pass.bind(gbuffer.get());
 
+    mesh::cluster_cull_view cull_view;
+    cull_view.frustum = camera.get_frustum();
+    cull_view.position = camera.get_position();
+
     for(const auto& e : visibility_set)
     {
         const auto& transform_comp = e.get<transform_component>();
@@ -657,7 +672,7 @@ void deferred::run_g_buffer_pass(const visibility_set_models_t& visibility_set,
         model::submit_callbacks callbacks;
         callbacks.setup_begin = [&](const model::submit_callbacks::params& submit_params)
         {
-            geom_program& prog = submit_params.skinned ? geom_program_skinned_ : geom_program_;
+            geom_program& prog = get_geom_program(submit_params.skinned, submit_params.compressed);
 
             prog.program->begin();
 
@@ -666,14 +681,14 @@ void deferred::run_g_buffer_pass(const visibility_set_models_t& visibility_set,
         };
         callbacks.setup_params_per_instance = [&](const model::submit_callbacks::params& submit_params)
         {
-            geom_program& prog = submit_params.skinned ? geom_program_skinned_ : geom_program_;
+            geom_program& prog = get_geom_program(submit_params.skinned, submit_params.compressed);
 
             gfx::set_uniform(prog.u_lod_params, params);
         };
         callbacks.setup_params_per_submesh =
             [&](const model::submit_callbacks::params& submit_params, const material& mat)
         {
-            geom_program& prog = submit_params.skinned ? geom_program_skinned_ : geom_program_;
+            geom_program& prog = get_geom_program(submit_params.skinned, submit_params.compressed);
 
             bool submitted = mat.submit(prog.program.get());
             if(!submitted)
@@ -689,23 +704,25 @@ void deferred::run_g_buffer_pass(const visibility_set_models_t& visibility_set,
         };
         callbacks.setup_end = [&](const model::submit_callbacks::params& submit_params)
         {
-            geom_program& prog = submit_params.skinned ? geom_program_skinned_ : geom_program_;
+            geom_program& prog = get_geom_program(submit_params.skinned, submit_params.compressed);
 
             prog.program->end();
         };
 
         model_comp.set_last_render_frame(gfx::get_render_frame());
+        model_comp.set_screen_coverage(lod_runtime_data.screen_coverage);
         model.submit(world_transform,
                      submesh_transforms,
                      bone_transforms,
                      skinning_matrices,
                      current_lod_index,
-                     callbacks);
+                     callbacks,
+                     &cull_view);
         if(math::epsilonNotEqual(current_time, 0.0f, math::epsilon<float>()))
         {
             callbacks.setup_params_per_instance = [&](const model::submit_callbacks::params& submit_params)
             {
-                geom_program& prog = submit_params.skinned ? geom_program_skinned_ : geom_program_;
+                geom_program& prog = get_geom_program(submit_params.skinned, submit_params.compressed);
 
                 gfx::set_uniform(prog.u_lod_params, params);
             };
@@ -715,7 +732,8 @@ void deferred::run_g_buffer_pass(const visibility_set_models_t& visibility_set,
                          bone_transforms,
                          skinning_matrices,
                          target_lod_index,
-                         callbacks);
+                         callbacks,
+                         &cull_view);
         }
     }
     gfx::discard();
@@ -1245,6 +1263,13 @@ auto deferred::init(rtti::context& ctx) -> bool
     geom_program_skinned_.program = load_program("vs_deferred_geom_skinned", "fs_deferred_geom");
     geom_program_skinned_.cache_uniforms();
 
+    geom_program_compressed_.program = load_program("vs_deferred_geom_compressed", "fs_deferred_geom");
+    geom_program_compressed_.cache_uniforms();
+
+    geom_program_skinned_compressed_.program =
+        load_program("vs_deferred_geom_skinned_compressed", "fs_deferred_geom");
+    geom_program_skinned_compressed_.cache_uniforms();
+
     sphere_ref_probe_program_.program = load_program("vs_clip_quad_ex", "reflection_probe/fs_sphere_reflection_probe");
     sphere_ref_probe_program_.cache_uniforms();
 
@@ -195,6 +195,10 @@ private:
 
     geom_program geom_program_;
     geom_program geom_program_skinned_;
+    geom_program geom_program_compressed_;
+    geom_program geom_program_skinned_compressed_;
+
+    auto get_geom_program(bool skinned, bool compressed) -> geom_program&;
 
     struct color_lighting : uniforms_cache
     {
@@ -37,6 +37,7 @@ struct lod_data
     std::uint32_t current_lod_index = 0; ///< Current LOD index.
     std::uint32_t target_lod_index = 0;  ///< Target LOD index.
     float current_time = 0.0f;           ///< Current time for LOD transition.
+    float screen_coverage = 0.0f;        ///< Percent of the viewport height covered by the mesh.
 };
 
 using lod_data_container = std::map<entt::handle, lod_data>;
@@ -9,24 +9,6 @@
 namespace unravel
 {
 
-namespace
-{
-
-struct managed_vector3
-{
-    float x, y, z;
-};
-
-struct managed_contact_point
-{
-    managed_vector3 point{};
-    managed_vector3 normal{};
-    float distance{};
-    float impulse{};
-};
-
-} // namespace
-
 void script_component::on_create_component(entt::registry& r, entt::entity e)
 {
     entt::handle entity(r, e);
@@ -82,46 +64,6 @@ void script_component::disable()
                  });
 }
 
-void script_component::on_sensor_enter(entt::handle other)
-{
-    safe_foreach(script_components_,
-                 [&](auto& script)
-                 {
-                     auto& obj = script.scoped->object;
-                     on_sensor_enter(obj, other);
-                 });
-}
-
-void script_component::on_sensor_exit(entt::handle other)
-{
-    safe_foreach(script_components_,
-                 [&](auto& script)
-                 {
-                     auto& obj = script.scoped->object;
-                     on_sensor_exit(obj, other);
-                 });
-}
-
-void script_component::on_collision_enter(entt::handle b, const std::vector<manifold_point>& manifolds, bool use_b)
-{
-    safe_foreach(script_components_,
-                 [&](auto& script)
-                 {
-                     auto& obj = script.scoped->object;
-                     on_collision_enter(obj, b, manifolds, use_b);
-                 });
-}
-
-void script_component::on_collision_exit(entt::handle b, const std::vector<manifold_point>& manifolds, bool use_b)
-{
-    safe_foreach(script_components_,
-                 [&](auto& script)
-                 {
-                     auto& obj = script.scoped->object;
-                     on_collision_exit(obj, b, manifolds, use_b);
-                 });
-}
-
 void script_component::enable(script_object& script_obj, bool check_order)
 {
     if(script_obj.is_enabled() || script_obj.is_marked_for_destroy())
@@ -241,106 +183,6 @@ void script_component::set_entity(const mono::mono_object& obj, entt::handle e)
     }
 }
 
-void script_component::on_sensor_enter(const mono::mono_object& obj, entt::handle other)
-{
-    try
-    {
-        auto method = mono::make_method_invoker<void(entt::entity)>(obj, "internal_n2m_on_sensor_enter");
-        method(obj, other.entity());
-    }
-    catch(const mono::mono_exception& e)
-    {
-        script_system::log_exception(e);
-    }
-}
-
-void script_component::on_sensor_exit(const mono::mono_object& obj, entt::handle other)
-{
-    try
-    {
-        auto method = mono::make_method_invoker<void(entt::entity)>(obj, "internal_n2m_on_sensor_exit");
-        method(obj, other.entity());
-    }
-    catch(const mono::mono_exception& e)
-    {
-        script_system::log_exception(e);
-    }
-}
-
-void script_component::on_collision_enter(const mono::mono_object& obj,
-                                          entt::handle b,
-                                          const std::vector<manifold_point>& manifolds,
-                                          bool use_b)
-{
-    std::vector<managed_contact_point> points;
-    points.reserve(manifolds.size());
-    for(const auto& manifold : manifolds)
-    {
-        auto& point = points.emplace_back();
-        if(use_b)
-        {
-            point.point = {manifold.b.x, manifold.b.y, manifold.b.z};
-            point.normal = {manifold.normal_on_b.x, manifold.normal_on_b.y, manifold.normal_on_b.z};
-        }
-        else
-        {
-            point.point = {manifold.a.x, manifold.a.y, manifold.a.z};
-            point.normal = {manifold.normal_on_a.x, manifold.normal_on_a.y, manifold.normal_on_a.z};
-        }
-        point.distance = manifold.distance;
-        point.impulse = manifold.impulse;
-    }
-
-    try
-    {
-        auto method = mono::make_method_invoker<void(entt::entity, const std::vector<managed_contact_point>&)>(
-            obj,
-            "internal_n2m_on_collision_enter");
-        method(obj, b.entity(), points);
-    }
-    catch(const mono::mono_exception& e)
-    {
-        script_system::log_exception(e);
-    }
-}
-
-void script_component::on_collision_exit(const mono::mono_object& obj,
-                                         entt::handle b,
-                                         const std::vector<manifold_point>& manifolds,
-                                         bool use_b)
-{
-    std::vector<managed_contact_point> points;
-    points.reserve(manifolds.size());
-    for(const auto& manifold : manifolds)
-    {
-        auto& point = points.emplace_back();
-        if(use_b)
-        {
-            point.point = {manifold.b.x, manifold.b.y, manifold.b.z};
-            point.normal = {manifold.normal_on_b.x, manifold.normal_on_b.y, manifold.normal_on_b.z};
-        }
-        else
-        {
-            point.point = {manifold.a.x, manifold.a.y, manifold.a.z};
-            point.normal = {manifold.normal_on_a.x, manifold.normal_on_a.y, manifold.normal_on_a.z};
-        }
-        point.distance = manifold.distance;
-        point.impulse = manifold.impulse;
-    }
-
-    try
-    {
-        auto method = mono::make_method_invoker<void(entt::entity, const std::vector<managed_contact_point>&)>(
-            obj,
-            "internal_n2m_on_collision_exit");
-        method(obj, b.entity(), points);
-    }
-    catch(const mono::mono_exception& e)
-    {
-        script_system::log_exception(e);
-    }
-}
-
 void script_component::process_pending_deletions()
 {
     auto& ctx = engine::context();
@@ -151,12 +151,6 @@ public:
     void enable();
     void disable();
 
-    void on_sensor_enter(entt::handle other);
-    void on_sensor_exit(entt::handle other);
-
-    void on_collision_enter(entt::handle other, const std::vector<manifold_point>& manifolds, bool use_b);
-    void on_collision_exit(entt::handle other, const std::vector<manifold_point>& manifolds, bool use_b);
-
 private:
     void enable(script_object& script_obj, bool check_order);
     void disable(script_object& script_obj, bool check_order);
@@ -164,17 +158,6 @@ private:
     void start(script_object& script_obj);
     void destroy(script_object& script_obj);
     void set_entity(const mono::mono_object& obj, entt::handle e);
-    void on_sensor_enter(const mono::mono_object& obj, entt::handle other);
-    void on_sensor_exit(const mono::mono_object& obj, entt::handle other);
-
-    void on_collision_enter(const mono::mono_object& obj,
-                            entt::handle other,
-                            const std::vector<manifold_point>& manifolds,
-                            bool use_b);
-    void on_collision_exit(const mono::mono_object& obj,
-                           entt::handle other,
-                           const std::vector<manifold_point>& manifolds,
-                           bool use_b);
 
     template<typename F>
     auto safe_foreach(script_components_t& components, F&& f)
@@ -735,7 +735,11 @@ void internal_m2n_set_layers(entt::entity id, int mask)
 {
     if(auto comp = safe_get_component<layer_component>(id))
     {
-        comp->layers.mask = mask;
+        if(comp->layers.mask != mask)
+        {
+            comp->layers.mask = mask;
+            get_entity_from_id(id).patch<layer_component>();
+        }
     }
 }
 
@@ -1412,6 +1416,50 @@ auto internal_m2n_physics_get_collision_layers(entt::entity id) -> layer_mask
 
     return {};
 }
+
+auto internal_m2n_physics_get_can_sleep(entt::entity id) -> bool
+{
+    if(auto comp = safe_get_component<physics_component>(id))
+    {
+        return comp->can_sleep();
+    }
+
+    return false;
+}
+
+void internal_m2n_physics_set_can_sleep(entt::entity id, bool can_sleep)
+{
+    if(auto comp = safe_get_component<physics_component>(id))
+    {
+        comp->set_can_sleep(can_sleep);
+    }
+}
+
+auto internal_m2n_physics_is_sleeping(entt::entity id) -> bool
+{
+    if(auto comp = safe_get_component<physics_component>(id))
+    {
+        return comp->is_sleeping();
+    }
+
+    return false;
+}
+
+void internal_m2n_physics_sleep(entt::entity id)
+{
+    if(auto comp = safe_get_component<physics_component>(id))
+    {
+        comp->sleep();
+    }
+}
+
+void internal_m2n_physics_wake_up(entt::entity id)
+{
+    if(auto comp = safe_get_component<physics_component>(id))
+    {
+        comp->wake_up();
+    }
+}
 //------------------------------
 
 void internal_m2n_animation_blend(entt::entity id, int layer, hpp::uuid guid, float seconds, bool loop, bool phase_sync)
@@ -2216,6 +2264,82 @@ auto internal_m2n_physics_sphere_overlap(const math::vec3& origin, float radius,
     return hits;
 }
 
+auto internal_m2n_physics_cast_batch(const hpp::small_vector<mono::managed_interface::cast_query>& casts)
+    -> hpp::small_vector<mono::managed_interface::raycast_hit>
+{
+    auto& ctx = engine::context();
+    auto& physics = ctx.get_cached<physics_system>();
+
+    using converter = mono::managed_interface::converter;
+
+    std::vector<physics_cast_query> queries(casts.size());
+    for(size_t i = 0; i < casts.size(); ++i)
+    {
+        auto& query = queries[i];
+        query.origin = converter::convert<mono::managed_interface::vector3, math::vec3>(casts[i].origin);
+        query.direction = converter::convert<mono::managed_interface::vector3, math::vec3>(casts[i].direction);
+        query.radius = casts[i].radius;
+        query.max_distance = casts[i].max_distance;
+        query.layer_mask = casts[i].layer_mask;
+        query.query_sensors = casts[i].query_sensors != 0;
+    }
+
+    std::vector<raycast_hit> ray_hits(queries.size());
+    physics.cast_batch(queries, ray_hits);
+
+    hpp::small_vector<mono::managed_interface::raycast_hit> hits;
+    hits.reserve(ray_hits.size());
+    for(const auto& ray_hit : ray_hits)
+    {
+        auto& hit = hits.emplace_back();
+        hit.entity = ray_hit.entity;
+        hit.point = converter::convert<math::vec3, mono::managed_interface::vector3>(ray_hit.point);
+        hit.normal = converter::convert<math::vec3, mono::managed_interface::vector3>(ray_hit.normal);
+        hit.distance = ray_hit.distance;
+    }
+
+    return hits;
+}
+
+auto internal_m2n_physics_sphere_overlap_batch(const hpp::small_vector<mono::managed_interface::overlap_query>& overlaps,
+                                               int max_hits) -> hpp::small_vector<mono::managed_interface::overlap_hit>
+{
+    auto& ctx = engine::context();
+    auto& physics = ctx.get_cached<physics_system>();
+
+    using converter = mono::managed_interface::converter;
+
+    std::vector<physics_overlap_query> queries(overlaps.size());
+    for(size_t i = 0; i < overlaps.size(); ++i)
+    {
+        auto& query = queries[i];
+        query.origin = converter::convert<mono::managed_interface::vector3, math::vec3>(overlaps[i].origin);
+        query.radius = overlaps[i].radius;
+        query.layer_mask = overlaps[i].layer_mask;
+        query.query_sensors = overlaps[i].query_sensors != 0;
+    }
+
+    // Every query owns 'max_hits' slots of the backend result.
+    size_t capacity = size_t(std::max(max_hits, 0));
+    std::vector<entt::entity> entities(queries.size() * capacity, entt::entity(entt::null));
+    std::vector<uint32_t> counts(queries.size());
+    physics.sphere_overlap_batch(queries, entities, counts);
+
+    // Every hit carries the index of its query, grouped by query.
+    hpp::small_vector<mono::managed_interface::overlap_hit> hits;
+    for(size_t i = 0; i < queries.size(); ++i)
+    {
+        for(uint32_t j = 0; j < counts[i]; ++j)
+        {
+            auto& hit = hits.emplace_back();
+            hit.query = uint32_t(i);
+            hit.entity = entities[i * capacity + j];
+        }
+    }
+
+    return hits;
+}
+
 //-------------------------------------------------
 
 auto internal_m2n_audio_source_get_loop(entt::entity id) -> bool
@@ -2644,6 +2768,11 @@ auto script_system::bind_internal_calls(rtti::context& ctx) -> bool
                               internal_call(internal_m2n_physics_set_exclude_layers));
         reg.add_internal_call("internal_m2n_physics_get_collision_layers",
                               internal_call(internal_m2n_physics_get_collision_layers));
+        reg.add_internal_call("internal_m2n_physics_get_can_sleep", internal_call(internal_m2n_physics_get_can_sleep));
+        reg.add_internal_call("internal_m2n_physics_set_can_sleep", internal_call(internal_m2n_physics_set_can_sleep));
+        reg.add_internal_call("internal_m2n_physics_is_sleeping", internal_call(internal_m2n_physics_is_sleeping));
+        reg.add_internal_call("internal_m2n_physics_sleep", internal_call(internal_m2n_physics_sleep));
+        reg.add_internal_call("internal_m2n_physics_wake_up", internal_call(internal_m2n_physics_wake_up));
     }
 
     {
@@ -2797,6 +2926,9 @@ auto script_system::bind_internal_calls(rtti::context& ctx) -> bool
                               internal_call(internal_m2n_physics_sphere_cast_all));
         reg.add_internal_call("internal_m2n_physics_sphere_overlap",
                               internal_call(internal_m2n_physics_sphere_overlap));
+        reg.add_internal_call("internal_m2n_physics_cast_batch", internal_call(internal_m2n_physics_cast_batch));
+        reg.add_internal_call("internal_m2n_physics_sphere_overlap_batch",
+                              internal_call(internal_m2n_physics_sphere_overlap_batch));
     }
 
     {
@@ -117,6 +117,48 @@ struct ray
     vector3 direction{};
 };
 
+// C# bools are marshaled as 4 byte BOOLs inside structs.
+struct cast_query
+{
+    vector3 origin{};
+    vector3 direction{};
+    float radius{};
+    float max_distance{};
+    int32_t layer_mask{};
+    int32_t query_sensors{};
+};
+
+struct overlap_query
+{
+    vector3 origin{};
+    float radius{};
+    int32_t layer_mask{};
+    int32_t query_sensors{};
+};
+
+struct overlap_hit
+{
+    uint32_t query{};
+    entt::entity entity{};
+};
+
+struct contact_point
+{
+    vector3 point{};
+    vector3 normal{};
+    float distance{};
+    float impulse{};
+};
+
+struct contact_event
+{
+    uint32_t type{};
+    entt::entity receiver{};
+    entt::entity other{};
+    uint32_t first_point{};
+    uint32_t point_count{};
+};
+
 struct material_properties
 {
     bool valid{};
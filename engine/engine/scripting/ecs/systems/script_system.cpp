@@ -844,106 +844,81 @@ auto script_system::get_lib_compiled_key(const std::string& protocol) -> std::st
     return output;
 }
 
-void script_system::on_sensor_enter(entt::handle sensor, entt::handle other)
+void script_system::on_contact_events(hpp::span<const contact_event> events, hpp::span<const manifold_point> points)
 {
-    if(!other || !sensor)
-    {
-        return;
-    }
-    auto comp = sensor.try_get<script_component>();
-    if(!comp)
-    {
-        return;
-    }
+    auto& ctx = engine::context();
+    auto& ec = ctx.get_cached<ecs>();
+    auto& registry = *ec.get_scene().registry;
 
-    try
-    {
-        comp->on_sensor_enter(other);
-    }
-    catch(const mono::mono_exception& e)
-    {
-        log_exception(e);
-    }
-}
+    contact_events_.clear();
+    contact_points_.clear();
 
-void script_system::on_sensor_exit(entt::handle sensor, entt::handle other)
-{
-    if(!other || !sensor)
+    // Each side of the pair receives the event with the points on the other body.
+    auto add = [&](const contact_event& event, entt::entity receiver, entt::entity other, bool use_b)
     {
-        return;
-    }
+        if(!registry.valid(receiver) || !registry.valid(other) || !registry.all_of<script_component>(receiver))
+        {
+            return;
+        }
 
-    auto comp = sensor.try_get<script_component>();
-    if(!comp)
-    {
-        return;
-    }
+        auto& managed = contact_events_.emplace_back();
+        managed.type = static_cast<uint32_t>(event.type);
+        managed.receiver = receiver;
+        managed.other = other;
+        managed.first_point = static_cast<uint32_t>(contact_points_.size());
+        managed.point_count = event.point_count;
 
-    try
-    {
-        comp->on_sensor_exit(other);
-    }
-    catch(const mono::mono_exception& e)
-    {
-        log_exception(e);
-    }
-}
-
-void script_system::on_collision_enter(entt::handle a, entt::handle b, const std::vector<manifold_point>& manifolds)
-{
-    if(!a || !b)
-    {
-        return;
-    }
+        for(const auto& manifold : points.subspan(event.first_point, event.point_count))
+        {
+            auto& point = contact_points_.emplace_back();
+            point.point = converter::convert<math::vec3, mono::managed_interface::vector3>(
+                use_b ? manifold.b : manifold.a);
+            point.normal = converter::convert<math::vec3, mono::managed_interface::vector3>(
+                use_b ? manifold.normal_on_b : manifold.normal_on_a);
+            point.distance = manifold.distance;
+            point.impulse = manifold.impulse;
+        }
+    };
 
-    try
+    for(const auto& event : events)
     {
+        switch(event.type)
         {
-            auto comp = a.try_get<script_component>();
-            if(comp)
+            case contact_event_type::sensor_enter:
+            case contact_event_type::sensor_exit:
             {
-                comp->on_collision_enter(b, manifolds, true);
+                add(event, event.a, event.b, false);
+                break;
             }
-        }
 
-        {
-            auto comp = b.try_get<script_component>();
-            if(comp)
+            case contact_event_type::collision_enter:
+            case contact_event_type::collision_exit:
+            {
+                add(event, event.a, event.b, true);
+                add(event, event.b, event.a, false);
+                break;
+            }
+
+            default:
             {
-                comp->on_collision_enter(a, manifolds, false);
+                break;
             }
         }
     }
-    catch(const mono::mono_exception& e)
-    {
-        log_exception(e);
-    }
-}
 
-void script_system::on_collision_exit(entt::handle a, entt::handle b, const std::vector<manifold_point>& manifolds)
-{
-    if(!a || !b)
+    if(contact_events_.empty())
     {
         return;
     }
 
     try
     {
-        {
-            auto comp = a.try_get<script_component>();
-            if(comp)
-            {
-                comp->on_collision_exit(b, manifolds, true);
-            }
-        }
-
-        {
-            auto comp = b.try_get<script_component>();
-            if(comp)
-            {
-                comp->on_collision_exit(a, manifolds, false);
-            }
-        }
+        using events_t = decltype(contact_events_);
+        using points_t = decltype(contact_points_);
+        auto method_thunk =
+            mono::make_method_invoker<void(const events_t&, const points_t&)>(cache_.update_manager_type,
+                                                                              "internal_n2m_on_contact_events");
+        method_thunk(contact_events_, contact_points_);
     }
     catch(const mono::mono_exception& e)
     {
@@ -2,6 +2,7 @@
 #include <engine/engine_export.h>
 #include <engine/physics/ecs/components/physics_component.h>
 #include <engine/scripting/ecs/components/script_component.h>
+#include <engine/scripting/ecs/systems/script_interop.h>
 
 #include <engine/threading/threader.h>
 
@@ -51,11 +52,12 @@ struct script_system
     void wait_for_jobs_to_finish(rtti::context& ctx);
     auto has_compilation_errors() const -> bool;
 
-    void on_sensor_enter(entt::handle sensor, entt::handle other);
-    void on_sensor_exit(entt::handle sensor, entt::handle other);
-
-    void on_collision_enter(entt::handle a, entt::handle b, const std::vector<manifold_point>& manifolds);
-    void on_collision_exit(entt::handle a, entt::handle b, const std::vector<manifold_point>& manifolds);
+    /**
+     * @brief Delivers the contact events of a frame to the scripts in one managed call.
+     * @param events The sensor and collision events of the frame.
+     * @param points Contact points referenced by the collision events.
+     */
+    void on_contact_events(hpp::span<const contact_event> events, hpp::span<const manifold_point> points);
 
     /**
      * @brief Called when a physics component is created.
@@ -153,6 +155,10 @@ private:
         finished
     };
 
+    ///< Contact events and points sent to the scripts, kept to reuse their allocations.
+    std::vector<mono::managed_interface::contact_event> contact_events_;
+    std::vector<mono::managed_interface::contact_point> contact_points_;
+
     call_progress create_call_{call_progress::not_called};
     bool is_updating_{};
     std::vector<tpp::future<void>> compilation_jobs_;
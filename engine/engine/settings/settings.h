@@ -7,6 +7,7 @@
 #include <engine/layers/layer_mask.h>
 #include <engine/input/input.h>
 #include <engine/assets/asset_manager.h>
+#include <math/math.h>
 
 #include <string>
 #include <vector>
@@ -100,8 +101,73 @@ struct settings
 
         float fixed_timestep{0.02f};
         int max_fixed_steps{3};
+        bool interpolate_physics{false};
     } time;
 
+    struct physics_settings
+    {
+        friend auto operator==(const physics_settings& lhs, const physics_settings& rhs) -> bool = default;
+
+        struct contact_filter
+        {
+            friend auto operator==(const contact_filter& lhs, const contact_filter& rhs) -> bool = default;
+
+            layer_mask layers_a{layer_reserved::everything_layer};
+            layer_mask layers_b{layer_reserved::everything_layer};
+            bool report_events{true};
+            float min_impulse{};
+        };
+
+        // The first filter matching the layers of a pair decides how its contact events are reported.
+        std::vector<contact_filter> contact_filters;
+
+        // Bodies slower than these thresholds for 'time_to_sleep' seconds fall asleep with their island.
+        float sleep_linear_threshold{0.8f};
+        float sleep_angular_threshold{1.0f};
+        float time_to_sleep{2.0f};
+
+        enum class broadphase_type : uint8_t
+        {
+            // Dynamic aabb trees, a good default for most scenes.
+            dbvt,
+            // Sorted bounds on the three axes, cheap when many bodies move little inside known world bounds.
+            sweep_and_prune,
+            // Square cells on the ground plane, for large flat open worlds.
+            uniform_grid,
+        };
+
+        // Finds the potentially colliding pairs, applied when the simulation starts.
+        broadphase_type broadphase{broadphase_type::dbvt};
+
+        // Percentage of the moving and resting tree nodes the dbvt broadphase rebalances per step.
+        int dbvt_dynamic_updates{0};
+        int dbvt_fixed_updates{1};
+        // Fraction of their size moving aabbs are extended by along their motion, so their nodes are refit less often.
+        float dbvt_prediction{0.0f};
+        // Find the pairs of added bodies on the next step instead of right away.
+        bool dbvt_deferred_collide{false};
+
+        // Bounds the sweep and prune broadphase sorts in, bodies outside of them get clamped to the border.
+        math::vec3 world_min{-1000.0f, -1000.0f, -1000.0f};
+        math::vec3 world_max{1000.0f, 1000.0f, 1000.0f};
+
+        // Side of the uniform grid cells, around the size of the larger moving bodies.
+        float grid_cell_size{16.0f};
+
+        // Most bodies the sweep and prune and uniform grid broadphases can hold.
+        int max_bodies{65536};
+
+        // Simulate only the bodies near the streaming anchors: the cameras and the entities tagged 'streaming_anchor_tag'.
+        // Bodies streamed out leave the dynamics world untouched and resume where they left off once streamed back in.
+        bool streaming{false};
+        bool streaming_camera_anchors{true};
+        std::string streaming_anchor_tag{"PhysicsAnchor"};
+        // Bodies closer than the radius to an anchor are simulated, they are only streamed out again past the
+        // radius plus the hysteresis so bodies moving along the border don't enter and leave every step.
+        float streaming_radius{250.0f};
+        float streaming_hysteresis{25.0f};
+    } physics;
+
     friend auto operator==(const settings& lhs, const settings& rhs) -> bool = default;
 
 };
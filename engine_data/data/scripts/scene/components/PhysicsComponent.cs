@@ -85,6 +85,49 @@ public Vector3 angularVelocity
             }
         }
 
+        /// <summary>
+        /// Whether the rigidbody may fall asleep when it comes to rest. Sleeping bodies cost no simulation time
+        /// until something touches them or they are woken up.
+        /// </summary>
+        public bool canSleep
+        {
+            get
+            {
+                return internal_m2n_physics_get_can_sleep(owner);
+            }
+            set
+            {
+                internal_m2n_physics_set_can_sleep(owner, value);
+            }
+        }
+
+        /// <summary>
+        /// Whether the rigidbody is asleep.
+        /// </summary>
+        public bool isSleeping
+        {
+            get
+            {
+                return internal_m2n_physics_is_sleeping(owner);
+            }
+        }
+
+        /// <summary>
+        /// Puts the rigidbody to sleep. It is woken again right away if the bodies it touches are awake.
+        /// </summary>
+        public void Sleep()
+        {
+            internal_m2n_physics_sleep(owner);
+        }
+
+        /// <summary>
+        /// Wakes the rigidbody up.
+        /// </summary>
+        public void WakeUp()
+        {
+            internal_m2n_physics_wake_up(owner);
+        }
+
         /// <summary>
         /// Applies an explosion force to the entity.
         /// </summary>
@@ -153,6 +196,21 @@ public void ApplyTorque(Vector3 torque, ForceMode mode = ForceMode.Force)
 
         [MethodImpl(MethodImplOptions.InternalCall)]
         private static extern LayerMask internal_m2n_physics_get_collision_layers(Entity eid);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern bool internal_m2n_physics_get_can_sleep(Entity eid);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern void internal_m2n_physics_set_can_sleep(Entity eid, bool canSleep);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern bool internal_m2n_physics_is_sleeping(Entity eid);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern void internal_m2n_physics_sleep(Entity eid);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern void internal_m2n_physics_wake_up(Entity eid);
     }
 }
 }
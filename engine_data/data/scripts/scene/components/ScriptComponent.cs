@@ -12,6 +12,7 @@ namespace Core
     public abstract class ScriptComponent : Component
     {
         private bool m_started = false;
+        internal uint contactEntityId = uint.MaxValue;
         private string SourceFilePath { get; }
         protected ScriptComponent([CallerFilePath] string file = "")
         {
@@ -117,6 +118,7 @@ public virtual void OnLateUpdate()
         /// </summary>
         private void internal_n2m_on_create()
         {
+            SystemManager.AddEntityScript(this);
             OnCreate();
         }
 
@@ -158,58 +160,9 @@ private void internal_n2m_on_start()
         private void internal_n2m_on_destroy()
         {
             SystemManager.ScriptManager.Remove(this);
+            SystemManager.RemoveEntityScript(this);
             OnDestroy();
         }
-
-        /// <summary>
-        /// Internal method invoked when another entity enters a sensor attached to this entity. Calls <see cref="OnSensorEnter"/>.
-        /// </summary>
-        /// <param name="entity">The entity that entered the sensor.</param>
-        private void internal_n2m_on_sensor_enter(Entity entity)
-        {
-            OnSensorEnter(entity);
-        }
-
-        /// <summary>
-        /// Internal method invoked when another entity exits a sensor attached to this entity. Calls <see cref="OnSensorExit"/>.
-        /// </summary>
-        /// <param name="entity">The entity that exited the sensor.</param>
-        private void internal_n2m_on_sensor_exit(Entity entity)
-        {
-            OnSensorExit(entity);
-        }
-
-        /// <summary>
-        /// Internal method invoked when this entity begins a collision. Converts contact data and calls <see cref="OnCollisionEnter"/>.
-        /// </summary>
-        /// <param name="entity">The other entity involved in the collision.</param>
-        /// <param name="contactData">The serialized contact data for the collision.</param>
-        private void internal_n2m_on_collision_enter(Entity entity, byte[] contactData)
-        {
-            Collision collision = new Collision
-            {
-                entity = entity,
-                contacts = contactData.ToStructArray<ContactPoint>()
-            };
-
-            OnCollisionEnter(collision);
-        }
-
-        /// <summary>
-        /// Internal method invoked when this entity ends a collision. Converts contact data and calls <see cref="OnCollisionExit"/>.
-        /// </summary>
-        /// <param name="entity">The other entity involved in the collision.</param>
-        /// <param name="contactData">The serialized contact data for the collision.</param>
-        private void internal_n2m_on_collision_exit(Entity entity, byte[] contactData)
-        {
-            Collision collision = new Collision
-            {
-                entity = entity,
-                contacts = contactData.ToStructArray<ContactPoint>()
-            };
-
-            OnCollisionExit(collision);
-        }
     }
 }
 }
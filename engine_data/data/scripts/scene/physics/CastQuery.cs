@@ -0,0 +1,66 @@
+using System;
+using System.Globalization;
+using System.Linq;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace Ace
+{
+namespace Core
+{
+    /// <summary>
+    /// A single ray or sphere cast of <see cref="Physics.CastBatch"/>.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct CastQuery
+    {
+        /// <summary>
+        /// The origin of the cast.
+        /// </summary>
+        public Vector3 origin;
+
+        /// <summary>
+        /// The direction of the cast.
+        /// </summary>
+        public Vector3 direction;
+
+        /// <summary>
+        /// The radius of the sphere to cast. A radius of zero casts a plain ray.
+        /// </summary>
+        public float radius;
+
+        /// <summary>
+        /// The maximum distance the cast should check for collisions.
+        /// </summary>
+        public float maxDistance;
+
+        /// <summary>
+        /// A layer mask that defines which layers to include in the cast.
+        /// </summary>
+        public int layerMask;
+
+        /// <summary>
+        /// If <c>true</c>, the cast will include sensors in its results.
+        /// </summary>
+        public bool querySensors;
+
+        /// <summary>
+        /// Initializes a new cast along a ray.
+        /// </summary>
+        /// <param name="ray">The ray to cast.</param>
+        /// <param name="radius">The radius of the sphere to cast. A radius of zero casts a plain ray.</param>
+        /// <param name="maxDistance">The maximum distance the cast should check for collisions. Defaults to <see cref="Mathf.Infinity"/>.</param>
+        /// <param name="layerMask">A layer mask that defines which layers to include in the cast. Defaults to <see cref="Physics.DefaultRaycastLayers"/>.</param>
+        /// <param name="querySensors">If <c>true</c>, the cast will include sensors in its results. Defaults to <c>false</c>.</param>
+        public CastQuery(Ray ray, float radius = 0.0f, float maxDistance = Mathf.Infinity, int layerMask = Physics.DefaultRaycastLayers, bool querySensors = false)
+        {
+            this.origin = ray.origin;
+            this.direction = ray.direction;
+            this.radius = radius;
+            this.maxDistance = maxDistance;
+            this.layerMask = layerMask;
+            this.querySensors = querySensors;
+        }
+    }
+}
+}
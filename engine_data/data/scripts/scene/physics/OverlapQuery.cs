@@ -0,0 +1,53 @@
+using System;
+using System.Globalization;
+using System.Linq;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace Ace
+{
+namespace Core
+{
+    /// <summary>
+    /// A single sphere overlap of <see cref="Physics.SphereOverlapBatch(OverlapQuery[], int)"/>.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct OverlapQuery
+    {
+        /// <summary>
+        /// The origin of the sphere.
+        /// </summary>
+        public Vector3 origin;
+
+        /// <summary>
+        /// The radius of the sphere.
+        /// </summary>
+        public float radius;
+
+        /// <summary>
+        /// A layer mask that defines which layers to include in the test.
+        /// </summary>
+        public int layerMask;
+
+        /// <summary>
+        /// If <c>true</c>, the test will include sensors in its results.
+        /// </summary>
+        public bool querySensors;
+
+        /// <summary>
+        /// Initializes a new sphere overlap.
+        /// </summary>
+        /// <param name="origin">The origin of the sphere.</param>
+        /// <param name="radius">The radius of the sphere.</param>
+        /// <param name="layerMask">A layer mask that defines which layers to include in the test. Defaults to <see cref="Physics.DefaultRaycastLayers"/>.</param>
+        /// <param name="querySensors">If <c>true</c>, the test will include sensors in its results. Defaults to <c>false</c>.</param>
+        public OverlapQuery(Vector3 origin, float radius, int layerMask = Physics.DefaultRaycastLayers, bool querySensors = false)
+        {
+            this.origin = origin;
+            this.radius = radius;
+            this.layerMask = layerMask;
+            this.querySensors = querySensors;
+        }
+    }
+}
+}
@@ -195,6 +195,140 @@ public static Entity[] SphereOverlap(Vector3 origin, float radius, int layerMask
                 return rawHits.ToStructArray<Entity>();
             }
 
+            /// <summary>
+            /// Casts many rays at once. The rays are processed in parallel against the physics world.
+            /// </summary>
+            /// <param name="rays">The rays to cast.</param>
+            /// <param name="maxDistance">The maximum distance each ray should check for collisions. Defaults to <see cref="Mathf.Infinity"/>.</param>
+            /// <param name="layerMask">A layer mask that defines which layers to include in the raycast. Defaults to <see cref="DefaultRaycastLayers"/>.</param>
+            /// <param name="querySensors">
+            /// If <c>true</c>, the raycast will include sensors in its results. Defaults to <c>false</c>.
+            /// </param>
+            /// <returns>
+            /// One entry per ray holding the first object hit, or <c>null</c> if that ray hit nothing.
+            /// </returns>
+            public static RaycastHit?[] RaycastBatch(Ray[] rays, float maxDistance = Mathf.Infinity, int layerMask = DefaultRaycastLayers, bool querySensors = false)
+            {
+                return SphereCastBatch(rays, 0.0f, maxDistance, layerMask, querySensors);
+            }
+
+            /// <summary>
+            /// Casts a sphere along many rays at once. The sweeps are processed in parallel against the physics world.
+            /// </summary>
+            /// <param name="rays">The rays to cast.</param>
+            /// <param name="radius">The radius of the sphere to cast. A radius of zero casts plain rays.</param>
+            /// <param name="maxDistance">The maximum distance each ray should check for collisions. Defaults to <see cref="Mathf.Infinity"/>.</param>
+            /// <param name="layerMask">A layer mask that defines which layers to include in the raycast. Defaults to <see cref="DefaultRaycastLayers"/>.</param>
+            /// <param name="querySensors">
+            /// If <c>true</c>, the cast will include sensors in its results. Defaults to <c>false</c>.
+            /// </param>
+            /// <returns>
+            /// One entry per ray holding the first object hit, or <c>null</c> if that ray hit nothing.
+            /// </returns>
+            public static RaycastHit?[] SphereCastBatch(Ray[] rays, float radius, float maxDistance = Mathf.Infinity, int layerMask = DefaultRaycastLayers, bool querySensors = false)
+            {
+                var queries = new CastQuery[rays.Length];
+                for (int i = 0; i < rays.Length; i++)
+                {
+                    queries[i] = new CastQuery(rays[i], radius, maxDistance, layerMask, querySensors);
+                }
+                return CastBatch(queries);
+            }
+
+            /// <summary>
+            /// Runs many ray and sphere casts at once, each with its own radius, distance and layers.
+            /// The casts are processed in parallel against the physics world.
+            /// </summary>
+            /// <param name="queries">The casts to run.</param>
+            /// <returns>
+            /// One entry per cast holding the first object hit, or <c>null</c> if that cast hit nothing.
+            /// </returns>
+            public static RaycastHit?[] CastBatch(CastQuery[] queries)
+            {
+                byte[] rawHits = internal_m2n_physics_cast_batch(queries.ToByteArray());
+                RaycastHit[] hits = rawHits.ToStructArray<RaycastHit>();
+
+                var result = new RaycastHit?[hits.Length];
+                for (int i = 0; i < hits.Length; i++)
+                {
+                    if (hits[i].entity.Id != uint.MaxValue)
+                    {
+                        result[i] = hits[i];
+                    }
+                }
+                return result;
+            }
+
+            /// <summary>
+            /// Tests many spheres at once and returns the objects touching or inside each of them.
+            /// The overlaps are processed in parallel against the physics world.
+            /// </summary>
+            /// <param name="origins">The origins of the spheres.</param>
+            /// <param name="radius">The radius of the spheres.</param>
+            /// <param name="maxHits">The maximum number of objects returned per sphere. Further objects are dropped.</param>
+            /// <param name="layerMask">A layer mask that defines which layers to include in the test. Defaults to <see cref="DefaultRaycastLayers"/>.</param>
+            /// <param name="querySensors">
+            /// If <c>true</c>, the test will include sensors in its results. Defaults to <c>false</c>.
+            /// </param>
+            /// <returns>
+            /// One array of <see cref="Entity"/> objects per sphere.
+            /// </returns>
+            public static Entity[][] SphereOverlapBatch(Vector3[] origins, float radius, int maxHits, int layerMask = DefaultRaycastLayers, bool querySensors = false)
+            {
+                var queries = new OverlapQuery[origins.Length];
+                for (int i = 0; i < origins.Length; i++)
+                {
+                    queries[i] = new OverlapQuery(origins[i], radius, layerMask, querySensors);
+                }
+                return SphereOverlapBatch(queries, maxHits);
+            }
+
+            /// <summary>
+            /// Tests many spheres at once, each with its own radius and layers, and returns the objects touching or inside each of them.
+            /// The overlaps are processed in parallel against the physics world.
+            /// </summary>
+            /// <param name="queries">The spheres to test.</param>
+            /// <param name="maxHits">The maximum number of objects returned per sphere. Further objects are dropped.</param>
+            /// <returns>
+            /// One array of <see cref="Entity"/> objects per sphere.
+            /// </returns>
+            public static Entity[][] SphereOverlapBatch(OverlapQuery[] queries, int maxHits)
+            {
+                // Hits come grouped by sphere, each with the index of its sphere.
+                byte[] rawHits = internal_m2n_physics_sphere_overlap_batch(queries.ToByteArray(), maxHits);
+                OverlapHit[] hits = rawHits.ToStructArray<OverlapHit>();
+
+                var counts = new int[queries.Length];
+                foreach (var hit in hits)
+                {
+                    counts[hit.query]++;
+                }
+
+                var result = new Entity[queries.Length][];
+                for (int i = 0; i < queries.Length; i++)
+                {
+                    result[i] = new Entity[counts[i]];
+                }
+
+                int offset = 0;
+                for (int i = 0; i < queries.Length; i++)
+                {
+                    for (int j = 0; j < counts[i]; j++)
+                    {
+                        result[i][j] = hits[offset + j].entity;
+                    }
+                    offset += counts[i];
+                }
+                return result;
+            }
+
+            [StructLayout(LayoutKind.Sequential)]
+            private struct OverlapHit
+            {
+                public int query;
+                public Entity entity;
+            }
+
             [MethodImpl(MethodImplOptions.InternalCall)]
             private static extern bool internal_m2n_physics_ray_cast(out RaycastHit hit, Vector3 origin, Vector3 direction, float maxDistance, int layerMask, bool querySensors);
 
@@ -209,6 +343,12 @@ public static Entity[] SphereOverlap(Vector3 origin, float radius, int layerMask
         
             [MethodImpl(MethodImplOptions.InternalCall)]
             private static extern byte[] internal_m2n_physics_sphere_overlap(Vector3 origin, float radius, int layerMask, bool querySensors);
+
+            [MethodImpl(MethodImplOptions.InternalCall)]
+            private static extern byte[] internal_m2n_physics_cast_batch(byte[] queries);
+
+            [MethodImpl(MethodImplOptions.InternalCall)]
+            private static extern byte[] internal_m2n_physics_sphere_overlap_batch(byte[] queries, int maxHits);
     }
 }
 }
@@ -35,6 +35,31 @@ public static class ByteArrayExtensions
         return result;
     }
 
+    // Public function to convert an array of structs to a byte array
+    public static byte[] ToByteArray<T>(this T[] data) where T : struct
+    {
+        int structSize = Marshal.SizeOf<T>();
+        byte[] result = new byte[data.Length * structSize];
+
+        IntPtr ptr = Marshal.AllocHGlobal(structSize);
+
+        try
+        {
+            for (int i = 0; i < data.Length; i++)
+            {
+                // Marshal each struct and copy it into its slot of the byte array
+                Marshal.StructureToPtr(data[i], ptr, false);
+                Marshal.Copy(ptr, result, i * structSize, structSize);
+            }
+        }
+        finally
+        {
+            Marshal.FreeHGlobal(ptr);
+        }
+
+        return result;
+    }
+
     // Private helper function to convert a byte array segment to a struct
     private static T ToStructImpl<T>(byte[] data, int offset, int size) where T : struct
     {
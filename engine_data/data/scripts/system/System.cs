@@ -22,6 +22,25 @@ public struct FixedUpdateInfo
     public float deltaTime;
 }
 
+// Mirrors unravel::contact_event_type in physics_component.h, keep them in the same order.
+public enum ContactEventType : uint
+{
+    SensorEnter,
+    SensorExit,
+    CollisionEnter,
+    CollisionExit,
+}
+
+[StructLayout(LayoutKind.Sequential)]
+public struct ContactEvent
+{
+    public ContactEventType type;
+    public Entity receiver;
+    public Entity other;
+    public uint firstPoint;
+    public uint pointCount;
+}
+
 public static class Time
 {
     public static float deltaTime;
@@ -259,6 +278,89 @@ public static void internal_n2m_late_update()
     {
         ScriptManager.InvokeLateUpdate();
     }
+
+    // Scripts by the id of their entity, for delivering contact events.
+    private static Dictionary<uint, List<ScriptComponent>> entityScripts = new Dictionary<uint, List<ScriptComponent>>();
+    private static List<ScriptComponent> receivers = new List<ScriptComponent>();
+
+    internal static void AddEntityScript(ScriptComponent comp)
+    {
+        // The owner is reset before the script is destroyed, remember which entity it was added for.
+        comp.contactEntityId = comp.owner.Id;
+        if (!entityScripts.TryGetValue(comp.contactEntityId, out var scripts))
+        {
+            scripts = new List<ScriptComponent>();
+            entityScripts.Add(comp.contactEntityId, scripts);
+        }
+        scripts.Add(comp);
+    }
+
+    internal static void RemoveEntityScript(ScriptComponent comp)
+    {
+        if (entityScripts.TryGetValue(comp.contactEntityId, out var scripts))
+        {
+            scripts.Remove(comp);
+            if (scripts.Count == 0)
+            {
+                entityScripts.Remove(comp.contactEntityId);
+            }
+        }
+    }
+
+    /// <summary>
+    /// Delivers the sensor and collision events of a frame, sent in one batch.
+    /// </summary>
+    /// <param name="eventData">The serialized events, one per receiving entity.</param>
+    /// <param name="pointData">The serialized contact points referenced by the collision events.</param>
+    public static void internal_n2m_on_contact_events(byte[] eventData, byte[] pointData)
+    {
+        var events = eventData.ToStructArray<ContactEvent>();
+        var points = pointData != null ? pointData.ToStructArray<ContactPoint>() : Array.Empty<ContactPoint>();
+
+        foreach (var e in events)
+        {
+            if (!entityScripts.TryGetValue(e.receiver.Id, out var scripts))
+            {
+                continue;
+            }
+
+            // Callbacks may add or remove scripts.
+            receivers.Clear();
+            receivers.AddRange(scripts);
+
+            Collision collision = null;
+            if (e.type == ContactEventType.CollisionEnter || e.type == ContactEventType.CollisionExit)
+            {
+                var contacts = new ContactPoint[e.pointCount];
+                Array.Copy(points, e.firstPoint, contacts, 0, e.pointCount);
+                collision = new Collision
+                {
+                    entity = e.other,
+                    contacts = contacts
+                };
+            }
+
+            foreach (var script in receivers)
+            {
+                // A throwing script must not keep the others from their events.
+                try
+                {
+                    switch (e.type)
+                    {
+                        case ContactEventType.SensorEnter: script.OnSensorEnter(e.other); break;
+                        case ContactEventType.SensorExit: script.OnSensorExit(e.other); break;
+                        case ContactEventType.CollisionEnter: script.OnCollisionEnter(collision); break;
+                        case ContactEventType.CollisionExit: script.OnCollisionExit(collision); break;
+                    }
+                }
+                catch (Exception ex)
+                {
+                    Log.Error(ex.ToString());
+                }
+            }
+        }
+        receivers.Clear();
+    }
 }
 
 
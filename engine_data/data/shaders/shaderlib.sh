@@ -494,6 +494,16 @@ mat3 calculateInverseTranspose( mat4 m )
 	return transpose(invert_3x3(m));
 }
 
+// Decodes a unit vector stored with octahedral encoding, e is in [-1, 1].
+vec3 octahedralDecode( vec2 e )
+{
+	vec3 n = vec3(e.x, e.y, 1.0 - abs(e.x) - abs(e.y));
+	float t = max(-n.z, 0.0);
+	n.x += n.x >= 0.0 ? -t : t;
+	n.y += n.y >= 0.0 ? -t : t;
+	return normalize(n);
+}
+
 #if BGFX_SHADER_TYPE_FRAGMENT
 mat3 computeTangentToWorldSpaceMatrix( vec3 N, vec3 p, vec2 uv )
 {
@@ -0,0 +1,31 @@
+$input a_position, a_normal, a_texcoord0
+$output v_wpos, v_pos, v_wnormal, v_wtangent, v_wbitangent, v_texcoord0
+
+#include "common.sh"
+
+void main()
+{
+    //u_world already expands the quantized position to mesh space
+    vec4 wpos = mul(u_world[0], vec4(a_position.xyz, 1.0) );
+    gl_Position = mul(u_viewProj, wpos );
+
+    vec3 normal = octahedralDecode(a_normal.xy * 2.0 - 1.0);
+    vec3 tangent = octahedralDecode(a_normal.zw * 2.0 - 1.0);
+    vec3 bitangent = cross(normal, tangent) * a_position.w;
+
+    mat3 modelIT = calculateInverseTranspose(u_world[0]);
+
+    vec3 wnormal = normalize(mul(modelIT, normal ));
+    vec3 wtangent = normalize(mul(modelIT, tangent ));
+    vec3 wbitangent = normalize(mul(modelIT, bitangent ));
+
+    v_wpos = wpos.xyz;
+    v_pos = gl_Position.xyz/gl_Position.w;
+
+    v_wnormal   = wnormal;
+    v_wtangent   = wtangent;
+    v_wbitangent = wbitangent;
+
+    v_texcoord0 = a_texcoord0;
+
+}